@@ -0,0 +1,279 @@
+/**
+ * frame_stream_bench: compares the FrameStream delta protocol with the raw
+ * one-frame-per-datagram path used by the Shadertoy, Video and SpotifyMV
+ * plugins. Reports bandwidth, datagrams, encode and decode cost per frame,
+ * and how many frames arrive intact when datagrams get lost.
+ *
+ * Usage:
+ *   frame_stream_bench [--width <px>] [--height <px>] [--frames <n>] [--loss <percent>] [--seed <n>]
+ *
+ * Defaults:
+ *   --width   128
+ *   --height  128
+ *   --frames  600
+ *   --loss    0       (chance that a single datagram or IP fragment is dropped)
+ *   --seed    1
+ *
+ * Content scenarios:
+ *   static   still image with a small animated area (album art with a progress bar)
+ *   sprites  dark background with a few moving objects (typical shader)
+ *   full     every pixel changes every frame (plasma, video pans)
+ *   noise    random pixels, the worst case for both deltas and compression
+ *
+ * "legacy" is the raw path: one UDP datagram per frame that the IP layer splits
+ * into 1480 byte fragments, losing any of them loses the frame. The other modes
+ * are FrameStream with the given tile codec. Decode cost is measured on the
+ * matrix side (FrameStreamReceiver, including publishing the frame). "intact"
+ * counts frames the scene draws exactly as sent, "pixels ok" is the average
+ * share of correct pixels, which shows how much of a frame survives a loss.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "shared/common/udp/frame_stream.h"
+#include "shared/matrix/utils/FrameStreamReceiver.h"
+
+namespace
+{
+    struct Args
+    {
+        int width = 128;
+        int height = 128;
+        int frames = 600;
+        double loss = 0;
+        unsigned seed = 1;
+    };
+
+    Args parse_args(int argc, char *argv[])
+    {
+        Args a;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--width" && i + 1 < argc)
+                a.width = std::clamp(std::atoi(argv[++i]), 8, 512);
+            else if (arg == "--height" && i + 1 < argc)
+                a.height = std::clamp(std::atoi(argv[++i]), 8, 512);
+            else if (arg == "--frames" && i + 1 < argc)
+                a.frames = std::max(1, std::atoi(argv[++i]));
+            else if (arg == "--loss" && i + 1 < argc)
+                a.loss = std::clamp(std::atof(argv[++i]), 0.0, 50.0) / 100.0;
+            else if (arg == "--seed" && i + 1 < argc)
+                a.seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        return a;
+    }
+
+    using Generator = std::function<void(std::vector<uint8_t> &frame, int width, int height, int index)>;
+
+    struct Scenario
+    {
+        const char *name;
+        Generator generate;
+    };
+
+    void put_pixel(std::vector<uint8_t> &frame, int width, int x, int y, uint8_t r, uint8_t g, uint8_t b)
+    {
+        uint8_t *pixel = frame.data() + (static_cast<size_t>(y) * width + x) * 3;
+        pixel[0] = r;
+        pixel[1] = g;
+        pixel[2] = b;
+    }
+
+    std::vector<Scenario> scenarios(unsigned seed)
+    {
+        return {
+            {"static", [](std::vector<uint8_t> &frame, int width, int height, int index)
+             {
+                 for (int y = 0; y < height; ++y)
+                     for (int x = 0; x < width; ++x)
+                         put_pixel(frame, width, x, y, static_cast<uint8_t>(x * 2), static_cast<uint8_t>(y * 2), static_cast<uint8_t>((x ^ y) * 4));
+
+                 const int progress = index % width;
+                 for (int x = 0; x < progress; ++x)
+                     for (int y = height - 3; y < height; ++y)
+                         put_pixel(frame, width, x, y, 30, 215, 96);
+             }},
+            {"sprites", [](std::vector<uint8_t> &frame, int width, int height, int index)
+             {
+                 std::fill(frame.begin(), frame.end(), 0);
+                 for (int s = 0; s < 6; ++s)
+                 {
+                     const float t = static_cast<float>(index) * 0.03f + static_cast<float>(s);
+                     const int cx = static_cast<int>((std::sin(t * 1.3f) * 0.4f + 0.5f) * static_cast<float>(width));
+                     const int cy = static_cast<int>((std::cos(t * 0.7f) * 0.4f + 0.5f) * static_cast<float>(height));
+                     for (int y = std::max(0, cy - 6); y < std::min(height, cy + 6); ++y)
+                         for (int x = std::max(0, cx - 6); x < std::min(width, cx + 6); ++x)
+                             put_pixel(frame, width, x, y, static_cast<uint8_t>(s * 40), 200, static_cast<uint8_t>(255 - s * 40));
+                 }
+             }},
+            {"full", [](std::vector<uint8_t> &frame, int width, int height, int index)
+             {
+                 const float t = static_cast<float>(index) * 0.05f;
+                 for (int y = 0; y < height; ++y)
+                     for (int x = 0; x < width; ++x)
+                     {
+                         const float v = std::sin(static_cast<float>(x) * 0.06f + t) + std::sin(static_cast<float>(y) * 0.05f - t);
+                         put_pixel(frame, width, x, y, static_cast<uint8_t>(64 * (v + 2)), static_cast<uint8_t>(x + index), static_cast<uint8_t>(y * 2));
+                     }
+             }},
+            {"noise", [rng = std::mt19937(seed)](std::vector<uint8_t> &frame, int, int, int) mutable
+             {
+                 for (auto &byte : frame)
+                     byte = static_cast<uint8_t>(rng());
+             }},
+        };
+    }
+
+    struct Lossy
+    {
+        std::mt19937 rng;
+        std::bernoulli_distribution drop;
+
+        Lossy(unsigned seed, double loss) : rng(seed), drop(loss) {}
+
+        bool lost() { return drop(rng); }
+    };
+
+    double elapsed_us(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    struct Accuracy
+    {
+        int intact_frames = 0;
+        double correct_pixels = 0;
+
+        /// Compares what the scene would draw with what the sender rendered.
+        void check(FrameStreamReceiver &receiver, const std::vector<uint8_t> &frame)
+        {
+            const auto view = receiver.read();
+            if (view.size() != frame.size())
+                return;
+
+            size_t correct = 0;
+            for (size_t i = 0; i < frame.size(); i += 3)
+                correct += std::memcmp(view.data() + i, frame.data() + i, 3) == 0;
+
+            intact_frames += correct * 3 == frame.size();
+            correct_pixels += static_cast<double>(correct * 3) / static_cast<double>(frame.size());
+        }
+    };
+
+    void print_row(const char *scenario, const char *mode, double bytes, double raw_bytes, double datagrams,
+                   double encode_us, double decode_us, const Accuracy &accuracy, int frames)
+    {
+        std::printf("%-8s %-6s %10.0f %7.1f%% %10.1f %10.2f %10.2f %9.1f%% %9.2f%%\n",
+                    scenario, mode, bytes, 100.0 * bytes / raw_bytes, datagrams, encode_us, decode_us,
+                    100.0 * accuracy.intact_frames / frames, 100.0 * accuracy.correct_pixels / frames);
+    }
+
+    void run_raw(const Scenario &scenario, const Args &args)
+    {
+        const size_t frame_bytes = static_cast<size_t>(args.width) * args.height * 3;
+        const size_t datagram_bytes = frame_bytes + FrameStream::packet_header_size;
+        // IPv4 fragments carry up to 1480 bytes of the UDP datagram (plus its 8 byte header)
+        const size_t ip_fragments = (datagram_bytes + 8 + 1479) / 1480;
+
+        std::vector<uint8_t> frame(frame_bytes);
+        FrameStreamReceiver receiver;
+        Lossy network(args.seed, args.loss);
+
+        double decode_us = 0;
+        Accuracy accuracy;
+        for (int i = 0; i < args.frames; ++i)
+        {
+            scenario.generate(frame, args.width, args.height, i);
+
+            bool lost = false;
+            for (size_t f = 0; f < ip_fragments; ++f)
+                lost |= network.lost();
+
+            if (!lost)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                receiver.receive(frame.data(), frame.size());
+                decode_us += elapsed_us(start);
+            }
+
+            accuracy.check(receiver, frame);
+        }
+
+        print_row(scenario.name, "legacy", static_cast<double>(datagram_bytes), static_cast<double>(datagram_bytes),
+                  static_cast<double>(ip_fragments), 0, decode_us / args.frames, accuracy, args.frames);
+    }
+
+    void run_stream(const Scenario &scenario, FrameStream::Codec codec, const Args &args)
+    {
+        const size_t frame_bytes = static_cast<size_t>(args.width) * args.height * 3;
+        const double raw_bytes = static_cast<double>(frame_bytes + FrameStream::packet_header_size);
+
+        FrameStream::EncoderOptions options;
+        options.codec = codec;
+        FrameStream::Encoder encoder(options);
+        FrameStreamReceiver receiver;
+        Lossy network(args.seed, args.loss);
+
+        std::vector<uint8_t> frame(frame_bytes);
+        double encode_us = 0;
+        double decode_us = 0;
+        Accuracy accuracy;
+        for (int i = 0; i < args.frames; ++i)
+        {
+            scenario.generate(frame, args.width, args.height, i);
+
+            // The keyframe request travels back over the websocket, assume it arrives before the next frame
+            if (receiver.take_keyframe_request())
+                encoder.force_keyframe();
+
+            auto start = std::chrono::steady_clock::now();
+            const auto fragments = encoder.encode(frame.data(), args.width, args.height);
+            encode_us += elapsed_us(start);
+
+            start = std::chrono::steady_clock::now();
+            for (const auto &fragment : fragments)
+            {
+                if (!network.lost())
+                    receiver.receive(fragment.data(), fragment.size());
+            }
+            decode_us += elapsed_us(start);
+
+            accuracy.check(receiver, frame);
+        }
+
+        const auto &stats = encoder.get_stats();
+        print_row(scenario.name, FrameStream::to_string(codec).c_str(),
+                  static_cast<double>(stats.bytes) / args.frames, raw_bytes,
+                  static_cast<double>(stats.fragments) / args.frames,
+                  encode_us / args.frames, decode_us / args.frames, accuracy, args.frames);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const Args args = parse_args(argc, argv);
+
+    std::printf("frame_stream_bench  %dx%d  frames=%d  loss=%.1f%%\n\n", args.width, args.height, args.frames, args.loss * 100);
+    std::printf("%-8s %-6s %10s %8s %10s %10s %10s %10s %10s\n",
+                "content", "mode", "bytes/frm", "of raw", "dgrams/frm", "encode us", "decode us", "intact", "pixels ok");
+
+    for (const auto &scenario : scenarios(args.seed))
+    {
+        run_raw(scenario, args);
+        for (const auto codec : {FrameStream::Codec::Raw, FrameStream::Codec::Rle, FrameStream::Codec::Lz4})
+            run_stream(scenario, codec, args);
+        std::printf("\n");
+    }
+
+    return 0;
+}
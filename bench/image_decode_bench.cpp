@@ -0,0 +1,193 @@
+/**
+ * image_decode_bench: compares the native GIF/PNG/JPEG decoder in LoadImageAndScale
+ * with the GraphicsMagick path (readImages + coalesceImages + scale + crop).
+ * Every image of the corpus is loaded and scaled to the panel size the same way
+ * ImageScene does (fill both axes, contain the image).
+ *
+ * Usage:
+ *   image_decode_bench [--width <px>] [--height <px>] [--runs <n>] [<image or directory>...]
+ *
+ * Defaults:
+ *   --width   64
+ *   --height  64
+ *   --runs    3
+ *   corpus    images/processed/ (downloaded PixelJoint posts), or scene_previews/ if that is empty
+ *
+ * Each decoder runs in its own child process, so "peak RSS" is the maximum resident
+ * size of a process that did nothing but load the corpus with that decoder.
+ * "p50/p95/max" are per image latencies over all runs.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Magick++.h"
+#include "shared/matrix/utils/canvas_image.h"
+#include "shared/matrix/utils/consts.h"
+
+namespace
+{
+    struct Args
+    {
+        int width = 64;
+        int height = 64;
+        int runs = 3;
+        std::vector<std::filesystem::path> inputs;
+    };
+
+    Args parse_args(int argc, char *argv[])
+    {
+        Args a;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--width" && i + 1 < argc)
+                a.width = std::clamp(std::atoi(argv[++i]), 1, 512);
+            else if (arg == "--height" && i + 1 < argc)
+                a.height = std::clamp(std::atoi(argv[++i]), 1, 512);
+            else if (arg == "--runs" && i + 1 < argc)
+                a.runs = std::max(1, std::atoi(argv[++i]));
+            else
+                a.inputs.emplace_back(arg);
+        }
+        return a;
+    }
+
+    std::vector<std::filesystem::path> collect_corpus(const std::vector<std::filesystem::path> &inputs)
+    {
+        std::vector<std::filesystem::path> files;
+        for (const auto &input : inputs)
+        {
+            std::error_code ec;
+            if (std::filesystem::is_regular_file(input, ec))
+            {
+                files.push_back(input);
+                continue;
+            }
+
+            for (const auto &entry : std::filesystem::directory_iterator(input, ec))
+            {
+                const auto ext = entry.path().extension().string();
+                if (entry.is_regular_file(ec) && (ext == ".gif" || ext == ".png" || ext == ".jpg" || ext == ".jpeg"))
+                    files.push_back(entry.path());
+            }
+        }
+
+        std::ranges::sort(files);
+        return files;
+    }
+
+    struct Result
+    {
+        int failed = 0;
+        size_t frames = 0;
+        double p50_ms = 0;
+        double p95_ms = 0;
+        double max_ms = 0;
+        double total_ms = 0;
+    };
+
+    Result run_decoder(const Args &args, const std::vector<std::filesystem::path> &files)
+    {
+        std::vector<double> latencies;
+        Result r;
+
+        for (int run = 0; run < args.runs; ++run)
+        {
+            for (const auto &file : files)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                auto frames = LoadImageAndScale(file, args.width, args.height, true, true, true);
+                const auto elapsed = std::chrono::steady_clock::now() - start;
+
+                latencies.push_back(std::chrono::duration<double, std::milli>(elapsed).count());
+                if (!frames.has_value())
+                    r.failed++;
+                else if (run == 0)
+                    r.frames += frames->size();
+            }
+        }
+
+        std::ranges::sort(latencies);
+        for (const double l : latencies)
+            r.total_ms += l;
+        r.p50_ms = latencies[latencies.size() / 2];
+        r.p95_ms = latencies[std::min(latencies.size() - 1, latencies.size() * 95 / 100)];
+        r.max_ms = latencies.back();
+        return r;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const Args args = parse_args(argc, argv);
+    auto files = collect_corpus(args.inputs);
+    if (args.inputs.empty())
+    {
+        files = collect_corpus({Constants::post_dir});
+        if (files.empty())
+            files = collect_corpus({"scene_previews"});
+    }
+
+    if (files.empty())
+    {
+        std::fprintf(stderr, "No images found, pass image files or directories\n");
+        return 1;
+    }
+
+    uintmax_t corpus_bytes = 0;
+    for (const auto &file : files)
+        corpus_bytes += std::filesystem::file_size(file);
+
+    std::printf("image_decode_bench  images=%zu (%.1f MB)  target=%dx%d  runs=%d\n\n", files.size(),
+                corpus_bytes / (1024.0 * 1024.0), args.width, args.height, args.runs);
+    std::printf("%-8s  %7s  %7s  %9s  %9s  %9s  %10s  %12s\n", "decoder", "frames", "failed", "p50 ms", "p95 ms",
+                "max ms", "total s", "peak RSS MB");
+
+    for (const char *decoder : {"magick", "native"})
+    {
+        int fds[2];
+        if (pipe(fds) != 0)
+            return 1;
+
+        const pid_t pid = fork();
+        if (pid == 0)
+        {
+            // The decoder choice is read once per process
+            close(fds[0]);
+            setenv("MATRIX_IMAGE_DECODER", decoder, 1);
+            Magick::InitializeMagick(*argv);
+
+            const Result r = run_decoder(args, files);
+            const ssize_t written = write(fds[1], &r, sizeof(r));
+            _exit(written == sizeof(r) ? 0 : 1);
+        }
+
+        close(fds[1]);
+        Result r;
+        const bool ok = read(fds[0], &r, sizeof(r)) == sizeof(r);
+        close(fds[0]);
+
+        int status = 0;
+        rusage usage{};
+        wait4(pid, &status, 0, &usage);
+        if (!ok || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            std::printf("%-8s  failed to run\n", decoder);
+            continue;
+        }
+
+        std::printf("%-8s  %7zu  %7d  %9.2f  %9.2f  %9.2f  %10.2f  %12.1f\n", decoder, r.frames, r.failed, r.p50_ms,
+                    r.p95_ms, r.max_ms, r.total_ms / 1000.0, usage.ru_maxrss / 1024.0);
+    }
+
+    return 0;
+}
@@ -0,0 +1,373 @@
+/**
+ * layer_composite_bench: per-frame cost of a WeatherScene frame drawn the way the
+ * scene did before (everything with SetPixel/DrawText every frame) vs sky in a
+ * CanvasBuffer with the cached CanvasLayer of border, labels and icons put on top.
+ *
+ * Usage:
+ *   layer_composite_bench [--fonts <dir>] [--sizes <WxH,...>] [--frames <n>]
+ *
+ * Defaults:
+ *   --fonts   shared/fonts of the source tree
+ *   --sizes   128x128,192x128
+ *   --frames  1000
+ *
+ * The frame is the scene's layout on a clear day without animations: the pulsing
+ * gradient sky, the border, eleven labels, a 42x42 weather icon and three 16x16
+ * forecast icons with soft (translucent) edges. Icons are generated, not loaded.
+ * The layer is drawn once, "rebuild us" is what a redraw costs when the data or
+ * the minute changes. "covered" is the share of the frame the layer writes.
+ *
+ * "max diff" is the largest difference of a color channel between both frames. The
+ * old path blends icons with what GetPixel() reads back from the canvas, the layer
+ * blends in memory, so the soft icon edges may differ slightly.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "graphics.h"
+#include "led-matrix.h"
+#include "shared/matrix/canvas_buffer.h"
+#include "shared/matrix/canvas_layer.h"
+#include "shared/matrix/utils/FontRegistry.h"
+#include "shared/matrix/utils/TextCache.h"
+
+#ifndef LAYER_BENCH_FONTS_DIR
+#define LAYER_BENCH_FONTS_DIR "shared/fonts"
+#endif
+
+namespace
+{
+    struct Size
+    {
+        int width;
+        int height;
+    };
+
+    struct Args
+    {
+        std::filesystem::path fonts = LAYER_BENCH_FONTS_DIR;
+        std::vector<Size> sizes{{128, 128}, {192, 128}};
+        int frames = 1000;
+    };
+
+    Args parse_args(int argc, char *argv[])
+    {
+        Args a;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--fonts" && i + 1 < argc)
+                a.fonts = argv[++i];
+            else if (arg == "--sizes" && i + 1 < argc)
+            {
+                a.sizes.clear();
+                std::stringstream ss(argv[++i]);
+                std::string token;
+                while (std::getline(ss, token, ','))
+                {
+                    Size size{};
+                    if (std::sscanf(token.c_str(), "%dx%d", &size.width, &size.height) == 2 && size.width > 0 &&
+                        size.height > 0)
+                        a.sizes.push_back(size);
+                }
+            }
+            else if (arg == "--frames" && i + 1 < argc)
+                a.frames = std::max(1, std::atoi(argv[++i]));
+        }
+        return a;
+    }
+
+    struct Label
+    {
+        const rgb_matrix::Font *font;
+        int x;
+        int y;
+        rgb_matrix::Color color;
+        std::string text;
+    };
+
+    /// A round icon with a soft edge, alpha in [0, 1] per pixel.
+    struct Icon
+    {
+        int x;
+        int y;
+        int size;
+        rgb_matrix::Color color;
+
+        [[nodiscard]] float alpha(int px, int py) const
+        {
+            const float r = size / 2.0f;
+            const float d = std::hypot(px + 0.5f - r, py + 0.5f - r);
+            return std::clamp(r - d, 0.0f, 1.5f) / 1.5f;
+        }
+    };
+
+    const rgb_matrix::Color sky{109, 158, 235}; // SkyColor::DAY_CLEAR
+    constexpr float gradient_intensity = 0.7f;
+    constexpr int border_padding = 2;
+
+    rgb_matrix::Color border_color()
+    {
+        return {static_cast<uint8_t>(std::min(255, sky.r + 40)), static_cast<uint8_t>(std::min(255, sky.g + 40)),
+                static_cast<uint8_t>(std::min(255, sky.b + 40))};
+    }
+
+    float pulse_factor(int frame)
+    {
+        const int animation_frame = frame % 60;
+        const int pulse = (animation_frame < 30) ? animation_frame : 60 - animation_frame;
+        return 1.0f + (pulse / 600.0f);
+    }
+
+    /// WeatherScene before the layers: every part drawn into the canvas every frame.
+    void draw_direct(rgb_matrix::FrameCanvas *canvas, int frame, const std::vector<Label> &labels,
+                     const std::vector<Icon> &icons)
+    {
+        const int w = canvas->width();
+        const int h = canvas->height();
+        canvas->Clear();
+
+        for (int y = 0; y < h; y++)
+        {
+            const float gradient_factor = 1.0f - (float)y / h * gradient_intensity;
+            for (int x = 0; x < w; x++)
+            {
+                const float x_variation = 1.0f + std::sin(x * 0.1f) * 0.05f;
+                const float pulse = pulse_factor(frame);
+                canvas->SetPixel(x, y, std::min(255.0f, sky.r * gradient_factor * x_variation * pulse),
+                                 std::min(255.0f, sky.g * gradient_factor * x_variation * pulse),
+                                 std::min(255.0f, sky.b * gradient_factor * x_variation * pulse));
+            }
+        }
+
+        const rgb_matrix::Color border = border_color();
+        for (int x = border_padding; x < w - border_padding; x++)
+        {
+            canvas->SetPixel(x, border_padding, border.r, border.g, border.b);
+            canvas->SetPixel(x, h - border_padding - 1, border.r, border.g, border.b);
+        }
+        for (int y = border_padding; y < h - border_padding; y++)
+        {
+            canvas->SetPixel(border_padding, y, border.r, border.g, border.b);
+            canvas->SetPixel(w - border_padding - 1, y, border.r, border.g, border.b);
+        }
+
+        for (const auto &icon : icons)
+        {
+            for (int y = 0; y < icon.size; y++)
+            {
+                for (int x = 0; x < icon.size; x++)
+                {
+                    const float alpha = icon.alpha(x, y);
+                    if (alpha <= 0.0f)
+                        continue;
+
+                    // Like SetImageTransparent(): blend with what the canvas reads back
+                    uint8_t r = 255, g, b;
+                    canvas->GetPixel(icon.x + x, icon.y + y, &r, &g, &b);
+                    canvas->SetPixel(icon.x + x, icon.y + y,
+                                     static_cast<uint8_t>(icon.color.r * alpha + r * (1.0f - alpha)),
+                                     static_cast<uint8_t>(icon.color.g * alpha + g * (1.0f - alpha)),
+                                     static_cast<uint8_t>(icon.color.b * alpha + b * (1.0f - alpha)));
+                }
+            }
+        }
+
+        for (const auto &label : labels)
+            rgb_matrix::DrawText(canvas, *label.font, label.x, label.y, label.color, label.text.c_str());
+    }
+
+    /// The cached part of the frame.
+    void draw_layer(CanvasLayer &layer, TextCache &text, const std::vector<Label> &labels,
+                    const std::vector<Icon> &icons)
+    {
+        const int w = layer.width();
+        const int h = layer.height();
+        layer.begin(1);
+
+        const rgb_matrix::Color border = border_color();
+        for (int x = border_padding; x < w - border_padding; x++)
+        {
+            layer.SetPixel(x, border_padding, border.r, border.g, border.b);
+            layer.SetPixel(x, h - border_padding - 1, border.r, border.g, border.b);
+        }
+        for (int y = border_padding; y < h - border_padding; y++)
+        {
+            layer.SetPixel(border_padding, y, border.r, border.g, border.b);
+            layer.SetPixel(w - border_padding - 1, y, border.r, border.g, border.b);
+        }
+
+        for (const auto &icon : icons)
+            for (int y = 0; y < icon.size; y++)
+                for (int x = 0; x < icon.size; x++)
+                    if (const float alpha = icon.alpha(x, y); alpha > 0.0f)
+                        layer.blend(icon.x + x, icon.y + y, icon.color.r, icon.color.g, icon.color.b, alpha);
+
+        for (const auto &label : labels)
+            text.draw(&layer, *label.font, label.x, label.y, label.color, label.text);
+
+        layer.end();
+    }
+
+    /// WeatherScene with the layers: sky into the buffer, cached layer on top, one bulk write.
+    void draw_layered(rgb_matrix::FrameCanvas *canvas, int frame, CanvasBuffer &buffer,
+                      const std::vector<float> &variation, const CanvasLayer &layer)
+    {
+        const int w = buffer.width();
+        const int h = buffer.height();
+        const float pulse = pulse_factor(frame);
+
+        for (int y = 0; y < h; y++)
+        {
+            const float gradient_factor = 1.0f - (float)y / h * gradient_intensity;
+            const float row_r = sky.r * gradient_factor;
+            const float row_g = sky.g * gradient_factor;
+            const float row_b = sky.b * gradient_factor;
+
+            rgb_matrix::Color *row = buffer.row(y);
+            for (int x = 0; x < w; x++)
+            {
+                row[x].r = std::min(255.0f, row_r * variation[x] * pulse);
+                row[x].g = std::min(255.0f, row_g * variation[x] * pulse);
+                row[x].b = std::min(255.0f, row_b * variation[x] * pulse);
+            }
+        }
+
+        layer.composite(buffer);
+        buffer.write_to(canvas);
+    }
+
+    rgb_matrix::RGBMatrixBase *create_matrix(const Size &size)
+    {
+        rgb_matrix::RGBMatrix::Options led_opts;
+        led_opts.rows = size.height;
+        led_opts.cols = size.width;
+        led_opts.chain_length = 1;
+        led_opts.parallel = 1;
+
+        rgb_matrix::RuntimeOptions runtime_opts;
+        runtime_opts.do_gpio_init = false;
+        runtime_opts.drop_privileges = -1;
+        return rgb_matrix::RGBMatrix::CreateFromOptions(led_opts, runtime_opts);
+    }
+
+    double us_per_frame(int frames, const std::function<void(int frame)> &draw)
+    {
+        for (int i = 0; i < std::min(frames, 10); ++i)
+            draw(i);
+
+        using clock = std::chrono::steady_clock;
+        const auto start = clock::now();
+        for (int i = 0; i < frames; ++i)
+            draw(i);
+        return std::chrono::duration<double, std::micro>(clock::now() - start).count() / frames;
+    }
+
+    std::vector<rgb_matrix::Color> snapshot(rgb_matrix::FrameCanvas *canvas)
+    {
+        std::vector<rgb_matrix::Color> pixels(static_cast<size_t>(canvas->width()) * canvas->height());
+        auto *out = pixels.data();
+        for (int y = 0; y < canvas->height(); ++y)
+            for (int x = 0; x < canvas->width(); ++x, ++out)
+                canvas->GetPixel(x, y, &out->r, &out->g, &out->b);
+        return pixels;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const Args args = parse_args(argc, argv);
+
+    auto &fonts = FontRegistry::instance();
+    const rgb_matrix::Font *header = fonts.load(args.fonts / "7x13.bdf");
+    const rgb_matrix::Font *body = fonts.load(args.fonts / "5x8.bdf");
+    const rgb_matrix::Font *small = fonts.load(args.fonts / "4x6.bdf");
+    if (header == nullptr || body == nullptr || small == nullptr)
+    {
+        std::fprintf(stderr, "Could not load the fonts from %s\n", args.fonts.c_str());
+        return 1;
+    }
+
+    std::printf("WeatherScene frame without animations, %d frames per measurement\n", args.frames);
+    std::printf("%-9s %12s %12s %9s %12s %9s %9s\n", "size", "direct us", "layered us", "speedup", "rebuild us",
+                "covered", "max diff");
+
+    for (const auto &size : args.sizes)
+    {
+        rgb_matrix::RGBMatrixBase *matrix = create_matrix(size);
+        if (matrix == nullptr)
+        {
+            std::fprintf(stderr, "Could not create an offscreen %dx%d matrix\n", size.width, size.height);
+            continue;
+        }
+        rgb_matrix::FrameCanvas *canvas = matrix->CreateFrameCanvas();
+
+        // Same places as WeatherScene, the forecast spread over the width
+        const int column = size.width / 3;
+        const std::vector<Label> labels = {
+            {header, 48, 20, {255, 255, 255}, "21.4°C"},
+            {body, 48, 34, {220, 220, 255}, "Partly cloudy"},
+            {small, 48, 44, {200, 200, 255}, "Humidity: 64%"},
+            {small, 48, 51, {200, 200, 255}, "Wind: 12 km/h"},
+            {small, 17, 57, {255, 220, 100}, "↑ 06:42"},
+            {small, size.width / 2 + 27, 57, {255, 180, 80}, "↓ 19:58"},
+            {small, 5, 65, {255, 255, 255}, "3-Day Forecast:"},
+            {small, 7, 78, {255, 255, 255}, "Mon"},
+            {small, column + 7, 78, {255, 255, 255}, "Tue"},
+            {small, 2 * column + 7, 78, {255, 255, 255}, "Wed"},
+            {body, size.width - 30, 11, {255, 255, 255}, "12:34"},
+        };
+        const std::vector<Icon> icons = {
+            {2, 12, 42, {250, 210, 80}},
+            {(column - 16) / 2 - 2, 79, 16, {230, 230, 240}},
+            {column + (column - 16) / 2 - 2, 79, 16, {250, 210, 80}},
+            {2 * column + (column - 16) / 2 - 2, 79, 16, {120, 150, 220}},
+        };
+
+        CanvasBuffer buffer(size.width, size.height);
+        CanvasLayer layer(size.width, size.height);
+        TextCache text;
+        std::vector<float> variation(size.width);
+        for (int x = 0; x < size.width; x++)
+            variation[x] = 1.0f + std::sin(x * 0.1f) * 0.05f;
+
+        // Agreement on one frame
+        draw_direct(canvas, 0, labels, icons);
+        const auto expected = snapshot(canvas);
+        draw_layer(layer, text, labels, icons);
+        draw_layered(canvas, 0, buffer, variation, layer);
+        const auto actual = snapshot(canvas);
+
+        int max_diff = 0;
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            max_diff = std::max({max_diff, std::abs(expected[i].r - actual[i].r),
+                                 std::abs(expected[i].g - actual[i].g), std::abs(expected[i].b - actual[i].b)});
+        }
+
+        const double direct = us_per_frame(args.frames, [&](int i) { draw_direct(canvas, i, labels, icons); });
+        const double layered =
+            us_per_frame(args.frames, [&](int i) { draw_layered(canvas, i, buffer, variation, layer); });
+        const double rebuild = us_per_frame(std::max(1, args.frames / 10),
+                                            [&](int) { draw_layer(layer, text, labels, icons); });
+
+        char label[32];
+        std::snprintf(label, sizeof(label), "%dx%d", size.width, size.height);
+        const double covered = 100.0 * layer.covered_pixels() / (static_cast<double>(size.width) * size.height);
+        std::printf("%-9s %12.1f %12.1f %8.1fx %12.1f %8.1f%% %9d\n", label, direct, layered, direct / layered,
+                    rebuild, covered, max_diff);
+
+        delete matrix;
+    }
+
+    return 0;
+}
@@ -0,0 +1,310 @@
+/**
+ * packet_serialize_bench: compares the old UdpPacket::toBytes() send path with
+ * the allocation-free one used by the desktop sender thread (UdpPacket::view()
+ * with a reused scratch buffer, sent as two iovecs with sendmsg). Every global
+ * operator new is counted, so the allocs/op column shows what each path costs
+ * the allocator per packet once it is warmed up.
+ *
+ * Usage:
+ *   packet_serialize_bench [--packets <n>] [--width <px>] [--height <px>] [--bands <n>] [--no-send]
+ *
+ * Defaults:
+ *   --packets  20000
+ *   --width    128
+ *   --height   128
+ *   --bands    64
+ *
+ * Packets:
+ *   frame   FramePacket with a width x height RGB24 frame (Shadertoy, Video, SpotifyMV)
+ *   bands   the AudioVisualizer's CompactAudioPacket, which overrides writeData()
+ *   legacy  packet that only implements toData() (third party plugins)
+ *
+ * Paths:
+ *   old      toData() copied behind the header into a second vector + sendto(), what
+ *            toBytes() and UdpSender::sendPacket did before serializeInto()
+ *   toBytes  toBytes() + sendto(), one fresh vector per packet
+ *   into     serializeInto() a reused buffer + sendto()
+ *   view     view() + sendmsg() with header and payload iovecs, the current UdpSender
+ *
+ * Packets are sent to a UDP socket on localhost that nobody reads, the kernel
+ * drops them once its buffer is full. --no-send only measures serialization.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "shared/common/udp/frame_stream.h"
+#include "shared/common/udp/packet.h"
+#include "udpBandsPacket.h"
+
+// ─── Allocation counting ─────────────────────────────────────────────────────
+
+namespace
+{
+    std::atomic<size_t> allocation_count{0};
+    std::atomic<size_t> allocation_bytes{0};
+}
+
+void *operator new(size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace
+{
+    struct Args
+    {
+        int packets = 20000;
+        int width = 128;
+        int height = 128;
+        int bands = 64;
+        bool send = true;
+    };
+
+    Args parse_args(int argc, char *argv[])
+    {
+        Args a;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--packets" && i + 1 < argc)
+                a.packets = std::max(1, std::atoi(argv[++i]));
+            else if (arg == "--width" && i + 1 < argc)
+                a.width = std::clamp(std::atoi(argv[++i]), 1, 147);
+            else if (arg == "--height" && i + 1 < argc)
+                a.height = std::clamp(std::atoi(argv[++i]), 1, 147);
+            else if (arg == "--bands" && i + 1 < argc)
+                a.bands = std::clamp(std::atoi(argv[++i]), 1, 255);
+            else if (arg == "--no-send")
+                a.send = false;
+        }
+        return a;
+    }
+
+    /// UdpPacket::toBytes() as it was before serializeInto(): the payload from toData()
+    /// copied behind the header into a second vector.
+    std::vector<uint8_t> old_to_bytes(const UdpPacket &packet)
+    {
+        const std::vector<uint8_t> data = packet.toData();
+
+        std::vector<uint8_t> bytes;
+        bytes.reserve(data.size() + UdpPacket::header_size);
+        bytes.push_back(0xAD);
+        bytes.push_back(0x01);
+        bytes.push_back(packet.pluginId);
+
+        const auto payload_size = static_cast<uint32_t>(data.size());
+        bytes.push_back(static_cast<uint8_t>((payload_size >> 24) & 0xFF));
+        bytes.push_back(static_cast<uint8_t>((payload_size >> 16) & 0xFF));
+        bytes.push_back(static_cast<uint8_t>((payload_size >> 8) & 0xFF));
+        bytes.push_back(static_cast<uint8_t>(payload_size & 0xFF));
+        bytes.insert(bytes.end(), data.begin(), data.end());
+        return bytes;
+    }
+
+    CompactAudioPacket make_bands_packet(int count)
+    {
+        std::vector<float> bands(count);
+        for (int i = 0; i < count; ++i)
+            bands[i] = static_cast<float>(i % 86) * 3.0f / 255.0f;
+
+        return {bands, true, false};
+    }
+
+    /// A plugin packet that predates writeData(), it pays for toData() on every path.
+    struct LegacyPacket final : UdpPacket
+    {
+        std::vector<uint8_t> payload;
+
+        explicit LegacyPacket(size_t size) : UdpPacket(0x05), payload(size, 0x5A) {}
+
+        [[nodiscard]] std::vector<uint8_t> toData() const override
+        {
+            std::vector<uint8_t> data;
+            for (const auto byte : payload)
+                data.push_back(byte);
+            return data;
+        }
+    };
+
+    class Sink
+    {
+    public:
+        explicit Sink(bool enabled)
+        {
+            if (!enabled)
+                return;
+
+            receiver = socket(AF_INET, SOCK_DGRAM, 0);
+            sender = socket(AF_INET, SOCK_DGRAM, 0);
+
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            bind(receiver, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+            socklen_t len = sizeof(addr);
+            getsockname(receiver, reinterpret_cast<sockaddr *>(&addr), &len);
+        }
+
+        ~Sink()
+        {
+            if (receiver >= 0)
+                close(receiver);
+            if (sender >= 0)
+                close(sender);
+        }
+
+        void send(const std::vector<uint8_t> &bytes) const
+        {
+            if (sender >= 0)
+                sendto(sender, bytes.data(), bytes.size(), 0, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr));
+        }
+
+        void send(const UdpPacket::View &view) const
+        {
+            if (sender < 0)
+                return;
+
+            iovec iov[2];
+            iov[0].iov_base = const_cast<uint8_t *>(view.header.data());
+            iov[0].iov_len = view.header.size();
+            iov[1].iov_base = const_cast<uint8_t *>(view.payload.data());
+            iov[1].iov_len = view.payload.size();
+
+            msghdr message{};
+            message.msg_name = const_cast<sockaddr_in *>(&addr);
+            message.msg_namelen = sizeof(addr);
+            message.msg_iov = iov;
+            message.msg_iovlen = 2;
+            sendmsg(sender, &message, 0);
+        }
+
+    private:
+        int receiver = -1;
+        int sender = -1;
+        sockaddr_in addr{};
+    };
+
+    struct Result
+    {
+        double ns_per_packet = 0;
+        double allocs_per_packet = 0;
+        double bytes_per_packet = 0;
+    };
+
+    Result measure(int packets, const std::function<void()> &send_one)
+    {
+        // Warm up: first sends grow the scratch buffers
+        for (int i = 0; i < 64; ++i)
+            send_one();
+
+        const size_t count_before = allocation_count.load();
+        const size_t bytes_before = allocation_bytes.load();
+        const auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < packets; ++i)
+            send_one();
+
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        Result r;
+        r.ns_per_packet = std::chrono::duration<double, std::nano>(elapsed).count() / packets;
+        r.allocs_per_packet = static_cast<double>(allocation_count.load() - count_before) / packets;
+        r.bytes_per_packet = static_cast<double>(allocation_bytes.load() - bytes_before) / packets;
+        return r;
+    }
+
+    /// All paths have to put the same bytes on the wire.
+    bool same_bytes(const UdpPacket &packet)
+    {
+        const auto expected = old_to_bytes(packet);
+
+        std::vector<uint8_t> into;
+        packet.serializeInto(into);
+
+        std::vector<uint8_t> scratch;
+        const auto view = packet.view(scratch);
+        std::vector<uint8_t> gathered(view.header.begin(), view.header.end());
+        gathered.insert(gathered.end(), view.payload.begin(), view.payload.end());
+
+        return packet.toBytes() == expected && into == expected && gathered == expected;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const Args args = parse_args(argc, argv);
+    const Sink sink(args.send);
+
+    std::vector<uint8_t> rgb(static_cast<size_t>(args.width) * args.height * 3);
+    for (size_t i = 0; i < rgb.size(); ++i)
+        rgb[i] = static_cast<uint8_t>(i * 7);
+
+    const FramePacket frame(0x02, rgb, static_cast<uint16_t>(args.width), static_cast<uint16_t>(args.height));
+    const CompactAudioPacket bands = make_bands_packet(args.bands);
+    const LegacyPacket legacy(256);
+
+    struct Case
+    {
+        const char *name;
+        const UdpPacket &packet;
+    };
+    const Case cases[] = {{"frame", frame}, {"bands", bands}, {"legacy", legacy}};
+
+    std::printf("packet_serialize_bench  packets=%d  frame=%dx%d  bands=%d  %s\n\n", args.packets, args.width,
+                args.height, args.bands, args.send ? "sending to localhost" : "serialization only");
+    std::printf("%-7s  %-8s  %9s  %10s  %11s  %6s\n", "packet", "path", "bytes", "ns/op", "allocs/op", "B/op");
+
+    bool all_same = true;
+    for (const auto &c : cases)
+    {
+        const UdpPacket &packet = c.packet;
+        const size_t wire_size = packet.toBytes().size();
+        all_same &= same_bytes(packet);
+
+        std::vector<uint8_t> buffer;
+        std::vector<uint8_t> scratch;
+
+        const std::pair<const char *, std::function<void()>> paths[] = {
+            {"old", [&] { sink.send(old_to_bytes(packet)); }},
+            {"toBytes", [&] { sink.send(packet.toBytes()); }},
+            {"into", [&] { packet.serializeInto(buffer); sink.send(buffer); }},
+            {"view", [&] { sink.send(packet.view(scratch)); }},
+        };
+
+        for (const auto &[path, send_one] : paths)
+        {
+            const Result r = measure(args.packets, send_one);
+            std::printf("%-7s  %-8s  %9zu  %10.1f  %11.2f  %6.0f\n", c.name, path, wire_size, r.ns_per_packet,
+                        r.allocs_per_packet, r.bytes_per_packet);
+        }
+    }
+
+    std::printf("\nwire bytes identical across paths: %s\n", all_same ? "yes" : "NO");
+    return all_same ? 0 : 1;
+}
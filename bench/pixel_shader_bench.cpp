@@ -0,0 +1,290 @@
+/**
+ * pixel_shader_bench: frames/s of the per-pixel scenes ported to PixelShader, against
+ * the per-pixel <cmath> loops they had before.
+ *
+ * Usage:
+ *   pixel_shader_bench [--sizes <WxH,...>] [--frames <n>]
+ *
+ * Defaults:
+ *   --sizes   64x64,128x128,192x128
+ *   --frames  300
+ *
+ * Every scene renders the same sequence of frames (1/60 s apart) into a CanvasBuffer
+ * three ways: the previous code on one thread, the shader on one thread (SIMD only)
+ * and the shader on the shared RenderPool (see "Render Pool" in the README, set
+ * MATRIX_RENDER_THREADS to change the thread count). Copying the buffer to the
+ * canvas is the same for all of them and not timed.
+ *
+ * "max diff" is the largest difference of a color channel between the previous code
+ * and the shader over all frames, "off" the share of pixels that differ by more
+ * than 8 levels. The tunnel's texture has hard edges, rounding moves a few of them
+ * by a pixel.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "shared/matrix/canvas_buffer.h"
+#include "shared/matrix/utils/PixelShader.h"
+#include "shared/matrix/utils/RenderPool.h"
+#include "NeonTunnelShader.h"
+#include "WatermelonPlasmaShader.h"
+
+namespace
+{
+    struct Size
+    {
+        int width;
+        int height;
+    };
+
+    struct Args
+    {
+        std::vector<Size> sizes{{64, 64}, {128, 128}, {192, 128}};
+        int frames = 300;
+    };
+
+    Args parse_args(int argc, char *argv[])
+    {
+        Args a;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--sizes" && i + 1 < argc)
+            {
+                a.sizes.clear();
+                std::stringstream ss(argv[++i]);
+                std::string token;
+                while (std::getline(ss, token, ','))
+                {
+                    Size size{};
+                    if (std::sscanf(token.c_str(), "%dx%d", &size.width, &size.height) == 2 && size.width > 0 &&
+                        size.height > 0)
+                        a.sizes.push_back(size);
+                }
+            }
+            else if (arg == "--frames" && i + 1 < argc)
+                a.frames = std::max(1, std::atoi(argv[++i]));
+        }
+        return a;
+    }
+
+    uint8_t to_byte(float value)
+    {
+        return static_cast<uint8_t>(std::max(0.0f, std::min(1.0f, value)) * 255.0f);
+    }
+
+    /// WatermelonPlasmaScene before PixelShader.
+    void reference_plasma(CanvasBuffer &frame, float t)
+    {
+        using namespace std;
+
+        for (int y = 0; y < frame.height(); y++)
+        {
+            for (int x = 0; x < frame.width(); x++)
+            {
+                float xp = ((x / 128.0f) - 0.5f) * (5.0f + sin(t * 0.25)) + sin(t * 0.25) * 5.0f;
+                float yp = ((y / 128.0f) - 0.5f) * (5.0f + sin(t * 0.25)) + cos(t * 0.25) * 5.0f;
+
+                float pixel = sin(sin(sin(0.25 * t) * xp + cos(0.29 * t) * yp + t) +
+                                  sin(sqrt(pow(xp + sin(t * 0.25f) * 4.0f, 2) + pow(yp + cos(t * 0.43f) * 4.0f, 2)) +
+                                      t) -
+                                  cos(sqrt(pow(xp + cos(t * 0.36f) * 6.0f, 2) + pow(yp + sin(t * 0.39f) * 5.3f, 2)) +
+                                      t));
+
+                float u = pow(cos(9 * pixel + 0.5f * xp + t) * 0.5f + 0.5f, 2);
+                float v = pow(sin(9 * pixel + 0.5f * yp + t) * 0.5f + 0.5f, 2);
+
+                frame.at(x, y) = rgb_matrix::Color(to_byte(u), to_byte(v), to_byte((u + v) / 2));
+            }
+        }
+    }
+
+    void hsl_to_rgb(float h, float s, float l, uint8_t &r, uint8_t &g, uint8_t &b)
+    {
+        float c = (1.0f - std::abs(2.0f * l - 1.0f)) * s;
+        float x = c * (1.0f - std::abs(std::fmod(h / 60.0f, 2.0f) - 1.0f));
+        float m = l - c / 2.0f;
+
+        float r1 = 0, g1 = 0, b1 = 0;
+        if (h >= 0 && h < 60) { r1 = c; g1 = x; b1 = 0; }
+        else if (h >= 60 && h < 120) { r1 = x; g1 = c; b1 = 0; }
+        else if (h >= 120 && h < 180) { r1 = 0; g1 = c; b1 = x; }
+        else if (h >= 180 && h < 240) { r1 = 0; g1 = x; b1 = c; }
+        else if (h >= 240 && h < 300) { r1 = x; g1 = 0; b1 = c; }
+        else if (h >= 300 && h < 360) { r1 = c; g1 = 0; b1 = x; }
+
+        r = static_cast<uint8_t>((r1 + m) * 255.0f);
+        g = static_cast<uint8_t>((g1 + m) * 255.0f);
+        b = static_cast<uint8_t>((b1 + m) * 255.0f);
+    }
+
+    /// NeonTunnelScene before PixelShader.
+    void reference_tunnel(CanvasBuffer &frame, const AmbientScenes::NeonTunnelParams &params, float time_counter)
+    {
+        const int matrix_width = frame.width();
+        const int matrix_height = frame.height();
+
+        float center_x = matrix_width / 2.0f;
+        float center_y = matrix_height / 2.0f;
+        float osc_x = center_x + std::sin(time_counter * 0.5f) * (matrix_width / 4.0f);
+        float osc_y = center_y + std::cos(time_counter * 0.7f) * (matrix_height / 4.0f);
+
+        for (int y = 0; y < matrix_height; ++y)
+        {
+            for (int x = 0; x < matrix_width; ++x)
+            {
+                float dx = x - osc_x;
+                float dy = y - osc_y;
+                float distance = std::sqrt(dx * dx + dy * dy);
+                if (distance == 0) distance = 0.001f;
+
+                float angle = std::atan2(dy, dx);
+
+                float v_u = (params.distance_factor / distance) + (params.speed * time_counter);
+                float v_v = (angle * params.angle_factor / M_PI) + (std::sin(time_counter) * 2.0f);
+
+                int tex_x = (int)std::round(std::abs(v_u * 32.0f)) % 256;
+                int tex_y = (int)std::round(std::abs(v_v * 32.0f)) % 256;
+                int pattern = tex_x ^ tex_y;
+
+                float depth_shade = 1.0f - (distance / (matrix_width * 1.5f));
+                if (depth_shade < 0) depth_shade = 0.0f;
+
+                float hue = std::fmod((time_counter * params.hue_shift_speed * 50.0f) + (distance * 2.0f), 360.0f);
+                float lightness = (pattern > 128) ? (0.5f * depth_shade) : 0.00f;
+
+                uint8_t r, g, b;
+                hsl_to_rgb(hue, 1.0f, lightness, r, g, b);
+                frame.at(x, y) = rgb_matrix::Color(r, g, b);
+            }
+        }
+    }
+
+    /// Renders frame 'index' into the buffer.
+    using FrameFn = std::function<void(CanvasBuffer &, int index)>;
+
+    struct Variant
+    {
+        const char *label;
+        FrameFn reference;
+        FrameFn shader_single;
+        FrameFn shader_pool;
+    };
+
+    double frames_per_second(const FrameFn &fn, CanvasBuffer &frame, int frames)
+    {
+        for (int i = 0; i < std::min(frames, 10); ++i)
+            fn(frame, i);
+
+        using clock = std::chrono::steady_clock;
+        const auto start = clock::now();
+        for (int i = 0; i < frames; ++i)
+            fn(frame, i);
+        const std::chrono::duration<double> elapsed = clock::now() - start;
+        return frames / elapsed.count();
+    }
+
+    struct Agreement
+    {
+        int max_diff = 0;
+        double off_share = 0;
+    };
+
+    Agreement compare(const FrameFn &reference, const FrameFn &shader, const Size &size, int frames)
+    {
+        CanvasBuffer expected(size.width, size.height);
+        CanvasBuffer actual(size.width, size.height);
+
+        Agreement agreement;
+        size_t off = 0;
+        size_t total = 0;
+        for (int i = 0; i < frames; i += std::max(1, frames / 20))
+        {
+            reference(expected, i);
+            shader(actual, i);
+
+            for (size_t p = 0; p < expected.size(); ++p)
+            {
+                const rgb_matrix::Color &e = expected.data()[p];
+                const rgb_matrix::Color &a = actual.data()[p];
+                const int diff = std::max({std::abs(e.r - a.r), std::abs(e.g - a.g), std::abs(e.b - a.b)});
+                agreement.max_diff = std::max(agreement.max_diff, diff);
+                off += diff > 8;
+            }
+            total += expected.size();
+        }
+        agreement.off_share = total > 0 ? static_cast<double>(off) / total : 0;
+        return agreement;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const Args args = parse_args(argc, argv);
+
+    RenderPool single(RenderPoolSettings{0, false});
+    RenderPool &pool = RenderPool::instance();
+
+    const auto time_at = [](int index) { return index / 60.0f; };
+    const AmbientScenes::NeonTunnelParams tunnel_params;
+
+    const std::vector<Variant> variants = {
+        {
+            "watermelon_plasma",
+            [&](CanvasBuffer &frame, int i) { reference_plasma(frame, time_at(i)); },
+            [&](CanvasBuffer &frame, int i)
+            { PixelShader::render(frame, Scenes::WatermelonPlasmaShader(time_at(i)), single); },
+            [&](CanvasBuffer &frame, int i)
+            { PixelShader::render(frame, Scenes::WatermelonPlasmaShader(time_at(i)), pool); },
+        },
+        {
+            "neontunnel",
+            // The scene advances 0.05 per frame
+            [&](CanvasBuffer &frame, int i) { reference_tunnel(frame, tunnel_params, 0.05f * (i + 1)); },
+            [&](CanvasBuffer &frame, int i)
+            {
+                PixelShader::render(frame, AmbientScenes::NeonTunnelShader(tunnel_params, 0.05f * (i + 1),
+                                                                           frame.width(), frame.height()), single);
+            },
+            [&](CanvasBuffer &frame, int i)
+            {
+                PixelShader::render(frame, AmbientScenes::NeonTunnelShader(tunnel_params, 0.05f * (i + 1),
+                                                                           frame.width(), frame.height()), pool);
+            },
+        },
+    };
+
+    std::printf("Pixel shaders, %d frames per measurement, render pool with %d worker(s)\n", args.frames,
+                pool.worker_count());
+    std::printf("%-18s %-8s %12s %12s %12s %9s %9s %9s %7s\n", "scene", "size", "before fps", "simd fps", "pool fps",
+                "simd x", "pool x", "max diff", "off");
+
+    for (const auto &variant : variants)
+    {
+        for (const auto &size : args.sizes)
+        {
+            char label[32];
+            std::snprintf(label, sizeof(label), "%dx%d", size.width, size.height);
+
+            CanvasBuffer frame(size.width, size.height);
+            const double before = frames_per_second(variant.reference, frame, args.frames);
+            const double simd = frames_per_second(variant.shader_single, frame, args.frames);
+            const double pooled = frames_per_second(variant.shader_pool, frame, args.frames);
+            const Agreement agreement = compare(variant.reference, variant.shader_single, size, args.frames);
+
+            std::printf("%-18s %-8s %12.0f %12.0f %12.0f %8.1fx %8.1fx %9d %6.2f%%\n", variant.label, label, before,
+                        simd, pooled, simd / before, pooled / before, agreement.max_diff,
+                        agreement.off_share * 100.0);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,513 @@
+/**
+ * scene_bench: render cost of every matrix scene that runs without the desktop app.
+ * The plugins are loaded from PLUGIN_DIR like in the matrix itself, every scene is
+ * created with its default properties and renders into an offscreen FrameCanvas.
+ *
+ * Usage:
+ *   scene_bench [--sizes <WxH,...>] [--frames <n>] [--warmup <n>] [--scenes <n1,n2,...>]
+ *               [--output <file>] [--baseline <file>] [--threshold <percent>]
+ *
+ * Defaults:
+ *   --sizes      64x64,128x128 (each between 32x32 and 256x128)
+ *   --frames     300
+ *   --warmup     30   (rendered before measuring, not counted)
+ *   --threshold  10
+ *   output       JSON on stdout
+ *
+ * Scenes run on a stepped virtual clock (see "Clock" in the README): every frame
+ * takes one 1/60 s step of virtual time and frame pacing sleeps return immediately,
+ * so only the render itself is timed. Every global operator new is counted, which
+ * includes allocations of plugin background threads while a scene is measured.
+ * "peak_rss_kb" is the process high-water mark while the scene rendered (reset per
+ * scene through /proc/self/clear_refs), "rss_growth_kb" how far it rose above the
+ * resident size before the scene was created.
+ *
+ * With --baseline the results are compared against a JSON file written by an earlier
+ * run. The comparison goes to stderr, and the exit code is 2 if a scene got slower
+ * by more than --threshold percent or allocates more per frame than before.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+#include <spdlog/cfg/env.h>
+#include <Magick++.h>
+#include <nlohmann/json.hpp>
+
+#ifdef ENABLE_EMULATOR
+#include "emulator.h"
+#endif
+
+#include "led-matrix.h"
+#include "shared/matrix/plugin_loader/loader.h"
+#include "shared/matrix/utils/shared.h"
+#include "shared/matrix/canvas_consts.h"
+#include "shared/matrix/utils/consts.h"
+#include "shared/common/utils/clock.h"
+
+namespace
+{
+    std::atomic<size_t> allocation_count{0};
+    std::atomic<size_t> allocation_bytes{0};
+}
+
+void *operator new(size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace
+{
+    constexpr int frame_step_ms = 1000 / 60;
+    constexpr tmillis_t start_time_ms = 1704110400000; // 2024-01-01 12:00 UTC, like preview_gen
+
+    struct Size
+    {
+        int width;
+        int height;
+    };
+
+    struct Args
+    {
+        std::vector<Size> sizes{{64, 64}, {128, 128}};
+        int frames = 300;
+        int warmup = 30;
+        std::vector<std::string> filter_scenes;
+        std::string output;
+        std::string baseline;
+        double threshold = 10.0;
+    };
+
+    std::vector<std::string> split(const std::string &csv)
+    {
+        std::vector<std::string> parts;
+        std::stringstream ss(csv);
+        std::string token;
+        while (std::getline(ss, token, ','))
+        {
+            if (!token.empty())
+                parts.push_back(token);
+        }
+        return parts;
+    }
+
+    std::optional<Size> parse_size(const std::string &raw)
+    {
+        int width = 0;
+        int height = 0;
+        if (std::sscanf(raw.c_str(), "%dx%d", &width, &height) != 2)
+            return std::nullopt;
+
+        return Size{std::clamp(width, 32, 256), std::clamp(height, 32, 128)};
+    }
+
+    Args parse_args(int argc, char *argv[])
+    {
+        Args a;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--sizes" && i + 1 < argc)
+            {
+                a.sizes.clear();
+                for (const auto &raw : split(argv[++i]))
+                {
+                    if (const auto size = parse_size(raw))
+                        a.sizes.push_back(*size);
+                    else
+                        spdlog::warn("Ignoring invalid size '{}', expected WxH", raw);
+                }
+            }
+            else if (arg == "--frames" && i + 1 < argc)
+                a.frames = std::max(1, std::atoi(argv[++i]));
+            else if (arg == "--warmup" && i + 1 < argc)
+                a.warmup = std::max(0, std::atoi(argv[++i]));
+            else if (arg == "--scenes" && i + 1 < argc)
+                a.filter_scenes = split(argv[++i]);
+            else if (arg == "--output" && i + 1 < argc)
+                a.output = argv[++i];
+            else if (arg == "--baseline" && i + 1 < argc)
+                a.baseline = argv[++i];
+            else if (arg == "--threshold" && i + 1 < argc)
+                a.threshold = std::max(0.0, std::atof(argv[++i]));
+        }
+        return a;
+    }
+
+    /// Offscreen matrix of the given size that never touches the panel.
+    rgb_matrix::RGBMatrixBase *create_matrix(const Size &size)
+    {
+        rgb_matrix::RGBMatrix::Options led_opts;
+        led_opts.rows = size.height;
+        led_opts.cols = size.width;
+        led_opts.chain_length = 1;
+        led_opts.parallel = 1;
+
+#ifdef ENABLE_EMULATOR
+        rgb_matrix::EmulatorOptions emu_opts;
+        emu_opts.headless = true;
+        return rgb_matrix::EmulatorMatrix::Create(led_opts, emu_opts);
+#else
+        rgb_matrix::RuntimeOptions runtime_opts;
+        runtime_opts.do_gpio_init = false;
+        runtime_opts.drop_privileges = -1;
+        return rgb_matrix::RGBMatrix::CreateFromOptions(led_opts, runtime_opts);
+#endif
+    }
+
+    /// Reads a "VmRSS:" style line of /proc/self/status, in KB.
+    long proc_status_kb(const char *key)
+    {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        const size_t key_len = std::strlen(key);
+        while (std::getline(status, line))
+        {
+            if (line.compare(0, key_len, key) == 0)
+                return std::atol(line.c_str() + key_len);
+        }
+        return 0;
+    }
+
+    void reset_peak_rss()
+    {
+        std::ofstream clear_refs("/proc/self/clear_refs");
+        clear_refs << "5";
+    }
+
+    struct Result
+    {
+        std::string scene;
+        Size size{};
+        int frames = 0;
+        double ns_per_frame = 0;
+        double p50_ns = 0;
+        double p95_ns = 0;
+        double max_ns = 0;
+        double allocs_per_frame = 0;
+        double bytes_per_frame = 0;
+        long peak_rss_kb = 0;
+        long rss_growth_kb = 0;
+        std::string error;
+    };
+
+    std::unique_ptr<Scenes::Scene, void (*)(Scenes::Scene *)> create_scene(Plugins::SceneWrapper &wrapper,
+                                                                            const Size &size)
+    {
+        // Same as preview_gen: dump the defaults and load them back so required
+        // properties without a user value are registered as well
+        auto scene = wrapper.create();
+        scene->update_default_properties();
+        scene->register_properties();
+
+        nlohmann::json default_props = nlohmann::json::object();
+        for (const auto &prop : scene->get_properties())
+            prop->dump_to_json(default_props);
+
+        scene->load_properties(default_props);
+        scene->initialize(size.width, size.height);
+        return scene;
+    }
+
+    Result run_scene(const Args &args, Plugins::SceneWrapper &wrapper, rgb_matrix::FrameCanvas *canvas,
+                     const Size &size)
+    {
+        Result r;
+        r.scene = wrapper.get_name();
+        r.size = size;
+
+        // Every scene starts at the same virtual time and random state
+        Clock::set_source(std::make_shared<Clock::VirtualSource>(
+            start_time_ms, std::chrono::milliseconds(frame_step_ms)));
+        std::srand(1);
+
+        reset_peak_rss();
+        const long rss_before = proc_status_kb("VmRSS:");
+
+        try
+        {
+            auto scene = create_scene(wrapper, size);
+
+            bool keep_going = true;
+            for (int f = 0; f < args.warmup && keep_going; ++f)
+            {
+                canvas->Clear();
+                keep_going = scene->render(canvas);
+                Clock::frame_presented();
+            }
+
+            std::vector<double> frame_ns;
+            frame_ns.reserve(static_cast<size_t>(args.frames));
+
+            const size_t count_before = allocation_count.load();
+            const size_t bytes_before = allocation_bytes.load();
+            for (int f = 0; f < args.frames && keep_going; ++f)
+            {
+                canvas->Clear();
+                const auto start = std::chrono::steady_clock::now();
+                keep_going = scene->render(canvas);
+                const auto elapsed = std::chrono::steady_clock::now() - start;
+                Clock::frame_presented();
+
+                frame_ns.push_back(static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+            }
+            const size_t allocations = allocation_count.load() - count_before;
+            const size_t bytes = allocation_bytes.load() - bytes_before;
+
+            scene->after_render_stop();
+
+            if (frame_ns.empty())
+            {
+                r.error = "stopped during warmup";
+                return r;
+            }
+
+            r.frames = static_cast<int>(frame_ns.size());
+            double total_ns = 0;
+            for (const double ns : frame_ns)
+                total_ns += ns;
+
+            std::ranges::sort(frame_ns);
+            r.ns_per_frame = total_ns / r.frames;
+            r.p50_ns = frame_ns[frame_ns.size() / 2];
+            r.p95_ns = frame_ns[std::min(frame_ns.size() - 1, frame_ns.size() * 95 / 100)];
+            r.max_ns = frame_ns.back();
+            r.allocs_per_frame = static_cast<double>(allocations) / r.frames;
+            r.bytes_per_frame = static_cast<double>(bytes) / r.frames;
+        }
+        catch (const std::exception &e)
+        {
+            r.error = e.what();
+        }
+        catch (...)
+        {
+            r.error = "unknown exception";
+        }
+
+        r.peak_rss_kb = proc_status_kb("VmHWM:");
+        r.rss_growth_kb = std::max(0L, r.peak_rss_kb - rss_before);
+        return r;
+    }
+
+    std::string size_key(const Size &size)
+    {
+        return std::to_string(size.width) + "x" + std::to_string(size.height);
+    }
+
+    nlohmann::json to_json(const Args &args, const std::vector<Result> &results)
+    {
+        nlohmann::json scenes = nlohmann::json::array();
+        for (const auto &r : results)
+        {
+            nlohmann::json entry = {
+                {"scene", r.scene},
+                {"size", size_key(r.size)},
+                {"frames", r.frames},
+                {"ns_per_frame", r.ns_per_frame},
+                {"p50_ns", r.p50_ns},
+                {"p95_ns", r.p95_ns},
+                {"max_ns", r.max_ns},
+                {"allocs_per_frame", r.allocs_per_frame},
+                {"bytes_per_frame", r.bytes_per_frame},
+                {"peak_rss_kb", r.peak_rss_kb},
+                {"rss_growth_kb", r.rss_growth_kb},
+            };
+            if (!r.error.empty())
+                entry["error"] = r.error;
+
+            scenes.push_back(std::move(entry));
+        }
+
+        return {
+            {"frames", args.frames},
+            {"warmup", args.warmup},
+            {"frame_step_ms", frame_step_ms},
+            {"scenes", std::move(scenes)},
+        };
+    }
+
+    /// Prints how every scene compares to the baseline, returns the number of regressions.
+    int compare_with_baseline(const Args &args, const std::vector<Result> &results, const nlohmann::json &baseline)
+    {
+        std::fprintf(stderr, "%-32s  %-7s  %12s  %12s  %8s  %9s  %9s\n", "scene", "size", "base ns/f", "ns/f",
+                     "delta", "base a/f", "allocs/f");
+
+        const auto base_scenes = baseline.value("scenes", nlohmann::json::array());
+        int regressions = 0;
+        for (const auto &r : results)
+        {
+            const auto key = size_key(r.size);
+            const auto it = std::ranges::find_if(base_scenes, [&](const nlohmann::json &entry)
+                                                 { return entry.value("scene", "") == r.scene && entry.value("size", "") == key; });
+            if (it == base_scenes.end() || r.frames == 0)
+            {
+                std::fprintf(stderr, "%-32s  %-7s  %s\n", r.scene.c_str(), key.c_str(),
+                             r.frames == 0 ? "failed" : "new, not in baseline");
+                continue;
+            }
+
+            const double base_ns = it->value("ns_per_frame", 0.0);
+            const double base_allocs = it->value("allocs_per_frame", 0.0);
+            const double delta = base_ns > 0 ? (r.ns_per_frame - base_ns) / base_ns * 100.0 : 0.0;
+
+            // Allocation counts are exact, so anything above half an allocation per frame more is real
+            const bool slower = delta > args.threshold;
+            const bool more_allocs = r.allocs_per_frame > base_allocs + 0.5;
+            if (slower || more_allocs)
+                regressions++;
+
+            std::fprintf(stderr, "%-32s  %-7s  %12.0f  %12.0f  %+7.1f%%  %9.1f  %9.1f%s\n", r.scene.c_str(), key.c_str(),
+                         base_ns, r.ns_per_frame, delta, base_allocs, r.allocs_per_frame,
+                         slower || more_allocs ? "  REGRESSION" : "");
+        }
+
+        std::fprintf(stderr, "\n%d regression(s), threshold %.1f%%\n", regressions, args.threshold);
+        return regressions;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    spdlog::cfg::load_env_levels();
+    Magick::InitializeMagick(*argv);
+
+    const Args args = parse_args(argc, argv);
+    if (args.sizes.empty())
+    {
+        std::fprintf(stderr, "No valid --sizes given\n");
+        return 1;
+    }
+
+    std::optional<nlohmann::json> baseline;
+    if (!args.baseline.empty())
+    {
+        std::ifstream file(args.baseline);
+        try
+        {
+            baseline = nlohmann::json::parse(file);
+        }
+        catch (const nlohmann::json::exception &e)
+        {
+            std::fprintf(stderr, "Could not read baseline '%s': %s\n", args.baseline.c_str(), e.what());
+            return 1;
+        }
+    }
+
+    if (!std::filesystem::exists(Constants::root_dir))
+    {
+        std::error_code ec;
+        std::filesystem::create_directory(Constants::root_dir, ec);
+    }
+
+    // Minimal globals and config, like preview_gen
+    Constants::global_post_processor = nullptr;
+    Constants::global_transition_manager = nullptr;
+    Constants::global_update_manager = nullptr;
+
+    const auto config_path = std::filesystem::temp_directory_path() /
+                             ("scene_bench_config_" + std::to_string(getpid()) + ".json");
+    config = new Config::MainConfig(config_path.string());
+
+    auto *plugins = Plugins::PluginManager::instance();
+    plugins->initialize();
+    for (auto *plugin : plugins->get_plugins())
+    {
+        plugin->before_server_init();
+        plugin->after_server_init();
+    }
+
+    std::vector<std::shared_ptr<Plugins::SceneWrapper>> scenes;
+    for (const auto &wrapper : plugins->get_scenes())
+    {
+        if (wrapper->get_default()->needs_desktop_app())
+            continue;
+
+        if (!args.filter_scenes.empty() && std::ranges::find(args.filter_scenes, wrapper->get_name()) == args.filter_scenes.end())
+            continue;
+
+        scenes.push_back(wrapper);
+    }
+
+    if (scenes.empty())
+        spdlog::warn("No scenes found. Make sure PLUGIN_DIR points to the built plugins directory.");
+
+    std::vector<Result> results;
+    for (const auto &size : args.sizes)
+    {
+        rgb_matrix::RGBMatrixBase *matrix = create_matrix(size);
+        if (matrix == nullptr)
+        {
+            spdlog::error("Could not create an offscreen {}x{} matrix", size.width, size.height);
+            continue;
+        }
+
+        Constants::width = size.width;
+        Constants::height = size.height;
+        rgb_matrix::FrameCanvas *canvas = matrix->CreateFrameCanvas();
+
+        for (const auto &wrapper : scenes)
+        {
+            spdlog::info("{} at {}...", wrapper->get_name(), size_key(size));
+            results.push_back(run_scene(args, *wrapper, canvas, size));
+            if (!results.back().error.empty())
+                spdlog::warn("{} failed: {}", wrapper->get_name(), results.back().error);
+        }
+
+        delete matrix;
+    }
+
+    Clock::set_source(nullptr);
+
+    const auto report = to_json(args, results).dump(2);
+    if (args.output.empty())
+    {
+        std::cout << report << std::endl;
+    }
+    else
+    {
+        std::ofstream out(args.output);
+        out << report << std::endl;
+    }
+
+    int regressions = 0;
+    if (baseline.has_value())
+        regressions = compare_with_baseline(args, results, *baseline);
+
+    plugins->delete_references();
+    plugins->destroy_plugins();
+    delete config;
+    config = nullptr;
+
+    std::error_code ec;
+    std::filesystem::remove(config_path, ec);
+
+    return regressions > 0 ? 2 : 0;
+}
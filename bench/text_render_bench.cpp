@@ -0,0 +1,203 @@
+/**
+ * text_render_bench: cost of drawing the labels of a WeatherScene frame with
+ * rgb_matrix::DrawText, as the scenes did every frame, vs the TextCache.
+ *
+ * Usage:
+ *   text_render_bench [--fonts <dir>] [--size <WxH>] [--frames <n>]
+ *
+ * Defaults:
+ *   --fonts   shared/fonts of the source tree
+ *   --size    128x128
+ *   --frames  2000
+ *
+ * Every frame draws the same eleven labels in the 7x13, 5x8 and 4x6 fonts at the
+ * positions WeatherScene uses into an offscreen FrameCanvas. Clearing the canvas
+ * is the same for both and not timed. "first frame" is the cached frame that has
+ * to rasterize every label, after that the cache only blits. "diff px" counts the
+ * pixels where both ways disagree, it should be 0.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "graphics.h"
+#include "led-matrix.h"
+#include "shared/matrix/utils/FontRegistry.h"
+#include "shared/matrix/utils/TextCache.h"
+
+#ifndef TEXT_BENCH_FONTS_DIR
+#define TEXT_BENCH_FONTS_DIR "shared/fonts"
+#endif
+
+namespace
+{
+    struct Args
+    {
+        std::filesystem::path fonts = TEXT_BENCH_FONTS_DIR;
+        int width = 128;
+        int height = 128;
+        int frames = 2000;
+    };
+
+    Args parse_args(int argc, char *argv[])
+    {
+        Args a;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--fonts" && i + 1 < argc)
+                a.fonts = argv[++i];
+            else if (arg == "--size" && i + 1 < argc)
+            {
+                int w = 0, h = 0;
+                if (std::sscanf(argv[++i], "%dx%d", &w, &h) == 2 && w > 0 && h > 0)
+                {
+                    a.width = w;
+                    a.height = h;
+                }
+            }
+            else if (arg == "--frames" && i + 1 < argc)
+                a.frames = std::max(1, std::atoi(argv[++i]));
+        }
+        return a;
+    }
+
+    struct Label
+    {
+        const rgb_matrix::Font *font;
+        int x;
+        int y;
+        rgb_matrix::Color color;
+        std::string text;
+    };
+
+    /// What WeatherScene draws on a clear day with the forecast and sunrise/sunset shown.
+    std::vector<Label> weather_labels(const rgb_matrix::Font *header, const rgb_matrix::Font *body,
+                                      const rgb_matrix::Font *small)
+    {
+        return {
+            {header, 48, 20, {255, 255, 255}, "21.4°C"},
+            {body, 48, 34, {220, 220, 255}, "Partly cloudy"},
+            {small, 48, 44, {200, 200, 255}, "Humidity: 64%"},
+            {small, 48, 51, {200, 200, 255}, "Wind: 12 km/h"},
+            {small, 17, 57, {255, 220, 100}, "↑ 06:42"},
+            {small, 91, 57, {255, 180, 80}, "↓ 19:58"},
+            {small, 5, 65, {255, 255, 255}, "3-Day Forecast:"},
+            {small, 7, 78, {255, 255, 255}, "Mon"},
+            {small, 49, 78, {255, 255, 255}, "Tue"},
+            {small, 91, 78, {255, 255, 255}, "Wed"},
+            {body, 98, 11, {255, 255, 255}, "12:34"},
+        };
+    }
+
+    rgb_matrix::RGBMatrixBase *create_matrix(int width, int height)
+    {
+        rgb_matrix::RGBMatrix::Options led_opts;
+        led_opts.rows = height;
+        led_opts.cols = width;
+        led_opts.chain_length = 1;
+        led_opts.parallel = 1;
+
+        rgb_matrix::RuntimeOptions runtime_opts;
+        runtime_opts.do_gpio_init = false;
+        runtime_opts.drop_privileges = -1;
+        return rgb_matrix::RGBMatrix::CreateFromOptions(led_opts, runtime_opts);
+    }
+
+    /// Microseconds per frame of 'draw', which renders all labels once.
+    double us_per_frame(rgb_matrix::FrameCanvas *canvas, int frames, const std::function<void()> &draw)
+    {
+        using clock = std::chrono::steady_clock;
+        clock::duration total{};
+        for (int i = 0; i < frames; ++i)
+        {
+            canvas->Clear();
+            const auto start = clock::now();
+            draw();
+            total += clock::now() - start;
+        }
+        return std::chrono::duration<double, std::micro>(total).count() / frames;
+    }
+
+    std::vector<rgb_matrix::Color> snapshot(rgb_matrix::FrameCanvas *canvas)
+    {
+        std::vector<rgb_matrix::Color> pixels(static_cast<size_t>(canvas->width()) * canvas->height());
+        auto *out = pixels.data();
+        for (int y = 0; y < canvas->height(); ++y)
+            for (int x = 0; x < canvas->width(); ++x, ++out)
+                canvas->GetPixel(x, y, &out->r, &out->g, &out->b);
+        return pixels;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const Args args = parse_args(argc, argv);
+
+    auto &fonts = FontRegistry::instance();
+    const rgb_matrix::Font *header = fonts.load(args.fonts / "7x13.bdf");
+    const rgb_matrix::Font *body = fonts.load(args.fonts / "5x8.bdf");
+    const rgb_matrix::Font *small = fonts.load(args.fonts / "4x6.bdf");
+    if (header == nullptr || body == nullptr || small == nullptr)
+    {
+        std::fprintf(stderr, "Could not load the fonts from %s\n", args.fonts.c_str());
+        return 1;
+    }
+
+    rgb_matrix::RGBMatrixBase *matrix = create_matrix(args.width, args.height);
+    if (matrix == nullptr)
+    {
+        std::fprintf(stderr, "Could not create an offscreen %dx%d matrix\n", args.width, args.height);
+        return 1;
+    }
+    rgb_matrix::FrameCanvas *canvas = matrix->CreateFrameCanvas();
+
+    const std::vector<Label> labels = weather_labels(header, body, small);
+    TextCache cache;
+
+    const auto draw_text = [&]
+    {
+        for (const auto &label : labels)
+            rgb_matrix::DrawText(canvas, *label.font, label.x, label.y, label.color, label.text.c_str());
+    };
+    const auto draw_cached = [&]
+    {
+        for (const auto &label : labels)
+            cache.draw(canvas, *label.font, label.x, label.y, label.color, label.text);
+    };
+
+    // Agreement, and the one frame that fills the cache
+    canvas->Clear();
+    draw_text();
+    const auto expected = snapshot(canvas);
+
+    canvas->Clear();
+    using clock = std::chrono::steady_clock;
+    const auto first_start = clock::now();
+    draw_cached();
+    const double first_us = std::chrono::duration<double, std::micro>(clock::now() - first_start).count();
+    const auto actual = snapshot(canvas);
+
+    size_t diff = 0;
+    for (size_t i = 0; i < expected.size(); ++i)
+        diff += expected[i].r != actual[i].r || expected[i].g != actual[i].g || expected[i].b != actual[i].b;
+
+    const double before = us_per_frame(canvas, args.frames, draw_text);
+    const double cached = us_per_frame(canvas, args.frames, draw_cached);
+
+    std::printf("WeatherScene labels (%zu strings) on %dx%d, %d frames per measurement\n", labels.size(),
+                args.width, args.height, args.frames);
+    std::printf("%-12s %14s %14s %9s %14s %8s\n", "", "DrawText us", "cached us", "speedup", "first frame us",
+                "diff px");
+    std::printf("%-12s %14.2f %14.2f %8.1fx %14.2f %8zu\n", "per frame", before, cached, before / cached, first_us,
+                diff);
+
+    delete matrix;
+    return 0;
+}
@@ -0,0 +1,281 @@
+/**
+ * udp_latency_bench: blasts UDP packets from a local sender at the matrix
+ * receive loop and measures the delivery latency and the CPU time the
+ * receiving thread burns.
+ *
+ * Usage:
+ *   udp_latency_bench [--packets <n>] [--size <bytes>] [--rate <packets/s>] [--mode epoll|sleep|both]
+ *
+ * Defaults:
+ *   --packets  20000
+ *   --size     1024     (audio band packets are ~100 bytes, 128x128 video frames ~49 KB)
+ *   --rate     2000     (0 = as fast as possible)
+ *   --mode     both
+ *
+ * "epoll" is the UdpReceiver used by the matrix (epoll + recvmmsg + SO_TIMESTAMPNS),
+ * "sleep" is the previous non-blocking recvfrom() loop that sleeps 1 ms when idle.
+ * Latency is measured from the sender's clock_gettime(CLOCK_REALTIME) to the
+ * receive callback. Idle CPU is measured over one second without traffic.
+ */
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <netinet/in.h>
+#include <string>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "udp_receiver.h"
+#include "shared/matrix/utils/FrameProfiler.h"
+
+namespace
+{
+    struct Args
+    {
+        int packets = 20000;
+        size_t size = 1024;
+        int rate = 2000;
+        std::string mode = "both";
+    };
+
+    Args parse_args(int argc, char *argv[])
+    {
+        Args a;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--packets" && i + 1 < argc)
+                a.packets = std::max(1, std::atoi(argv[++i]));
+            else if (arg == "--size" && i + 1 < argc)
+                a.size = std::clamp<size_t>(std::strtoul(argv[++i], nullptr, 10), sizeof(int64_t), 65000);
+            else if (arg == "--rate" && i + 1 < argc)
+                a.rate = std::max(0, std::atoi(argv[++i]));
+            else if (arg == "--mode" && i + 1 < argc)
+                a.mode = argv[++i];
+        }
+        return a;
+    }
+
+    int64_t realtime_ns()
+    {
+        timespec now{};
+        clock_gettime(CLOCK_REALTIME, &now);
+        return static_cast<int64_t>(now.tv_sec) * 1'000'000'000 + now.tv_nsec;
+    }
+
+    double thread_cpu_ms()
+    {
+        rusage usage{};
+        getrusage(RUSAGE_THREAD, &usage);
+        return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e3 +
+               (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e3;
+    }
+
+    struct Result
+    {
+        int received = 0;
+        double busy_cpu_ms = 0;
+        double busy_wall_ms = 0;
+        double idle_cpu_ms = 0;
+        LatencyHistogram latency;
+        LatencyHistogram kernel_to_callback;
+    };
+
+    /// Receiver side of one run. 'receive' blocks until 'stop' is called.
+    struct Receiver
+    {
+        virtual ~Receiver() = default;
+        [[nodiscard]] virtual uint16_t port() const = 0;
+        virtual void receive(Result &result) = 0;
+        virtual void stop() = 0;
+    };
+
+    void record_packet(Result &result, const uint8_t *data, size_t size, const timespec *kernel_timestamp)
+    {
+        if (size < sizeof(int64_t))
+            return;
+
+        int64_t sent_ns;
+        std::memcpy(&sent_ns, data, sizeof(sent_ns));
+        const int64_t now_ns = realtime_ns();
+        result.latency.record(std::chrono::nanoseconds(now_ns - sent_ns));
+
+        if (kernel_timestamp != nullptr && kernel_timestamp->tv_sec != 0)
+        {
+            const int64_t kernel_ns = static_cast<int64_t>(kernel_timestamp->tv_sec) * 1'000'000'000 + kernel_timestamp->tv_nsec;
+            result.kernel_to_callback.record(std::chrono::nanoseconds(now_ns - kernel_ns));
+        }
+        result.received++;
+    }
+
+    struct EpollReceiver final : Receiver
+    {
+        UdpReceiver receiver{0};
+
+        [[nodiscard]] uint16_t port() const override { return receiver.port(); }
+
+        void receive(Result &result) override
+        {
+            receiver.run([&](const uint8_t *data, size_t size, const timespec &kernel_timestamp)
+                         { record_packet(result, data, size, &kernel_timestamp); });
+        }
+
+        void stop() override { receiver.stop(); }
+    };
+
+    /// The receive loop the matrix used before: non-blocking recvfrom() with a 1 ms sleep when idle.
+    struct SleepReceiver final : Receiver
+    {
+        int socket_fd = -1;
+        uint16_t bound_port = 0;
+        std::atomic<bool> running{true};
+
+        SleepReceiver()
+        {
+            socket_fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+            int rcvbuf = 256 * 1024;
+            setsockopt(socket_fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_ANY);
+            bind(socket_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+
+            socklen_t len = sizeof(addr);
+            getsockname(socket_fd, reinterpret_cast<sockaddr *>(&addr), &len);
+            bound_port = ntohs(addr.sin_port);
+        }
+
+        ~SleepReceiver() override { close(socket_fd); }
+
+        [[nodiscard]] uint16_t port() const override { return bound_port; }
+
+        void receive(Result &result) override
+        {
+            std::vector<uint8_t> buffer(64 * 1024);
+            while (running)
+            {
+                const ssize_t n = recvfrom(socket_fd, buffer.data(), buffer.size(), 0, nullptr, nullptr);
+                if (n < 0)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    continue;
+                }
+                record_packet(result, buffer.data(), static_cast<size_t>(n), nullptr);
+            }
+        }
+
+        void stop() override { running = false; }
+    };
+
+    void run(const char *name, Receiver &receiver, const Args &args)
+    {
+        Result result;
+
+        std::thread receive_thread([&]()
+                                   {
+            // Idle phase: no traffic for one second
+            const double idle_start_cpu = thread_cpu_ms();
+            std::thread idle_stopper([&]() {
+                std::this_thread::sleep_for(std::chrono::seconds(1));
+                receiver.stop();
+            });
+            receiver.receive(result);
+            idle_stopper.join();
+            result.idle_cpu_ms = thread_cpu_ms() - idle_start_cpu; });
+        receive_thread.join();
+
+        // The sleep receiver needs to be re-armed after the idle phase, the epoll one consumes its stop event
+        if (auto *sleep_receiver = dynamic_cast<SleepReceiver *>(&receiver))
+            sleep_receiver->running = true;
+
+        const auto busy_start = std::chrono::steady_clock::now();
+        receive_thread = std::thread([&]()
+                                     {
+            const double start_cpu = thread_cpu_ms();
+            receiver.receive(result);
+            result.busy_cpu_ms = thread_cpu_ms() - start_cpu; });
+
+        const int sender = socket(AF_INET, SOCK_DGRAM, 0);
+        int sndbuf = 256 * 1024;
+        setsockopt(sender, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
+        sockaddr_in target{};
+        target.sin_family = AF_INET;
+        target.sin_port = htons(receiver.port());
+        target.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        std::vector<uint8_t> payload(args.size, 0x5A);
+        const auto interval = args.rate > 0 ? std::chrono::nanoseconds(1'000'000'000 / args.rate) : std::chrono::nanoseconds(0);
+        auto next_send = std::chrono::steady_clock::now();
+        for (int i = 0; i < args.packets; ++i)
+        {
+            if (args.rate > 0)
+            {
+                std::this_thread::sleep_until(next_send);
+                next_send += interval;
+            }
+
+            const int64_t sent_ns = realtime_ns();
+            std::memcpy(payload.data(), &sent_ns, sizeof(sent_ns));
+            sendto(sender, payload.data(), payload.size(), 0, reinterpret_cast<sockaddr *>(&target), sizeof(target));
+        }
+        close(sender);
+
+        // Give the receiver time to drain the socket queue
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        receiver.stop();
+        receive_thread.join();
+        result.busy_wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - busy_start).count();
+
+        const auto latency = result.latency.snapshot();
+        std::printf("%-6s  %7d/%-7d  %8.1f  %8.1f  %8.1f  %8.1f  %9.1f  %6.2f%%  %8.2f\n",
+                    name, result.received, args.packets,
+                    latency.p50_seconds * 1e6, latency.p95_seconds * 1e6, latency.p99_seconds * 1e6, latency.max_seconds * 1e6,
+                    result.busy_cpu_ms, 100.0 * result.busy_cpu_ms / result.busy_wall_ms, result.idle_cpu_ms);
+
+        const auto kernel = result.kernel_to_callback.snapshot();
+        if (kernel.count > 0)
+        {
+            std::printf("        kernel timestamp -> callback: p50 %.1f us, p99 %.1f us, max %.1f us\n",
+                        kernel.p50_seconds * 1e6, kernel.p99_seconds * 1e6, kernel.max_seconds * 1e6);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const Args args = parse_args(argc, argv);
+
+    std::printf("udp_latency_bench  packets=%d  size=%zu bytes  rate=%s\n\n", args.packets, args.size,
+                args.rate > 0 ? (std::to_string(args.rate) + "/s").c_str() : "unlimited");
+    std::printf("%-6s  %15s  %8s  %8s  %8s  %8s  %9s  %7s  %8s\n",
+                "mode", "received", "p50 us", "p95 us", "p99 us", "max us", "cpu ms", "cpu", "idle ms");
+
+    if (args.mode == "epoll" || args.mode == "both")
+    {
+        EpollReceiver receiver;
+        if (!receiver.receiver.is_open())
+        {
+            std::fprintf(stderr, "Could not open UDP receiver\n");
+            return 1;
+        }
+        run("epoll", receiver, args);
+    }
+
+    if (args.mode == "sleep" || args.mode == "both")
+    {
+        SleepReceiver receiver;
+        run("sleep", receiver, args);
+    }
+
+    return 0;
+}
@@ -0,0 +1,428 @@
+/**
+ * boids_bench: cost of one BoidsScene simulation step with the grid-based Flock vs
+ * the previous engine (separation, alignment and cohesion as three all-pairs loops
+ * over an array of boids), and the largest flock each of them steps within one
+ * frame at the target FPS.
+ *
+ * Usage:
+ *   boids_bench [--sizes <WxH,...>] [--fps <n>] [--steps <n>]
+ *
+ * Defaults:
+ *   --sizes  64x64,128x128
+ *   --fps    60
+ *   --steps  100
+ *
+ * Flocks use the scene's default properties. Both engines start from the same
+ * random flock; before timing, the bench checks that they end up at the same
+ * positions after a few steps. The ceiling is found by doubling the flock size
+ * until a step takes longer than 1/fps and then bisecting, and only counts the
+ * simulation, not drawing.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Flock.h"
+
+using AmbientScenes::Flock;
+using AmbientScenes::FlockParams;
+
+namespace
+{
+    struct Size
+    {
+        int width;
+        int height;
+    };
+
+    struct Args
+    {
+        std::vector<Size> sizes{{64, 64}, {128, 128}};
+        int fps = 60;
+        int steps = 100;
+    };
+
+    Args parse_args(int argc, char *argv[])
+    {
+        Args a;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--sizes" && i + 1 < argc)
+            {
+                a.sizes.clear();
+                std::stringstream ss(argv[++i]);
+                std::string token;
+                while (std::getline(ss, token, ','))
+                {
+                    Size size{};
+                    if (std::sscanf(token.c_str(), "%dx%d", &size.width, &size.height) == 2 && size.width > 0 &&
+                        size.height > 0)
+                        a.sizes.push_back(size);
+                }
+            }
+            else if (arg == "--fps" && i + 1 < argc)
+                a.fps = std::clamp(std::atoi(argv[++i]), 1, 1000);
+            else if (arg == "--steps" && i + 1 < argc)
+                a.steps = std::max(1, std::atoi(argv[++i]));
+        }
+        return a;
+    }
+
+    /// The simulation BoidsScene had before Flock.
+    class ReferenceFlock
+    {
+    public:
+        struct Vector2
+        {
+            float x = 0, y = 0;
+
+            Vector2 operator-(const Vector2 &v) const { return {x - v.x, y - v.y}; }
+            Vector2 &operator+=(const Vector2 &v)
+            {
+                x += v.x;
+                y += v.y;
+                return *this;
+            }
+            Vector2 &operator-=(const Vector2 &v)
+            {
+                x -= v.x;
+                y -= v.y;
+                return *this;
+            }
+            Vector2 &operator*=(float s)
+            {
+                x *= s;
+                y *= s;
+                return *this;
+            }
+            Vector2 &operator/=(float s)
+            {
+                x /= s;
+                y /= s;
+                return *this;
+            }
+
+            [[nodiscard]] float magSq() const { return x * x + y * y; }
+            [[nodiscard]] float mag() const { return std::sqrt(magSq()); }
+
+            void normalize()
+            {
+                const float m = mag();
+                if (m > 0.0001f)
+                {
+                    x /= m;
+                    y /= m;
+                }
+            }
+
+            void limit(float max)
+            {
+                if (magSq() > max * max)
+                {
+                    normalize();
+                    x *= max;
+                    y *= max;
+                }
+            }
+        };
+
+        struct Boid
+        {
+            Vector2 position;
+            Vector2 velocity;
+            Vector2 acceleration;
+        };
+
+        /// Same rand() sequence as Flock::reset.
+        void reset(int count, int w, int h)
+        {
+            width = w;
+            height = h;
+            boids.clear();
+            for (int i = 0; i < count; ++i)
+            {
+                Boid b;
+                b.position.x = static_cast<float>(rand() % width);
+                b.position.y = static_cast<float>(rand() % height);
+                b.velocity.x = 2.0f * (static_cast<float>(rand()) / RAND_MAX - 0.5f);
+                b.velocity.y = 2.0f * (static_cast<float>(rand()) / RAND_MAX - 0.5f);
+                boids.push_back(b);
+            }
+        }
+
+        void step(const FlockParams &params)
+        {
+            for (auto &b : boids)
+            {
+                Vector2 sep = separate(b, params);
+                Vector2 ali = align(b, params);
+                Vector2 coh = cohesion(b, params);
+                sep *= params.sep_weight;
+                ali *= params.ali_weight;
+                coh *= params.coh_weight;
+                b.acceleration += sep;
+                b.acceleration += ali;
+                b.acceleration += coh;
+            }
+            for (auto &b : boids)
+            {
+                b.velocity += b.acceleration;
+                b.velocity.limit(params.max_speed);
+                b.acceleration *= 0.0f;
+                edges(b, params);
+            }
+            for (auto &b : boids)
+                b.position += b.velocity;
+        }
+
+        std::vector<Boid> boids;
+
+    private:
+        void edges(Boid &b, const FlockParams &params) const
+        {
+            if (params.wraparound)
+            {
+                if (b.position.x > width)
+                    b.position.x = 0;
+                else if (b.position.x < 0)
+                    b.position.x = static_cast<float>(width);
+
+                if (b.position.y > height)
+                    b.position.y = 0;
+                else if (b.position.y < 0)
+                    b.position.y = static_cast<float>(height);
+            }
+            else
+            {
+                if (b.position.x >= width)
+                {
+                    b.position.x = static_cast<float>(width) - 1;
+                    b.velocity.x *= -1;
+                }
+                else if (b.position.x < 0)
+                {
+                    b.position.x = 0;
+                    b.velocity.x *= -1;
+                }
+
+                if (b.position.y >= height)
+                {
+                    b.position.y = static_cast<float>(height) - 1;
+                    b.velocity.y *= -1;
+                }
+                else if (b.position.y < 0)
+                {
+                    b.position.y = 0;
+                    b.velocity.y *= -1;
+                }
+            }
+        }
+
+        Vector2 separate(const Boid &boid, const FlockParams &params) const
+        {
+            Vector2 steer;
+            int count = 0;
+            for (const auto &other : boids)
+            {
+                const float d = (boid.position - other.position).mag();
+                if (d > 0 && d < params.sep_dist)
+                {
+                    Vector2 diff = boid.position - other.position;
+                    diff.normalize();
+                    diff /= (d + 0.0001f);
+                    steer += diff;
+                    count++;
+                }
+            }
+            if (count > 0)
+            {
+                steer /= static_cast<float>(count);
+                if (steer.magSq() > 0)
+                {
+                    steer.normalize();
+                    steer *= params.max_speed;
+                    steer -= boid.velocity;
+                    steer.limit(params.max_force);
+                }
+            }
+            return steer;
+        }
+
+        Vector2 align(const Boid &boid, const FlockParams &params) const
+        {
+            Vector2 sum;
+            int count = 0;
+            for (const auto &other : boids)
+            {
+                const float d = (boid.position - other.position).mag();
+                if (d > 0 && d < params.ali_dist)
+                {
+                    sum += other.velocity;
+                    count++;
+                }
+            }
+            if (count == 0)
+                return {};
+
+            sum /= static_cast<float>(count);
+            sum.normalize();
+            sum *= params.max_speed;
+            sum -= boid.velocity;
+            sum.limit(params.max_force);
+            return sum;
+        }
+
+        Vector2 cohesion(const Boid &boid, const FlockParams &params) const
+        {
+            Vector2 sum;
+            int count = 0;
+            for (const auto &other : boids)
+            {
+                const float d = (boid.position - other.position).mag();
+                if (d > 0 && d < params.coh_dist)
+                {
+                    sum += other.position;
+                    count++;
+                }
+            }
+            if (count == 0)
+                return {};
+
+            sum /= static_cast<float>(count);
+            Vector2 desired = sum - boid.position;
+            desired.normalize();
+            desired *= params.max_speed;
+            desired -= boid.velocity;
+            desired.limit(params.max_force);
+            return desired;
+        }
+
+        int width = 0;
+        int height = 0;
+    };
+
+    /// Largest distance between the positions of the two flocks.
+    float max_deviation(const Flock &flock, const ReferenceFlock &reference)
+    {
+        float deviation = 0;
+        for (size_t i = 0; i < flock.size(); ++i)
+        {
+            deviation = std::max(deviation, std::abs(flock.x(i) - reference.boids[i].position.x));
+            deviation = std::max(deviation, std::abs(flock.y(i) - reference.boids[i].position.y));
+        }
+        return deviation;
+    }
+
+    /// Average ns per step of a freshly seeded flock of 'count' boids. Gives up early
+    /// once the steps took more than a couple of seconds.
+    template <typename Engine>
+    double ns_per_step(Engine &engine, int count, const Size &size, int steps, const FlockParams &params)
+    {
+        srand(42);
+        engine.reset(count, size.width, size.height);
+        for (int i = 0; i < 5; ++i)
+            engine.step(params);
+
+        using clock = std::chrono::steady_clock;
+        const auto start = clock::now();
+        int done = 0;
+        while (done < steps && clock::now() - start < std::chrono::seconds(2))
+        {
+            engine.step(params);
+            done++;
+        }
+        const std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+        return elapsed.count() / done;
+    }
+
+    /// Largest flock that still steps within budget_ns, or 0 if not even 16 boids do.
+    template <typename Engine>
+    int flock_ceiling(Engine &engine, const Size &size, int steps, const FlockParams &params, double budget_ns)
+    {
+        constexpr int limit = 1 << 20;
+
+        int fits = 0;
+        int fails = 16;
+        while (fails <= limit && ns_per_step(engine, fails, size, steps, params) <= budget_ns)
+        {
+            fits = fails;
+            fails *= 2;
+        }
+        if (fits == 0 || fails > limit)
+            return fits;
+
+        // Bisect down to about 2% of the flock size
+        while (fails - fits > std::max(1, fits / 50))
+        {
+            const int mid = fits + (fails - fits) / 2;
+            if (ns_per_step(engine, mid, size, steps, params) <= budget_ns)
+                fits = mid;
+            else
+                fails = mid;
+        }
+        return fits;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const Args args = parse_args(argc, argv);
+    const FlockParams params;
+    const double budget_ns = 1e9 / args.fps;
+
+    std::printf("Boids, %d steps per measurement, budget %.2f ms per step (%d FPS)\n", args.steps, budget_ns / 1e6,
+                args.fps);
+    std::printf("%-10s %6s %14s %14s %9s %9s\n", "size", "boids", "reference ns", "grid ns", "speedup", "agree");
+
+    for (const auto &size : args.sizes)
+    {
+        char label[32];
+        std::snprintf(label, sizeof(label), "%dx%d", size.width, size.height);
+
+        for (const int count : {100, 500, 2000})
+        {
+            Flock flock;
+            ReferenceFlock reference;
+
+            // A few steps only, the flocks drift apart by float rounding after that
+            srand(7);
+            flock.reset(count, size.width, size.height);
+            srand(7);
+            reference.reset(count, size.width, size.height);
+            for (int i = 0; i < 5; ++i)
+            {
+                flock.step(params);
+                reference.step(params);
+            }
+            const bool agree = max_deviation(flock, reference) < 1e-3f;
+
+            const double reference_ns = ns_per_step(reference, count, size, args.steps, params);
+            const double grid_ns = ns_per_step(flock, count, size, args.steps, params);
+            std::printf("%-10s %6d %14.0f %14.0f %8.1fx %9s\n", label, count, reference_ns, grid_ns,
+                        reference_ns / grid_ns, agree ? "yes" : "NO");
+        }
+    }
+
+    std::printf("\nLargest flock within %.2f ms per step\n", budget_ns / 1e6);
+    std::printf("%-10s %14s %14s\n", "size", "reference", "grid");
+    for (const auto &size : args.sizes)
+    {
+        Flock flock;
+        ReferenceFlock reference;
+        const int reference_ceiling = flock_ceiling(reference, size, args.steps, params, budget_ns);
+        const int grid_ceiling = flock_ceiling(flock, size, args.steps, params, budget_ns);
+
+        char label[32];
+        std::snprintf(label, sizeof(label), "%dx%d", size.width, size.height);
+        std::printf("%-10s %14d %14d\n", label, reference_ceiling, grid_ceiling);
+    }
+
+    return 0;
+}
@@ -2,62 +2,19 @@
 
 #include "shared/matrix/Scene.h"
 #include "shared/matrix/plugin/main.h"
+#include "Flock.h"
 #include <vector>
 #include <random>
 
 namespace AmbientScenes {
     class BoidsScene : public Scenes::Scene {
     private:
-        struct Vector2 {
-            float x, y;
-
-            Vector2() : x(0), y(0) {}
-            Vector2(float _x, float _y) : x(_x), y(_y) {}
-
-            Vector2 operator+(const Vector2& v) const { return {x + v.x, y + v.y}; }
-            Vector2 operator-(const Vector2& v) const { return {x - v.x, y - v.y}; }
-            Vector2 operator*(float s) const { return {x * s, y * s}; }
-            Vector2 operator/(float s) const { return {x / s, y / s}; }
-
-            Vector2& operator+=(const Vector2& v) { x += v.x; y += v.y; return *this; }
-            Vector2& operator-=(const Vector2& v) { x -= v.x; y -= v.y; return *this; }
-            Vector2& operator*=(float s) { x *= s; y *= s; return *this; }
-            Vector2& operator/=(float s) { x /= s; y /= s; return *this; }
-
-            float magSq() const { return x * x + y * y; }
-            float mag() const { return std::sqrt(magSq()); }
-
-            void normalize() {
-                float m = mag();
-                if (m > 0.0001f) {
-                    x /= m;
-                    y /= m;
-                }
-            }
-
-            void limit(float max) {
-                if (magSq() > max * max) {
-                    normalize();
-                    x *= max;
-                    y *= max;
-                }
-            }
-        };
-
-        struct Boid {
-            Vector2 position;
-            Vector2 velocity;
-            Vector2 acceleration;
+        struct BoidColor {
             uint8_t r, g, b;
-
-            Boid(float x, float y) : position(x, y) {
-                acceleration = Vector2(0, 0);
-                velocity = Vector2(2.0f * ((float)rand() / RAND_MAX - 0.5f), 
-                                   2.0f * ((float)rand() / RAND_MAX - 0.5f));
-            }
         };
 
-        std::vector<Boid> flock;
+        Flock flock;
+        std::vector<BoidColor> colors;
 
         PropertyPointer<int> num_boids = MAKE_PROPERTY("num_boids", int, 100);
         PropertyPointer<float> max_speed = MAKE_PROPERTY("max_speed", float, 1.0f);
@@ -72,14 +29,6 @@ namespace AmbientScenes {
         PropertyPointer<float> coh_weight = MAKE_PROPERTY("coh_weight", float, 1.0f);
         PropertyPointer<bool> wraparound = MAKE_PROPERTY("wraparound", bool, true);
 
-        void run_boids();
-        void edges(Boid& b);
-        void flock_boid(Boid& boid);
-
-        Vector2 separate(Boid& boid);
-        Vector2 align(Boid& boid);
-        Vector2 cohesion(Boid& boid);
-
         void hsl_to_rgb(float h, float s, float l, uint8_t& r, uint8_t& g, uint8_t& b);
 
     public:
@@ -2,22 +2,27 @@
 
 #include "shared/matrix/Scene.h"
 #include "shared/matrix/plugin/main.h"
-#include <vector>
+#include "shared/matrix/canvas_buffer.h"
+#include "SandGrid.h"
 
 namespace AmbientScenes {
     class FallingSandScene : public Scenes::Scene {
     private:
-        std::vector<uint32_t> grid; // 0 for empty, otherwise RGB packed (R << 16 | G << 8 | B)
-        std::vector<uint32_t> next_grid; 
+        SandGrid sand; // 0 for empty, otherwise RGB packed (R << 16 | G << 8 | B)
+        CanvasBuffer frame; // Last frame, only cells the simulation changed are repainted
 
         PropertyPointer<int> spawn_rate = MAKE_PROPERTY("spawn_rate", int, 5);
         PropertyPointer<int> hue_speed = MAKE_PROPERTY("hue_speed", int, 2);
         PropertyPointer<int> max_sand = MAKE_PROPERTY("max_sand", int, 10000); 
+        PropertyPointer<int> steps_per_frame = MAKE_PROPERTY_MINMAX("steps_per_frame", int, 1, 1, 16);
 
         float current_hue = 0.0f;
         int sand_count = 0;
         int spawner_x = 64;
         int spawner_dir = 1;
+        int full_steps = 0;
+
+        void update_simulation();
 
         void hsl_to_rgb(float h, float s, float l, uint8_t& r, uint8_t& g, uint8_t& b);
 
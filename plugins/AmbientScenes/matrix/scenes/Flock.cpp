@@ -0,0 +1,440 @@
+#include "Flock.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define FLOCK_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define FLOCK_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace AmbientScenes {
+    namespace {
+        inline void limit(float &x, float &y, float max) {
+            const float mag_sq = x * x + y * y;
+            if (mag_sq > max * max) {
+                const float scale = max / std::sqrt(mag_sq);
+                x *= scale;
+                y *= scale;
+            }
+        }
+
+        inline void normalize(float &x, float &y) {
+            const float mag = std::sqrt(x * x + y * y);
+            if (mag > 0.0001f) {
+                x /= mag;
+                y /= mag;
+            }
+        }
+
+        /// Turns a summed up direction into a steering force: full speed along it, minus the current velocity.
+        inline void steer_towards(float &x, float &y, float vx, float vy, const FlockParams &params) {
+            normalize(x, y);
+            x = x * params.max_speed - vx;
+            y = y * params.max_speed - vy;
+            limit(x, y, params.max_force);
+        }
+
+        float random_unit() {
+            return 2.0f * (static_cast<float>(rand()) / RAND_MAX - 0.5f);
+        }
+
+        constexpr float epsilon = 0.0001f; // Prevent division by zero
+
+        /// What one boid sees of its neighbours, summed up for all three rules at once.
+        struct NeighbourSums {
+            float sep_x = 0, sep_y = 0, sep_count = 0;
+            float ali_x = 0, ali_y = 0, ali_count = 0;
+            float coh_x = 0, coh_y = 0, coh_count = 0;
+        };
+
+        struct Radii {
+            float sep_sq, ali_sq, coh_sq;
+        };
+
+        struct Neighbours {
+            const float *x, *y, *vx, *vy;
+        };
+
+        void accumulate_scalar(float x, float y, const Neighbours &n, uint32_t begin, uint32_t end, const Radii &r,
+                               NeighbourSums &sums) {
+            for (uint32_t j = begin; j < end; ++j) {
+                const float dx = x - n.x[j];
+                const float dy = y - n.y[j];
+                const float d_sq = dx * dx + dy * dy;
+                if (d_sq <= 0.0f)
+                    continue;
+
+                if (d_sq < r.sep_sq) {
+                    // Away from the neighbour, weighted by 1 / distance
+                    const float d = std::sqrt(d_sq);
+                    const float away = 1.0f / ((d > epsilon ? d : 1.0f) * (d + epsilon));
+                    sums.sep_x += dx * away;
+                    sums.sep_y += dy * away;
+                    sums.sep_count += 1;
+                }
+                if (d_sq < r.ali_sq) {
+                    sums.ali_x += n.vx[j];
+                    sums.ali_y += n.vy[j];
+                    sums.ali_count += 1;
+                }
+                if (d_sq < r.coh_sq) {
+                    sums.coh_x += n.x[j];
+                    sums.coh_y += n.y[j];
+                    sums.coh_count += 1;
+                }
+            }
+        }
+
+#if defined(FLOCK_SSE2)
+        // ─── SSE2, four neighbours per iteration ─────────────────────────────────
+        // Masks instead of branches, lanes outside a rule's radius add zero.
+        inline float horizontal_sum(__m128 v) {
+            const __m128 pairs = _mm_add_ps(v, _mm_movehl_ps(v, v));
+            return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+        }
+
+        void accumulate(float x, float y, const Neighbours &n, uint32_t begin, uint32_t end, const Radii &r,
+                        NeighbourSums &sums) {
+            const __m128 px = _mm_set1_ps(x);
+            const __m128 py = _mm_set1_ps(y);
+            const __m128 sep_sq = _mm_set1_ps(r.sep_sq);
+            const __m128 ali_sq = _mm_set1_ps(r.ali_sq);
+            const __m128 coh_sq = _mm_set1_ps(r.coh_sq);
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 eps = _mm_set1_ps(epsilon);
+
+            __m128 sep_x = zero, sep_y = zero, sep_count = zero;
+            __m128 ali_x = zero, ali_y = zero, ali_count = zero;
+            __m128 coh_x = zero, coh_y = zero, coh_count = zero;
+
+            uint32_t j = begin;
+            for (; j + 4 <= end; j += 4) {
+                const __m128 nx = _mm_loadu_ps(n.x + j);
+                const __m128 ny = _mm_loadu_ps(n.y + j);
+                const __m128 dx = _mm_sub_ps(px, nx);
+                const __m128 dy = _mm_sub_ps(py, ny);
+                const __m128 d_sq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+                const __m128 valid = _mm_cmpgt_ps(d_sq, zero);
+
+                const __m128 in_sep = _mm_and_ps(valid, _mm_cmplt_ps(d_sq, sep_sq));
+                const __m128 in_ali = _mm_and_ps(valid, _mm_cmplt_ps(d_sq, ali_sq));
+                const __m128 in_coh = _mm_and_ps(valid, _mm_cmplt_ps(d_sq, coh_sq));
+
+                if (_mm_movemask_ps(in_sep)) {
+                    const __m128 d = _mm_sqrt_ps(d_sq);
+                    const __m128 above_eps = _mm_cmpgt_ps(d, eps);
+                    const __m128 unit = _mm_or_ps(_mm_and_ps(above_eps, d), _mm_andnot_ps(above_eps, one));
+                    const __m128 away = _mm_and_ps(in_sep, _mm_div_ps(one, _mm_mul_ps(unit, _mm_add_ps(d, eps))));
+                    sep_x = _mm_add_ps(sep_x, _mm_mul_ps(dx, away));
+                    sep_y = _mm_add_ps(sep_y, _mm_mul_ps(dy, away));
+                    sep_count = _mm_add_ps(sep_count, _mm_and_ps(in_sep, one));
+                }
+
+                ali_x = _mm_add_ps(ali_x, _mm_and_ps(in_ali, _mm_loadu_ps(n.vx + j)));
+                ali_y = _mm_add_ps(ali_y, _mm_and_ps(in_ali, _mm_loadu_ps(n.vy + j)));
+                ali_count = _mm_add_ps(ali_count, _mm_and_ps(in_ali, one));
+
+                coh_x = _mm_add_ps(coh_x, _mm_and_ps(in_coh, nx));
+                coh_y = _mm_add_ps(coh_y, _mm_and_ps(in_coh, ny));
+                coh_count = _mm_add_ps(coh_count, _mm_and_ps(in_coh, one));
+            }
+
+            sums.sep_x += horizontal_sum(sep_x);
+            sums.sep_y += horizontal_sum(sep_y);
+            sums.sep_count += horizontal_sum(sep_count);
+            sums.ali_x += horizontal_sum(ali_x);
+            sums.ali_y += horizontal_sum(ali_y);
+            sums.ali_count += horizontal_sum(ali_count);
+            sums.coh_x += horizontal_sum(coh_x);
+            sums.coh_y += horizontal_sum(coh_y);
+            sums.coh_count += horizontal_sum(coh_count);
+
+            accumulate_scalar(x, y, n, j, end, r, sums);
+        }
+#elif defined(FLOCK_NEON)
+        // ─── NEON, four neighbours per iteration ─────────────────────────────────
+        inline float horizontal_sum(float32x4_t v) {
+#if defined(__aarch64__)
+            return vaddvq_f32(v);
+#else
+            const float32x2_t pairs = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+            return vget_lane_f32(vpadd_f32(pairs, pairs), 0);
+#endif
+        }
+
+        inline bool any_lane(uint32x4_t mask) {
+#if defined(__aarch64__)
+            return vmaxvq_u32(mask) != 0;
+#else
+            const uint32x2_t folded = vorr_u32(vget_low_u32(mask), vget_high_u32(mask));
+            return (vget_lane_u32(folded, 0) | vget_lane_u32(folded, 1)) != 0;
+#endif
+        }
+
+        // Exact square root and division, so the result matches the scalar path. 32-bit
+        // NEON only has estimates for them, it goes through the lanes one by one.
+        inline float32x4_t square_root(float32x4_t v) {
+#if defined(__aarch64__)
+            return vsqrtq_f32(v);
+#else
+            float lanes[4];
+            vst1q_f32(lanes, v);
+            for (float &lane: lanes)
+                lane = std::sqrt(lane);
+            return vld1q_f32(lanes);
+#endif
+        }
+
+        inline float32x4_t reciprocal(float32x4_t v) {
+#if defined(__aarch64__)
+            return vdivq_f32(vdupq_n_f32(1.0f), v);
+#else
+            float lanes[4];
+            vst1q_f32(lanes, v);
+            for (float &lane: lanes)
+                lane = 1.0f / lane;
+            return vld1q_f32(lanes);
+#endif
+        }
+
+        inline float32x4_t masked(uint32x4_t mask, float32x4_t v) {
+            return vreinterpretq_f32_u32(vandq_u32(mask, vreinterpretq_u32_f32(v)));
+        }
+
+        void accumulate(float x, float y, const Neighbours &n, uint32_t begin, uint32_t end, const Radii &r,
+                        NeighbourSums &sums) {
+            const float32x4_t px = vdupq_n_f32(x);
+            const float32x4_t py = vdupq_n_f32(y);
+            const float32x4_t sep_sq = vdupq_n_f32(r.sep_sq);
+            const float32x4_t ali_sq = vdupq_n_f32(r.ali_sq);
+            const float32x4_t coh_sq = vdupq_n_f32(r.coh_sq);
+            const float32x4_t zero = vdupq_n_f32(0.0f);
+            const float32x4_t one = vdupq_n_f32(1.0f);
+            const float32x4_t eps = vdupq_n_f32(epsilon);
+
+            float32x4_t sep_x = zero, sep_y = zero, sep_count = zero;
+            float32x4_t ali_x = zero, ali_y = zero, ali_count = zero;
+            float32x4_t coh_x = zero, coh_y = zero, coh_count = zero;
+
+            uint32_t j = begin;
+            for (; j + 4 <= end; j += 4) {
+                const float32x4_t nx = vld1q_f32(n.x + j);
+                const float32x4_t ny = vld1q_f32(n.y + j);
+                const float32x4_t dx = vsubq_f32(px, nx);
+                const float32x4_t dy = vsubq_f32(py, ny);
+                const float32x4_t d_sq = vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy));
+                const uint32x4_t valid = vcgtq_f32(d_sq, zero);
+
+                const uint32x4_t in_sep = vandq_u32(valid, vcltq_f32(d_sq, sep_sq));
+                const uint32x4_t in_ali = vandq_u32(valid, vcltq_f32(d_sq, ali_sq));
+                const uint32x4_t in_coh = vandq_u32(valid, vcltq_f32(d_sq, coh_sq));
+
+                if (any_lane(in_sep)) {
+                    const float32x4_t d = square_root(d_sq);
+                    const float32x4_t unit = vbslq_f32(vcgtq_f32(d, eps), d, one);
+                    const float32x4_t away = masked(in_sep, reciprocal(vmulq_f32(unit, vaddq_f32(d, eps))));
+                    sep_x = vaddq_f32(sep_x, vmulq_f32(dx, away));
+                    sep_y = vaddq_f32(sep_y, vmulq_f32(dy, away));
+                    sep_count = vaddq_f32(sep_count, masked(in_sep, one));
+                }
+
+                ali_x = vaddq_f32(ali_x, masked(in_ali, vld1q_f32(n.vx + j)));
+                ali_y = vaddq_f32(ali_y, masked(in_ali, vld1q_f32(n.vy + j)));
+                ali_count = vaddq_f32(ali_count, masked(in_ali, one));
+
+                coh_x = vaddq_f32(coh_x, masked(in_coh, nx));
+                coh_y = vaddq_f32(coh_y, masked(in_coh, ny));
+                coh_count = vaddq_f32(coh_count, masked(in_coh, one));
+            }
+
+            sums.sep_x += horizontal_sum(sep_x);
+            sums.sep_y += horizontal_sum(sep_y);
+            sums.sep_count += horizontal_sum(sep_count);
+            sums.ali_x += horizontal_sum(ali_x);
+            sums.ali_y += horizontal_sum(ali_y);
+            sums.ali_count += horizontal_sum(ali_count);
+            sums.coh_x += horizontal_sum(coh_x);
+            sums.coh_y += horizontal_sum(coh_y);
+            sums.coh_count += horizontal_sum(coh_count);
+
+            accumulate_scalar(x, y, n, j, end, r, sums);
+        }
+#else
+        void accumulate(float x, float y, const Neighbours &n, uint32_t begin, uint32_t end, const Radii &r,
+                        NeighbourSums &sums) {
+            accumulate_scalar(x, y, n, begin, end, r, sums);
+        }
+#endif
+    }
+
+    void Flock::reset(int count, int new_width, int new_height) {
+        width = new_width;
+        height = new_height;
+
+        const auto n = static_cast<size_t>(std::max(0, count));
+        pos_x.resize(n);
+        pos_y.resize(n);
+        vel_x.resize(n);
+        vel_y.resize(n);
+        acc_x.assign(n, 0.0f);
+        acc_y.assign(n, 0.0f);
+
+        for (size_t i = 0; i < n; ++i) {
+            pos_x[i] = static_cast<float>(rand() % width);
+            pos_y[i] = static_cast<float>(rand() % height);
+            vel_x[i] = random_unit();
+            vel_y[i] = random_unit();
+        }
+    }
+
+    void Flock::step(const FlockParams &params) {
+        if (pos_x.empty())
+            return;
+
+        build_grid(std::max({params.sep_dist, params.ali_dist, params.coh_dist, 1.0f}));
+        steer(params);
+        move(params);
+    }
+
+    void Flock::build_grid(float cell_size) {
+        inv_cell_size = 1.0f / cell_size;
+        grid_cols = static_cast<int>(static_cast<float>(width) * inv_cell_size) + 1;
+        grid_rows = static_cast<int>(static_cast<float>(height) * inv_cell_size) + 1;
+
+        const size_t n = pos_x.size();
+        cell_of.resize(n);
+        cell_start.assign(static_cast<size_t>(grid_cols) * grid_rows + 1, 0);
+
+        // Counting sort by cell. Boids just outside the panel (they move after the edge
+        // check) go to the border cells, which still holds every neighbour within reach.
+        for (size_t i = 0; i < n; ++i) {
+            const int cx = std::clamp(static_cast<int>(pos_x[i] * inv_cell_size), 0, grid_cols - 1);
+            const int cy = std::clamp(static_cast<int>(pos_y[i] * inv_cell_size), 0, grid_rows - 1);
+            cell_of[i] = static_cast<uint32_t>(cy * grid_cols + cx);
+            cell_start[cell_of[i] + 1]++;
+        }
+
+        for (size_t c = 1; c < cell_start.size(); ++c)
+            cell_start[c] += cell_start[c - 1];
+
+        sorted.resize(n);
+        sorted_x.resize(n);
+        sorted_y.resize(n);
+        sorted_vx.resize(n);
+        sorted_vy.resize(n);
+
+        cell_next.assign(cell_start.begin(), cell_start.end() - 1);
+        for (size_t i = 0; i < n; ++i) {
+            const uint32_t slot = cell_next[cell_of[i]]++;
+            sorted[slot] = static_cast<uint32_t>(i);
+            sorted_x[slot] = pos_x[i];
+            sorted_y[slot] = pos_y[i];
+            sorted_vx[slot] = vel_x[i];
+            sorted_vy[slot] = vel_y[i];
+        }
+    }
+
+    void Flock::steer(const FlockParams &params) {
+        const Radii radii{
+            params.sep_dist * params.sep_dist,
+            params.ali_dist * params.ali_dist,
+            params.coh_dist * params.coh_dist
+        };
+        const Neighbours neighbours{sorted_x.data(), sorted_y.data(), sorted_vx.data(), sorted_vy.data()};
+
+        for (size_t slot = 0; slot < sorted.size(); ++slot) {
+            const float x = sorted_x[slot];
+            const float y = sorted_y[slot];
+            const int cx = std::clamp(static_cast<int>(x * inv_cell_size), 0, grid_cols - 1);
+            const int cy = std::clamp(static_cast<int>(y * inv_cell_size), 0, grid_rows - 1);
+
+            NeighbourSums sums;
+            for (int ny = std::max(0, cy - 1); ny <= std::min(grid_rows - 1, cy + 1); ++ny) {
+                // The three cells of a grid row are next to each other in the sorted arrays
+                const size_t row = static_cast<size_t>(ny) * grid_cols;
+                const uint32_t begin = cell_start[row + std::max(0, cx - 1)];
+                const uint32_t end = cell_start[row + std::min(grid_cols - 1, cx + 1) + 1];
+                accumulate(x, y, neighbours, begin, end, radii, sums);
+            }
+
+            const float vx = sorted_vx[slot];
+            const float vy = sorted_vy[slot];
+            float ax = 0, ay = 0;
+
+            // Separation, the average direction only matters once normalized
+            if (sums.sep_count > 0 && sums.sep_x * sums.sep_x + sums.sep_y * sums.sep_y > 0) {
+                steer_towards(sums.sep_x, sums.sep_y, vx, vy, params);
+                ax += sums.sep_x * params.sep_weight;
+                ay += sums.sep_y * params.sep_weight;
+            }
+
+            // Alignment, towards the average heading
+            if (sums.ali_count > 0) {
+                steer_towards(sums.ali_x, sums.ali_y, vx, vy, params);
+                ax += sums.ali_x * params.ali_weight;
+                ay += sums.ali_y * params.ali_weight;
+            }
+
+            // Cohesion, towards the centre of the neighbours
+            if (sums.coh_count > 0) {
+                float to_x = sums.coh_x / sums.coh_count - x;
+                float to_y = sums.coh_y / sums.coh_count - y;
+                steer_towards(to_x, to_y, vx, vy, params);
+                ax += to_x * params.coh_weight;
+                ay += to_y * params.coh_weight;
+            }
+
+            acc_x[sorted[slot]] = ax;
+            acc_y[sorted[slot]] = ay;
+        }
+    }
+
+    void Flock::move(const FlockParams &params) {
+        const auto w = static_cast<float>(width);
+        const auto h = static_cast<float>(height);
+
+        for (size_t i = 0; i < pos_x.size(); ++i) {
+            float &x = pos_x[i];
+            float &y = pos_y[i];
+            float &vx = vel_x[i];
+            float &vy = vel_y[i];
+
+            vx += acc_x[i];
+            vy += acc_y[i];
+            limit(vx, vy, params.max_speed);
+
+            if (params.wraparound) {
+                if (x > w) x = 0;
+                else if (x < 0) x = w;
+
+                if (y > h) y = 0;
+                else if (y < 0) y = h;
+            } else {
+                // Bounce
+                if (x >= w) {
+                    x = w - 1;
+                    vx *= -1;
+                } else if (x < 0) {
+                    x = 0;
+                    vx *= -1;
+                }
+
+                if (y >= h) {
+                    y = h - 1;
+                    vy *= -1;
+                } else if (y < 0) {
+                    y = 0;
+                    vy *= -1;
+                }
+            }
+
+            x += vx;
+            y += vy;
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AmbientScenes {
+    struct FlockParams {
+        float max_speed = 1.0f;
+        float max_force = 0.05f;
+        float sep_dist = 10.0f;
+        float ali_dist = 25.0f;
+        float coh_dist = 25.0f;
+        float sep_weight = 1.5f;
+        float ali_weight = 1.0f;
+        float coh_weight = 1.0f;
+        bool wraparound = true;
+    };
+
+    /// Boids simulation behind BoidsScene. The flock is kept as separate position and
+    /// velocity arrays. Every step buckets the boids into a uniform grid with cells as
+    /// large as the biggest rule distance, so a boid only looks at the 3x3 cells around
+    /// it, and separation, alignment and cohesion are summed up in one pass over those
+    /// neighbours.
+    class Flock {
+    public:
+        /// Places 'count' boids at random positions with random velocities (rand(), like before).
+        void reset(int count, int width, int height);
+
+        /// Steers every boid, then moves it by its new velocity.
+        void step(const FlockParams &params);
+
+        [[nodiscard]] size_t size() const { return pos_x.size(); }
+        [[nodiscard]] float x(size_t i) const { return pos_x[i]; }
+        [[nodiscard]] float y(size_t i) const { return pos_y[i]; }
+
+    private:
+        void build_grid(float cell_size);
+        void steer(const FlockParams &params);
+        void move(const FlockParams &params);
+
+        int width = 0;
+        int height = 0;
+
+        std::vector<float> pos_x;
+        std::vector<float> pos_y;
+        std::vector<float> vel_x;
+        std::vector<float> vel_y;
+        std::vector<float> acc_x;
+        std::vector<float> acc_y;
+
+        // Grid: boids of cell c are sorted[cell_start[c] .. cell_start[c + 1]), copied in
+        // that order so the neighbour loop reads contiguous memory
+        float inv_cell_size = 1.0f;
+        int grid_cols = 0;
+        int grid_rows = 0;
+        std::vector<uint32_t> cell_of;
+        std::vector<uint32_t> cell_start;
+        std::vector<uint32_t> cell_next;
+        std::vector<uint32_t> sorted;
+        std::vector<float> sorted_x;
+        std::vector<float> sorted_y;
+        std::vector<float> sorted_vx;
+        std::vector<float> sorted_vy;
+    };
+}
@@ -41,8 +41,6 @@ namespace AmbientScenes {
     }
 
     bool MetaBlobScene::render(rgb_matrix::FrameCanvas *canvas) {
-        canvas->Clear();
-
         // Update blob positions
         blobs.clear();
         for (int i = 0; i < num_blobs->get(); i++) {
@@ -85,34 +83,42 @@ namespace AmbientScenes {
             }
         };
 
-        // Render metaballs
-        for (int y = 0; y < matrix_height; y++) {
-            for (int x = 0; x < matrix_width; x++) {
-                float dist_sum = 0.0f;
-                for (const auto &blob: blobs) {
-                    dist_sum += calculate_field(x, y, blob);
-                }
+        // Get base color and edge color (90 degrees shifted hue)
+        const auto [r1, g1, b1] = hue_to_rgb(hue);
+        const auto [r2, g2, b2] = hue_to_rgb(hue + 0.25f);
+        const float threshold_l = this->threshold->get();
+
+        // Render metaballs, rows are spread over the render pool
+        frame.resize(matrix_width, matrix_height);
+        parallel_rows(matrix_height, [&](int y_begin, int y_end) {
+            for (int y = y_begin; y < y_end; y++) {
+                rgb_matrix::Color *row = frame.row(y);
+                for (int x = 0; x < matrix_width; x++) {
+                    float dist_sum = 0.0f;
+                    for (const auto &blob: blobs) {
+                        dist_sum += calculate_field(x, y, blob);
+                    }
+
+                    // Black background
+                    if (dist_sum <= threshold_l) {
+                        row[x] = rgb_matrix::Color(0, 0, 0);
+                        continue;
+                    }
 
-                float threshold_l = this->threshold->get();
-                if (dist_sum > threshold_l) {
                     // Mix between center and edge colors
                     float t = std::min(1.0f, (dist_sum - threshold_l) / threshold_l);
                     t = t * t * (3.0f - 2.0f * t); // Smooth step
 
-                    // Get base color and edge color (90 degrees shifted hue)
-                    auto [r1, g1, b1] = hue_to_rgb(hue);
-                    auto [r2, g2, b2] = hue_to_rgb(hue + 0.25f);
-
                     // Mix colors based on field strength
                     uint8_t r = static_cast<uint8_t>(r1 * t + r2 * (1 - t));
                     uint8_t g = static_cast<uint8_t>(g1 * t + g2 * (1 - t));
                     uint8_t b = static_cast<uint8_t>(b1 * t + b2 * (1 - t));
 
-                    canvas->SetPixel(x, y, r, g, b);
+                    row[x] = rgb_matrix::Color(r, g, b);
                 }
-                // Black background - no else clause needed as Clear() sets black
             }
-        }
+        });
+        frame.write_to(canvas);
 
         time += 1.0f / 60.0f;
         return true;
@@ -2,6 +2,7 @@
 
 #include "shared/matrix/Scene.h"
 #include "shared/matrix/plugin/main.h"
+#include "shared/matrix/canvas_buffer.h"
 #include <vector>
 #include <random>
 
@@ -25,6 +26,7 @@ namespace AmbientScenes {
         };
 
         std::vector<Blob> blobs;
+        CanvasBuffer frame;
 
         // Shader conversion helpers
         float rand_sin(int i) const;
@@ -2,6 +2,7 @@
 
 #include "shared/matrix/Scene.h"
 #include "shared/matrix/plugin/main.h"
+#include "shared/matrix/canvas_buffer.h"
 
 namespace AmbientScenes {
     class NeonTunnelScene : public Scenes::Scene {
@@ -12,8 +13,7 @@ namespace AmbientScenes {
         PropertyPointer<float> hue_shift_speed = MAKE_PROPERTY("hue_shift_speed", float, 1.0f);
         
         float time_counter = 0.0f;
-
-        void hsl_to_rgb(float h, float s, float l, uint8_t& r, uint8_t& g, uint8_t& b);
+        CanvasBuffer frame;
 
     public:
         explicit NeonTunnelScene();
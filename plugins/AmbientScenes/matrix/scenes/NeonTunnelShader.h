@@ -0,0 +1,80 @@
+#pragma once
+
+#include "shared/matrix/utils/PixelShader.h"
+#include <cmath>
+
+namespace AmbientScenes {
+    struct NeonTunnelParams {
+        float speed = 2.0f;
+        float distance_factor = 100.0f;
+        float angle_factor = 8.0f;
+        float hue_shift_speed = 1.0f;
+    };
+
+    /// Per-pixel part of NeonTunnelScene for one frame at 'time'.
+    struct NeonTunnelShader {
+        float center_x, center_y;
+        float distance_factor;
+        float u_offset;
+        float angle_scale, v_offset;
+        float inv_fade_distance;
+        float hue_offset;
+
+        NeonTunnelShader(const NeonTunnelParams &params, float time, int width, int height) {
+            // Animate the center point slightly to make the effect loop / swing around
+            center_x = width / 2.0f + std::sin(time * 0.5f) * (width / 4.0f);
+            center_y = height / 2.0f + std::cos(time * 0.7f) * (height / 4.0f);
+
+            distance_factor = params.distance_factor;
+            u_offset = params.speed * time;
+            angle_scale = static_cast<float>(params.angle_factor / M_PI);
+            v_offset = std::sin(time) * 2.0f;
+            inv_fade_distance = 1.0f / (width * 1.5f);
+            hue_offset = time * params.hue_shift_speed * 50.0f;
+        }
+
+        PixelShader::Color4 operator()(FastMath::f32x4 x, FastMath::f32x4 y) const {
+            using namespace FastMath;
+
+            const f32x4 dx = x - center_x;
+            const f32x4 dy = y - center_y;
+            f32x4 distance = sqrt(dx * dx + dy * dy);
+            distance = select(distance == 0.0f, 0.001f, distance);
+
+            // U and V coordinates from distance and angle
+            const f32x4 v_u = f32x4(distance_factor) / distance + u_offset;
+            const f32x4 v_v = atan2(dy, dx) * angle_scale + v_offset;
+
+            // XOR texture: (tex_x ^ tex_y) > 128 means bit 7 differs and the low seven bits
+            // are not all equal. Texture coordinates stay exact integers in float, so all
+            // of this works without converting to int.
+            const f32x4 tex_x = wrap256(round(abs(v_u * 32.0f)));
+            const f32x4 tex_y = wrap256(round(abs(v_v * 32.0f)));
+            const f32x4 high_x = floor(tex_x * (1.0f / 128.0f));
+            const f32x4 high_y = floor(tex_y * (1.0f / 128.0f));
+            const mask4 lit = (high_x != high_y) & (tex_x - high_x * 128.0f != tex_y - high_y * 128.0f);
+
+            // Dim down the color based on depth/distance
+            const f32x4 depth_shade = max(f32x4(1.0f) - distance * inv_fade_distance, 0.0f);
+            const f32x4 lightness = select(lit, depth_shade * 0.5f, 0.0f);
+
+            // Color hue changes over time and depth, fully saturated
+            const f32x4 sector = fmod(distance * 2.0f + hue_offset, 360.0f) * (1.0f / 60.0f);
+            const f32x4 chroma = f32x4(1.0f) - abs(lightness * 2.0f - 1.0f);
+
+            const auto channel = [&](f32x4 pure) {
+                return (clamp(pure, 0.0f, 1.0f) - 0.5f) * chroma + lightness;
+            };
+            return {
+                channel(abs(sector - 3.0f) - 1.0f),
+                channel(f32x4(2.0f) - abs(sector - 2.0f)),
+                channel(f32x4(2.0f) - abs(sector - 4.0f))
+            };
+        }
+
+    private:
+        static FastMath::f32x4 wrap256(FastMath::f32x4 value) {
+            return value - FastMath::floor(value * (1.0f / 256.0f)) * 256.0f;
+        }
+    };
+}
@@ -0,0 +1,143 @@
+#include "SandGrid.h"
+#include <algorithm>
+#include <cstdlib> // rand
+
+namespace AmbientScenes {
+    void SandGrid::resize(int width, int height) {
+        grid_width = width;
+        grid_height = height;
+        chunk_cols = (width + chunk_size - 1) / chunk_size;
+        chunk_rows = (height + chunk_size - 1) / chunk_size;
+
+        const size_t cells = static_cast<size_t>(width) * height;
+        for (auto &buffer: buffers)
+            buffer.assign(cells, 0);
+        front = 0;
+
+        active.assign(static_cast<size_t>(chunk_cols) * chunk_rows, 0);
+        next_active.assign(active.size(), 0);
+        awake_chunks = 0;
+        changed_cells.clear();
+    }
+
+    void SandGrid::clear() {
+        for (auto &buffer: buffers)
+            std::fill(buffer.begin(), buffer.end(), 0);
+        std::fill(next_active.begin(), next_active.end(), 0);
+        awake_chunks = 0;
+        changed_cells.clear();
+    }
+
+    bool SandGrid::spawn(int x, uint32_t color) {
+        if (x < 0 || x >= grid_width || grid_height == 0)
+            return false;
+
+        uint32_t &cell = buffers[front][x];
+        if (cell != 0)
+            return false;
+
+        cell = color;
+        touch(x, 0);
+        changed_cells.push_back(static_cast<uint32_t>(x));
+        return true;
+    }
+
+    void SandGrid::touch(int x, int y) {
+        const int cx0 = std::max(0, x - 1) / chunk_size;
+        const int cx1 = std::min(grid_width - 1, x + 1) / chunk_size;
+        const int cy0 = std::max(0, y - 1) / chunk_size;
+        const int cy1 = std::min(grid_height - 1, y + 1) / chunk_size;
+
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                uint8_t &chunk = next_active[static_cast<size_t>(cy) * chunk_cols + cx];
+                if (!chunk) {
+                    chunk = 1;
+                    awake_chunks++;
+                }
+            }
+        }
+    }
+
+    void SandGrid::step() {
+        if (awake_chunks == 0)
+            return;
+
+        active.swap(next_active);
+        std::fill(next_active.begin(), next_active.end(), 0);
+        awake_chunks = 0;
+
+        const uint32_t *grid = buffers[front].data();
+        uint32_t *next_grid = buffers[1 - front].data();
+
+        // Awake chunks start out empty in the next buffer, every grain in them is written
+        // back below whether it moves or stays. Sleeping chunks already match.
+        for (int cy = 0; cy < chunk_rows; ++cy) {
+            for (int cx = 0; cx < chunk_cols; ++cx) {
+                if (!active[static_cast<size_t>(cy) * chunk_cols + cx])
+                    continue;
+
+                const int x0 = cx * chunk_size;
+                const int x1 = std::min(x0 + chunk_size, grid_width);
+                const int y1 = std::min((cy + 1) * chunk_size, grid_height);
+                for (int y = cy * chunk_size; y < y1; ++y)
+                    std::fill_n(next_grid + static_cast<size_t>(y) * grid_width + x0, x1 - x0, 0);
+            }
+        }
+
+        const auto move = [&](int x, int y, int to_x, uint32_t val) {
+            const int to = (y + 1) * grid_width + to_x;
+            next_grid[to] = val;
+
+            touch(x, y);
+            touch(to_x, y + 1);
+            changed_cells.push_back(static_cast<uint32_t>(y * grid_width + x));
+            changed_cells.push_back(static_cast<uint32_t>(to));
+        };
+
+        // Update Sand Logic from bottom up, in the same order as a full scan so rand() picks the same sides
+        for (int y = grid_height - 1; y >= 0; y--) {
+            const uint8_t *chunk_row = active.data() + static_cast<size_t>(y / chunk_size) * chunk_cols;
+
+            for (int cx = 0; cx < chunk_cols; ++cx) {
+                if (!chunk_row[cx])
+                    continue;
+
+                const int x_end = std::min((cx + 1) * chunk_size, grid_width);
+                for (int x = cx * chunk_size; x < x_end; x++) {
+                    int idx = y * grid_width + x;
+                    uint32_t val = grid[idx];
+                    if (val == 0)
+                        continue;
+
+                    // Grains on the bottom row stay
+                    if (y == grid_height - 1) {
+                        next_grid[idx] = val;
+                        continue;
+                    }
+
+                    int down = idx + grid_width;
+                    if (next_grid[down] == 0 && grid[down] == 0) {
+                        move(x, y, x, val); // Move Down
+                        continue;
+                    }
+
+                    bool can_left = x > 0 && next_grid[down - 1] == 0 && grid[down - 1] == 0;
+                    bool can_right = x < grid_width - 1 && next_grid[down + 1] == 0 && grid[down + 1] == 0;
+
+                    if (can_left && can_right) {
+                        move(x, y, rand() % 2 == 0 ? x - 1 : x + 1, val);
+                    } else if (can_left) {
+                        move(x, y, x - 1, val);
+                    } else if (can_right) {
+                        move(x, y, x + 1, val);
+                    } else {
+                        next_grid[idx] = val; // Stay
+                    }
+                }
+            }
+        }
+
+        front = 1 - front;
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AmbientScenes {
+    /// Falling sand simulation behind FallingSandScene, same rules as before: every step
+    /// a grain falls down, or else diagonally down (a random side if both are free).
+    ///
+    /// The board is double-buffered and the buffers are swapped, not copied. It is split
+    /// into chunks, and only chunks in which something changed last step (or next to one)
+    /// are simulated, so a settled pile costs nothing. Inside a sleeping chunk both
+    /// buffers hold the same cells, which is what lets a step skip it entirely.
+    class SandGrid {
+    public:
+        static constexpr int chunk_size = 8;
+
+        /// Resizes and clears the board.
+        void resize(int width, int height);
+        void clear();
+
+        /// Drops a grain of 'color' (packed RGB, never 0) into the top row. Returns false if the cell is taken.
+        bool spawn(int x, uint32_t color);
+
+        /// Advances one step, with rand() choosing between two free sides.
+        void step();
+
+        /// Packed RGB of the grain at x, y, 0 if empty.
+        [[nodiscard]] uint32_t at(int x, int y) const {
+            return current()[static_cast<size_t>(y) * grid_width + x];
+        }
+
+        /// Cells (y * width + x) that changed since the last clear_changes(). May contain duplicates.
+        [[nodiscard]] const std::vector<uint32_t> &changes() const { return changed_cells; }
+        void clear_changes() { changed_cells.clear(); }
+
+        /// True if no chunk has to be simulated in the next step.
+        [[nodiscard]] bool settled() const { return awake_chunks == 0; }
+
+        [[nodiscard]] int width() const { return grid_width; }
+        [[nodiscard]] int height() const { return grid_height; }
+
+    private:
+        [[nodiscard]] const uint32_t *current() const { return buffers[front].data(); }
+
+        /// Wakes the chunks holding the cell and its eight neighbours for the next step.
+        void touch(int x, int y);
+
+        int grid_width = 0;
+        int grid_height = 0;
+        int chunk_cols = 0;
+        int chunk_rows = 0;
+
+        std::vector<uint32_t> buffers[2];
+        int front = 0;
+
+        std::vector<uint8_t> active;      // Chunks simulated in this step
+        std::vector<uint8_t> next_active; // Chunks woken for the next one
+        int awake_chunks = 0;
+
+        std::vector<uint32_t> changed_cells;
+    };
+}
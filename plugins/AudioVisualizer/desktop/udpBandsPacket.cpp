@@ -26,21 +26,20 @@ CompactAudioPacket::CompactAudioPacket(const std::vector<float> &bands, bool int
 std::vector<uint8_t> CompactAudioPacket::toData() const
 {
     std::vector<uint8_t> data;
+    writeData(data);
+    return data;
+}
 
-    data.reserve(6 + bands.size());
+void CompactAudioPacket::writeData(std::vector<uint8_t> &out) const
+{
+    out.resize(6 + bands.size());
 
     // Header (6 bytes total)
-
-    data.push_back(numBands); // 1 byte
-    data.push_back(flags);    // 1 byte
-
-    uint8_t timestampBytes[4];
-    std::memcpy(timestampBytes, &timestamp, 4);
-
-    data.insert(data.end(), timestampBytes, timestampBytes + 4); // 4 bytes
+    out[0] = numBands; // 1 byte
+    out[1] = flags;    // 1 byte
+    std::memcpy(out.data() + 2, &timestamp, 4); // 4 bytes
 
     // Band data (numBands bytes)
-    data.insert(data.end(), bands.begin(), bands.end());
-
-    return data;
+    if (!bands.empty())
+        std::memcpy(out.data() + 6, bands.data(), bands.size());
 }
@@ -6,6 +6,7 @@ struct CompactAudioPacket final : UdpPacket
 public:
     CompactAudioPacket(const std::vector<float> &bands, bool interpolatedLog, bool beatDetected = false);
     std::vector<uint8_t> toData() const override;
+    void writeData(std::vector<uint8_t> &out) const override;
 private:
     uint32_t timestamp;
     uint8_t numBands;
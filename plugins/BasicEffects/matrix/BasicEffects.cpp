@@ -53,11 +53,8 @@ std::string BasicEffects::get_plugin_name() const
 }
 
 // Flash effect implementation
-void FlashEffect::apply(FrameCanvas *canvas, const PostProcessEffect &effect)
+void FlashEffect::apply(CanvasBuffer &frame, const PostProcessEffect &effect)
 {
-    if (!canvas)
-        return;
-
     float progress = get_effect_progress(effect);
 
     // Create a flash that peaks quickly and fades out
@@ -74,46 +71,35 @@ void FlashEffect::apply(FrameCanvas *canvas, const PostProcessEffect &effect)
         flash_intensity = effect.intensity * std::exp(-decay_progress * 5.0f);
     }
 
-    int width = canvas->width();
-    int height = canvas->height();
+    const float gain = flash_intensity * 0.8f;
 
     // Apply flash by brightening all pixels
-    for (int y = 0; y < height; y++)
+    rgb_matrix::Color *pixel = frame.data();
+    rgb_matrix::Color *const end = pixel + frame.size();
+    for (; pixel != end; ++pixel)
     {
-        for (int x = 0; x < width; x++)
-        {
-            // Get current pixel color
-            uint8_t r, g, b;
-            canvas->GetPixel(x, y, &r, &g, &b);
-
-            // Skip completely black pixels to preserve intentional darkness
-            if (r == 0 && g == 0 && b == 0)
-                continue;
-
-            // Brighten the pixel based on flash intensity
-            int new_r = std::min(255, static_cast<int>(r + flash_intensity * (255 - r) * 0.8f));
-            int new_g = std::min(255, static_cast<int>(g + flash_intensity * (255 - g) * 0.8f));
-            int new_b = std::min(255, static_cast<int>(b + flash_intensity * (255 - b) * 0.8f));
-
-            canvas->SetPixel(x, y, new_r, new_g, new_b);
-        }
+        // Skip completely black pixels to preserve intentional darkness
+        if (pixel->r == 0 && pixel->g == 0 && pixel->b == 0)
+            continue;
+
+        // Brighten the pixel based on flash intensity
+        pixel->r = static_cast<uint8_t>(std::min(255, static_cast<int>(pixel->r + gain * (255 - pixel->r))));
+        pixel->g = static_cast<uint8_t>(std::min(255, static_cast<int>(pixel->g + gain * (255 - pixel->g))));
+        pixel->b = static_cast<uint8_t>(std::min(255, static_cast<int>(pixel->b + gain * (255 - pixel->b))));
     }
 }
 
 // Rotate effect implementation
-void RotateEffect::apply(FrameCanvas *canvas, const PostProcessEffect &effect)
+void RotateEffect::apply(CanvasBuffer &frame, const PostProcessEffect &effect)
 {
-    if (!canvas)
-        return;
-
     float progress = get_effect_progress(effect);
 
     // Rotate up to 360 degrees over the duration
     float rotation_degrees = progress * 360.0f * effect.intensity;
     float rotation_radians = rotation_degrees * M_PI / 180.0f;
 
-    int width = canvas->width();
-    int height = canvas->height();
+    int width = frame.width();
+    int height = frame.height();
     int center_x = width / 2;
     int center_y = height / 2;
 
@@ -121,22 +107,8 @@ void RotateEffect::apply(FrameCanvas *canvas, const PostProcessEffect &effect)
     if (std::abs(rotation_degrees) < 1.0f)
         return;
 
-    // Create a temporary canvas for rotation
-    std::vector<std::vector<rgb_matrix::Color>> temp_canvas(height, std::vector<rgb_matrix::Color>(width));
-
-    // Copy current canvas to temp
-    for (int y = 0; y < height; y++)
-    {
-        for (int x = 0; x < width; x++)
-        {
-            uint8_t r, g, b;
-            canvas->GetPixel(x, y, &r, &g, &b);
-            temp_canvas[y][x] = rgb_matrix::Color(r, g, b);
-        }
-    }
-
-    // Clear canvas for rotated image
-    canvas->Clear();
+    // Snapshot the frame so we can sample from it while overwriting 'frame'
+    source.assign(frame.data(), frame.data() + frame.size());
 
     // Apply rotation with improved sampling
     float cos_angle = std::cos(rotation_radians);
@@ -144,22 +116,23 @@ void RotateEffect::apply(FrameCanvas *canvas, const PostProcessEffect &effect)
 
     for (int y = 0; y < height; y++)
     {
+        rgb_matrix::Color *out = frame.row(y);
+
+        // Translate to origin
+        const int rel_y = y - center_y;
         for (int x = 0; x < width; x++)
         {
-            // Translate to origin
-            int rel_x = x - center_x;
-            int rel_y = y - center_y;
+            const int rel_x = x - center_x;
 
             // Rotate (inverse transformation)
             int src_x = static_cast<int>(rel_x * cos_angle + rel_y * sin_angle + center_x);
             int src_y = static_cast<int>(-rel_x * sin_angle + rel_y * cos_angle + center_y);
 
-            // Check bounds and copy pixel
+            // Check bounds and copy pixel, anything outside the source is black
             if (src_x >= 0 && src_x < width && src_y >= 0 && src_y < height)
-            {
-                const auto &color = temp_canvas[src_y][src_x];
-                canvas->SetPixel(x, y, color.r, color.g, color.b);
-            }
+                out[x] = source[static_cast<size_t>(src_y) * width + src_x];
+            else
+                out[x] = rgb_matrix::Color();
         }
     }
-}
\ No newline at end of file
+}
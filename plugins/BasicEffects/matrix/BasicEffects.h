@@ -21,12 +21,15 @@ namespace Plugins {
 class FlashEffect : public PostProcessingEffect {
 public:
     std::string get_name() const override { return "flash"; }
-    void apply(FrameCanvas* canvas, const PostProcessEffect& effect) override;
+    void apply(CanvasBuffer& frame, const PostProcessEffect& effect) override;
 };
 
 // Rotate effect implementation  
 class RotateEffect : public PostProcessingEffect {
+    // Copy of the unrotated frame, kept between frames to avoid reallocating
+    std::vector<rgb_matrix::Color> source;
+
 public:
     std::string get_name() const override { return "rotate"; }
-    void apply(FrameCanvas* canvas, const PostProcessEffect& effect) override;
+    void apply(CanvasBuffer& frame, const PostProcessEffect& effect) override;
 };
\ No newline at end of file
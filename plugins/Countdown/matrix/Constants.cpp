@@ -1,5 +1,5 @@
 #include "Constants.h"
 
-rgb_matrix::Font HEADER_FONT = rgb_matrix::Font();
-rgb_matrix::Font BODY_FONT = rgb_matrix::Font();
-rgb_matrix::Font SMALL_FONT = rgb_matrix::Font();
+const rgb_matrix::Font *HEADER_FONT = nullptr;
+const rgb_matrix::Font *BODY_FONT = nullptr;
+const rgb_matrix::Font *SMALL_FONT = nullptr;
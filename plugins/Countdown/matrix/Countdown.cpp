@@ -1,6 +1,7 @@
 #include "Countdown.h"
 #include "scenes/CountdownScene.h"
 #include "Constants.h"
+#include "shared/matrix/utils/FontRegistry.h"
 #include <spdlog/spdlog.h>
 
 using namespace std;
@@ -43,13 +44,18 @@ std::optional<string> Countdown::before_server_init() {
 
     spdlog::debug("Loading Countdown fonts from {}", font_dir.string());
 
-    if (!HEADER_FONT.LoadFont(HEADER_FONT_FILE.c_str()))
+    auto &fonts = FontRegistry::instance();
+    HEADER_FONT = fonts.load(HEADER_FONT_FILE);
+    BODY_FONT = fonts.load(BODY_FONT_FILE);
+    SMALL_FONT = fonts.load(SMALL_FONT_FILE);
+
+    if (HEADER_FONT == nullptr)
         return std::string("Could not load header font at ") + HEADER_FONT_FILE;
 
-    if (!BODY_FONT.LoadFont(BODY_FONT_FILE.c_str()))
+    if (BODY_FONT == nullptr)
         return std::string("Could not load body font at ") + BODY_FONT_FILE;
 
-    if (!SMALL_FONT.LoadFont(SMALL_FONT_FILE.c_str()))
+    if (SMALL_FONT == nullptr)
         return std::string("Could not load small font at ") + SMALL_FONT_FILE;
 
     return BasicPlugin::before_server_init();
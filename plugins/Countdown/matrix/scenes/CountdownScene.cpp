@@ -178,29 +178,13 @@ bool CountdownScene::render(rgb_matrix::FrameCanvas *canvas)
     // Draw digits using the loaded fonts. Choose color
     rgb_matrix::Color text_color = digit_color->get();
 
-    // Choose font and vertical position based on big_digits flag
-    if (big_digits->get())
-    {
-        // Use HEADER_FONT as large font; draw centered horizontally
-        int baseline = HEADER_FONT.baseline();
-        // Compute text width using CharacterWidth per character (handles variable width fonts)
-        int text_width = 0;
-        for (char c : disp)
-            text_width += HEADER_FONT.CharacterWidth(static_cast<uint32_t>(c));
-        int text_x = (width - text_width) / 2;
-        int text_y = (height + baseline) / 2;
-        rgb_matrix::DrawText(canvas, HEADER_FONT, text_x, text_y, text_color, disp.c_str());
-    }
-    else
-    {
-        int baseline = BODY_FONT.baseline();
-        int text_width = 0;
-        for (char c : disp)
-            text_width += BODY_FONT.CharacterWidth(static_cast<uint32_t>(c));
-        int text_x = (width - text_width) / 2;
-        int text_y = (height + baseline) / 2;
-        rgb_matrix::DrawText(canvas, BODY_FONT, text_x, text_y, text_color, disp.c_str());
-    }
+    // Choose font based on big_digits flag, HEADER_FONT is the large one; draw centered
+    const rgb_matrix::Font &font = big_digits->get() ? *HEADER_FONT : *BODY_FONT;
+    // Measuring caches the string, the draw below only blits it (handles variable width fonts)
+    int text_width = text_cache.draw(nullptr, font, 0, 0, text_color, disp);
+    int text_x = (width - text_width) / 2;
+    int text_y = (height + font.baseline()) / 2;
+    text_cache.draw(canvas, font, text_x, text_y, text_color, disp);
 
     // Particle effects
     if ((confetti->get()
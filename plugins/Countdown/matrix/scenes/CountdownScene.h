@@ -4,6 +4,7 @@
 #include "shared/matrix/wrappers.h"
 #include "shared/matrix/utils/FrameTimer.h"
 #include "shared/matrix/plugin/property.h"
+#include "shared/matrix/utils/TextCache.h"
 
 #include <vector>
 #include <random>
@@ -42,6 +43,9 @@ namespace Scenes
         std::vector<Particle> confetti_particles;
         std::vector<Particle> fireworks_particles;
 
+        // The digits only change once a second (or minute)
+        TextCache text_cache;
+
         int width = 0, height = 0;
         std::mt19937 rng;
         // Spawn throttle helpers
@@ -21,11 +21,8 @@ bool ColorPulseScene::render(rgb_matrix::FrameCanvas *canvas) {
             break;
     }
     
-    for(int y = 0; y < matrix_height; y++) {
-        for(int x = 0; x < matrix_width; x++) {
-            canvas->SetPixel(x, y, r, g, b);
-        }
-    }
+    // Every pixel has the same color, no need to shade them one by one
+    canvas->Fill(r, g, b);
     
     return true;
 }
@@ -0,0 +1,209 @@
+/**
+ * game_of_life_bench: generations per second of the bit-packed LifeBoard used by
+ * GameOfLifeScene vs the previous engine (std::vector<bool> with a 3x3
+ * count_neighbors loop per cell, ages updated per cell).
+ *
+ * Usage:
+ *   game_of_life_bench [--sizes <WxH,...>] [--generations <n>] [--fill <0-1>]
+ *
+ * Defaults:
+ *   --sizes        64x64,128x128,256x256,1024x1024
+ *   --generations  200
+ *   --fill         0.25
+ *
+ * Both engines start from the same random board; before timing, the bench checks
+ * that they agree on every cell and age for the first generations.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "LifeBoard.h"
+
+using Scenes::LifeBoard;
+
+namespace
+{
+    struct Size
+    {
+        int width;
+        int height;
+    };
+
+    struct Args
+    {
+        std::vector<Size> sizes{{64, 64}, {128, 128}, {256, 256}, {1024, 1024}};
+        int generations = 200;
+        float fill = 0.25f;
+    };
+
+    Args parse_args(int argc, char *argv[])
+    {
+        Args a;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--sizes" && i + 1 < argc)
+            {
+                a.sizes.clear();
+                std::stringstream ss(argv[++i]);
+                std::string token;
+                while (std::getline(ss, token, ','))
+                {
+                    Size size{};
+                    if (std::sscanf(token.c_str(), "%dx%d", &size.width, &size.height) == 2 && size.width > 0 &&
+                        size.height > 0)
+                        a.sizes.push_back(size);
+                }
+            }
+            else if (arg == "--generations" && i + 1 < argc)
+                a.generations = std::max(1, std::atoi(argv[++i]));
+            else if (arg == "--fill" && i + 1 < argc)
+                a.fill = std::clamp(static_cast<float>(std::atof(argv[++i])), 0.0f, 1.0f);
+        }
+        return a;
+    }
+
+    /// The engine GameOfLifeScene had before LifeBoard.
+    class ReferenceBoard
+    {
+    public:
+        ReferenceBoard(int width, int height)
+            : width(width), height(height), current(width * height), next(width * height), ages(width * height)
+        {
+        }
+
+        void set(int x, int y, bool alive) { current[y * width + x] = alive; }
+        [[nodiscard]] bool alive(int x, int y) const { return current[y * width + x]; }
+        [[nodiscard]] int age(int x, int y) const { return ages[y * width + x]; }
+
+        void step()
+        {
+            for (int y = 0; y < height; ++y)
+            {
+                for (int x = 0; x < width; ++x)
+                {
+                    const int idx = y * width + x;
+                    const int neighbors = count_neighbors(x, y);
+                    if (current[idx])
+                    {
+                        next[idx] = neighbors == 2 || neighbors == 3;
+                        if (next[idx])
+                            ages[idx]++;
+                    }
+                    else
+                    {
+                        next[idx] = neighbors == 3;
+                        if (next[idx])
+                            ages[idx] = 0;
+                    }
+                }
+            }
+            current.swap(next);
+        }
+
+    private:
+        int count_neighbors(int x, int y) const
+        {
+            int count = 0;
+            for (int dy = -1; dy <= 1; ++dy)
+            {
+                for (int dx = -1; dx <= 1; ++dx)
+                {
+                    if (dx == 0 && dy == 0)
+                        continue;
+
+                    const int nx = (x + dx + width) % width;
+                    const int ny = (y + dy + height) % height;
+                    if (current[ny * width + nx])
+                        count++;
+                }
+            }
+            return count;
+        }
+
+        int width;
+        int height;
+        std::vector<bool> current;
+        std::vector<bool> next;
+        std::vector<int> ages;
+    };
+
+    bool boards_agree(const LifeBoard &board, const ReferenceBoard &reference, int width, int height)
+    {
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                if (board.alive(x, y) != reference.alive(x, y))
+                    return false;
+
+                // LifeBoard saturates, and ages of dead cells do not matter
+                if (board.alive(x, y) && board.age(x, y) != std::min(reference.age(x, y), LifeBoard::max_age))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename Fn>
+    double generations_per_second(int generations, Fn &&step)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < generations; ++i)
+            step();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return generations / elapsed.count();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const Args args = parse_args(argc, argv);
+
+    std::printf("Game of Life, %d generations, fill %.2f\n", args.generations, args.fill);
+    std::printf("%-10s %14s %14s %9s %7s\n", "size", "reference g/s", "bitboard g/s", "speedup", "agree");
+
+    for (const auto &size : args.sizes)
+    {
+        LifeBoard board;
+        board.resize(size.width, size.height);
+        ReferenceBoard reference(size.width, size.height);
+
+        std::mt19937 gen(1234);
+        board.randomize(args.fill, gen);
+        for (int y = 0; y < size.height; ++y)
+        {
+            for (int x = 0; x < size.width; ++x)
+                reference.set(x, y, board.alive(x, y));
+        }
+
+        bool agree = boards_agree(board, reference, size.width, size.height);
+        for (int i = 0; i < 100 && agree; ++i)
+        {
+            board.step();
+            reference.step();
+            agree = boards_agree(board, reference, size.width, size.height);
+        }
+
+        // The reference is slow on big boards, it gets fewer generations there
+        const int reference_generations =
+            std::max(1, static_cast<int>(args.generations * 16384LL / (static_cast<long long>(size.width) * size.height)));
+        const double reference_rate =
+            generations_per_second(std::min(args.generations, reference_generations), [&] { reference.step(); });
+        const double board_rate = generations_per_second(args.generations, [&] { board.step(); });
+
+        char label[32];
+        std::snprintf(label, sizeof(label), "%dx%d", size.width, size.height);
+        std::printf("%-10s %14.0f %14.0f %8.1fx %7s\n", label, reference_rate, board_rate, board_rate / reference_rate,
+                    agree ? "yes" : "NO");
+    }
+
+    return 0;
+}
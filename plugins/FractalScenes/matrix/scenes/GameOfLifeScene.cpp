@@ -1,6 +1,7 @@
 #include "GameOfLifeScene.h"
 #include <random>
 #include <algorithm>
+#include <array>
 
 using namespace Scenes;
 
@@ -9,183 +10,105 @@ GameOfLifeScene::GameOfLifeScene() : Scene() {
 
 void GameOfLifeScene::initialize(int width, int height) {
     Scene::initialize(width, height);
-    width = matrix_width;
-    height = matrix_height;
-    
-    // Setup grid sizes
-    current_grid.resize(width * height);
-    next_grid.resize(width * height);
-    cell_ages.resize(width * height);
-    
-    last_update = std::chrono::steady_clock::now();
+    // The parameters shadow the members, which used to stay 0
+    this->width = matrix_width;
+    this->height = matrix_height;
+
+    board.resize(this->width, this->height);
+    frame.resize(this->width, this->height);
+    states.resize(this->width);
+
+    timer = FrameTimer();
     accumulated_time = 0.0f;
-    steps_since_reset = 0;
-    steps_since_change = 0;
-    has_changed = false;
-    
+
     reset_simulation();
 }
 
 bool GameOfLifeScene::render(rgb_matrix::FrameCanvas *canvas) {
-    auto current_time = std::chrono::steady_clock::now();
-    float delta_time = std::chrono::duration<float>(current_time - last_update).count();
-    last_update = current_time;
-    
-    accumulated_time += delta_time;
+    accumulated_time += timer.tick().dt;
     update_interval = 1.0f / update_rate->get();
-    
+
     if (accumulated_time >= update_interval) {
         accumulated_time -= update_interval;
         update_simulation();
-        
-        steps_since_reset++;
-        
-        // Check if we need to reset based on stability or max steps
-        if ((steps_since_change > 10 && is_stable()) || 
+
+        // Reseed once the board has settled into still lifes and oscillators (a dead board
+        // is a still life too), or after the maximum number of steps
+        if (steps_in_cycle > 10 ||
             (auto_reset->get() > 0 && steps_since_reset >= auto_reset->get())) {
             reset_simulation();
         }
     }
-    
-    // Render the current state
-    canvas->Clear();
-    
+
+    // Render the current state, colors[0] is a dead cell and colors[age + 1] a living one
+    std::array<rgb_matrix::Color, LifeBoard::max_age + 2> colors;
+    colors[0] = rgb_matrix::Color(0, 0, 0);
+    for (int age = 0; age <= LifeBoard::max_age; ++age)
+        get_cell_color(age, colors[age + 1].r, colors[age + 1].g, colors[age + 1].b);
+
     for (int y = 0; y < height; ++y) {
+        board.row_states(y, states.data());
+        rgb_matrix::Color *row = frame.row(y);
         for (int x = 0; x < width; ++x) {
-            int idx = y * width + x;
-            if (current_grid[idx]) {
-                uint8_t r, g, b;
-                get_cell_color(cell_ages[idx], r, g, b);
-                canvas->SetPixel(x, y, r, g, b);
-            }
+            row[x] = colors[states[x]];
         }
     }
-    
+    frame.write_to(canvas);
+
     wait_until_next_frame();
     return true;
 }
 
 void GameOfLifeScene::update_simulation() {
-    has_changed = false;
-    
-    // Apply Game of Life rules
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            int idx = y * width + x;
-            int neighbors = count_neighbors(x, y);
-            bool current_state = current_grid[idx];
-            
-            // Conway's Game of Life rules
-            if (current_state) {
-                // Live cell
-                if (neighbors < 2 || neighbors > 3) {
-                    next_grid[idx] = false; // Cell dies
-                    has_changed = true;
-                } else {
-                    next_grid[idx] = true; // Cell survives
-                    cell_ages[idx]++; // Increase cell age
-                }
-            } else {
-                // Dead cell
-                if (neighbors == 3) {
-                    next_grid[idx] = true; // Cell becomes alive
-                    cell_ages[idx] = 0; // Reset age for new cell
-                    has_changed = true;
-                } else {
-                    next_grid[idx] = false; // Cell remains dead
-                }
-            }
-        }
-    }
-    
-    // Swap grids
-    current_grid.swap(next_grid);
-    
-    if (has_changed) {
-        steps_since_change = 0;
-    } else {
-        steps_since_change++;
-    }
-}
+    const int generations = generations_per_update->get();
+    for (int i = 0; i < generations; ++i) {
+        board.step();
+        steps_since_reset++;
 
-int GameOfLifeScene::count_neighbors(int x, int y) {
-    int count = 0;
-    
-    // Check 8 surrounding cells
-    for (int dy = -1; dy <= 1; ++dy) {
-        for (int dx = -1; dx <= 1; ++dx) {
-            if (dx == 0 && dy == 0) continue; // Skip self
-            
-            // Use modulo for wrapping around edges (toroidal grid)
-            int nx = (x + dx + width) % width;
-            int ny = (y + dy + height) % height;
-            
-            if (current_grid[ny * width + nx]) {
-                count++;
-            }
-        }
+        if (cycles.observe(board.hash()) > 0)
+            steps_in_cycle++;
+        else
+            steps_in_cycle = 0;
     }
-    
-    return count;
 }
 
 void GameOfLifeScene::reset_simulation(bool randomize) {
-    std::fill(current_grid.begin(), current_grid.end(), false);
-    std::fill(next_grid.begin(), next_grid.end(), false);
-    std::fill(cell_ages.begin(), cell_ages.end(), 0);
-    
+    board.clear();
+    cycles.reset();
+
     if (randomize) {
         // Randomly seed the grid
         std::random_device rd;
         std::mt19937 gen(rd());
-        std::uniform_real_distribution<> dis(0.0, 1.0);
-        
-        float fill_probability = random_fill->get();
-        
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                int idx = y * width + x;
-                if (dis(gen) < fill_probability) {
-                    current_grid[idx] = true;
-                }
-            }
-        }
+        board.randomize(random_fill->get(), gen);
     } else {
         // Add a few interesting patterns
-        
-        // Add a glider
+
+        // R-pentomino
         int center_x = width / 4;
         int center_y = height / 4;
-        
-        // R-pentomino
         if (width > 5 && height > 5) {
-            current_grid[(center_y - 1) * width + center_x] = true;
-            current_grid[(center_y - 1) * width + center_x + 1] = true;
-            current_grid[center_y * width + center_x - 1] = true;
-            current_grid[center_y * width + center_x] = true;
-            current_grid[(center_y + 1) * width + center_x] = true;
+            board.set(center_x, center_y - 1, true);
+            board.set(center_x + 1, center_y - 1, true);
+            board.set(center_x - 1, center_y, true);
+            board.set(center_x, center_y, true);
+            board.set(center_x, center_y + 1, true);
         }
-        
+
         // Glider
         center_x = 3 * width / 4;
         center_y = 3 * height / 4;
         if (width > 3 && height > 3) {
-            current_grid[(center_y - 1) * width + center_x] = true;
-            current_grid[center_y * width + center_x + 1] = true;
-            current_grid[(center_y + 1) * width + center_x - 1] = true;
-            current_grid[(center_y + 1) * width + center_x] = true;
-            current_grid[(center_y + 1) * width + center_x + 1] = true;
+            board.set(center_x, center_y - 1, true);
+            board.set(center_x + 1, center_y, true);
+            board.set(center_x - 1, center_y + 1, true);
+            board.set(center_x, center_y + 1, true);
+            board.set(center_x + 1, center_y + 1, true);
         }
     }
-    
-    steps_since_reset = 0;
-    steps_since_change = 0;
-    has_changed = true;
-}
 
-bool GameOfLifeScene::is_stable() {
-    // If nothing changed in the last update, consider it stable
-    return !has_changed;
+    steps_since_reset = 0;
+    steps_in_cycle = 0;
 }
 
 void GameOfLifeScene::get_cell_color(int age, uint8_t& r, uint8_t& g, uint8_t& b) const {
@@ -212,6 +135,7 @@ void GameOfLifeScene::register_properties() {
     add_property(random_fill);
     add_property(auto_reset);
     add_property(age_coloring);
+    add_property(generations_per_update);
 }
 
 void GameOfLifeScene::load_properties(const json &j) {
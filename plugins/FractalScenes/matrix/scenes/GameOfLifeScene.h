@@ -2,8 +2,9 @@
 
 #include "shared/matrix/Scene.h"
 #include "shared/matrix/plugin/main.h"
-#include <chrono>
-#include <vector>
+#include "shared/matrix/canvas_buffer.h"
+#include "shared/matrix/utils/FrameTimer.h"
+#include "LifeBoard.h"
 
 namespace Scenes {
     class GameOfLifeSceneWrapper final : public Plugins::SceneWrapper {
@@ -37,32 +38,28 @@ namespace Scenes {
         void load_properties(const json &j) override;
 
     private:
-        std::chrono::steady_clock::time_point last_update;
-        std::vector<bool> current_grid;
-        std::vector<bool> next_grid;
-        std::vector<int> cell_ages;
+        FrameTimer timer;
+        LifeBoard board;
+        LifeCycleDetector cycles;
+        CanvasBuffer frame;
+        std::vector<uint8_t> states; // one row of LifeBoard::row_states()
         float update_interval = 0.2f; // seconds between updates
         float accumulated_time = 0.0f;
         int width = 0;
         int height = 0;
         int steps_since_reset = 0;
-        int steps_since_change = 0;
-        bool has_changed = false;
-
-        // Game of Life rules
-        int count_neighbors(int x, int y);
+        int steps_in_cycle = 0;
 
         void update_simulation();
 
         void reset_simulation(bool randomize = true);
 
-        bool is_stable();
-
         // Display parameters
         PropertyPointer<int> update_rate = MAKE_PROPERTY_MINMAX("update_rate", int, 5, 1, 20);
         PropertyPointer<float> random_fill = MAKE_PROPERTY_MINMAX("random_fill", float, 0.25f, 0.05f, 0.5f);
         PropertyPointer<int> auto_reset = MAKE_PROPERTY_MINMAX("auto_reset", int, 200, 0, 1000);
         PropertyPointer<bool> age_coloring = MAKE_PROPERTY("age_coloring", bool, true);
+        PropertyPointer<int> generations_per_update = MAKE_PROPERTY_MINMAX("generations_per_update", int, 1, 1, 64);
 
         // Color functions
         void get_cell_color(int age, uint8_t &r, uint8_t &g, uint8_t &b) const;
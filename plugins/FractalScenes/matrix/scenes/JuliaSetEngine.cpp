@@ -0,0 +1,355 @@
+#include "JuliaSetEngine.h"
+#include "shared/matrix/utils/RenderPool.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define JULIA_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define JULIA_NEON 1
+#include <arm_neon.h>
+#endif
+
+using namespace Scenes;
+
+namespace {
+    constexpr int palette_size = 1024;
+
+    // |z|^2 right after escaping is below (2 + |c|)^2, the table covers [4, 4 + smooth_range)
+    constexpr int smooth_table_size = 1024;
+    constexpr float smooth_range = 32.0f;
+
+    struct Tables {
+        std::array<rgb_matrix::Color, palette_size> palette{};
+        /// 1 - log2(log2(|z|)) in 8.8 fixed point, indexed by |z|^2
+        std::array<int32_t, smooth_table_size> smooth_fraction{};
+    };
+
+    rgb_matrix::Color hsv_to_rgb(float h, float s, float v) {
+        const float c = v * s;
+        const float x = c * (1 - std::abs(std::fmod(h * 6, 2) - 1));
+        const float m = v - c;
+        float r1, g1, b1;
+
+        if (h < 1.0f / 6.0f) { r1 = c; g1 = x; b1 = 0; }
+        else if (h < 2.0f / 6.0f) { r1 = x; g1 = c; b1 = 0; }
+        else if (h < 3.0f / 6.0f) { r1 = 0; g1 = c; b1 = x; }
+        else if (h < 4.0f / 6.0f) { r1 = 0; g1 = x; b1 = c; }
+        else if (h < 5.0f / 6.0f) { r1 = x; g1 = 0; b1 = c; }
+        else { r1 = c; g1 = 0; b1 = x; }
+
+        return {
+            static_cast<uint8_t>((r1 + m) * 255),
+            static_cast<uint8_t>((g1 + m) * 255),
+            static_cast<uint8_t>((b1 + m) * 255)
+        };
+    }
+
+    int32_t smooth_fraction_exact(float magnitude_sq) {
+        // log2(|z|) = log2(|z|^2) / 2
+        const float fraction = 1.0f - std::log2(0.5f * std::log2(magnitude_sq));
+        return static_cast<int32_t>(std::lround(fraction * 256.0f));
+    }
+
+    const Tables &tables() {
+        static const Tables t = [] {
+            Tables result;
+            for (int i = 0; i < palette_size; ++i)
+                result.palette[i] = hsv_to_rgb(static_cast<float>(i) / palette_size, 0.9f, 1.0f);
+
+            for (int i = 0; i < smooth_table_size; ++i)
+                result.smooth_fraction[i] = smooth_fraction_exact(4.0f + (i + 0.5f) * smooth_range / smooth_table_size);
+
+            return result;
+        }();
+        return t;
+    }
+
+    /// Smoothed iteration count in 8.8 fixed point, or -1 if the point did not escape.
+    inline int32_t smooth_iteration(int iterations, float magnitude_sq, int max_iterations, const Tables &t) {
+        if (iterations >= max_iterations)
+            return -1;
+
+        const float index = (magnitude_sq - 4.0f) * (smooth_table_size / smooth_range);
+        const int32_t fraction = index >= 0.0f && index < smooth_table_size
+                                     ? t.smooth_fraction[static_cast<int>(index)]
+                                     : smooth_fraction_exact(magnitude_sq); // only points that start far outside
+
+        return std::max(0, iterations * 256 + fraction);
+    }
+
+    /// Escape times for 'count' points starting at (x0, y) spaced 'dx' apart, written to out[i * stride].
+    void escape_scalar(float x0, float y, float dx, int count, float c_re, float c_im, int max_iterations,
+                       int32_t *out, int stride, const Tables &t) {
+        for (int i = 0; i < count; ++i) {
+            float zr = x0 + static_cast<float>(i) * dx;
+            float zi = y;
+            float zr2 = zr * zr;
+            float zi2 = zi * zi;
+
+            int iterations = 0;
+            while (zr2 + zi2 < 4.0f && iterations < max_iterations) {
+                zi = 2.0f * zr * zi + c_im;
+                zr = zr2 - zi2 + c_re;
+                zr2 = zr * zr;
+                zi2 = zi * zi;
+                iterations++;
+            }
+
+            out[i * stride] = smooth_iteration(iterations, zr2 + zi2, max_iterations, t);
+        }
+    }
+
+#if defined(JULIA_SSE2)
+    // ─── SSE2, four points per iteration ─────────────────────────────────────
+    // Escaped lanes keep their z, so |z|^2 of every lane is still at hand after the loop.
+    void escape_simd(float x0, float y, float dx, int count, float c_re, float c_im, int max_iterations,
+                     int32_t *out, int stride, const Tables &t) {
+        const __m128 four = _mm_set1_ps(4.0f);
+        const __m128 cr = _mm_set1_ps(c_re);
+        const __m128 ci = _mm_set1_ps(c_im);
+        const __m128 lane_offsets = _mm_mul_ps(_mm_set_ps(3, 2, 1, 0), _mm_set1_ps(dx));
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128 zr = _mm_add_ps(_mm_set1_ps(x0 + static_cast<float>(i) * dx), lane_offsets);
+            __m128 zi = _mm_set1_ps(y);
+            __m128i iterations = _mm_setzero_si128();
+
+            for (int n = 0; n < max_iterations; ++n) {
+                const __m128 zr2 = _mm_mul_ps(zr, zr);
+                const __m128 zi2 = _mm_mul_ps(zi, zi);
+                const __m128 inside = _mm_cmplt_ps(_mm_add_ps(zr2, zi2), four);
+                if (_mm_movemask_ps(inside) == 0)
+                    break;
+
+                // inside lanes are all ones, i.e. -1
+                iterations = _mm_sub_epi32(iterations, _mm_castps_si128(inside));
+
+                const __m128 zri = _mm_mul_ps(zr, zi);
+                const __m128 next_zi = _mm_add_ps(_mm_add_ps(zri, zri), ci);
+                const __m128 next_zr = _mm_add_ps(_mm_sub_ps(zr2, zi2), cr);
+                zr = _mm_or_ps(_mm_and_ps(inside, next_zr), _mm_andnot_ps(inside, zr));
+                zi = _mm_or_ps(_mm_and_ps(inside, next_zi), _mm_andnot_ps(inside, zi));
+            }
+
+            alignas(16) float magnitude_sq[4];
+            alignas(16) int32_t counts[4];
+            _mm_store_ps(magnitude_sq, _mm_add_ps(_mm_mul_ps(zr, zr), _mm_mul_ps(zi, zi)));
+            _mm_store_si128(reinterpret_cast<__m128i *>(counts), iterations);
+
+            for (int lane = 0; lane < 4; ++lane)
+                out[(i + lane) * stride] = smooth_iteration(counts[lane], magnitude_sq[lane], max_iterations, t);
+        }
+
+        escape_scalar(x0 + static_cast<float>(i) * dx, y, dx, count - i, c_re, c_im, max_iterations,
+                      out + i * stride, stride, t);
+    }
+#elif defined(JULIA_NEON)
+    // ─── NEON, four points per iteration ─────────────────────────────────────
+    inline bool any_lane(uint32x4_t mask) {
+#if defined(__aarch64__)
+        return vmaxvq_u32(mask) != 0;
+#else
+        const uint32x2_t folded = vorr_u32(vget_low_u32(mask), vget_high_u32(mask));
+        return (vget_lane_u32(folded, 0) | vget_lane_u32(folded, 1)) != 0;
+#endif
+    }
+
+    void escape_simd(float x0, float y, float dx, int count, float c_re, float c_im, int max_iterations,
+                     int32_t *out, int stride, const Tables &t) {
+        const float32x4_t four = vdupq_n_f32(4.0f);
+        const float32x4_t cr = vdupq_n_f32(c_re);
+        const float32x4_t ci = vdupq_n_f32(c_im);
+        const float lane_init[4] = {0.0f, dx, 2.0f * dx, 3.0f * dx};
+        const float32x4_t lane_offsets = vld1q_f32(lane_init);
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4) {
+            float32x4_t zr = vaddq_f32(vdupq_n_f32(x0 + static_cast<float>(i) * dx), lane_offsets);
+            float32x4_t zi = vdupq_n_f32(y);
+            int32x4_t iterations = vdupq_n_s32(0);
+
+            for (int n = 0; n < max_iterations; ++n) {
+                const float32x4_t zr2 = vmulq_f32(zr, zr);
+                const float32x4_t zi2 = vmulq_f32(zi, zi);
+                const uint32x4_t inside = vcltq_f32(vaddq_f32(zr2, zi2), four);
+                if (!any_lane(inside))
+                    break;
+
+                iterations = vsubq_s32(iterations, vreinterpretq_s32_u32(inside));
+
+                const float32x4_t zri = vmulq_f32(zr, zi);
+                const float32x4_t next_zi = vaddq_f32(vaddq_f32(zri, zri), ci);
+                const float32x4_t next_zr = vaddq_f32(vsubq_f32(zr2, zi2), cr);
+                zr = vbslq_f32(inside, next_zr, zr);
+                zi = vbslq_f32(inside, next_zi, zi);
+            }
+
+            float magnitude_sq[4];
+            int32_t counts[4];
+            vst1q_f32(magnitude_sq, vaddq_f32(vmulq_f32(zr, zr), vmulq_f32(zi, zi)));
+            vst1q_s32(counts, iterations);
+
+            for (int lane = 0; lane < 4; ++lane)
+                out[(i + lane) * stride] = smooth_iteration(counts[lane], magnitude_sq[lane], max_iterations, t);
+        }
+
+        escape_scalar(x0 + static_cast<float>(i) * dx, y, dx, count - i, c_re, c_im, max_iterations,
+                      out + i * stride, stride, t);
+    }
+#else
+    void escape_simd(float x0, float y, float dx, int count, float c_re, float c_im, int max_iterations,
+                     int32_t *out, int stride, const Tables &t) {
+        escape_scalar(x0, y, dx, count, c_re, c_im, max_iterations, out, stride, t);
+    }
+#endif
+
+    bool same_shape(const JuliaSetParams &a, const JuliaSetParams &b) {
+        return a.c_re == b.c_re && a.c_im == b.c_im && a.zoom == b.zoom && a.max_iterations == b.max_iterations;
+    }
+
+    // Offsets of the passes within a 2x2 block, the coarse pass first
+    constexpr int pass_dx[] = {0, 1, 0, 1};
+    constexpr int pass_dy[] = {0, 1, 1, 0};
+}
+
+void JuliaSetEngine::resize(int new_width, int new_height) {
+    width = new_width;
+    height = new_height;
+    smooth.assign(static_cast<size_t>(width) * height, -1);
+    has_params = false;
+    fresh_passes = 0;
+    filled_passes = 0;
+    colors_valid = false;
+}
+
+void JuliaSetEngine::render(const JuliaSetParams &params, std::chrono::nanoseconds budget, CanvasBuffer &frame) {
+    if (!has_params || !same_shape(params, computed)) {
+        computed = params;
+        has_params = true;
+        fresh_passes = 0;
+    }
+
+    std::vector<int> passes;
+    if ((fresh_passes & 1) == 0)
+        passes.push_back(0);
+
+    // Fine passes in turns, as many as the budget is estimated to allow
+    const auto affordable = pass_ns > 0 ? static_cast<int>(static_cast<double>(budget.count()) / pass_ns) : pass_count;
+    for (int tried = 0; tried < pass_count - 1; ++tried) {
+        const int pass = next_fine_pass;
+        if (fresh_passes & (1 << pass)) {
+            next_fine_pass = pass % (pass_count - 1) + 1;
+            continue;
+        }
+
+        if (!passes.empty() && static_cast<int>(passes.size()) >= affordable)
+            break;
+
+        passes.push_back(pass);
+        next_fine_pass = pass % (pass_count - 1) + 1;
+    }
+
+    if (!passes.empty()) {
+        const float aspect_ratio = static_cast<float>(width) / static_cast<float>(height);
+        const Geometry geometry{
+            -1.5f * aspect_ratio / params.zoom,
+            -1.5f / params.zoom,
+            3.0f * aspect_ratio / params.zoom / static_cast<float>(width),
+            3.0f / params.zoom / static_cast<float>(height)
+        };
+
+        const auto start = std::chrono::steady_clock::now();
+        compute_passes(passes, geometry, params);
+        const double elapsed = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+
+        const double per_pass = elapsed / static_cast<double>(passes.size());
+        pass_ns = pass_ns > 0 ? pass_ns * 0.75 + per_pass * 0.25 : per_pass;
+
+        for (const int pass: passes) {
+            fresh_passes |= 1 << pass;
+            filled_passes |= 1 << pass;
+        }
+        colors_valid = false;
+    }
+
+    if (!colors_valid || colored_shift != params.color_shift) {
+        colorize(params, frame);
+        colors_valid = true;
+        colored_shift = params.color_shift;
+    }
+}
+
+void JuliaSetEngine::compute_passes(const std::vector<int> &passes, const Geometry &geometry,
+                                    const JuliaSetParams &params) {
+    // Coarse values are only copied into passes that were never computed and are not part of this batch,
+    // otherwise two threads could write the same pixel
+    uint8_t keep_mask = filled_passes;
+    for (const int pass: passes)
+        keep_mask |= 1 << pass;
+
+    // The rows of all passes in one job; the pool hands out tiles of neighbouring rows and
+    // steals them back and forth, so the expensive middle of the set does not stall a thread
+    pass_rows.clear();
+    for (const int pass: passes) {
+        for (int y = pass_dy[pass]; y < height; y += 2)
+            pass_rows.emplace_back(pass, y);
+    }
+
+    RenderPool::instance().parallel_rows(static_cast<int>(pass_rows.size()), [&](int begin, int end) {
+        for (int i = begin; i < end; ++i)
+            compute_row(pass_rows[i].first, pass_rows[i].second, geometry, params, keep_mask);
+    });
+}
+
+void JuliaSetEngine::compute_row(int pass, int y, const Geometry &geometry, const JuliaSetParams &params,
+                                 uint8_t keep_mask) {
+    const Tables &t = tables();
+    const int x_start = pass_dx[pass];
+    const int count = (width - x_start + 1) / 2;
+    if (count <= 0)
+        return;
+
+    int32_t *row = smooth.data() + static_cast<size_t>(y) * width;
+    escape_simd(geometry.x0 + static_cast<float>(x_start) * geometry.dx, geometry.y0 + static_cast<float>(y) * geometry.dy,
+                2.0f * geometry.dx, count, params.c_re, params.c_im, params.max_iterations, row + x_start, 2, t);
+
+    if (pass != 0)
+        return;
+
+    // Until a fine pass ran once, its pixels show the coarse value of their block
+    for (int fine = 1; fine < pass_count; ++fine) {
+        if (keep_mask & (1 << fine))
+            continue;
+
+        const int fy = y + pass_dy[fine];
+        if (fy >= height)
+            continue;
+
+        int32_t *fine_row = smooth.data() + static_cast<size_t>(fy) * width;
+        for (int x = pass_dx[fine]; x < width; x += 2)
+            fine_row[x] = row[x - pass_dx[fine]];
+    }
+}
+
+void JuliaSetEngine::colorize(const JuliaSetParams &params, CanvasBuffer &frame) const {
+    const auto &palette = tables().palette;
+    const int32_t shift = static_cast<int32_t>(params.color_shift * palette_size);
+
+    rgb_matrix::Color *out = frame.data();
+    const size_t count = std::min(frame.size(), smooth.size());
+    for (size_t i = 0; i < count; ++i) {
+        const int32_t value = smooth[i];
+        if (value < 0) {
+            out[i] = rgb_matrix::Color(0, 0, 0);
+            continue;
+        }
+
+        // hue = iterations * 0.01 + shift, with 8.8 iterations that is value / 25 palette steps
+        out[i] = palette[(value / 25 + shift) & (palette_size - 1)];
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "shared/matrix/canvas_buffer.h"
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Scenes {
+    struct JuliaSetParams {
+        float c_re = -0.7f;
+        float c_im = 0.27f;
+        float zoom = 0.8f;
+        int max_iterations = 100;
+        float color_shift = 0.0f;
+    };
+
+    /// Julia set renderer behind JuliaSetScene. Escape times are computed four pixels
+    /// at a time (SSE2/NEON, scalar elsewhere), with the rows spread over the shared
+    /// RenderPool, and kept as smoothed iteration counts in 8.8 fixed point so that a
+    /// colour shift is only a palette lookup per pixel.
+    ///
+    /// The image is split into the four pixels of every 2x2 block ("passes"). When the
+    /// parameters change and all four passes would not fit into the frame budget, the
+    /// first pass (the coarse grid) is always recomputed and the other passes take
+    /// turns with whatever budget is left, so detail catches up over the next frames.
+    /// Once nothing changes anymore the last frame is reused as is.
+    class JuliaSetEngine {
+    public:
+        void resize(int width, int height);
+
+        /// Renders 'params' into 'frame', which has to be of the size given to resize().
+        void render(const JuliaSetParams &params, std::chrono::nanoseconds budget, CanvasBuffer &frame);
+
+    private:
+        static constexpr int pass_count = 4;
+
+        struct Geometry {
+            float x0;
+            float y0;
+            float dx;
+            float dy;
+        };
+
+        void compute_passes(const std::vector<int> &passes, const Geometry &geometry, const JuliaSetParams &params);
+        /// 'keep_mask' has a bit for every pass the coarse pass must not overwrite
+        void compute_row(int pass, int y, const Geometry &geometry, const JuliaSetParams &params, uint8_t keep_mask);
+        void colorize(const JuliaSetParams &params, CanvasBuffer &frame) const;
+
+        int width = 0;
+        int height = 0;
+
+        /// Smoothed escape iteration per pixel in 8.8 fixed point, -1 inside the set.
+        std::vector<int32_t> smooth;
+
+        bool has_params = false;
+        JuliaSetParams computed{};
+        /// Bit per pass: computed for the current parameters
+        uint8_t fresh_passes = 0;
+        /// Bit per pass: computed at least once since resize(); before that a pass
+        /// shows the coarse value of its block
+        uint8_t filled_passes = 0;
+        int next_fine_pass = 1;
+        bool colors_valid = false;
+        float colored_shift = 0.0f;
+
+        /// Moving average of the time one pass takes, 0 until measured
+        double pass_ns = 0;
+
+        /// (pass, y) of every row computed in the current batch
+        std::vector<std::pair<int, int>> pass_rows;
+    };
+}
@@ -2,7 +2,9 @@
 
 #include "shared/matrix/Scene.h"
 #include "shared/matrix/plugin/main.h"
-#include <chrono>
+#include "shared/matrix/canvas_buffer.h"
+#include "shared/matrix/utils/FrameTimer.h"
+#include "JuliaSetEngine.h"
 #include <complex>
 
 namespace Scenes {
@@ -32,9 +34,11 @@ namespace Scenes {
         void register_properties() override;
 
     private:
-        std::chrono::steady_clock::time_point last_update;
+        FrameTimer timer;
         float total_time = 0.0f;
-        float animation_speed = 0.1f;
+
+        JuliaSetEngine engine;
+        CanvasBuffer frame;
         
         // Julia set parameters
         std::complex<float> c = {-0.7, 0.27};
@@ -45,8 +49,5 @@ namespace Scenes {
         PropertyPointer<int> max_iterations = MAKE_PROPERTY_MINMAX("max_iterations", int, 100, 10, 500);
         PropertyPointer<bool> animate_params = MAKE_PROPERTY("animate_params", bool, true);
         PropertyPointer<float> color_shift = MAKE_PROPERTY_MINMAX("color_shift", float, 0.0f, 0.0f, 1.0f);
-        
-        // Color mapping
-        void hsv_to_rgb(float h, float s, float v, uint8_t& r, uint8_t& g, uint8_t& b) const;
     };
 }
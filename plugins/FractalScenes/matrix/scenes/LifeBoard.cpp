@@ -0,0 +1,193 @@
+#include "LifeBoard.h"
+#include <algorithm>
+
+using namespace Scenes;
+
+void LifeBoard::resize(int width, int height) {
+    board_width = width;
+    board_height = height;
+    words_per_row = (width + 63) / 64;
+
+    const int used_bits = width - (words_per_row - 1) * 64;
+    last_word_mask = used_bits >= 64 ? ~uint64_t{0} : (uint64_t{1} << used_bits) - 1;
+
+    const size_t words = static_cast<size_t>(words_per_row) * height;
+    cells.assign(words, 0);
+    next_cells.assign(words, 0);
+    west_rows.assign(words, 0);
+    east_rows.assign(words, 0);
+    for (auto &plane: age_planes)
+        plane.assign(words, 0);
+}
+
+void LifeBoard::clear() {
+    std::fill(cells.begin(), cells.end(), 0);
+    for (auto &plane: age_planes)
+        std::fill(plane.begin(), plane.end(), 0);
+}
+
+void LifeBoard::randomize(float fill_probability, std::mt19937 &gen) {
+    clear();
+
+    std::uniform_real_distribution<> dis(0.0, 1.0);
+    for (int y = 0; y < board_height; ++y) {
+        for (int x = 0; x < board_width; ++x) {
+            if (dis(gen) < fill_probability)
+                cells[word_index(x, y)] |= uint64_t{1} << (x & 63);
+        }
+    }
+}
+
+void LifeBoard::set(int x, int y, bool alive) {
+    const uint64_t bit = uint64_t{1} << (x & 63);
+    if (alive)
+        cells[word_index(x, y)] |= bit;
+    else
+        cells[word_index(x, y)] &= ~bit;
+}
+
+int LifeBoard::age(int x, int y) const {
+    const size_t index = word_index(x, y);
+    const int shift = x & 63;
+
+    int result = 0;
+    for (int p = 0; p < age_bits; ++p)
+        result |= static_cast<int>((age_planes[p][index] >> shift) & 1) << p;
+    return result;
+}
+
+void LifeBoard::row_states(int y, uint8_t *out) const {
+    const size_t row = static_cast<size_t>(y) * words_per_row;
+    for (int w = 0; w < words_per_row; ++w) {
+        const int begin = w * 64;
+        const int count = std::min(64, board_width - begin);
+
+        uint64_t living = cells[row + w];
+        if (living == 0) {
+            std::fill_n(out + begin, count, 0);
+            continue;
+        }
+
+        std::array<uint64_t, age_bits> planes;
+        for (int p = 0; p < age_bits; ++p)
+            planes[p] = age_planes[p][row + w];
+
+        for (int b = 0; b < count; ++b) {
+            int age = 0;
+            for (int p = 0; p < age_bits; ++p) {
+                age |= static_cast<int>(planes[p] & 1) << p;
+                planes[p] >>= 1;
+            }
+
+            out[begin + b] = (living & 1) ? static_cast<uint8_t>(age + 1) : 0;
+            living >>= 1;
+        }
+    }
+}
+
+void LifeBoard::shift_row(const uint64_t *row, uint64_t *west, uint64_t *east) const {
+    const int last = words_per_row - 1;
+    const int last_bit = (board_width - 1) & 63;
+
+    // Cell x - 1 moves up one bit, the carry comes from the previous word (or wraps from the last cell)
+    west[0] = (row[0] << 1) | ((row[last] >> last_bit) & 1);
+    for (int k = 1; k <= last; ++k)
+        west[k] = (row[k] << 1) | (row[k - 1] >> 63);
+
+    // Cell x + 1 moves down one bit, the first cell wraps around to the last one
+    for (int k = 0; k < last; ++k)
+        east[k] = (row[k] >> 1) | (row[k + 1] << 63);
+    east[last] = ((row[last] >> 1) & (last_word_mask >> 1)) | ((row[0] & 1) << last_bit);
+}
+
+bool LifeBoard::step() {
+    if (cells.empty())
+        return false;
+
+    for (int y = 0; y < board_height; ++y) {
+        const size_t offset = static_cast<size_t>(y) * words_per_row;
+        shift_row(cells.data() + offset, west_rows.data() + offset, east_rows.data() + offset);
+    }
+
+    uint64_t changed = 0;
+    for (int y = 0; y < board_height; ++y) {
+        const size_t up = static_cast<size_t>((y + board_height - 1) % board_height) * words_per_row;
+        const size_t mid = static_cast<size_t>(y) * words_per_row;
+        const size_t down = static_cast<size_t>((y + 1) % board_height) * words_per_row;
+
+        for (int k = 0; k < words_per_row; ++k) {
+            const uint64_t a_w = west_rows[up + k], a = cells[up + k], a_e = east_rows[up + k];
+            const uint64_t b_w = west_rows[mid + k], b = cells[mid + k], b_e = east_rows[mid + k];
+            const uint64_t c_w = west_rows[down + k], c = cells[down + k], c_e = east_rows[down + k];
+
+            // Per row a two bit count (sum, carry) of its neighbours
+            const uint64_t sum_a = a_w ^ a ^ a_e;
+            const uint64_t carry_a = (a_w & a) | (a_e & (a_w ^ a));
+            const uint64_t sum_c = c_w ^ c ^ c_e;
+            const uint64_t carry_c = (c_w & c) | (c_e & (c_w ^ c));
+            const uint64_t sum_b = b_w ^ b_e;
+            const uint64_t carry_b = b_w & b_e;
+
+            // Ones digit of the total, its carry joins the three twos
+            const uint64_t ones = sum_a ^ sum_b ^ sum_c;
+            const uint64_t carry_ones = (sum_a & sum_b) | (sum_c & (sum_a ^ sum_b));
+
+            // 2 or 3 neighbours means exactly one of the four twos is set
+            const uint64_t any_pair = (carry_a & carry_c) | (carry_b & carry_ones);
+            const uint64_t one_two = (carry_a ^ carry_c ^ carry_b ^ carry_ones) & ~any_pair;
+
+            // 3 neighbours: born or survives, 2 neighbours: survives
+            uint64_t next = one_two & (ones | b);
+            if (k == words_per_row - 1)
+                next &= last_word_mask;
+
+            next_cells[mid + k] = next;
+            changed |= next ^ b;
+
+            // Survivors count their age up (saturating), everything else starts at 0
+            const uint64_t survived = next & b;
+            uint64_t full = ~uint64_t{0};
+            for (const auto &plane: age_planes)
+                full &= plane[mid + k];
+
+            uint64_t carry = survived & ~full;
+            for (auto &plane: age_planes) {
+                const uint64_t old = plane[mid + k];
+                plane[mid + k] = (old ^ carry) & survived;
+                carry &= old;
+            }
+        }
+    }
+
+    cells.swap(next_cells);
+    return changed != 0;
+}
+
+uint64_t LifeBoard::hash() const {
+    uint64_t h = 0x9E3779B97F4A7C15ull ^ cells.size();
+    for (const uint64_t word: cells) {
+        h = (h ^ word) * 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 31;
+    }
+    return h;
+}
+
+void LifeCycleDetector::reset() {
+    count = 0;
+    next = 0;
+}
+
+int LifeCycleDetector::observe(uint64_t hash) {
+    int period = 0;
+    for (int back = 1; back <= count; ++back) {
+        if (hashes[(next - back + history) % history] == hash) {
+            period = back;
+            break;
+        }
+    }
+
+    hashes[next] = hash;
+    next = (next + 1) % history;
+    count = std::min(count + 1, history);
+    return period;
+}
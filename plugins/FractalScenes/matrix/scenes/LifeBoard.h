@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace Scenes {
+    /// Bit-packed, wrapping Game of Life board: 64 cells per word, and a whole word of
+    /// cells is advanced at once by adding up the eight neighbour words with full adders.
+    /// Cell ages are bit-sliced as well (a saturating counter spread over age_bits
+    /// planes), so stepping never looks at single cells.
+    class LifeBoard {
+    public:
+        static constexpr int age_bits = 6;
+        static constexpr int max_age = (1 << age_bits) - 1;
+
+        /// Resizes and clears the board.
+        void resize(int width, int height);
+        void clear();
+
+        void randomize(float fill_probability, std::mt19937 &gen);
+        void set(int x, int y, bool alive);
+
+        [[nodiscard]] bool alive(int x, int y) const {
+            return (cells[word_index(x, y)] >> (x & 63)) & 1;
+        }
+
+        /// Generations the cell has survived, saturating at max_age.
+        [[nodiscard]] int age(int x, int y) const;
+
+        /// One row of cell states for drawing: 0 for dead cells, age + 1 for living ones.
+        /// Loads the cell and age words once per 64 cells instead of once per cell.
+        void row_states(int y, uint8_t *out) const;
+
+        /// Advances one generation, returns true if any cell changed.
+        bool step();
+
+        /// Hash of the living cells, equal boards hash equally.
+        [[nodiscard]] uint64_t hash() const;
+
+        [[nodiscard]] int width() const { return board_width; }
+        [[nodiscard]] int height() const { return board_height; }
+
+    private:
+        [[nodiscard]] size_t word_index(int x, int y) const {
+            return static_cast<size_t>(y) * words_per_row + (x >> 6);
+        }
+
+        /// Row shifted so that every bit holds its west (x - 1) or east (x + 1) neighbour, wrapping around.
+        void shift_row(const uint64_t *row, uint64_t *west, uint64_t *east) const;
+
+        int board_width = 0;
+        int board_height = 0;
+        int words_per_row = 0;
+        uint64_t last_word_mask = 0;
+
+        std::vector<uint64_t> cells;
+        std::vector<uint64_t> next_cells;
+        std::array<std::vector<uint64_t>, age_bits> age_planes;
+
+        // Shifted copies of the three rows around the one being stepped
+        std::vector<uint64_t> west_rows;
+        std::vector<uint64_t> east_rows;
+    };
+
+    /// Remembers the hashes of the last generations and tells when the board repeats
+    /// one of them, i.e. it turned into still lifes and oscillators.
+    class LifeCycleDetector {
+    public:
+        static constexpr int history = 64;
+
+        void reset();
+
+        /// Returns the period of the cycle the board is in, or 0.
+        int observe(uint64_t hash);
+
+    private:
+        std::array<uint64_t, history> hashes{};
+        int count = 0;
+        int next = 0;
+    };
+}
@@ -1,4 +1,5 @@
 #include "MazeGameScene.h"
+#include "shared/common/utils/clock.h"
 
 #ifdef ENABLE_EMULATOR
 #include "emulator.h"
@@ -55,7 +56,7 @@ namespace Scenes {
     }
 
     bool MazeGameScene::render(rgb_matrix::FrameCanvas *canvas) {
-        if(solving_complete && GetTimeInMillis() - finished_maze_at_ms > delay_solution_found * 1000) {
+        if(solving_complete && Clock::wall_millis() - finished_maze_at_ms > delay_solution_found * 1000) {
             return false;
         }
 
@@ -65,7 +66,7 @@ namespace Scenes {
         } else if (!solving_complete) {
             solving_complete = solve_step();
             if(solving_complete) {
-                finished_maze_at_ms = GetTimeInMillis();
+                finished_maze_at_ms = Clock::wall_millis();
             }
         }
 
@@ -0,0 +1,262 @@
+/**
+ * reaction_diffusion_bench: Gray-Scott cells updated per second by the GrayScott grid
+ * of ReactionDiffusionScene vs the previous scalar step (wrapping coordinates with %
+ * for every neighbour).
+ *
+ * Usage:
+ *   reaction_diffusion_bench [--sizes <WxH,...>] [--steps <n>] [--batch <n>] [--budget <ms>]
+ *
+ * Defaults:
+ *   --sizes   64x64,128x128,256x128
+ *   --steps   400
+ *   --batch   8  (steps per GrayScott::step() call, like the scene per frame)
+ *   --budget  5  (the scene's default step_budget_ms)
+ *
+ * The grid is measured on one thread and on the shared RenderPool (see "Render Pool"
+ * in the README, MATRIX_RENDER_THREADS changes the thread count). "steps/budget" is
+ * how many steps the pooled grid fits into the budget, which is what the scene runs
+ * per frame if max_steps_per_frame allows it. Before timing, both engines run the
+ * same seeded grid and "max diff" is the largest difference of V between them. It
+ * is not quite 0 because GrayScott flushes concentrations below 1e-15 to 0.
+ *
+ * The single-threaded grid steps all rows as one band, so agreement is checked for
+ * the pooled grid as well ("pool diff"), which is the band halo / step fusion path
+ * the scene runs on a multi-core Pi. If the shared pool has fewer than two workers,
+ * a pool with three unpinned workers stands in for it, so the path is compared on
+ * any machine.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "GrayScott.h"
+
+using GenerativeScenes::GrayScott;
+using GenerativeScenes::GrayScottParams;
+
+namespace
+{
+    struct Size
+    {
+        int width;
+        int height;
+    };
+
+    struct Args
+    {
+        std::vector<Size> sizes{{64, 64}, {128, 128}, {256, 128}};
+        int steps = 400;
+        int batch = 8;
+        double budget_ms = 5.0;
+    };
+
+    Args parse_args(int argc, char *argv[])
+    {
+        Args a;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--sizes" && i + 1 < argc)
+            {
+                a.sizes.clear();
+                std::stringstream ss(argv[++i]);
+                std::string token;
+                while (std::getline(ss, token, ','))
+                {
+                    Size size{};
+                    if (std::sscanf(token.c_str(), "%dx%d", &size.width, &size.height) == 2 && size.width > 0 &&
+                        size.height > 0)
+                        a.sizes.push_back(size);
+                }
+            }
+            else if (arg == "--steps" && i + 1 < argc)
+                a.steps = std::max(1, std::atoi(argv[++i]));
+            else if (arg == "--batch" && i + 1 < argc)
+                a.batch = std::max(1, std::atoi(argv[++i]));
+            else if (arg == "--budget" && i + 1 < argc)
+                a.budget_ms = std::max(0.1, std::atof(argv[++i]));
+        }
+        return a;
+    }
+
+    /// The simulation ReactionDiffusionScene had before GrayScott, on grids of any size.
+    class ReferenceGrid
+    {
+    public:
+        void resize(int width, int height)
+        {
+            W = width;
+            H = height;
+            u_cur.assign(static_cast<size_t>(W) * H, 1.0f);
+            v_cur.assign(u_cur.size(), 0.0f);
+            u_nxt = u_cur;
+            v_nxt = v_cur;
+        }
+
+        void seed(int cx, int cy, int radius)
+        {
+            for (int y = std::max(0, cy - radius); y <= std::min(H - 1, cy + radius); y++)
+            {
+                for (int x = std::max(0, cx - radius); x <= std::min(W - 1, cx + radius); x++)
+                {
+                    u_cur[y * W + x] = 0.0f;
+                    v_cur[y * W + x] = 1.0f;
+                }
+            }
+        }
+
+        void step(const GrayScottParams &params)
+        {
+            const float DU = params.du, DV = params.dv, DT = params.dt, F = params.feed, k = params.kill;
+
+            for (int y = 0; y < H; y++)
+            {
+                for (int x = 0; x < W; x++)
+                {
+                    const int xp = (x + 1) % W;
+                    const int xm = (x - 1 + W) % W;
+                    const int yp = (y + 1) % H;
+                    const int ym = (y - 1 + H) % H;
+
+                    const float u = u_cur[y * W + x];
+                    const float v = v_cur[y * W + x];
+
+                    const float lap_u = u_cur[y * W + xp] + u_cur[y * W + xm] + u_cur[yp * W + x] +
+                                        u_cur[ym * W + x] - 4.0f * u;
+                    const float lap_v = v_cur[y * W + xp] + v_cur[y * W + xm] + v_cur[yp * W + x] +
+                                        v_cur[ym * W + x] - 4.0f * v;
+
+                    const float uvv = u * v * v;
+
+                    u_nxt[y * W + x] = std::clamp(u + DT * (DU * lap_u - uvv + F * (1.0f - u)), 0.0f, 1.0f);
+                    v_nxt[y * W + x] = std::clamp(v + DT * (DV * lap_v + uvv - (F + k) * v), 0.0f, 1.0f);
+                }
+            }
+
+            std::swap(u_cur, u_nxt);
+            std::swap(v_cur, v_nxt);
+        }
+
+        [[nodiscard]] float v(int x, int y) const { return v_cur[y * W + x]; }
+
+    private:
+        int W = 0;
+        int H = 0;
+        std::vector<float> u_cur, v_cur, u_nxt, v_nxt;
+    };
+
+    /// Same seeds as the scene would scatter, from a fixed random sequence.
+    template <typename Grid>
+    void seed(Grid &grid, const Size &size)
+    {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> rx(0, size.width - 1);
+        std::uniform_int_distribution<int> ry(0, size.height - 1);
+        for (int s = 0; s < 12; s++)
+        {
+            const int cx = rx(rng);
+            const int cy = ry(rng);
+            grid.seed(cx, cy, 2);
+        }
+    }
+
+    /// Largest difference of V between the reference and a GrayScott on 'pool', after 200 steps from the same seeds.
+    float max_difference(const Size &size, const GrayScottParams &params, int batch, RenderPool &pool)
+    {
+        ReferenceGrid reference;
+        GrayScott grid(pool);
+        reference.resize(size.width, size.height);
+        grid.resize(size.width, size.height);
+        seed(reference, size);
+        seed(grid, size);
+        for (int i = 0; i < 200; i += batch)
+        {
+            for (int s = 0; s < batch; ++s)
+                reference.step(params);
+            grid.step(params, batch);
+        }
+
+        float max_diff = 0;
+        for (int y = 0; y < size.height; ++y)
+            for (int x = 0; x < size.width; ++x)
+                max_diff = std::max(max_diff, std::abs(reference.v(x, y) - grid.v(x, y)));
+        return max_diff;
+    }
+
+    /// Cells updated per second, over about 'steps' steps of a seeded grid. 'step' runs 'batch' of them.
+    template <typename Grid, typename Step>
+    double cells_per_second(Grid &grid, const Size &size, int steps, int batch, Step step)
+    {
+        grid.resize(size.width, size.height);
+        seed(grid, size);
+        step();
+
+        const int calls = std::max(1, steps / batch);
+        using clock = std::chrono::steady_clock;
+        const auto start = clock::now();
+        for (int i = 0; i < calls; ++i)
+            step();
+        const std::chrono::duration<double> elapsed = clock::now() - start;
+        return static_cast<double>(size.width) * size.height * calls * batch / elapsed.count();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const Args args = parse_args(argc, argv);
+    const GrayScottParams params; // The "spots" preset
+
+    RenderPool single(RenderPoolSettings{0, false});
+    RenderPool &pool = RenderPool::instance();
+    std::unique_ptr<RenderPool> stand_in;
+    if (pool.worker_count() < 2)
+        stand_in = std::make_unique<RenderPool>(RenderPoolSettings{3, false});
+    RenderPool &checked_pool = stand_in ? *stand_in : pool;
+
+    std::printf("Gray-Scott, %d steps per measurement in batches of %d, render pool with %d worker(s)\n",
+                args.steps, args.batch, pool.worker_count());
+    if (stand_in)
+        std::printf("pool diff checked with %d unpinned workers\n", checked_pool.worker_count());
+    std::printf("%-10s %16s %16s %16s %9s %9s %13s %10s %10s\n", "size", "reference Mc/s", "simd Mc/s", "pool Mc/s",
+                "simd x", "pool x", "steps/budget", "max diff", "pool diff");
+
+    for (const auto &size : args.sizes)
+    {
+        char label[32];
+        std::snprintf(label, sizeof(label), "%dx%d", size.width, size.height);
+
+        // Agreement first, from the same seeds
+        const float max_diff = max_difference(size, params, args.batch, single);
+        const float pool_diff = max_difference(size, params, args.batch, checked_pool);
+
+        ReferenceGrid reference;
+        GrayScott grid(single);
+
+        const double before = cells_per_second(reference, size, args.steps, args.batch, [&]
+        {
+            for (int s = 0; s < args.batch; ++s)
+                reference.step(params);
+        });
+        const double simd = cells_per_second(grid, size, args.steps, args.batch, [&] { grid.step(params, args.batch); });
+
+        GrayScott pooled(pool);
+        const double parallel =
+            cells_per_second(pooled, size, args.steps, args.batch, [&] { pooled.step(params, args.batch); });
+
+        const double cells = static_cast<double>(size.width) * size.height;
+        const double budget_steps = args.budget_ms * 1e-3 * parallel / cells;
+
+        std::printf("%-10s %16.1f %16.1f %16.1f %8.1fx %8.1fx %13.0f %10.2g %10.2g\n", label, before / 1e6,
+                    simd / 1e6, parallel / 1e6, simd / before, parallel / before, budget_steps, max_diff, pool_diff);
+    }
+
+    return 0;
+}
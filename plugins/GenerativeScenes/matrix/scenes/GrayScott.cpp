@@ -0,0 +1,144 @@
+#include "GrayScott.h"
+#include "shared/matrix/utils/FastMath.h"
+#include <algorithm>
+#include <utility>
+
+namespace GenerativeScenes {
+    namespace {
+        /// Floats of one band's rows: three rows of U and V for every step but the last
+        size_t ring_floats(int stride) {
+            return static_cast<size_t>(GrayScott::max_fused_steps - 1) * 3 * 2 * stride;
+        }
+    }
+
+    void GrayScott::resize(int width, int height) {
+        grid_width = width;
+        grid_height = height;
+        // Room for the ghost cells and for the last group of four running past the width
+        stride = first_column + (width + 3) / 4 * 4 + 4;
+
+        const size_t cells = static_cast<size_t>(stride) * height;
+        for (auto *grid: {&u_cur, &v_cur, &u_next, &v_next})
+            grid->assign(cells, 0.0f);
+
+        const int bands = (height + band_rows - 1) / band_rows;
+        band_rings.assign(ring_floats(stride) * bands, 0.0f);
+
+        clear();
+    }
+
+    void GrayScott::clear() {
+        std::fill(u_cur.begin(), u_cur.end(), 1.0f);
+        std::fill(v_cur.begin(), v_cur.end(), 0.0f);
+    }
+
+    void GrayScott::seed(int cx, int cy, int radius) {
+        for (int y = std::max(0, cy - radius); y <= std::min(grid_height - 1, cy + radius); y++) {
+            for (int x = std::max(0, cx - radius); x <= std::min(grid_width - 1, cx + radius); x++) {
+                u_cur[index(x, y)] = 0.0f;
+                v_cur[index(x, y)] = 1.0f;
+            }
+            wrap_row(y);
+        }
+    }
+
+    void GrayScott::wrap_row(int y) {
+        for (auto *grid: {&u_cur, &v_cur}) {
+            float *row = grid->data() + index(0, y);
+            row[-1] = row[grid_width - 1];
+            row[grid_width] = row[0];
+        }
+    }
+
+    void GrayScott::step(const GrayScottParams &params, int steps) {
+        if (grid_width == 0 || grid_height == 0)
+            return;
+
+        while (steps > 0) {
+            const int fused = std::min(steps, max_fused_steps);
+            pool.parallel_rows(grid_height, [&](int y_begin, int y_end) {
+                step_band(params, fused, y_begin, y_end);
+            }, band_rows);
+
+            std::swap(u_cur, u_next);
+            std::swap(v_cur, v_next);
+            steps -= fused;
+        }
+    }
+
+    void GrayScott::step_band(const GrayScottParams &params, int steps, int y_begin, int y_end) {
+        // With a single thread the pool hands over all rows at once, that is still band 0
+        float *ring = band_rings.data() + ring_floats(stride) * (y_begin / band_rows);
+
+        const auto ring_row = [&](int level, int plane, int y) {
+            const int slot = (y % 3 + 3) % 3;
+            return ring + static_cast<size_t>(((level - 1) * 3 + slot) * 2 + plane) * stride + first_column;
+        };
+
+        // Row 'y' after 'level' steps: the grid itself before the first step, a ring row after that
+        const auto input = [&](int level, int plane, int y) -> const float * {
+            if (level == 0) {
+                const int wrapped = (y % grid_height + grid_height) % grid_height;
+                return (plane == 0 ? u_cur : v_cur).data() + index(0, wrapped);
+            }
+            return ring_row(level, plane, y);
+        };
+
+        // After step 'level' the band needs steps - level rows beyond either edge for the
+        // steps still to come. Every new row of the grid lets each step go one row further,
+        // each step trailing the one before by a row.
+        for (int newest = y_begin - steps; newest < y_end + steps; newest++) {
+            for (int level = 1; level <= steps; level++) {
+                const int y = newest - level;
+                if (y < y_begin - (steps - level) || y >= y_end + (steps - level))
+                    continue;
+
+                const float *u[3] = {input(level - 1, 0, y - 1), input(level - 1, 0, y), input(level - 1, 0, y + 1)};
+                const float *v[3] = {input(level - 1, 1, y - 1), input(level - 1, 1, y), input(level - 1, 1, y + 1)};
+
+                if (level == steps)
+                    step_row(params, u, v, u_next.data() + index(0, y), v_next.data() + index(0, y));
+                else
+                    step_row(params, u, v, ring_row(level, 0, y), ring_row(level, 1, y));
+            }
+        }
+    }
+
+    void GrayScott::step_row(const GrayScottParams &params, const float *const u[3], const float *const v[3],
+                             float *u_out, float *v_out) const {
+        using FastMath::f32x4;
+
+        const f32x4 du = params.du, dv = params.dv, dt = params.dt;
+        const f32x4 feed = params.feed, feed_kill = params.feed + params.kill;
+        const f32x4 zero = 0.0f, one = 1.0f, four = 4.0f, tiny = 1e-15f;
+
+        // Same operations in the same order as one cell at a time, only four of them at once
+        for (int x = 0; x < grid_width; x += 4) {
+            const f32x4 uc = f32x4::load(u[1] + x);
+            const f32x4 vc = f32x4::load(v[1] + x);
+
+            const f32x4 lap_u = f32x4::load(u[1] + x + 1) + f32x4::load(u[1] + x - 1)
+                                + f32x4::load(u[2] + x) + f32x4::load(u[0] + x)
+                                - four * uc;
+            const f32x4 lap_v = f32x4::load(v[1] + x + 1) + f32x4::load(v[1] + x - 1)
+                                + f32x4::load(v[2] + x) + f32x4::load(v[0] + x)
+                                - four * vc;
+
+            const f32x4 uvv = uc * vc * vc;
+
+            const f32x4 u_new = FastMath::clamp(uc + dt * (du * lap_u - uvv + feed * (one - uc)), zero, one);
+            const f32x4 v_new = FastMath::clamp(vc + dt * (dv * lap_v + uvv - feed_kill * vc), zero, one);
+
+            // Away from the patterns V decays towards 0 and ends up in denormals after a few
+            // hundred steps, which are many times slower to compute with on x86
+            FastMath::select(u_new < tiny, zero, u_new).store(u_out + x);
+            FastMath::select(v_new < tiny, zero, v_new).store(v_out + x);
+        }
+
+        // The last group may have run into the right ghost cell, set both ghosts now
+        u_out[-1] = u_out[grid_width - 1];
+        u_out[grid_width] = u_out[0];
+        v_out[-1] = v_out[grid_width - 1];
+        v_out[grid_width] = v_out[0];
+    }
+}
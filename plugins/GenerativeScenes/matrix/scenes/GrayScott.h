@@ -0,0 +1,83 @@
+#pragma once
+
+#include "shared/matrix/utils/RenderPool.h"
+#include <cstddef>
+#include <vector>
+
+namespace GenerativeScenes {
+    struct GrayScottParams {
+        float feed = 0.035f;
+        float kill = 0.065f;
+        float du = 0.16f;
+        float dv = 0.08f;
+        float dt = 1.0f;
+    };
+
+    /// Wrapping Gray-Scott grid with concentrations U and V per cell.
+    ///
+    /// Every row has a ghost cell on either side holding a copy of the opposite edge,
+    /// so the stencil never wraps coordinates and runs four cells at a time.
+    ///
+    /// Steps are cache-blocked in time: the grid is cut into bands of rows, and each
+    /// band goes through up to max_fused_steps steps in one pass, keeping only three
+    /// rows per intermediate step (which stay in L1) and writing only the final rows
+    /// back. Bands read a few rows beyond their edges and compute those twice, in
+    /// exchange the whole grid crosses the cache once per pass instead of once per
+    /// step. Bands are spread over the render pool.
+    class GrayScott {
+    public:
+        static constexpr int max_fused_steps = 4;
+        static constexpr int band_rows = 16;
+
+        explicit GrayScott(RenderPool &pool = RenderPool::instance()) : pool(pool) {}
+
+        /// Resizes the grid and fills it with U = 1, V = 0.
+        void resize(int width, int height);
+        void clear();
+
+        /// Sets U = 0, V = 1 in the square of 'radius' around (cx, cy), cut off at the edges.
+        void seed(int cx, int cy, int radius);
+
+        void step(const GrayScottParams &params, int steps = 1);
+
+        [[nodiscard]] float u(int x, int y) const { return u_cur[index(x, y)]; }
+        [[nodiscard]] float v(int x, int y) const { return v_cur[index(x, y)]; }
+
+        /// The 'width' V values of row 'y'.
+        [[nodiscard]] const float *v_row(int y) const { return v_cur.data() + index(0, y); }
+
+        [[nodiscard]] int width() const { return grid_width; }
+        [[nodiscard]] int height() const { return grid_height; }
+
+    private:
+        /// Cells start at column 4, so every row of cells is 16 byte aligned. Columns 3
+        /// and 4 + width are the left and right ghost cells.
+        static constexpr int first_column = 4;
+
+        [[nodiscard]] size_t index(int x, int y) const {
+            return static_cast<size_t>(y) * stride + first_column + x;
+        }
+
+        /// Runs 'steps' steps on the rows [y_begin, y_end) from u_cur/v_cur into u_next/v_next.
+        void step_band(const GrayScottParams &params, int steps, int y_begin, int y_end);
+
+        /// One step of one row, from the rows above, at and below it. Sets the ghost cells of the output.
+        void step_row(const GrayScottParams &params, const float *const u[3], const float *const v[3],
+                      float *u_out, float *v_out) const;
+
+        /// Copies the edge cells of row 'y' of u_cur and v_cur into its ghost cells.
+        void wrap_row(int y);
+
+        RenderPool &pool;
+
+        int grid_width = 0;
+        int grid_height = 0;
+        int stride = 0;
+
+        std::vector<float> u_cur, v_cur;
+        std::vector<float> u_next, v_next;
+
+        /// Per band, three rows of U and V for every intermediate step
+        std::vector<float> band_rings;
+    };
+}
@@ -1,6 +1,7 @@
 #include "ReactionDiffusionScene.h"
 #include <cmath>
 #include <algorithm>
+#include <chrono>
 
 namespace GenerativeScenes {
 
@@ -10,12 +11,14 @@ namespace GenerativeScenes {
 
     void ReactionDiffusionScene::initialize(int width, int height) {
         Scene::initialize(width, height);
-        u_cur.fill(1.0f);
-        v_cur.fill(0.0f);
+        grid.resize(width, height);
         seed_random_patch();
         step_count = 0;
         current_preset = 0;
         global_hue = 0.0f;
+
+        steps_per_frame = max_steps_per_frame->get();
+        ns_per_step = 0;
     }
 
     void ReactionDiffusionScene::seed_random_patch() {
@@ -30,51 +33,29 @@ namespace GenerativeScenes {
         for (int s = 0; s < num_seeds; s++) {
             int cx = rx(rng);
             int cy = ry(rng);
-            for (int dy = -2; dy <= 2; dy++) {
-                for (int dx = -2; dx <= 2; dx++) {
-                    int x = cx + dx;
-                    int y = cy + dy;
-                    if (x >= 0 && x < W && y >= 0 && y < H) {
-                        u_cur[y * W + x] = 0.0f;
-                        v_cur[y * W + x] = 1.0f;
-                    }
-                }
-            }
+            grid.seed(cx, cy, 2);
         }
     }
 
-    void ReactionDiffusionScene::simulation_step(float F, float k) {
-        const int W = matrix_width;
-        const int H = matrix_height;
-
-        for (int y = 0; y < H; y++) {
-            for (int x = 0; x < W; x++) {
-                // Toroidal (wrap-around) boundary conditions
-                const int xp = (x + 1) % W;
-                const int xm = (x - 1 + W) % W;
-                const int yp = (y + 1) % H;
-                const int ym = (y - 1 + H) % H;
-
-                const float u = u_cur[y * W + x];
-                const float v = v_cur[y * W + x];
-
-                const float lap_u = u_cur[y * W + xp] + u_cur[y * W + xm]
-                                  + u_cur[yp * W + x] + u_cur[ym * W + x]
-                                  - 4.0f * u;
-
-                const float lap_v = v_cur[y * W + xp] + v_cur[y * W + xm]
-                                  + v_cur[yp * W + x] + v_cur[ym * W + x]
-                                  - 4.0f * v;
-
-                const float uvv = u * v * v;
-
-                u_nxt[y * W + x] = std::clamp(u + DT * (DU * lap_u - uvv + F * (1.0f - u)), 0.0f, 1.0f);
-                v_nxt[y * W + x] = std::clamp(v + DT * (DV * lap_v + uvv - (F + k) * v),   0.0f, 1.0f);
-            }
-        }
-
-        std::swap(u_cur, u_nxt);
-        std::swap(v_cur, v_nxt);
+    void ReactionDiffusionScene::simulate(const Preset &preset) {
+        GrayScottParams params;
+        params.feed = preset.F;
+        params.kill = preset.k;
+        params.du = DU;
+        params.dv = DV;
+        params.dt = DT;
+
+        const auto start = std::chrono::steady_clock::now();
+        grid.step(params, steps_per_frame);
+        const std::chrono::duration<double, std::nano> took = std::chrono::steady_clock::now() - start;
+        step_count += steps_per_frame;
+
+        // Fit the next frame's steps into the budget, from an average that a single slow frame does not throw off
+        const double measured = took.count() / steps_per_frame;
+        ns_per_step = ns_per_step == 0 ? measured : 0.8 * ns_per_step + 0.2 * measured;
+
+        const double fitting = step_budget_ms->get() * 1e6 / ns_per_step;
+        steps_per_frame = static_cast<int>(std::clamp(fitting, 1.0, static_cast<double>(max_steps_per_frame->get())));
     }
 
     // Maps V concentration + a slowly drifting hue offset to an RGB colour.
@@ -124,16 +105,12 @@ namespace GenerativeScenes {
     bool ReactionDiffusionScene::render(rgb_matrix::FrameCanvas *canvas) {
         const Preset &preset = PRESETS[current_preset];
 
-        for (int s = 0; s < SIM_STEPS_PER_FRAME; s++) {
-            simulation_step(preset.F, preset.k);
-        }
-        step_count += SIM_STEPS_PER_FRAME;
+        simulate(preset);
 
         // Cycle to the next preset and re-seed once enough steps have elapsed
         if (step_count >= STEPS_PER_PRESET) {
             current_preset = (current_preset + 1) % NUM_PRESETS;
-            u_cur.fill(1.0f);
-            v_cur.fill(0.0f);
+            grid.clear();
             seed_random_patch();
             step_count = 0;
         }
@@ -141,22 +118,27 @@ namespace GenerativeScenes {
         // Slowly rotate the colour palette
         global_hue = std::fmod(global_hue + 0.00025f, 1.0f);
 
-        const int W = matrix_width;
-        const int H = matrix_height;
-        for (int y = 0; y < H; y++) {
-            for (int x = 0; x < W; x++) {
-                const float v = v_cur[y * W + x];
-                auto [r, g, b] = palette(v, global_hue);
-                canvas->SetPixel(x, y, r, g, b);
-            }
+        for (int i = 0; i < PALETTE_SIZE; i++) {
+            auto [r, g, b] = palette(static_cast<float>(i) / (PALETTE_SIZE - 1), global_hue);
+            palette_lut[i] = rgb_matrix::Color(r, g, b);
+        }
+
+        frame.resize(matrix_width, matrix_height);
+        for (int y = 0; y < matrix_height; y++) {
+            const float *v = grid.v_row(y);
+            rgb_matrix::Color *row = frame.row(y);
+            for (int x = 0; x < matrix_width; x++)
+                row[x] = palette_lut[static_cast<int>(v[x] * (PALETTE_SIZE - 1) + 0.5f)];
         }
+        frame.write_to(canvas);
 
         wait_until_next_frame();
         return true;
     }
 
     void ReactionDiffusionScene::register_properties() {
-        // The scene manages all state internally; nothing user-configurable.
+        add_property(step_budget_ms);
+        add_property(max_steps_per_frame);
     }
 
 } // namespace GenerativeScenes
@@ -2,8 +2,9 @@
 
 #include "shared/matrix/Scene.h"
 #include "shared/matrix/plugin/main.h"
+#include "shared/matrix/canvas_buffer.h"
+#include "GrayScott.h"
 #include <array>
-#include <vector>
 #include <random>
 
 namespace GenerativeScenes {
@@ -26,12 +27,8 @@ namespace GenerativeScenes {
         int get_default_weight() override { return 3; }
 
     private:
-        // Simulation grid (double-buffered)
-        static constexpr int MAX_W = 128;
-        static constexpr int MAX_H = 128;
-
-        std::array<float, MAX_W * MAX_H> u_cur{}, v_cur{};
-        std::array<float, MAX_W * MAX_H> u_nxt{}, v_nxt{};
+        GrayScott grid;
+        CanvasBuffer frame;
 
         // Gray-Scott parameter preset
         struct Preset {
@@ -56,15 +53,25 @@ namespace GenerativeScenes {
         static constexpr float DU = 0.16f;
         static constexpr float DV = 0.08f;
         static constexpr float DT = 1.0f;
-        static constexpr int   SIM_STEPS_PER_FRAME = 8;
+
+        // Steps per frame follow the CPU time they take, within the budget and at most max_steps_per_frame
+        PropertyPointer<float> step_budget_ms = MAKE_PROPERTY_MINMAX("step_budget_ms", float, 5.0f, 0.5f, 30.0f);
+        PropertyPointer<int> max_steps_per_frame = MAKE_PROPERTY_MINMAX("max_steps_per_frame", int, 8, 1, 64);
+
+        int steps_per_frame = 1;
+        double ns_per_step = 0; // Running average, 0 until the first frame was measured
 
         // Visual
         float global_hue = 0.0f;
 
+        // Colors for V = i / (PALETTE_SIZE - 1), refilled every frame as the hue drifts
+        static constexpr int PALETTE_SIZE = 1024;
+        std::array<rgb_matrix::Color, PALETTE_SIZE> palette_lut;
+
         std::mt19937 rng;
 
         void seed_random_patch();
-        void simulation_step(float F, float k);
+        void simulate(const Preset &preset);
         static std::tuple<uint8_t, uint8_t, uint8_t> palette(float v, float hue_shift);
     };
 
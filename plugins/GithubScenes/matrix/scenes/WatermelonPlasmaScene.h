@@ -3,12 +3,14 @@
 #include "shared/matrix/Scene.h"
 #include "shared/matrix/wrappers.h"
 #include "shared/matrix/utils/FrameTimer.h"
+#include "shared/matrix/canvas_buffer.h"
 
 using Scenes::Scene;
 namespace Scenes {
     class WatermelonPlasmaScene : public Scene {
     private:
         FrameTimer frameTimer;
+        CanvasBuffer frame;
     public:
         ~WatermelonPlasmaScene() override = default;
         bool render(rgb_matrix::FrameCanvas *canvas) override;
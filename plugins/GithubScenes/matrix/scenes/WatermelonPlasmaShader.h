@@ -0,0 +1,51 @@
+#pragma once
+
+#include "shared/matrix/utils/PixelShader.h"
+#include <cmath>
+
+namespace Scenes {
+    /// Per-pixel part of WatermelonPlasmaScene, everything that only depends on the time is computed once per frame.
+    struct WatermelonPlasmaShader {
+        float t;
+
+        // xp = x * xp_scale + xp_offset, same for y
+        float p_scale, xp_offset, yp_offset;
+        float swirl_x, swirl_y;
+        float ring1_x, ring1_y, ring2_x, ring2_y;
+
+        explicit WatermelonPlasmaShader(float time) : t(time) {
+            const float zoom = 5.0f + std::sin(t * 0.25);
+            p_scale = zoom / 128.0f;
+            xp_offset = -0.5f * zoom + std::sin(t * 0.25) * 5.0f;
+            yp_offset = -0.5f * zoom + std::cos(t * 0.25) * 5.0f;
+
+            swirl_x = std::sin(0.25 * t);
+            swirl_y = std::cos(0.29 * t);
+            ring1_x = std::sin(t * 0.25f) * 4.0f;
+            ring1_y = std::cos(t * 0.43f) * 4.0f;
+            ring2_x = std::cos(t * 0.36f) * 6.0f;
+            ring2_y = std::sin(t * 0.39f) * 5.3f;
+        }
+
+        PixelShader::Color4 operator()(FastMath::f32x4 x, FastMath::f32x4 y) const {
+            using namespace FastMath;
+
+            const f32x4 xp = x * p_scale + xp_offset;
+            const f32x4 yp = y * p_scale + yp_offset;
+
+            const f32x4 r1x = xp + ring1_x, r1y = yp + ring1_y;
+            const f32x4 r2x = xp + ring2_x, r2y = yp + ring2_y;
+
+            const f32x4 pixel = sin(sin(xp * swirl_x + yp * swirl_y + t) +
+                                    sin(sqrt(r1x * r1x + r1y * r1y) + t) -
+                                    cos(sqrt(r2x * r2x + r2y * r2y) + t));
+
+            f32x4 u = cos(pixel * 9.0f + xp * 0.5f + t) * 0.5f + 0.5f;
+            f32x4 v = sin(pixel * 9.0f + yp * 0.5f + t) * 0.5f + 0.5f;
+            u *= u;
+            v *= v;
+
+            return {u, v, (u + v) * 0.5f};
+        }
+    };
+}
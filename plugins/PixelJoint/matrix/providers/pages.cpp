@@ -47,6 +47,29 @@ ImageProviders::Pages::get_next_image() {
     }
 }
 
+std::expected<std::optional<ImageProviders::PendingPost>, string> ImageProviders::Pages::get_next_pending() {
+    while (curr_posts.empty() && !total_pages.empty()) {
+        int page = total_pages.front();
+        total_pages.erase(total_pages.begin());
+        curr_posts = pixeljoint::ScrapedPost::get_posts(page);
+    }
+
+    if (curr_posts.empty()) {
+        return std::nullopt;
+    }
+
+    std::shared_ptr<pixeljoint::ScrapedPost> post = std::move(curr_posts.front());
+    curr_posts.erase(curr_posts.begin());
+
+    return PendingPost([post]() -> std::expected<PostVariant, string> {
+        auto link = post->fetch_link();
+        if (!link)
+            return std::unexpected(link.error());
+
+        return PostVariant(std::shared_ptr<Post>(std::move(link.value())));
+    });
+}
+
 ImageProviders::Pages::Pages() : General(), pages_end(-1) {
 }
 
@@ -20,6 +20,9 @@ namespace ImageProviders {
         std::expected<std::optional<std::variant<std::unique_ptr<Post, void(*)(Post *)>, std::shared_ptr<Post>>>, string>
         get_next_image() override;
 
+        /// Scrapes result pages here, but leaves fetching the post page to the prefetcher.
+        std::expected<std::optional<PendingPost>, string> get_next_pending() override;
+
         [[nodiscard]] string get_name() const override;
 
         explicit Pages();
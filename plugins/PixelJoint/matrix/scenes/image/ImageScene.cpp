@@ -3,10 +3,10 @@
 #include "shared/matrix/utils/utils.h"
 #include "shared/matrix/utils/shared.h"
 #include "shared/matrix/utils/canvas_image.h"
+#include "shared/common/utils/clock.h"
 #include <vector>
 
 #include "Magick++.h"
-#include <future>
 #include "shared/matrix/plugin_loader/loader.h"
 
 using namespace std;
@@ -16,15 +16,18 @@ using rgb_matrix::StreamReader;
 
 
 bool ImageScene::DisplayAnimation(rgb_matrix::FrameCanvas *canvas) {
-    if (skip_image || GetTimeInMillis() > curr_animation->get()->end_time_ms) {
+    if (skip_image || Clock::wall_millis() > curr_animation->get()->end_time_ms) {
         this->curr_animation.reset();
         return true;
     }
 
+    auto *anim = curr_animation->get();
+    if (anim->cached)
+        return DisplayCachedAnimation(canvas);
+
     canvas->Clear();
 
-    auto *anim = curr_animation->get();
-    auto *reader = &anim->reader;
+    auto *reader = &anim->reader.value();
     uint32_t delay_us = 0;
 
     // Peek at the current frame to render it without consuming
@@ -39,12 +42,12 @@ bool ImageScene::DisplayAnimation(rgb_matrix::FrameCanvas *canvas) {
 
     // Record start time and delay on first peek after an advance (or at start)
     if (anim->frame_start_ms == 0) {
-        anim->frame_start_ms = GetTimeInMillis();
+        anim->frame_start_ms = Clock::wall_millis();
         anim->frame_delay_ms = delay_us / 1000;
     }
 
     // Consume the frame and advance once its hold time has elapsed
-    if (GetTimeInMillis() >= anim->frame_start_ms + anim->frame_delay_ms) {
+    if (Clock::wall_millis() >= anim->frame_start_ms + anim->frame_delay_ms) {
         reader->GetNext(canvas, &delay_us);
         anim->frame_start_ms = 0;
     }
@@ -52,6 +55,28 @@ bool ImageScene::DisplayAnimation(rgb_matrix::FrameCanvas *canvas) {
     return true;
 }
 
+bool ImageScene::DisplayCachedAnimation(rgb_matrix::FrameCanvas *canvas) {
+    auto *anim = curr_animation->get();
+    const auto &cached = *anim->cached;
+
+    // Every cached frame covers the whole canvas, no need to clear
+    cached.write_to(canvas, anim->cached_frame);
+    if (cached.frame_count() == 1)
+        return true;
+
+    if (anim->frame_start_ms == 0) {
+        anim->frame_start_ms = Clock::wall_millis();
+        anim->frame_delay_ms = cached.delay_us(anim->cached_frame) / 1000;
+    }
+
+    if (Clock::wall_millis() >= anim->frame_start_ms + anim->frame_delay_ms) {
+        anim->cached_frame = (anim->cached_frame + 1) % cached.frame_count();
+        anim->frame_start_ms = 0;
+    }
+
+    return true;
+}
+
 
 bool ImageScene::render(rgb_matrix::FrameCanvas *canvas) {
     if (!this->curr_animation.has_value()) {
@@ -69,7 +94,7 @@ bool ImageScene::render(rgb_matrix::FrameCanvas *canvas) {
     return DisplayAnimation(canvas);
 }
 
-Post *get_pointer_raw(std::variant<std::unique_ptr<Post, void (*)(Post *)>, std::shared_ptr<Post> > &post) {
+Post *get_pointer_raw(ImageProviders::PostVariant &post) {
     if (holds_alternative<std::unique_ptr<Post, void (*)(Post *)> >(post)) {
         return get<0>(post).get();
     }
@@ -89,20 +114,21 @@ ImageScene::get_next_anim(rgb_matrix::FrameCanvas *canvas, int recursiveness) {
         this->curr_category = 0;
     }
 
-    int width = matrix_width;
-    int height = matrix_height;
+    if (prefetchers.size() != providers.size())
+        prefetchers.resize(providers.size());
 
-
-    auto img_category = providers[this->curr_category];
-    if (!this->next_img.has_value() || !this->next_img->valid()) {
-        this->next_img = async(launch::async, get_next_image, img_category, width, height, std::ref(is_exiting));
+    auto &prefetcher = prefetchers[this->curr_category];
+    if (!prefetcher) {
+        prefetcher = std::make_unique<ImageProviders::Prefetcher>(providers[this->curr_category], matrix_width,
+                                                                  matrix_height, ImageProviders::PrefetchSettings::from_env(),
+                                                                  is_exiting);
     }
 
     tmillis_t start_loading = GetTimeInMillis();
 
-    optional<expected<optional<ImageInfo>, string> > info_res_opt = nullopt;
+    optional<expected<optional<ImageProviders::PreparedImage>, string> > info_res_opt = nullopt;
     try {
-        info_res_opt = std::move(next_img->get());
+        info_res_opt = prefetcher->next();
         if (!info_res_opt.value().has_value()) {
             warn("Could not get next image. Trying again. Error was: {}", info_res_opt.value().error());
             return get_next_anim(canvas, recursiveness + 1);
@@ -115,22 +141,38 @@ ImageScene::get_next_anim(rgb_matrix::FrameCanvas *canvas, int recursiveness) {
     auto info_res = std::move(info_res_opt.value());
     auto info_opt = std::move(info_res.value());
     if (!info_opt.has_value()) {
+        if (is_exiting)
+            return unexpected("Image scene is exiting");
+
         // No images left, new category
         spdlog::debug("Flushing category");
-        img_category->flush();
+        prefetcher->flush();
         this->curr_category++;
 
         debug("No images left. Flushing and moving onto next category.");
         return get_next_anim(canvas, recursiveness + 1);
     }
 
-    next_img = async(launch::async, get_next_image, img_category, width, height, std::ref(is_exiting));
-    auto [frames, post] = std::move(info_opt.value());
+    auto post = std::move(info_opt->post);
+    auto frames = std::move(info_opt->frames);
+    auto cached = std::move(info_opt->cached);
 
     auto raw_ptr = get_pointer_raw(post);
     auto filename = raw_ptr->get_filename();
     auto image_url = raw_ptr->get_image_url();
 
+    if (cached) {
+        info("Loaded {} ({}) from frame cache", filename, image_url);
+        info("Loading image took {}s.", (GetTimeInMillis() - start_loading) / 1000.0);
+
+        const tmillis_t end_time_ms = Clock::wall_millis() + image_display_duration->get();
+        return std::unique_ptr<CurrAnimation, void(*)(CurrAnimation *)>(
+            new CurrAnimation(std::move(cached), end_time_ms),
+            [](CurrAnimation *anim) {
+                delete anim;
+            });
+    }
+
     auto file = GetFileInfo(frames, canvas);
     info("Loaded p_info for {} ({})", filename, image_url);
 
@@ -138,7 +180,7 @@ ImageScene::get_next_anim(rgb_matrix::FrameCanvas *canvas, int recursiveness) {
     const tmillis_t duration_ms = file->params.duration_ms;
 
     StreamReader reader(file->content_stream);
-    const tmillis_t end_time_ms = GetTimeInMillis() + duration_ms;
+    const tmillis_t end_time_ms = Clock::wall_millis() + duration_ms;
 
     std::unique_ptr<CurrAnimation, void(*)(CurrAnimation *)> res(
         new CurrAnimation(reader, end_time_ms, std::move(file)),
@@ -150,40 +192,6 @@ ImageScene::get_next_anim(rgb_matrix::FrameCanvas *canvas, int recursiveness) {
 }
 
 
-expected<optional<ImageInfo>, string>
-ImageScene::get_next_image(const std::shared_ptr<ImageProviders::General> &category, const int width,
-                           const int height, const atomic<bool> &is_exiting) {
-    auto post_res = category->get_next_image();
-    if (!post_res.has_value()) {
-        return unexpected(post_res.error());
-    }
-
-    auto post_opt = std::move(post_res.value());
-    if (!post_opt.has_value()) {
-        return std::nullopt;
-    }
-
-    auto post = std::move(post_opt.value());
-    const auto raw_post = get_pointer_raw(post);
-    auto frames_opt = raw_post->process_images(width, height);
-
-    if (!frames_opt.has_value()) {
-        const auto image_url = raw_post->get_image_url();
-
-        return unexpected("Could not load image " + image_url);
-    }
-
-    if (is_exiting.load()) {
-        debug("Exiting image scene...");
-        return nullopt;
-    }
-
-    return ImageInfo{
-        .frames = std::move(frames_opt.value()),
-        .post = std::move(post)
-    };
-}
-
 std::unique_ptr<FileInfo, void(*)(FileInfo *)> ImageScene::GetFileInfo(const vector<Magick::Image> &frames,
                                                                        FrameCanvas *canvas) const {
     auto params = ImageParams();
@@ -218,9 +226,7 @@ std::unique_ptr<FileInfo, void(*)(FileInfo *)> ImageScene::GetFileInfo(const vec
 ImageScene::~ImageScene() {
     spdlog::info("Waiting for ImageScene to finish...");
     is_exiting = true;
-    if (next_img.has_value() && next_img.value().valid()) {
-        next_img.value().wait();
-    }
+    prefetchers.clear(); // Waits for prefetch stages that are still running
     curr_animation.reset();  // Ensure animation is cleaned up
 }
 
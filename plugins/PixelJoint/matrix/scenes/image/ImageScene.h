@@ -5,13 +5,14 @@
 #include "led-matrix.h"
 #include <optional>
 #include <utility>
-#include <future>
 #include "shared/matrix/config/MainConfig.h"
 #include "spdlog/spdlog.h"
 
 #include "shared/matrix/Scene.h"
 #include "shared/matrix/plugin/main.h"
 #include "shared/matrix/utils/utils.h"
+#include "shared/matrix/utils/FrameCache.h"
+#include "shared/matrix/config/image_providers/prefetch.h"
 #include "shared/matrix/config/data.h"
 
 
@@ -37,8 +38,12 @@ struct FileInfo {
 };
 
 struct CurrAnimation {
-    rgb_matrix::StreamReader reader;
+    /// Set when playing through the content stream, i.e. without the frame cache.
+    std::optional<rgb_matrix::StreamReader> reader;
     std::unique_ptr<FileInfo, void(*)(FileInfo *)> file;
+    /// Set when playing straight from the frame cache.
+    std::shared_ptr<const CachedAnimation> cached;
+    size_t cached_frame = 0;
     const tmillis_t end_time_ms;
     tmillis_t frame_start_ms = 0;
     tmillis_t frame_delay_ms = 0;
@@ -49,17 +54,16 @@ struct CurrAnimation {
                                                                         end_time_ms(end_time_ms) {
     }
 
+    CurrAnimation(std::shared_ptr<const CachedAnimation> cached, const tmillis_t end_time_ms)
+        : file(nullptr, [](FileInfo *info) { delete info; }), cached(std::move(cached)), end_time_ms(end_time_ms) {
+    }
+
     ~CurrAnimation() {
         spdlog::trace("Deleting animation");
         std::flush(std::cout);
     }
 };
 
-struct ImageInfo {
-    vector<Magick::Image> frames;
-    std::variant<std::unique_ptr<Post, void (*)(Post *)>, std::shared_ptr<Post> > post;
-};
-
 const std::string PROVIDER_DEFAULT = R"(
 [
 {
@@ -79,18 +83,17 @@ class ImageScene final : public Scenes::Scene {
     std::atomic<bool> is_exiting{false};
     std::atomic<bool> has_image{false};
 
-    optional<std::future<expected<optional<ImageInfo>, string> > > next_img;
+    /// One per provider, created when the provider is first shown
+    std::vector<std::unique_ptr<ImageProviders::Prefetcher> > prefetchers;
 
 
     bool DisplayAnimation(rgb_matrix::FrameCanvas *canvas);
 
+    bool DisplayCachedAnimation(rgb_matrix::FrameCanvas *canvas);
+
     expected<std::unique_ptr<CurrAnimation, void(*)(CurrAnimation *)>, string>
     get_next_anim(rgb_matrix::FrameCanvas *canvas, int recursiveness);
 
-    static expected<optional<ImageInfo>, string>
-    get_next_image(const std::shared_ptr<ImageProviders::General> &category, int width, int height,
-                   const atomic<bool> &is_exiting);
-
     std::unique_ptr<FileInfo, void(*)(FileInfo *)> GetFileInfo(const vector<Magick::Image> &frames,
                                                                FrameCanvas *canvas) const;
 
@@ -1,9 +1,5 @@
 #include "CanvasPacket.h"
 
-CanvasPacket::CanvasPacket(std::vector<uint8_t> rgbData)
-    : UdpPacket(0x02), data(std::move(rgbData)) {
-}
-
-std::vector<uint8_t> CanvasPacket::toData() const {
-    return data;
+CanvasPacket::CanvasPacket(std::vector<uint8_t> rgbData, uint16_t width, uint16_t height)
+    : FramePacket(0x02, std::move(rgbData), width, height) {
 }
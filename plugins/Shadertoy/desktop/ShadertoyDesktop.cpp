@@ -363,7 +363,7 @@ std::optional<std::unique_ptr<UdpPacket, void (*)(UdpPacket *)>> ShadertoyDeskto
 
     isActive = true;
     std::shared_lock lock(currDataMutex);
-    return std::unique_ptr<UdpPacket, void (*)(UdpPacket *)>(new CanvasPacket(currData),
+    return std::unique_ptr<UdpPacket, void (*)(UdpPacket *)>(new CanvasPacket(currData, width, height),
                                                              [](UdpPacket *packet)
                                                              {
                                                                  delete dynamic_cast<CanvasPacket *>(packet);
@@ -93,6 +93,14 @@ bool ShadertoyPlugin::on_udp_packet(const uint8_t pluginId, const uint8_t *packe
     if (pluginId != 0x02)
         return false; // Not destined for this plugin
 
+    if (FrameStream::is_fragment(packetData, size))
+    {
+        frames.receive(packetData, size);
+        if (frames.take_keyframe_request())
+            send_msg_to_desktop(FrameStream::keyframe_request_message);
+        return true;
+    }
+
     int neededPacketSize = Constants::height * Constants::width * 3; // 3 bytes per pixel (RGB)
     static int consecutiveErrors = 0;
     if (size < neededPacketSize)
@@ -104,8 +112,7 @@ bool ShadertoyPlugin::on_udp_packet(const uint8_t pluginId, const uint8_t *packe
     }
 
     consecutiveErrors = 0;
-    std::unique_lock lock(dataMutex);
-    data.assign(packetData, packetData + neededPacketSize);
+    frames.receive(packetData, neededPacketSize);
 
     return true;
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "shared/matrix/plugin/main.h"
+#include "shared/matrix/utils/FrameStreamReceiver.h"
 #include <mutex>
 #include <vector>
 #include <filesystem>
@@ -33,9 +34,9 @@ public:
     std::string add_custom_shader_scene(const std::filesystem::path &shader_file_path);
     std::string remove_custom_shader_scene(const std::filesystem::path &shader_file_path);
 
-    std::vector<uint8_t> get_data() {
-        std::lock_guard<std::mutex> lock(dataMutex);
-        return data;
+    /// Latest frame, read in place. Keep the view only while drawing it.
+    FrameTripleBuffer::FrameView get_data() {
+        return frames.read();
     }
 
     void set_last_sent_message(const std::string& message) {
@@ -46,8 +47,7 @@ public:
 private:
     std::mutex lastMsgMutex;
     std::string last_sent_message;
-    std::mutex dataMutex;
-    std::vector<uint8_t> data;
+    FrameStreamReceiver frames;
     std::mutex customSceneMutex;
     std::unordered_map<std::string, std::string> customSceneNamesByFile;
     std::thread watcher_thread_;
@@ -96,7 +96,7 @@ SpotifyMVDesktop::compute_next_packet(const std::string sceneName) {
     if (frame.empty())
         return std::nullopt;
     return std::unique_ptr<UdpPacket, void(*)(UdpPacket*)>(
-        new SpotifyMVPacket(std::move(frame)),
+        new SpotifyMVPacket(std::move(frame), kWidth, kHeight),
         [](UdpPacket* p) { delete static_cast<SpotifyMVPacket*>(p); });
 }
 
@@ -1,6 +1,4 @@
 #include "SpotifyMVPacket.h"
 
-SpotifyMVPacket::SpotifyMVPacket(std::vector<uint8_t> rgbData)
-    : UdpPacket(0x04), data(std::move(rgbData)) {}
-
-std::vector<uint8_t> SpotifyMVPacket::toData() const { return data; }
+SpotifyMVPacket::SpotifyMVPacket(std::vector<uint8_t> rgbData, uint16_t width, uint16_t height)
+    : FramePacket(0x04, std::move(rgbData), width, height) {}
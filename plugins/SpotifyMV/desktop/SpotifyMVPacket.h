@@ -1,10 +1,7 @@
 #pragma once
-#include <shared/common/udp/packet.h>
+#include <shared/common/udp/frame_stream.h>
 #include <vector>
 
-struct SpotifyMVPacket final : UdpPacket {
-  std::vector<uint8_t> data;
-
-  explicit SpotifyMVPacket(std::vector<uint8_t> rgbData);
-  std::vector<uint8_t> toData() const override;
+struct SpotifyMVPacket final : FramePacket {
+  SpotifyMVPacket(std::vector<uint8_t> rgbData, uint16_t width, uint16_t height);
 };
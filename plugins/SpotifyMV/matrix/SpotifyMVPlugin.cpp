@@ -25,9 +25,9 @@ SpotifyMVPlugin::create_image_providers() {
 
 bool SpotifyMVPlugin::on_udp_packet(uint8_t pluginId, const uint8_t* data, size_t size) {
   if (pluginId != 0x04) return false;
-  std::lock_guard<std::mutex> lock(frame_mutex_);
-  frame_.assign(data, data + size);
-  last_frame_time_ = std::chrono::steady_clock::now();
+  frames_.receive(data, size);
+  if (frames_.take_keyframe_request())
+    send_msg_to_desktop(FrameStream::keyframe_request_message);
   return true;
 }
 
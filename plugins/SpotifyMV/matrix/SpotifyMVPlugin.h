@@ -1,5 +1,6 @@
 #pragma once
 #include "shared/matrix/plugin/main.h"
+#include "shared/matrix/utils/FrameStreamReceiver.h"
 #include <chrono>
 #include <mutex>
 #include <string>
@@ -17,10 +18,8 @@ public:
   void on_websocket_message(const std::string& message) override;
   std::string get_plugin_name() const override { return PLUGIN_NAME; }
 
-  std::vector<uint8_t> get_frame() {
-    std::lock_guard<std::mutex> lock(frame_mutex_);
-    return frame_;
-  }
+  /// Latest frame, read in place. Keep the view only while drawing it.
+  FrameTripleBuffer::FrameView get_frame() { return frames_.read(); }
 
   std::string get_status() {
     std::lock_guard<std::mutex> lock(status_mutex_);
@@ -34,17 +33,14 @@ public:
     last_track_message_ = msg;
   }
 
-  [[nodiscard]] bool is_stale() {
-    std::lock_guard<std::mutex> lock(frame_mutex_);
-    return std::chrono::steady_clock::now() - last_frame_time_ > kStaleTimeout;
+  [[nodiscard]] bool is_stale() const {
+    return std::chrono::steady_clock::now() - frames_.last_write() > kStaleTimeout;
   }
 
   static constexpr auto kStaleTimeout = std::chrono::seconds(5);
 
 private:
-  std::mutex frame_mutex_;
-  std::vector<uint8_t> frame_;
-  std::chrono::steady_clock::time_point last_frame_time_{};
+  FrameStreamReceiver frames_;
 
   std::mutex status_mutex_;
   std::string status_ = "idle";
@@ -4,6 +4,7 @@
 #include "../manager/shared_spotify.h"
 #include "shared/matrix/utils/canvas_image.h"
 #include "shared/matrix/utils/image_fetch.h"
+#include "shared/common/utils/clock.h"
 #include "led-matrix.h"
 #include <cmath>
 #include <chrono>
@@ -132,12 +133,12 @@ bool CoverOnlyScene::DisplaySpotifySong(rgb_matrix::FrameCanvas *canvas)
             // Record start time and delay on first peek after an advance (or at start)
             if (anim_frame_start_ms == 0)
             {
-                anim_frame_start_ms = GetTimeInMillis();
+                anim_frame_start_ms = Clock::wall_millis();
                 anim_frame_delay_ms = delay_us / 1000;
             }
 
             // Consume the frame and advance once its hold time has elapsed
-            if (GetTimeInMillis() >= anim_frame_start_ms + anim_frame_delay_ms)
+            if (Clock::wall_millis() >= anim_frame_start_ms + anim_frame_delay_ms)
             {
                 curr_animation->GetNext(canvas, &delay_us);
                 anim_frame_start_ms = 0;
@@ -0,0 +1,390 @@
+#include "BlendKernels.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BLEND_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define BLEND_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+    // round(x / 255) for x in [0, 65025] without a division
+    inline uint8_t div255(uint32_t x)
+    {
+        x += 128;
+        return static_cast<uint8_t>((x + (x >> 8)) >> 8);
+    }
+
+    inline uint8_t blend_byte(uint8_t from, uint8_t to, uint32_t weight)
+    {
+        return div255(from * (255 - weight) + to * weight);
+    }
+
+    inline uint32_t ramp_weight(int16_t position, int16_t threshold)
+    {
+        return static_cast<uint32_t>(std::clamp(position - threshold, 0, 255));
+    }
+
+    // ─── Scalar ──────────────────────────────────────────────────────────────
+    void uniform_scalar(const uint8_t *from, const uint8_t *to, uint8_t *dst, size_t count, uint8_t weight)
+    {
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = blend_byte(from[i], to[i], weight);
+    }
+
+    void weighted_scalar(const uint8_t *from, const uint8_t *to, uint8_t *dst, const uint8_t *weights, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = blend_byte(from[i], to[i], weights[i]);
+    }
+
+    void ramp_scalar(const uint8_t *from, const uint8_t *to, uint8_t *dst, const int16_t *ramp, int16_t position,
+                     size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = blend_byte(from[i], to[i], ramp_weight(position, ramp[i]));
+    }
+
+#ifdef BLEND_KERNELS_X86
+    // ─── SSE2 (16 bytes per iteration) ───────────────────────────────────────
+    // from * (255 - w) + to * w fits in 16 bits, so everything stays in u16 lanes.
+    inline __m128i blend_u16_sse2(__m128i from, __m128i to, __m128i weight)
+    {
+        const __m128i v255 = _mm_set1_epi16(255);
+        const __m128i v128 = _mm_set1_epi16(128);
+
+        __m128i x = _mm_add_epi16(_mm_mullo_epi16(from, _mm_sub_epi16(v255, weight)),
+                                  _mm_mullo_epi16(to, weight));
+        x = _mm_add_epi16(x, v128);
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    }
+
+    inline __m128i blend_16_sse2(__m128i from, __m128i to, __m128i weight_lo, __m128i weight_hi)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i lo = blend_u16_sse2(_mm_unpacklo_epi8(from, zero), _mm_unpacklo_epi8(to, zero), weight_lo);
+        const __m128i hi = blend_u16_sse2(_mm_unpackhi_epi8(from, zero), _mm_unpackhi_epi8(to, zero), weight_hi);
+        return _mm_packus_epi16(lo, hi);
+    }
+
+    void uniform_sse2(const uint8_t *from, const uint8_t *to, uint8_t *dst, size_t count, uint8_t weight)
+    {
+        const __m128i w = _mm_set1_epi16(weight);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m128i f = _mm_loadu_si128(reinterpret_cast<const __m128i *>(from + i));
+            const __m128i t = _mm_loadu_si128(reinterpret_cast<const __m128i *>(to + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), blend_16_sse2(f, t, w, w));
+        }
+        uniform_scalar(from + i, to + i, dst + i, count - i, weight);
+    }
+
+    void weighted_sse2(const uint8_t *from, const uint8_t *to, uint8_t *dst, const uint8_t *weights, size_t count)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m128i f = _mm_loadu_si128(reinterpret_cast<const __m128i *>(from + i));
+            const __m128i t = _mm_loadu_si128(reinterpret_cast<const __m128i *>(to + i));
+            const __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i *>(weights + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                             blend_16_sse2(f, t, _mm_unpacklo_epi8(w, zero), _mm_unpackhi_epi8(w, zero)));
+        }
+        weighted_scalar(from + i, to + i, dst + i, weights + i, count - i);
+    }
+
+    void ramp_sse2(const uint8_t *from, const uint8_t *to, uint8_t *dst, const int16_t *ramp, int16_t position,
+                   size_t count)
+    {
+        const __m128i pos = _mm_set1_epi16(position);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i v255 = _mm_set1_epi16(255);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m128i f = _mm_loadu_si128(reinterpret_cast<const __m128i *>(from + i));
+            const __m128i t = _mm_loadu_si128(reinterpret_cast<const __m128i *>(to + i));
+            const __m128i r_lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ramp + i));
+            const __m128i r_hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ramp + i + 8));
+            const __m128i w_lo = _mm_min_epi16(_mm_max_epi16(_mm_subs_epi16(pos, r_lo), zero), v255);
+            const __m128i w_hi = _mm_min_epi16(_mm_max_epi16(_mm_subs_epi16(pos, r_hi), zero), v255);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), blend_16_sse2(f, t, w_lo, w_hi));
+        }
+        ramp_scalar(from + i, to + i, dst + i, ramp + i, position, count - i);
+    }
+
+    // ─── AVX2 (32 bytes per iteration) ───────────────────────────────────────
+    // Compiled with a function-level target so the plugin still runs on CPUs without AVX2.
+    __attribute__((target("avx2"))) inline __m256i blend_u16_avx2(__m256i from, __m256i to, __m256i weight)
+    {
+        const __m256i v255 = _mm256_set1_epi16(255);
+        const __m256i v128 = _mm256_set1_epi16(128);
+
+        __m256i x = _mm256_add_epi16(_mm256_mullo_epi16(from, _mm256_sub_epi16(v255, weight)),
+                                     _mm256_mullo_epi16(to, weight));
+        x = _mm256_add_epi16(x, v128);
+        return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+    }
+
+    // Widens 2x16 bytes, blends and packs back. packus works per 128-bit lane, hence the permute.
+    __attribute__((target("avx2"))) inline void blend_32_avx2(const uint8_t *from, const uint8_t *to, uint8_t *dst,
+                                                              __m256i weight_lo, __m256i weight_hi)
+    {
+        const __m256i f_lo = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(from)));
+        const __m256i f_hi = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(from + 16)));
+        const __m256i t_lo = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(to)));
+        const __m256i t_hi = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(to + 16)));
+
+        const __m256i packed = _mm256_packus_epi16(blend_u16_avx2(f_lo, t_lo, weight_lo),
+                                                   blend_u16_avx2(f_hi, t_hi, weight_hi));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+
+    __attribute__((target("avx2"))) void uniform_avx2(const uint8_t *from, const uint8_t *to, uint8_t *dst,
+                                                      size_t count, uint8_t weight)
+    {
+        const __m256i w = _mm256_set1_epi16(weight);
+        size_t i = 0;
+        for (; i + 32 <= count; i += 32)
+            blend_32_avx2(from + i, to + i, dst + i, w, w);
+
+        uniform_sse2(from + i, to + i, dst + i, count - i, weight);
+    }
+
+    __attribute__((target("avx2"))) void weighted_avx2(const uint8_t *from, const uint8_t *to, uint8_t *dst,
+                                                       const uint8_t *weights, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 32 <= count; i += 32)
+        {
+            const __m256i w_lo = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(weights + i)));
+            const __m256i w_hi = _mm256_cvtepu8_epi16(
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(weights + i + 16)));
+            blend_32_avx2(from + i, to + i, dst + i, w_lo, w_hi);
+        }
+
+        weighted_sse2(from + i, to + i, dst + i, weights + i, count - i);
+    }
+
+    __attribute__((target("avx2"))) void ramp_avx2(const uint8_t *from, const uint8_t *to, uint8_t *dst,
+                                                   const int16_t *ramp, int16_t position, size_t count)
+    {
+        const __m256i pos = _mm256_set1_epi16(position);
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i v255 = _mm256_set1_epi16(255);
+        size_t i = 0;
+        for (; i + 32 <= count; i += 32)
+        {
+            const __m256i r_lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ramp + i));
+            const __m256i r_hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ramp + i + 16));
+            const __m256i w_lo = _mm256_min_epi16(_mm256_max_epi16(_mm256_subs_epi16(pos, r_lo), zero), v255);
+            const __m256i w_hi = _mm256_min_epi16(_mm256_max_epi16(_mm256_subs_epi16(pos, r_hi), zero), v255);
+            blend_32_avx2(from + i, to + i, dst + i, w_lo, w_hi);
+        }
+
+        ramp_sse2(from + i, to + i, dst + i, ramp + i, position, count - i);
+    }
+#endif
+
+#ifdef BLEND_KERNELS_NEON
+    // ─── NEON (16 bytes per iteration) ───────────────────────────────────────
+    inline uint8x8_t blend_u16_neon(uint8x8_t from, uint8x8_t to, uint16x8_t weight)
+    {
+        const uint16x8_t inv = vsubq_u16(vdupq_n_u16(255), weight);
+        uint16x8_t x = vmulq_u16(vmovl_u8(from), inv);
+        x = vmlaq_u16(x, vmovl_u8(to), weight);
+        x = vaddq_u16(x, vdupq_n_u16(128));
+        // (x + (x >> 8)) >> 8, narrowed to u8
+        return vshrn_n_u16(vsraq_n_u16(x, x, 8), 8);
+    }
+
+    inline void blend_16_neon(const uint8_t *from, const uint8_t *to, uint8_t *dst,
+                              uint16x8_t weight_lo, uint16x8_t weight_hi)
+    {
+        const uint8x16_t f = vld1q_u8(from);
+        const uint8x16_t t = vld1q_u8(to);
+        vst1q_u8(dst, vcombine_u8(blend_u16_neon(vget_low_u8(f), vget_low_u8(t), weight_lo),
+                                  blend_u16_neon(vget_high_u8(f), vget_high_u8(t), weight_hi)));
+    }
+
+    void uniform_neon(const uint8_t *from, const uint8_t *to, uint8_t *dst, size_t count, uint8_t weight)
+    {
+        const uint16x8_t w = vdupq_n_u16(weight);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+            blend_16_neon(from + i, to + i, dst + i, w, w);
+
+        uniform_scalar(from + i, to + i, dst + i, count - i, weight);
+    }
+
+    void weighted_neon(const uint8_t *from, const uint8_t *to, uint8_t *dst, const uint8_t *weights, size_t count)
+    {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            const uint8x16_t w = vld1q_u8(weights + i);
+            blend_16_neon(from + i, to + i, dst + i, vmovl_u8(vget_low_u8(w)), vmovl_u8(vget_high_u8(w)));
+        }
+
+        weighted_scalar(from + i, to + i, dst + i, weights + i, count - i);
+    }
+
+    void ramp_neon(const uint8_t *from, const uint8_t *to, uint8_t *dst, const int16_t *ramp, int16_t position,
+                   size_t count)
+    {
+        const int16x8_t pos = vdupq_n_s16(position);
+        const int16x8_t zero = vdupq_n_s16(0);
+        const int16x8_t v255 = vdupq_n_s16(255);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            const int16x8_t w_lo = vminq_s16(vmaxq_s16(vqsubq_s16(pos, vld1q_s16(ramp + i)), zero), v255);
+            const int16x8_t w_hi = vminq_s16(vmaxq_s16(vqsubq_s16(pos, vld1q_s16(ramp + i + 8)), zero), v255);
+            blend_16_neon(from + i, to + i, dst + i, vreinterpretq_u16_s16(w_lo), vreinterpretq_u16_s16(w_hi));
+        }
+
+        ramp_scalar(from + i, to + i, dst + i, ramp + i, position, count - i);
+    }
+#endif
+
+    struct KernelTable
+    {
+        BlendKernels::Backend backend;
+        void (*uniform)(const uint8_t *, const uint8_t *, uint8_t *, size_t, uint8_t);
+        void (*weighted)(const uint8_t *, const uint8_t *, uint8_t *, const uint8_t *, size_t);
+        void (*ramp)(const uint8_t *, const uint8_t *, uint8_t *, const int16_t *, int16_t, size_t);
+    };
+
+    KernelTable table_for(BlendKernels::Backend backend)
+    {
+        using BlendKernels::Backend;
+        switch (backend)
+        {
+#ifdef BLEND_KERNELS_X86
+        case Backend::SSE2:
+            return {Backend::SSE2, uniform_sse2, weighted_sse2, ramp_sse2};
+        case Backend::AVX2:
+            return {Backend::AVX2, uniform_avx2, weighted_avx2, ramp_avx2};
+#endif
+#ifdef BLEND_KERNELS_NEON
+        case Backend::NEON:
+            return {Backend::NEON, uniform_neon, weighted_neon, ramp_neon};
+#endif
+        default:
+            return {Backend::Scalar, uniform_scalar, weighted_scalar, ramp_scalar};
+        }
+    }
+
+    KernelTable &active_table()
+    {
+        static KernelTable table = table_for(BlendKernels::best_backend());
+        return table;
+    }
+}
+
+namespace BlendKernels
+{
+    const char *backend_name(Backend backend)
+    {
+        switch (backend)
+        {
+        case Backend::SSE2:
+            return "sse2";
+        case Backend::AVX2:
+            return "avx2";
+        case Backend::NEON:
+            return "neon";
+        default:
+            return "scalar";
+        }
+    }
+
+    bool is_supported(Backend backend)
+    {
+        switch (backend)
+        {
+        case Backend::Scalar:
+            return true;
+#ifdef BLEND_KERNELS_X86
+        case Backend::SSE2:
+            return __builtin_cpu_supports("sse2");
+        case Backend::AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+#ifdef BLEND_KERNELS_NEON
+        case Backend::NEON:
+            return true;
+#endif
+        default:
+            return false;
+        }
+    }
+
+    Backend best_backend()
+    {
+        for (const auto backend : {Backend::AVX2, Backend::NEON, Backend::SSE2})
+        {
+            if (is_supported(backend))
+                return backend;
+        }
+
+        return Backend::Scalar;
+    }
+
+    Backend active_backend()
+    {
+        return active_table().backend;
+    }
+
+    bool set_backend(Backend backend)
+    {
+        if (!is_supported(backend))
+            return false;
+
+        active_table() = table_for(backend);
+        return true;
+    }
+
+    void blend_uniform(const uint8_t *from, const uint8_t *to, uint8_t *dst, size_t count, uint8_t weight)
+    {
+        if (weight == 0)
+        {
+            std::copy_n(from, count, dst);
+            return;
+        }
+
+        if (weight == 255)
+        {
+            std::copy_n(to, count, dst);
+            return;
+        }
+
+        active_table().uniform(from, to, dst, count, weight);
+    }
+
+    void blend_weighted(const uint8_t *from, const uint8_t *to, uint8_t *dst, const uint8_t *weights, size_t count)
+    {
+        active_table().weighted(from, to, dst, weights, count);
+    }
+
+    void blend_ramp(const uint8_t *from, const uint8_t *to, uint8_t *dst, const int16_t *ramp, int16_t position,
+                    size_t count)
+    {
+        active_table().ramp(from, to, dst, ramp, position, count);
+    }
+
+    int16_t AlphaRamp::to_fixed(float value) const
+    {
+        // Leave headroom so position() + 128 and the saturating subtract never wrap
+        const float fixed = std::round(value * ramp_scale * 255.0f);
+        return static_cast<int16_t>(std::clamp(fixed, -32000.0f, 32000.0f));
+    }
+}
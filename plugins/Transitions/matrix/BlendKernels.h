@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Fixed-point RGB blend kernels used by the transitions.
+/// All kernels work on interleaved 8-bit channel data (a CanvasBuffer viewed as
+/// bytes) and compute out = round((from * (255 - w) + to * w) / 255) per byte.
+/// The fastest backend supported by the CPU is picked once at startup
+/// (NEON on ARM, AVX2 or SSE2 on x86) with a scalar fallback everywhere else.
+namespace BlendKernels
+{
+    enum class Backend
+    {
+        Scalar,
+        SSE2,
+        AVX2,
+        NEON
+    };
+
+    [[nodiscard]] const char *backend_name(Backend backend);
+
+    [[nodiscard]] bool is_supported(Backend backend);
+
+    [[nodiscard]] Backend best_backend();
+
+    [[nodiscard]] Backend active_backend();
+
+    /// Switches all kernels to 'backend'. Returns false (and keeps the current
+    /// backend) if the CPU does not support it. Mainly used by the benchmark.
+    bool set_backend(Backend backend);
+
+    /// Same weight for every byte, 'weight' in [0, 255].
+    void blend_uniform(const uint8_t *from, const uint8_t *to, uint8_t *dst, size_t count, uint8_t weight);
+
+    /// One weight per byte, each in [0, 255].
+    void blend_weighted(const uint8_t *from, const uint8_t *to, uint8_t *dst, const uint8_t *weights, size_t count);
+
+    /// Weight per byte is clamp(position - ramp[i], 0, 255), see AlphaRamp.
+    void blend_ramp(const uint8_t *from, const uint8_t *to, uint8_t *dst, const int16_t *ramp, int16_t position,
+                    size_t count);
+
+    /// Precomputed per-pixel mask for transitions of the form
+    /// local_alpha = clamp((alpha - threshold(x, y)) * scale + 0.5, 0, 1).
+    /// Thresholds are stored per channel byte in fixed point so a frame only
+    /// needs position(alpha) and one blend_ramp call.
+    class AlphaRamp
+    {
+        std::vector<int16_t> thresholds;
+        int ramp_width = 0;
+        int ramp_height = 0;
+        float ramp_scale = 1.0f;
+
+    public:
+        /// Returns true if the ramp has to be rebuilt for this size.
+        [[nodiscard]] bool needs_rebuild(int width, int height) const
+        {
+            return width != ramp_width || height != ramp_height;
+        }
+
+        /// Recomputes the ramp. 'threshold_fn(x, y)' returns the pixel's threshold in alpha units.
+        template <typename ThresholdFn>
+        void build(int width, int height, float scale, ThresholdFn &&threshold_fn)
+        {
+            ramp_width = width;
+            ramp_height = height;
+            ramp_scale = scale;
+            thresholds.resize(static_cast<size_t>(width) * height * 3);
+
+            int16_t *out = thresholds.data();
+            for (int y = 0; y < height; ++y)
+            {
+                for (int x = 0; x < width; ++x)
+                {
+                    const auto value = to_fixed(static_cast<float>(threshold_fn(x, y)));
+                    *out++ = value;
+                    *out++ = value;
+                    *out++ = value;
+                }
+            }
+        }
+
+        /// Fixed-point position for the current progress.
+        [[nodiscard]] int16_t position(float alpha) const
+        {
+            return static_cast<int16_t>(to_fixed(alpha) + 128);
+        }
+
+        [[nodiscard]] const int16_t *data() const { return thresholds.data(); }
+        [[nodiscard]] size_t size() const { return thresholds.size(); }
+
+    private:
+        [[nodiscard]] int16_t to_fixed(float value) const;
+    };
+}
@@ -3,10 +3,36 @@
 #include <algorithm>
 #include <cmath>
 
+using rgb_matrix::Color;
+
 // ─── Helper ───────────────────────────────────────────────────────────────────
-static inline uint8_t lerp_u8(uint8_t a, uint8_t b, float t)
+static_assert(sizeof(Color) == 3, "CanvasBuffer must be tightly packed RGB888");
+
+static inline const uint8_t *bytes(const CanvasBuffer &buffer)
+{
+    return reinterpret_cast<const uint8_t *>(buffer.data());
+}
+
+static inline uint8_t *bytes(CanvasBuffer &buffer)
 {
-    return static_cast<uint8_t>(std::round(a + (b - a) * t));
+    return reinterpret_cast<uint8_t *>(buffer.data());
+}
+
+static inline size_t byte_count(const CanvasBuffer &buffer)
+{
+    return buffer.size() * 3;
+}
+
+static inline uint8_t alpha_to_weight(float alpha)
+{
+    return static_cast<uint8_t>(std::lround(std::clamp(alpha, 0.0f, 1.0f) * 255.0f));
+}
+
+static inline void blend_with_ramp(CanvasBuffer &dst, const CanvasBuffer &from, const CanvasBuffer &to,
+                                   const BlendKernels::AlphaRamp &ramp, float alpha)
+{
+    BlendKernels::blend_ramp(bytes(from), bytes(to), bytes(dst), ramp.data(), ramp.position(alpha),
+                             byte_count(from));
 }
 
 static inline float hash01(int x, int y)
@@ -27,224 +53,178 @@ static constexpr uint8_t BAYER_8X8[8][8] = {
     {10, 58, 6, 54, 9, 57, 5, 53},
     {42, 26, 38, 22, 41, 25, 37, 21}};
 
+// Every masked transition below has the shape
+//   local_alpha = clamp((alpha - threshold(x, y)) * scale + 0.5, 0, 1)
+// so the per-pixel thresholds are baked into an AlphaRamp once per canvas size
+// and each frame is a single blend_ramp call.
+
 // ─── BlendTransition ─────────────────────────────────────────────────────────
-void BlendTransition::apply(FrameCanvas *dst, FrameCanvas *from, FrameCanvas *to,
-                            float alpha, int width, int height)
+void BlendTransition::apply(CanvasBuffer &dst, const CanvasBuffer &from, const CanvasBuffer &to,
+                            float alpha)
 {
-    for (int y = 0; y < height; ++y)
-    {
-        for (int x = 0; x < width; ++x)
-        {
-            uint8_t fr = 0, fg = 0, fb = 0;
-            uint8_t tr = 0, tg = 0, tb = 0;
-            from->GetPixel(x, y, &fr, &fg, &fb);
-            to->GetPixel(x, y, &tr, &tg, &tb);
-            dst->SetPixel(x, y, lerp_u8(fr, tr, alpha),
-                          lerp_u8(fg, tg, alpha),
-                          lerp_u8(fb, tb, alpha));
-        }
-    }
+    BlendKernels::blend_uniform(bytes(from), bytes(to), bytes(dst), byte_count(from), alpha_to_weight(alpha));
 }
 
 // ─── SwipeTransition ─────────────────────────────────────────────────────────
 // The incoming scene slides in column by column from the left.
 // A soft blend edge (width = ~10% of total width) smooths the boundary.
-void SwipeTransition::apply(FrameCanvas *dst, FrameCanvas *from, FrameCanvas *to,
-                            float alpha, int width, int height)
+void SwipeTransition::apply(CanvasBuffer &dst, const CanvasBuffer &from, const CanvasBuffer &to,
+                            float alpha)
 {
-    const float edge_px = std::max(1.0f, width * 0.10f);
-    const float pivot = alpha * static_cast<float>(width); // leading edge of incoming scene
-
-    for (int y = 0; y < height; ++y)
+    const int width = from.width();
+    const int height = from.height();
+    if (ramp.needs_rebuild(width, height))
     {
-        for (int x = 0; x < width; ++x)
-        {
-            // t = 0 → fully 'from'  t = 1 → fully 'to'
-            const float dist = pivot - static_cast<float>(x);
-            const float t = std::clamp(dist / edge_px * 0.5f + 0.5f, 0.0f, 1.0f);
-
-            uint8_t fr = 0, fg = 0, fb = 0;
-            uint8_t tr = 0, tg = 0, tb = 0;
-            from->GetPixel(x, y, &fr, &fg, &fb);
-            to->GetPixel(x, y, &tr, &tg, &tb);
-            dst->SetPixel(x, y, lerp_u8(fr, tr, t),
-                          lerp_u8(fg, tg, t),
-                          lerp_u8(fb, tb, t));
-        }
+        // Leading edge of the incoming scene sits at alpha * width
+        const float edge_px = std::max(1.0f, width * 0.10f);
+        ramp.build(width, height, static_cast<float>(width) / (2.0f * edge_px), [width](int x, int)
+                   { return static_cast<float>(x) / static_cast<float>(width); });
     }
+
+    blend_with_ramp(dst, from, to, ramp, alpha);
 }
 
 // ─── MorphTransition ─────────────────────────────────────────────────────────
 // Pixels of the incoming scene with higher luminance appear earlier.
 // Each pixel's local alpha is shifted by its brightness so bright areas
 // transition first and dark areas last — giving an organic dissolve.
-void MorphTransition::apply(FrameCanvas *dst, FrameCanvas *from, FrameCanvas *to,
-                            float alpha, int width, int height)
+// The mask depends on the incoming frame, so it is rebuilt every frame.
+void MorphTransition::apply(CanvasBuffer &dst, const CanvasBuffer &from, const CanvasBuffer &to,
+                            float alpha)
 {
-    for (int y = 0; y < height; ++y)
+    const Color *t = to.data();
+    const size_t count = to.size();
+    weights.resize(count * 3);
+
+    for (size_t i = 0; i < count; ++i)
     {
-        for (int x = 0; x < width; ++x)
-        {
-            uint8_t fr = 0, fg = 0, fb = 0;
-            uint8_t tr = 0, tg = 0, tb = 0;
-            from->GetPixel(x, y, &fr, &fg, &fb);
-            to->GetPixel(x, y, &tr, &tg, &tb);
-
-            // Luminance of the incoming pixel [0..1]
-            const float lum = (0.299f * tr + 0.587f * tg + 0.114f * tb) / 255.0f;
-
-            // Shift alpha by luminance: bright pixels of 'to' lead the transition
-            // local_alpha remapped so that a fully-bright pixel transitions first
-            // and a fully-dark pixel transitions last, by half the total range.
-            const float shift = lum * 0.5f;
-            const float local_alpha = std::clamp((alpha - (1.0f - lum) * 0.5f) / (1.0f - shift * 0.5f + 0.001f), 0.0f, 1.0f);
-
-            dst->SetPixel(x, y, lerp_u8(fr, tr, local_alpha),
-                          lerp_u8(fg, tg, local_alpha),
-                          lerp_u8(fb, tb, local_alpha));
-        }
+        // Luminance of the incoming pixel [0..1]
+        const float lum = (0.299f * t[i].r + 0.587f * t[i].g + 0.114f * t[i].b) / 255.0f;
+
+        // Shift alpha by luminance: bright pixels of 'to' lead the transition
+        // local_alpha remapped so that a fully-bright pixel transitions first
+        // and a fully-dark pixel transitions last, by half the total range.
+        const float shift = lum * 0.5f;
+        const float local_alpha = std::clamp((alpha - (1.0f - lum) * 0.5f) / (1.0f - shift * 0.5f + 0.001f), 0.0f, 1.0f);
+
+        const uint8_t weight = alpha_to_weight(local_alpha);
+        weights[i * 3] = weight;
+        weights[i * 3 + 1] = weight;
+        weights[i * 3 + 2] = weight;
     }
+
+    BlendKernels::blend_weighted(bytes(from), bytes(to), bytes(dst), weights.data(), byte_count(from));
 }
 
 // ─── RadialRevealTransition ──────────────────────────────────────────────────
-void RadialRevealTransition::apply(FrameCanvas *dst, FrameCanvas *from, FrameCanvas *to,
-                                   float alpha, int width, int height)
+void RadialRevealTransition::apply(CanvasBuffer &dst, const CanvasBuffer &from, const CanvasBuffer &to,
+                                   float alpha)
 {
-    const float cx = (static_cast<float>(width) - 1.0f) * 0.5f;
-    const float cy = (static_cast<float>(height) - 1.0f) * 0.5f;
-    const float max_dx = std::max(cx, static_cast<float>(width) - 1.0f - cx);
-    const float max_dy = std::max(cy, static_cast<float>(height) - 1.0f - cy);
-    const float max_dist = std::sqrt(max_dx * max_dx + max_dy * max_dy) + 0.0001f;
-    const float soft = 0.10f;
-
-    for (int y = 0; y < height; ++y)
+    const int width = from.width();
+    const int height = from.height();
+    if (ramp.needs_rebuild(width, height))
     {
-        for (int x = 0; x < width; ++x)
-        {
-            uint8_t fr = 0, fg = 0, fb = 0;
-            uint8_t tr = 0, tg = 0, tb = 0;
-            from->GetPixel(x, y, &fr, &fg, &fb);
-            to->GetPixel(x, y, &tr, &tg, &tb);
-
-            const float dx = static_cast<float>(x) - cx;
-            const float dy = static_cast<float>(y) - cy;
-            const float threshold = std::sqrt(dx * dx + dy * dy) / max_dist;
-            const float local_alpha = std::clamp((alpha - threshold + soft) / (2.0f * soft), 0.0f, 1.0f);
-
-            dst->SetPixel(x, y,
-                          lerp_u8(fr, tr, local_alpha),
-                          lerp_u8(fg, tg, local_alpha),
-                          lerp_u8(fb, tb, local_alpha));
-        }
+        const float cx = (static_cast<float>(width) - 1.0f) * 0.5f;
+        const float cy = (static_cast<float>(height) - 1.0f) * 0.5f;
+        const float max_dx = std::max(cx, static_cast<float>(width) - 1.0f - cx);
+        const float max_dy = std::max(cy, static_cast<float>(height) - 1.0f - cy);
+        const float max_dist = std::sqrt(max_dx * max_dx + max_dy * max_dy) + 0.0001f;
+        const float soft = 0.10f;
+
+        ramp.build(width, height, 1.0f / (2.0f * soft), [&](int x, int y)
+                   {
+                       const float dx = static_cast<float>(x) - cx;
+                       const float dy = static_cast<float>(y) - cy;
+                       return std::sqrt(dx * dx + dy * dy) / max_dist; });
     }
+
+    blend_with_ramp(dst, from, to, ramp, alpha);
 }
 
 // ─── CheckerRevealTransition ─────────────────────────────────────────────────
-void CheckerRevealTransition::apply(FrameCanvas *dst, FrameCanvas *from, FrameCanvas *to,
-                                    float alpha, int width, int height)
+void CheckerRevealTransition::apply(CanvasBuffer &dst, const CanvasBuffer &from, const CanvasBuffer &to,
+                                    float alpha)
 {
-    for (int y = 0; y < height; ++y)
+    const int width = from.width();
+    const int height = from.height();
+    if (ramp.needs_rebuild(width, height))
     {
-        for (int x = 0; x < width; ++x)
-        {
-            uint8_t fr = 0, fg = 0, fb = 0;
-            uint8_t tr = 0, tg = 0, tb = 0;
-            from->GetPixel(x, y, &fr, &fg, &fb);
-            to->GetPixel(x, y, &tr, &tg, &tb);
-
-            const int tile_phase = ((x >> 3) + (y >> 3)) & 1;
-            const float stage_start = tile_phase == 0 ? 0.0f : 0.5f;
-            const float stage_alpha = std::clamp((alpha - stage_start) * 2.0f, 0.0f, 1.0f);
-
-            dst->SetPixel(x, y,
-                          lerp_u8(fr, tr, stage_alpha),
-                          lerp_u8(fg, tg, stage_alpha),
-                          lerp_u8(fb, tb, stage_alpha));
-        }
+        // Tiles of phase 0 run during the first half, phase 1 during the second
+        ramp.build(width, height, 2.0f, [](int x, int y)
+                   {
+                       const int tile_phase = ((x >> 3) + (y >> 3)) & 1;
+                       const float stage_start = tile_phase == 0 ? 0.0f : 0.5f;
+                       return stage_start + 0.25f; });
     }
+
+    blend_with_ramp(dst, from, to, ramp, alpha);
 }
 
 // ─── OrderedDissolveTransition ───────────────────────────────────────────────
-void OrderedDissolveTransition::apply(FrameCanvas *dst, FrameCanvas *from, FrameCanvas *to,
-                                      float alpha, int width, int height)
+void OrderedDissolveTransition::apply(CanvasBuffer &dst, const CanvasBuffer &from, const CanvasBuffer &to,
+                                      float alpha)
 {
-    const float progress = std::clamp(alpha, 0.0f, 1.0f) * 64.0f;
-
-    for (int y = 0; y < height; ++y)
+    const int width = from.width();
+    const int height = from.height();
+    if (ramp.needs_rebuild(width, height))
     {
-        for (int x = 0; x < width; ++x)
-        {
-            uint8_t fr = 0, fg = 0, fb = 0;
-            uint8_t tr = 0, tg = 0, tb = 0;
-            from->GetPixel(x, y, &fr, &fg, &fb);
-            to->GetPixel(x, y, &tr, &tg, &tb);
-
-            const float threshold = static_cast<float>(BAYER_8X8[y & 7][x & 7]);
-            const float local_alpha = std::clamp(progress - threshold, 0.0f, 1.0f);
-
-            dst->SetPixel(x, y,
-                          lerp_u8(fr, tr, local_alpha),
-                          lerp_u8(fg, tg, local_alpha),
-                          lerp_u8(fb, tb, local_alpha));
-        }
+        // Each Bayer cell fades in over 1/64 of the transition
+        ramp.build(width, height, 64.0f, [](int x, int y)
+                   { return (static_cast<float>(BAYER_8X8[y & 7][x & 7]) + 0.5f) / 64.0f; });
     }
+
+    blend_with_ramp(dst, from, to, ramp, std::clamp(alpha, 0.0f, 1.0f));
 }
 
 // ─── RandomDissolveTransition ────────────────────────────────────────────────
-void RandomDissolveTransition::apply(FrameCanvas *dst, FrameCanvas *from, FrameCanvas *to,
-                                     float alpha, int width, int height)
+void RandomDissolveTransition::apply(CanvasBuffer &dst, const CanvasBuffer &from, const CanvasBuffer &to,
+                                     float alpha)
 {
-    const float soft = 0.06f;
-
-    for (int y = 0; y < height; ++y)
+    const int width = from.width();
+    const int height = from.height();
+    if (ramp.needs_rebuild(width, height))
     {
-        for (int x = 0; x < width; ++x)
-        {
-            uint8_t fr = 0, fg = 0, fb = 0;
-            uint8_t tr = 0, tg = 0, tb = 0;
-            from->GetPixel(x, y, &fr, &fg, &fb);
-            to->GetPixel(x, y, &tr, &tg, &tb);
-
-            const float threshold = hash01(x, y);
-            const float local_alpha = std::clamp((alpha - threshold + soft) / (2.0f * soft), 0.0f, 1.0f);
-
-            dst->SetPixel(x, y,
-                          lerp_u8(fr, tr, local_alpha),
-                          lerp_u8(fg, tg, local_alpha),
-                          lerp_u8(fb, tb, local_alpha));
-        }
+        const float soft = 0.06f;
+        ramp.build(width, height, 1.0f / (2.0f * soft), [](int x, int y)
+                   { return hash01(x, y); });
     }
+
+    blend_with_ramp(dst, from, to, ramp, alpha);
 }
 
 // ─── ZoomBlendTransition ─────────────────────────────────────────────────────
-void ZoomBlendTransition::apply(FrameCanvas *dst, FrameCanvas *from, FrameCanvas *to,
-                                float alpha, int width, int height)
+// The incoming frame is resampled into 'zoomed' first, then blended uniformly.
+void ZoomBlendTransition::apply(CanvasBuffer &dst, const CanvasBuffer &from, const CanvasBuffer &to,
+                                float alpha)
 {
+    const int width = from.width();
+    const int height = from.height();
     const float cx = (static_cast<float>(width) - 1.0f) * 0.5f;
     const float cy = (static_cast<float>(height) - 1.0f) * 0.5f;
     const float zoom = 1.25f - 0.25f * std::clamp(alpha, 0.0f, 1.0f);
 
+    zoomed.resize(width, height);
+    sample_columns.resize(width);
+    for (int x = 0; x < width; ++x)
+    {
+        const float sample_xf = (static_cast<float>(x) - cx) / zoom + cx;
+        sample_columns[x] = std::clamp(static_cast<int>(std::round(sample_xf)), 0, width - 1);
+    }
+
     for (int y = 0; y < height; ++y)
     {
+        const float sample_yf = (static_cast<float>(y) - cy) / zoom + cy;
+        const int sy = std::clamp(static_cast<int>(std::round(sample_yf)), 0, height - 1);
+        const Color *t = to.row(sy);
+        Color *out = zoomed.row(y);
+
         for (int x = 0; x < width; ++x)
         {
-            uint8_t fr = 0, fg = 0, fb = 0;
-            from->GetPixel(x, y, &fr, &fg, &fb);
-
-            const float sample_xf = (static_cast<float>(x) - cx) / zoom + cx;
-            const float sample_yf = (static_cast<float>(y) - cy) / zoom + cy;
-            const int sx = std::clamp(static_cast<int>(std::round(sample_xf)), 0, width - 1);
-            const int sy = std::clamp(static_cast<int>(std::round(sample_yf)), 0, height - 1);
-
-            uint8_t tr = 0, tg = 0, tb = 0;
-            to->GetPixel(sx, sy, &tr, &tg, &tb);
-
-            dst->SetPixel(x, y,
-                          lerp_u8(fr, tr, alpha),
-                          lerp_u8(fg, tg, alpha),
-                          lerp_u8(fb, tb, alpha));
+            out[x] = t[sample_columns[x]];
         }
     }
+
+    BlendKernels::blend_uniform(bytes(from), bytes(zoomed), bytes(dst), byte_count(from), alpha_to_weight(alpha));
 }
 
 // ─── Factory ─────────────────────────────────────────────────────────────────
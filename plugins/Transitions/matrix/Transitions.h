@@ -2,6 +2,7 @@
 
 #include "shared/matrix/plugin/main.h"
 #include "shared/matrix/transition_effect.h"
+#include "BlendKernels.h"
 
 namespace Plugins
 {
@@ -30,76 +31,91 @@ class BlendTransition : public TransitionEffect
 {
 public:
     std::string get_name() const override { return "blend"; }
-    void apply(FrameCanvas *dst, FrameCanvas *from, FrameCanvas *to,
-               float alpha, int width, int height) override;
+    void apply(CanvasBuffer &dst, const CanvasBuffer &from, const CanvasBuffer &to,
+               float alpha) override;
 };
 
 // ─── Swipe ────────────────────────────────────────────────────────────────────
 /// Horizontal wipe: the incoming scene slides in from the right.
 class SwipeTransition : public TransitionEffect
 {
+    BlendKernels::AlphaRamp ramp;
+
 public:
     std::string get_name() const override { return "swipe"; }
-    void apply(FrameCanvas *dst, FrameCanvas *from, FrameCanvas *to,
-               float alpha, int width, int height) override;
+    void apply(CanvasBuffer &dst, const CanvasBuffer &from, const CanvasBuffer &to,
+               float alpha) override;
 };
 
 // ─── Morph ────────────────────────────────────────────────────────────────────
 /// Luminance-weighted reveal: bright pixels of 'to' appear before dark ones.
 class MorphTransition : public TransitionEffect
 {
+    std::vector<uint8_t> weights;
+
 public:
     std::string get_name() const override { return "morph"; }
-    void apply(FrameCanvas *dst, FrameCanvas *from, FrameCanvas *to,
-               float alpha, int width, int height) override;
+    void apply(CanvasBuffer &dst, const CanvasBuffer &from, const CanvasBuffer &to,
+               float alpha) override;
 };
 
 // ─── Radial Reveal ───────────────────────────────────────────────────────────
 /// Circular reveal from center with a soft edge.
 class RadialRevealTransition : public TransitionEffect
 {
+    BlendKernels::AlphaRamp ramp;
+
 public:
     std::string get_name() const override { return "radial_reveal"; }
-    void apply(FrameCanvas *dst, FrameCanvas *from, FrameCanvas *to,
-               float alpha, int width, int height) override;
+    void apply(CanvasBuffer &dst, const CanvasBuffer &from, const CanvasBuffer &to,
+               float alpha) override;
 };
 
 // ─── Checker Reveal ──────────────────────────────────────────────────────────
 /// Checkerboard-style staged reveal using 8x8 tiles.
 class CheckerRevealTransition : public TransitionEffect
 {
+    BlendKernels::AlphaRamp ramp;
+
 public:
     std::string get_name() const override { return "checker_reveal"; }
-    void apply(FrameCanvas *dst, FrameCanvas *from, FrameCanvas *to,
-               float alpha, int width, int height) override;
+    void apply(CanvasBuffer &dst, const CanvasBuffer &from, const CanvasBuffer &to,
+               float alpha) override;
 };
 
 // ─── Ordered Dissolve ────────────────────────────────────────────────────────
 /// Deterministic dissolve using an 8x8 Bayer threshold pattern.
 class OrderedDissolveTransition : public TransitionEffect
 {
+    BlendKernels::AlphaRamp ramp;
+
 public:
     std::string get_name() const override { return "ordered_dissolve"; }
-    void apply(FrameCanvas *dst, FrameCanvas *from, FrameCanvas *to,
-               float alpha, int width, int height) override;
+    void apply(CanvasBuffer &dst, const CanvasBuffer &from, const CanvasBuffer &to,
+               float alpha) override;
 };
 
 // ─── Random Dissolve ─────────────────────────────────────────────────────────
 /// Hash-based pseudo-random dissolve with deterministic per-pixel ordering.
 class RandomDissolveTransition : public TransitionEffect
 {
+    BlendKernels::AlphaRamp ramp;
+
 public:
     std::string get_name() const override { return "random_dissolve"; }
-    void apply(FrameCanvas *dst, FrameCanvas *from, FrameCanvas *to,
-               float alpha, int width, int height) override;
+    void apply(CanvasBuffer &dst, const CanvasBuffer &from, const CanvasBuffer &to,
+               float alpha) override;
 };
 
 // ─── Zoom Blend ──────────────────────────────────────────────────────────────
 /// Incoming scene zooms into place while blending from the current scene.
 class ZoomBlendTransition : public TransitionEffect
 {
+    CanvasBuffer zoomed;
+    std::vector<int> sample_columns;
+
 public:
     std::string get_name() const override { return "zoom_blend"; }
-    void apply(FrameCanvas *dst, FrameCanvas *from, FrameCanvas *to,
-               float alpha, int width, int height) override;
+    void apply(CanvasBuffer &dst, const CanvasBuffer &from, const CanvasBuffer &to,
+               float alpha) override;
 };
@@ -105,7 +105,7 @@ VideoDesktop::compute_next_packet(const std::string sceneName) {
   if (frame.empty()) return std::nullopt;
 
   return std::unique_ptr<UdpPacket, void (*)(UdpPacket *)>(
-      new VideoPacket(std::move(frame)),
+      new VideoPacket(std::move(frame), matrix_width, matrix_height),
       [](UdpPacket *p) { delete dynamic_cast<VideoPacket *>(p); });
 }
 
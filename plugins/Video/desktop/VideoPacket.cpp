@@ -1,6 +1,4 @@
 #include "VideoPacket.h"
 
-VideoPacket::VideoPacket(std::vector<uint8_t> rgbData)
-    : UdpPacket(0x03), data(std::move(rgbData)) {}
-
-std::vector<uint8_t> VideoPacket::toData() const { return data; }
+VideoPacket::VideoPacket(std::vector<uint8_t> rgbData, uint16_t width, uint16_t height)
+    : FramePacket(0x03, std::move(rgbData), width, height) {}
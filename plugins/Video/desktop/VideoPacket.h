@@ -1,11 +1,8 @@
 #pragma once
-#include <shared/common/udp/packet.h>
+#include <shared/common/udp/frame_stream.h>
 #include <vector>
 
-struct VideoPacket final : UdpPacket {
-  std::vector<uint8_t> data;
-
+struct VideoPacket final : FramePacket {
 public:
-  VideoPacket(std::vector<uint8_t> rgbData);
-  std::vector<uint8_t> toData() const override;
+  VideoPacket(std::vector<uint8_t> rgbData, uint16_t width, uint16_t height);
 };
@@ -32,9 +32,10 @@ VideoPlugin::create_shader_providers() {
 bool VideoPlugin::on_udp_packet(const uint8_t pluginId,
                                 const uint8_t *packetData, const size_t size) {
   if (pluginId != 0x03) return false;
-  
-  std::lock_guard<std::mutex> lock(dataMutex);
-  data.assign(packetData, packetData + size);
+
+  frames.receive(packetData, size);
+  if (frames.take_keyframe_request())
+    send_msg_to_desktop(FrameStream::keyframe_request_message);
   return true;
 }
 
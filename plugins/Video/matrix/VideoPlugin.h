@@ -1,6 +1,7 @@
 #pragma once
 
 #include "shared/matrix/plugin/main.h"
+#include "shared/matrix/utils/FrameStreamReceiver.h"
 #include <mutex>
 #include <vector>
 
@@ -30,10 +31,8 @@ public:
   std::optional<std::vector<std::string>> on_websocket_open() override;
   void on_websocket_message(const std::string &message) override;
 
-  std::vector<uint8_t> get_data() {
-    std::lock_guard<std::mutex> lock(dataMutex);
-    return data;
-  };
+  /// Latest frame, read in place. Keep the view only while drawing it.
+  FrameTripleBuffer::FrameView get_data() { return frames.read(); }
 
   std::string get_status() {
     std::lock_guard<std::mutex> lock(statusMutex);
@@ -44,8 +43,7 @@ public:
   }
 
 private:
-  std::mutex dataMutex;
-  std::vector<uint8_t> data;
+  FrameStreamReceiver frames;
 
   std::mutex statusMutex;
   std::string status = "idle";
@@ -3,6 +3,7 @@
 #include <shared/matrix/canvas_consts.h>
 #include <shared/matrix/plugin_loader/loader.h>
 #include <shared/matrix/utils/LoadingAnimation.h>
+#include <shared/common/utils/clock.h>
 #include <spdlog/spdlog.h>
 
 using namespace Scenes;
@@ -96,7 +97,7 @@ bool VideoScene::render(rgb_matrix::FrameCanvas *canvas)
   }
 
   // Select URL logic
-  tmillis_t now = GetTimeInMillis();
+  tmillis_t now = Clock::wall_millis();
   if (lastUrlSent.empty() ||
       (now - last_switch_time > 30000 && urls.size() > 1))
   { // 30 seconds
@@ -5,12 +5,13 @@
 #include "shared/matrix/utils/consts.h"
 
 #include "led-matrix.h"
+#include "graphics.h"
 
-// Fonts
-extern rgb_matrix::Font HEADER_FONT;
-extern rgb_matrix::Font BODY_FONT;
-extern rgb_matrix::Font SMALL_FONT;
-extern rgb_matrix::Font TINY_FONT;  // New tiny font for additional details
+// Fonts, shared through the FontRegistry and loaded in before_server_init()
+extern const rgb_matrix::Font *HEADER_FONT;
+extern const rgb_matrix::Font *BODY_FONT;
+extern const rgb_matrix::Font *SMALL_FONT;
+extern const rgb_matrix::Font *TINY_FONT;  // New tiny font for additional details
 
 // Sky colors for different conditions
 namespace SkyColor {
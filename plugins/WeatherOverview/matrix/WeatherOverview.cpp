@@ -2,6 +2,7 @@
 #include "WeatherOverview.h"
 #include "scenes/WeatherScene.h"
 #include "shared/matrix/utils/shared.h"
+#include "shared/matrix/utils/FontRegistry.h"
 #include "spdlog/spdlog.h"
 #include "Constants.h"
 
@@ -51,17 +52,18 @@ std::optional<string> WeatherOverview::before_server_init() {
     const std::string SMALL_FONT_FILE = std::string(plugin_weather_dir) + "/4x6.bdf";
 
     spdlog::debug("Loading font...");
-    const auto headerRes = HEADER_FONT.LoadFont(HEADER_FONT_FILE.c_str());
-    const auto bodyRes = BODY_FONT.LoadFont(BODY_FONT_FILE.c_str());
-    const auto smallRes = SMALL_FONT.LoadFont(SMALL_FONT_FILE.c_str());
+    auto &fonts = FontRegistry::instance();
+    HEADER_FONT = fonts.load(HEADER_FONT_FILE);
+    BODY_FONT = fonts.load(BODY_FONT_FILE);
+    SMALL_FONT = fonts.load(SMALL_FONT_FILE);
 
-    if (!headerRes)
+    if (HEADER_FONT == nullptr)
         return "Could not load header font at " + HEADER_FONT_FILE;
 
-    if (!bodyRes)
+    if (BODY_FONT == nullptr)
         return "Could not load body font at " + BODY_FONT_FILE;
 
-    if(!smallRes)
+    if (SMALL_FONT == nullptr)
         return "Could not load small font at " + SMALL_FONT_FILE;
 
     return BasicPlugin::before_server_init();
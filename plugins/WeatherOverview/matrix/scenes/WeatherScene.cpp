@@ -52,6 +52,15 @@ string Scenes::WeatherScene::get_name() const
     return "weather";
 }
 
+/// SetPixelAlpha() for a frame in a CanvasBuffer
+static void blend_pixel(CanvasBuffer &frame, int x, int y, uint8_t r, uint8_t g, uint8_t b, float alpha)
+{
+    rgb_matrix::Color &pixel = frame.at(x, y);
+    pixel.r = static_cast<uint8_t>(r * alpha + pixel.r * (1.0f - alpha));
+    pixel.g = static_cast<uint8_t>(g * alpha + pixel.g * (1.0f - alpha));
+    pixel.b = static_cast<uint8_t>(b * alpha + pixel.b * (1.0f - alpha));
+}
+
 static void pre_process_image(Magick::Image *img)
 {
     const int w = img->columns() * 0.9f;
@@ -63,7 +72,7 @@ static void pre_process_image(Magick::Image *img)
     img->crop(Magick::Geometry(w, h, x, y));
 }
 
-void Scenes::WeatherScene::renderCurrentWeather(rgb_matrix::FrameCanvas *canvas, const WeatherData &data)
+void Scenes::WeatherScene::renderCurrentWeather(CanvasLayer *canvas, const WeatherData &data)
 {
     // Draw the main weather icon
     if (images.has_value())
@@ -75,34 +84,34 @@ void Scenes::WeatherScene::renderCurrentWeather(rgb_matrix::FrameCanvas *canvas,
     // Draw temperature in large font
     constexpr int temp_x = MAIN_ICON_SIZE + 6;
     constexpr int temp_y = 20;
-    DrawText(canvas, HEADER_FONT, temp_x, temp_y,
-             {255, 255, 255}, data.temperature.c_str());
+    text_cache.draw(canvas, *HEADER_FONT, temp_x, temp_y,
+                    {255, 255, 255}, data.temperature);
 
     // Draw weather description with scroll effect if needed
     const std::string desc = data.description;
     const int desc_y = temp_y + 14;
 
-    DrawText(canvas, BODY_FONT, temp_x, desc_y,
-             {220, 220, 255}, desc.c_str());
+    text_cache.draw(canvas, *BODY_FONT, temp_x, desc_y,
+                    {220, 220, 255}, desc);
 
     // Draw additional weather info
     constexpr int add_info_y = desc_y + 10;
     const std::string humidity_info = "Humidity: " + data.humidity;
-    DrawText(canvas, SMALL_FONT, temp_x, add_info_y,
-             {200, 200, 255}, humidity_info.c_str());
+    text_cache.draw(canvas, *SMALL_FONT, temp_x, add_info_y,
+                    {200, 200, 255}, humidity_info);
 
     const std::string wind_info = "Wind: " + data.wind_speed;
-    DrawText(canvas, SMALL_FONT, temp_x, add_info_y + 7,
-             {200, 200, 255}, wind_info.c_str());
+    text_cache.draw(canvas, *SMALL_FONT, temp_x, add_info_y + 7,
+                    {200, 200, 255}, wind_info);
 }
 
-void Scenes::WeatherScene::renderForecast(rgb_matrix::FrameCanvas *canvas, const WeatherData &data) const
+void Scenes::WeatherScene::renderForecast(CanvasLayer *canvas, const WeatherData &data) const
 {
     int base_offset_x = 5;
 
     // Draw forecast title
-    DrawText(canvas, SMALL_FONT, base_offset_x, 65,
-             {255, 255, 255}, "3-Day Forecast:");
+    text_cache.draw(canvas, *SMALL_FONT, base_offset_x, 65,
+                    {255, 255, 255}, "3-Day Forecast:");
 
     // Draw forecast data
     if (data.forecast.size() >= 3 && images.has_value())
@@ -115,8 +124,8 @@ void Scenes::WeatherScene::renderForecast(rgb_matrix::FrameCanvas *canvas, const
             const int base_x = i * forecast_width + base_offset_x;
 
             // Draw day name
-            DrawText(canvas, SMALL_FONT, base_x + 2, 78,
-                     {255, 255, 255}, day.day_name.c_str());
+            text_cache.draw(canvas, *SMALL_FONT, base_x + 2, 78,
+                            {255, 255, 255}, day.day_name);
 
             // Draw forecast icon
             if (i < images->forecastIcons.size())
@@ -127,9 +136,9 @@ void Scenes::WeatherScene::renderForecast(rgb_matrix::FrameCanvas *canvas, const
 
             // Draw min/max temperature
             std::string temp = day.temperature_min + "/" + day.temperature_max;
-            const int temp_width = SMALL_FONT.CharacterWidth('A') * temp.length();
-            DrawText(canvas, SMALL_FONT, base_x + (forecast_width - temp_width) / 2, 100,
-                     {220, 220, 255}, temp.c_str());
+            const int temp_width = SMALL_FONT->CharacterWidth('A') * temp.length();
+            text_cache.draw(canvas, *SMALL_FONT, base_x + (forecast_width - temp_width) / 2, 100,
+                            {220, 220, 255}, temp);
 
             // Draw precipitation indicator if probability is significant
             if (day.precipitation_chance > 0.1f)
@@ -143,8 +152,8 @@ void Scenes::WeatherScene::renderForecast(rgb_matrix::FrameCanvas *canvas, const
 
                 // Draw the probability percentage
                 std::string prob = std::to_string(static_cast<int>(day.precipitation_chance * 100)) + "%";
-                DrawText(canvas, SMALL_FONT, base_x + 10, 110,
-                         {150, 200, 255}, prob.c_str());
+                text_cache.draw(canvas, *SMALL_FONT, base_x + 10, 110,
+                                {150, 200, 255}, prob);
             }
         }
     }
@@ -215,29 +224,36 @@ RGB Scenes::WeatherScene::interpolateColor(const RGB &start, const RGB &end, flo
         static_cast<uint8_t>(start.b + (end.b - start.b) * progress)};
 }
 
-void Scenes::WeatherScene::applyBackgroundEffects(rgb_matrix::FrameCanvas *canvas, const RGB &base_color)
+void Scenes::WeatherScene::applyBackgroundEffects(CanvasBuffer &frame, const RGB &base_color)
 {
+    // Add some subtle horizontal variation, the same for every row
+    if (sky_variation.size() != static_cast<size_t>(matrix_width))
+    {
+        sky_variation.resize(matrix_width);
+        for (int x = 0; x < matrix_width; x++)
+            sky_variation[x] = 1.0f + std::sin(x * 0.1f) * 0.05f;
+    }
+
+    // Apply pulse animation
+    const int pulse = (animation_frame < 30) ? animation_frame : 60 - animation_frame;
+    const float pulse_factor = 1.0f + (pulse / 600.0f);
+
     // Create a gradient background
     for (int y = 0; y < matrix_height; y++)
     {
         // Calculate gradient factor (darker at bottom, lighter at top)
-        float gradient_factor = 1.0f - (float)y / matrix_height * GRADIENT_INTENSITY;
+        const float gradient_factor = 1.0f - (float)y / matrix_height * GRADIENT_INTENSITY;
+        const float row_r = base_color.r * gradient_factor;
+        const float row_g = base_color.g * gradient_factor;
+        const float row_b = base_color.b * gradient_factor;
 
+        rgb_matrix::Color *row = frame.row(y);
         for (int x = 0; x < matrix_width; x++)
         {
-            // Add some subtle horizontal variation
-            float x_variation = 1.0f + std::sin(x * 0.1f) * 0.05f;
-
-            // Apply pulse animation
-            int pulse = (animation_frame < 30) ? animation_frame : 60 - animation_frame;
-            float pulse_factor = 1.0f + (pulse / 600.0f);
-
             // Calculate final color
-            uint8_t r = std::min(255.0f, base_color.r * gradient_factor * x_variation * pulse_factor);
-            uint8_t g = std::min(255.0f, base_color.g * gradient_factor * x_variation * pulse_factor);
-            uint8_t b = std::min(255.0f, base_color.b * gradient_factor * x_variation * pulse_factor);
-
-            canvas->SetPixel(x, y, r, g, b);
+            row[x].r = std::min(255.0f, row_r * sky_variation[x] * pulse_factor);
+            row[x].g = std::min(255.0f, row_g * sky_variation[x] * pulse_factor);
+            row[x].b = std::min(255.0f, row_b * sky_variation[x] * pulse_factor);
         }
     }
 
@@ -255,9 +271,13 @@ void Scenes::WeatherScene::applyBackgroundEffects(rgb_matrix::FrameCanvas *canva
             const int x = std::get<0>(coords);
             const int y = std::get<1>(coords);
 
+            // Stars are placed up to one pixel past the edges
+            if (x >= matrix_width || y >= matrix_height)
+                continue;
+
             // Make stars twinkle
-            const int brightness = 150 + (std::sin(0.1f * animation_frame + i) + 1) * 50;
-            canvas->SetPixel(x, y, brightness, brightness, brightness);
+            const uint8_t brightness = 150 + (std::sin(0.1f * animation_frame + i) + 1) * 50;
+            frame.at(x, y) = rgb_matrix::Color(brightness, brightness, brightness);
         }
 
         // Update and render shooting stars
@@ -265,7 +285,7 @@ void Scenes::WeatherScene::applyBackgroundEffects(rgb_matrix::FrameCanvas *canva
         {
             tryCreateShootingStar();
             updateShootingStars();
-            renderShootingStars(canvas);
+            renderShootingStars(frame);
         }
     }
 }
@@ -375,7 +395,7 @@ void Scenes::WeatherScene::updateShootingStars()
     }
 }
 
-void Scenes::WeatherScene::renderShootingStars(rgb_matrix::FrameCanvas *canvas)
+void Scenes::WeatherScene::renderShootingStars(CanvasBuffer &frame)
 {
     for (const auto &star : shooting_stars)
     {
@@ -396,14 +416,14 @@ void Scenes::WeatherScene::renderShootingStars(rgb_matrix::FrameCanvas *canvas)
                 int py = static_cast<int>(tail_y);
                 if (px >= 0 && px < matrix_width && py >= 0 && py < matrix_height)
                 {
-                    SetPixelAlpha(canvas, px, py, 255, 255, 255, ((float)b / 255.0f));
+                    blend_pixel(frame, px, py, 255, 255, 255, ((float)b / 255.0f));
                 }
             }
         }
     }
 }
 
-void Scenes::WeatherScene::drawWeatherBorder(rgb_matrix::FrameCanvas *canvas, const RGB &color, int brightness_mod) const
+void Scenes::WeatherScene::drawWeatherBorder(CanvasLayer *canvas, const RGB &color, int brightness_mod) const
 {
     // Draw a subtle border around the display
     for (int i = 0; i < BORDER_THICKNESS; i++)
@@ -438,7 +458,7 @@ void Scenes::WeatherScene::drawWeatherBorder(rgb_matrix::FrameCanvas *canvas, co
     }
 }
 
-void Scenes::WeatherScene::drawPrecipitationIndicator(rgb_matrix::FrameCanvas *canvas, float probability, int x,
+void Scenes::WeatherScene::drawPrecipitationIndicator(CanvasLayer *canvas, float probability, int x,
                                                       int y) const
 {
     if (probability <= 0.05f)
@@ -465,7 +485,7 @@ void Scenes::WeatherScene::drawPrecipitationIndicator(rgb_matrix::FrameCanvas *c
     }
 }
 
-void Scenes::WeatherScene::renderSunriseSunset(rgb_matrix::FrameCanvas *canvas, const WeatherData &data) const
+void Scenes::WeatherScene::renderSunriseSunset(CanvasLayer *canvas, const WeatherData &data) const
 {
     if (data.sunrise.empty() || data.sunset.empty() || !show_sunrise_sunset->get())
     {
@@ -492,8 +512,8 @@ void Scenes::WeatherScene::renderSunriseSunset(rgb_matrix::FrameCanvas *canvas,
 
     // Draw sunrise time
     std::string sunrise_text = "↑ " + data.sunrise;
-    DrawText(canvas, SMALL_FONT, base_x + icon_size + 2, base_y + 2,
-             {255, 220, 100}, sunrise_text.c_str());
+    text_cache.draw(canvas, *SMALL_FONT, base_x + icon_size + 2, base_y + 2,
+                    {255, 220, 100}, sunrise_text);
 
     // Draw sunset icon (simple sun with down arrow)
     const int sunset_x = matrix_width / 2 + 20;
@@ -511,19 +531,37 @@ void Scenes::WeatherScene::renderSunriseSunset(rgb_matrix::FrameCanvas *canvas,
 
     // Draw sunset time
     std::string sunset_text = "↓ " + data.sunset;
-    DrawText(canvas, SMALL_FONT, sunset_x + icon_size + 2, base_y + 2,
-             {255, 180, 80}, sunset_text.c_str());
+    text_cache.draw(canvas, *SMALL_FONT, sunset_x + icon_size + 2, base_y + 2,
+                    {255, 180, 80}, sunset_text);
 }
 
-void Scenes::WeatherScene::renderClock(rgb_matrix::FrameCanvas *canvas) const
+std::string Scenes::WeatherScene::clockText()
 {
     const time_t timestamp = time(nullptr);
     const tm datetime = *localtime(&timestamp);
 
     char output[50];
     strftime(output, 50, "%H:%M", &datetime);
+    return output;
+}
 
-    rgb_matrix::DrawText(canvas, BODY_FONT, 98, 11, {255, 255, 255}, output);
+void Scenes::WeatherScene::renderClock(CanvasLayer *canvas, const std::string &time) const
+{
+    text_cache.draw(canvas, *BODY_FONT, 98, 11, {255, 255, 255}, time);
+}
+
+uint64_t Scenes::WeatherScene::infoLayerKey(const RGB &theme_color, const std::string &clock) const
+{
+    uint64_t key = std::hash<std::string>{}(clock);
+    const auto mix = [&key](uint64_t value)
+    {
+        key ^= value + 0x9e3779b97f4a7c15ULL + (key << 6) + (key >> 2);
+    };
+
+    mix(data_version);
+    mix(static_cast<uint64_t>(theme_color.r) << 16 | theme_color.g << 8 | theme_color.b);
+    mix(show_border->get() << 1 | show_sunrise_sunset->get());
+    return key;
 }
 
 void Scenes::WeatherScene::resetStars()
@@ -574,10 +612,10 @@ bool Scenes::WeatherScene::render(rgb_matrix::FrameCanvas *canvas)
         spdlog::warn("Could not get weather data: {}", data_res.error());
         // Instead of returning false, show an error message and continue
         canvas->Clear();
-        DrawText(canvas, BODY_FONT, 2, BODY_FONT.baseline() + 5,
-                 {255, 100, 100}, "Weather data error");
-        DrawText(canvas, SMALL_FONT, 2, BODY_FONT.baseline() + 15,
-                 {200, 200, 200}, data_res.error().c_str());
+        text_cache.draw(canvas, *BODY_FONT, 2, BODY_FONT->baseline() + 5,
+                        {255, 100, 100}, "Weather data error");
+        text_cache.draw(canvas, *SMALL_FONT, 2, BODY_FONT->baseline() + 15,
+                        {200, 200, 200}, data_res.error());
         // Render loop now uses the provided canvas directly.
 
 #ifdef ENABLE_EMULATOR
@@ -683,6 +721,7 @@ bool Scenes::WeatherScene::render(rgb_matrix::FrameCanvas *canvas)
 
         parser.unmark_changed();
         images = img;
+        data_version++;
 
         // Initialize animation state when data changes
         updateAnimationState(data);
@@ -691,33 +730,48 @@ bool Scenes::WeatherScene::render(rgb_matrix::FrameCanvas *canvas)
     animation_frame = (animation_frame + 1) % get_target_fps();
 
     updateEnhancedParticles(data);
-    canvas->Clear();
+    frame.resize(matrix_width, matrix_height);
 
     // Apply beautiful background with gradient if enabled
     if (gradient_background->get())
     {
-        applyBackgroundEffects(canvas, theme_color);
+        applyBackgroundEffects(frame, theme_color);
     }
     else
     {
         // Simple background fill
-        canvas->Fill(theme_color.r, theme_color.g, theme_color.b);
+        frame.fill(rgb_matrix::Color(theme_color.r, theme_color.g, theme_color.b));
     }
 
-    renderRainbowEffect(canvas, data);
-    // Draw a subtle border if enabled
-    if (show_border->get())
+    renderRainbowEffect(frame, data);
+
+    // Everything in front of the sky only changes with the data, the settings or the minute
+    const std::string clock = enable_clock->get() ? clockText() : std::string();
+    const uint64_t info_key = infoLayerKey(theme_color, clock);
+    info_layer.resize(matrix_width, matrix_height);
+    if (info_layer.stale(info_key))
     {
-        drawWeatherBorder(canvas, theme_color, 40);
-    }
+        info_layer.begin(info_key);
 
-    if (enable_clock->get())
-        renderClock(canvas);
+        // Draw a subtle border if enabled
+        if (show_border->get())
+        {
+            drawWeatherBorder(&info_layer, theme_color, 40);
+        }
+
+        if (!clock.empty())
+            renderClock(&info_layer, clock);
+
+        // Render all components
+        renderCurrentWeather(&info_layer, data);
+        renderSunriseSunset(&info_layer, data);
+        renderForecast(&info_layer, data);
+
+        info_layer.end();
+    }
 
-    // Render all components
-    renderCurrentWeather(canvas, data);
-    renderSunriseSunset(canvas, data);
-    renderForecast(canvas, data);
+    info_layer.composite(frame);
+    frame.write_to(canvas);
 
     // Render weather animations (rain, snow, etc.)
     if (enable_animations->get())
@@ -1239,7 +1293,7 @@ void Scenes::WeatherScene::renderFogMist(rgb_matrix::FrameCanvas *canvas, const
     }
 }
 
-void Scenes::WeatherScene::renderRainbowEffect(rgb_matrix::FrameCanvas *canvas, const WeatherData &data)
+void Scenes::WeatherScene::renderRainbowEffect(CanvasBuffer &frame, const WeatherData &data)
 {
     if (!enable_rainbow->get() || !enable_animations->get())
         return;
@@ -1307,7 +1361,7 @@ void Scenes::WeatherScene::renderRainbowEffect(rgb_matrix::FrameCanvas *canvas,
                         uint8_t r = static_cast<uint8_t>(std::min(255.0f, (r_f + m) * 255.0f));
                         uint8_t g = static_cast<uint8_t>(std::min(255.0f, (g_f + m) * 255.0f));
                         uint8_t b = static_cast<uint8_t>(std::min(255.0f, (b_f + m) * 255.0f));
-                        canvas->SetPixel(x, y, r, g, b);
+                        frame.at(x, y) = rgb_matrix::Color(r, g, b);
                     }
                 }
             }
@@ -2,6 +2,9 @@
 
 #include "shared/matrix/Scene.h"
 #include "shared/matrix/wrappers.h"
+#include "shared/matrix/utils/TextCache.h"
+#include "shared/matrix/canvas_buffer.h"
+#include "shared/matrix/canvas_layer.h"
 #include "../WeatherParser.h"
 
 namespace Scenes {
@@ -90,15 +93,30 @@ namespace Scenes {
         };
 
         std::optional<Images> images;
+
+        // Labels stay the same for many frames. Mutable, the const render helpers draw through it
+        mutable TextCache text_cache;
+
+        // The sky is drawn into 'frame' every frame. Border, clock, labels and icons go into
+        // 'info_layer', which is only redrawn when the data, the minute or the settings change,
+        // and composited over the sky. Animations are drawn over the finished canvas.
+        CanvasBuffer frame;
+        CanvasLayer info_layer;
+        // Bumped whenever new weather data (and with it new icons) arrived
+        uint64_t data_version = 0;
+        // Horizontal brightness variation of the sky gradient per column
+        std::vector<float> sky_variation;
         
         // Get theme color based on selected theme
         static RGB getThemeColor(ColorTheme theme, const WeatherData &data);
 
         // Rendering methods
-        void renderCurrentWeather(rgb_matrix::FrameCanvas *canvas, const WeatherData &data);
-        void renderForecast(rgb_matrix::FrameCanvas *canvas, const WeatherData &data) const;
-        void renderSunriseSunset(rgb_matrix::FrameCanvas *canvas, const WeatherData &data) const;
-        void renderClock(rgb_matrix::FrameCanvas *canvas) const;
+        void renderCurrentWeather(CanvasLayer *canvas, const WeatherData &data);
+        void renderForecast(CanvasLayer *canvas, const WeatherData &data) const;
+        void renderSunriseSunset(CanvasLayer *canvas, const WeatherData &data) const;
+        void renderClock(CanvasLayer *canvas, const std::string &time) const;
+        static std::string clockText();
+        [[nodiscard]] uint64_t infoLayerKey(const RGB &theme_color, const std::string &clock) const;
         void resetStars();
         
         // Enhanced animation methods
@@ -111,7 +129,7 @@ namespace Scenes {
         void renderLightning(rgb_matrix::FrameCanvas *canvas);
         void renderSunRays(rgb_matrix::FrameCanvas *canvas, const WeatherData &data);
         void renderFogMist(rgb_matrix::FrameCanvas *canvas, const WeatherData &data);
-        void renderRainbowEffect(rgb_matrix::FrameCanvas *canvas, const WeatherData &data);
+        void renderRainbowEffect(CanvasBuffer &frame, const WeatherData &data);
         void renderAurora(rgb_matrix::FrameCanvas *canvas);
         
         // Enhanced particle effects
@@ -120,16 +138,16 @@ namespace Scenes {
         
         // Shooting star methods
         void updateShootingStars();
-        void renderShootingStars(rgb_matrix::FrameCanvas *canvas);
+        void renderShootingStars(CanvasBuffer &frame);
         void tryCreateShootingStar();
         
         // Shared rendering utilities
         static RGB interpolateColor(const RGB &start, const RGB &end, float progress) ;
-        void applyBackgroundEffects(rgb_matrix::FrameCanvas *canvas, const RGB &base_color);
+        void applyBackgroundEffects(CanvasBuffer &frame, const RGB &base_color);
         
         // Visual styling helpers
-        void drawWeatherBorder(rgb_matrix::FrameCanvas *canvas, const RGB &color, int brightness_mod) const;
-        void drawPrecipitationIndicator(rgb_matrix::FrameCanvas *canvas, float probability, int x, int y) const;
+        void drawWeatherBorder(CanvasLayer *canvas, const RGB &color, int brightness_mod) const;
+        void drawPrecipitationIndicator(CanvasLayer *canvas, float probability, int x, int y) const;
 
         // Location properties
         PropertyPointer<std::string> location_lat = MAKE_PROPERTY("location_lat", std::string, "52.5200");
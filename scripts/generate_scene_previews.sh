@@ -18,6 +18,7 @@
 #   --frames <n>             Total frames per GIF (default: 90 = 6s @ 15fps)
 #   --width <n>              Matrix width in pixels (default: 128)
 #   --height <n>             Matrix height in pixels (default: 128)
+#   --jobs <n>               Scenes rendered in parallel (default: number of cores)
 #   --build-dir <dir>        Build directory (default: emulator_build)
 #   --skip-validation        Skip checking if emulator binary exists
 #   --dry-run                Show what would be done without executing
@@ -69,6 +70,7 @@ FPS=15
 FRAMES=90
 WIDTH=128
 HEIGHT=128
+JOBS=0
 SKIP_VALIDATION=0
 DRY_RUN=0
 
@@ -132,6 +134,10 @@ while [[ $# -gt 0 ]]; do
         HEIGHT="$2"
         shift 2
         ;;
+    --jobs)
+        JOBS="$2"
+        shift 2
+        ;;
     --build-dir)
         BUILD_DIR="$2"
         shift 2
@@ -231,6 +237,7 @@ CMD="$CMD --fps $FPS"
 CMD="$CMD --frames $FRAMES"
 CMD="$CMD --width $WIDTH"
 CMD="$CMD --height $HEIGHT"
+CMD="$CMD --jobs $JOBS"
 
 if [[ -n "$SCENES_CSV" ]]; then
     CMD="$CMD --scenes '$SCENES_CSV'"
@@ -244,6 +251,7 @@ print_info "Configuration:"
 echo "  FPS:           $FPS"
 echo "  Frames:        $FRAMES"
 echo "  Resolution:    ${WIDTH}x${HEIGHT}"
+echo "  Jobs:          $([[ $JOBS -gt 0 ]] && echo "$JOBS" || echo "all cores")"
 echo "  Output:        $OUTPUT_DIR"
 echo "  Runtime dir:   $BUILD_INSTALL_DIR"
 echo ""
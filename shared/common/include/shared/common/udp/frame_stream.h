@@ -0,0 +1,218 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include "shared/common/macro.h"
+#include "shared/common/udp/packet.h"
+
+/// Versioned streaming format for RGB24 frames sent from the desktop app to the matrix.
+///
+/// Every frame is split into square tiles. Only tiles that changed since the previous
+/// frame are sent (keyframes carry all of them), each one optionally compressed with
+/// RLE or LZ4. Tiles are packed into fragments that fit a single MTU-sized datagram,
+/// and every fragment can be decoded on its own, so a lost datagram only loses the
+/// tiles inside it instead of the whole frame. The decoder notices gaps through the
+/// frame sequence numbers and asks for a keyframe to resynchronize.
+///
+/// Fragment layout (all integers big-endian), carried as the payload of a normal UdpPacket:
+///   0  'F' 'S'           magic
+///   2  u8  version
+///   3  u8  flags         (bit 0: keyframe)
+///   4  u32 sequence      (frame number)
+///   8  u16 width
+///  10  u16 height
+///  12  u8  tile size
+///  13  u8  fragment index
+///  14  u8  fragment count
+///  15  u8  tile count    (tiles in this fragment)
+///  16  tile records:     u16 tile index, u8 codec, u16 encoded length, encoded bytes
+namespace FrameStream
+{
+    constexpr uint8_t magic[2] = {'F', 'S'};
+    constexpr uint8_t version = 1;
+    constexpr size_t header_size = 16;
+    constexpr size_t tile_header_size = 5;
+    constexpr uint8_t keyframe_flag = 0x01;
+
+    /// Size of the UdpPacket header (magic, plugin id, u32 size) in front of every fragment.
+    constexpr size_t packet_header_size = UdpPacket::header_size;
+
+    /// Message a matrix plugin sends to the desktop app when it lost sync and needs a keyframe.
+    constexpr auto keyframe_request_message = "stream:keyframe";
+
+    enum class Codec : uint8_t
+    {
+        Raw = 0,
+        Rle = 1,
+        Lz4 = 2,
+    };
+
+    SHARED_COMMON_API std::string to_string(Codec codec);
+
+    /// Parses "raw", "rle" or "lz4", anything else maps to 'fallback'.
+    SHARED_COMMON_API Codec codec_from_string(const std::string &name, Codec fallback = Codec::Lz4);
+
+    /// Returns true if 'payload' is a structurally valid stream fragment. Legacy raw
+    /// frames never pass this check, so receivers can accept both.
+    SHARED_COMMON_API bool is_fragment(const uint8_t *payload, size_t size);
+
+    struct EncoderOptions
+    {
+        /// Tile edge length in pixels. A raw tile has to fit into one datagram, so it is capped at 20.
+        /// Small tiles find tighter dirty regions and pack densely into datagrams (seven raw 8x8 tiles
+        /// fill one), a lost datagram then damages a smaller part of the frame.
+        uint8_t tile_size = 8;
+
+        /// Upper bound for a whole datagram including the UdpPacket header.
+        /// 1472 bytes is the largest UDP payload that fits an Ethernet MTU without IP fragmentation.
+        size_t max_datagram_size = 1472;
+
+        /// Codec tried for every tile, tiles that do not get smaller are sent raw.
+        Codec codec = Codec::Lz4;
+
+        /// Frames between periodic keyframes (0 disables them).
+        uint32_t keyframe_interval = 300;
+
+        /// A frame is sent as a keyframe if more than this fraction of the tiles changed,
+        /// because it costs about the same and resynchronizes receivers that lost packets.
+        float keyframe_threshold = 0.75f;
+    };
+
+    struct EncoderStats
+    {
+        uint64_t frames = 0;
+        uint64_t keyframes = 0;
+        uint64_t tiles_sent = 0;
+        uint64_t fragments = 0;
+        uint64_t bytes = 0;
+    };
+
+    /// Desktop side: turns full frames into delta fragments. Not thread-safe.
+    class SHARED_COMMON_API Encoder
+    {
+    public:
+        explicit Encoder(EncoderOptions options = {});
+
+        /// Encodes one width x height RGB24 frame and returns the fragments, each one
+        /// the payload of its own UdpPacket. The fragments stay valid until the next call,
+        /// which reuses their buffers. Returns an empty list if the frame is too large
+        /// for 255 fragments, callers should send it raw then.
+        std::span<const std::vector<uint8_t>> encode(const uint8_t *rgb, int width, int height);
+
+        /// Makes the next frame a keyframe.
+        void force_keyframe() { keyframe_requested = true; }
+
+        void set_codec(Codec codec) { options.codec = codec; }
+
+        [[nodiscard]] const EncoderOptions &get_options() const { return options; }
+        [[nodiscard]] const EncoderStats &get_stats() const { return stats; }
+
+    private:
+        struct EncodedTile
+        {
+            uint16_t index;
+            Codec codec;
+            size_t offset;
+            size_t size;
+        };
+
+        void encode_tile(const uint8_t *rgb, int width, int height, uint16_t index);
+        bool pack_fragments(uint32_t frame_sequence, uint16_t width, uint16_t height, bool keyframe);
+
+        EncoderOptions options;
+        EncoderStats stats;
+
+        std::vector<uint8_t> reference;
+        int reference_width = 0;
+        int reference_height = 0;
+        uint32_t sequence = 0;
+        uint32_t frames_since_keyframe = 0;
+        bool keyframe_requested = true;
+
+        std::vector<uint16_t> changed_tiles;
+        std::vector<EncodedTile> tiles;
+        std::vector<uint8_t> tile_pixels;
+        std::vector<uint8_t> tile_scratch;
+        std::vector<uint8_t> tile_data;
+        std::vector<std::vector<uint8_t>> fragments;
+        size_t fragment_count = 0;
+    };
+
+    struct DecoderStats
+    {
+        uint64_t fragments = 0;
+        uint64_t frames = 0;
+        uint64_t keyframes = 0;
+        uint64_t lost_frames = 0;
+        uint64_t late_fragments = 0;
+        uint64_t corrupt_tiles = 0;
+    };
+
+    /// Matrix side: applies fragments to a full RGB24 frame. Not thread-safe, it is meant
+    /// to live on the UDP receive thread and hand completed frames over to the renderer.
+    class SHARED_COMMON_API Decoder
+    {
+    public:
+        enum class Result
+        {
+            /// Not a stream fragment.
+            Invalid,
+            /// Fragment applied (or dropped as late), the frame is not complete yet.
+            Partial,
+            /// frame() holds the new frame: either all fragments arrived, or the last one did
+            /// and the tiles of the lost ones are stale (needs_keyframe() is set then).
+            FrameComplete,
+        };
+
+        Result apply(const uint8_t *payload, size_t size);
+
+        /// The decoded frame, width() * height() * 3 bytes.
+        [[nodiscard]] const std::vector<uint8_t> &frame() const { return pixels; }
+        [[nodiscard]] int width() const { return frame_width; }
+        [[nodiscard]] int height() const { return frame_height; }
+
+        /// True while the frame may differ from the sender's, i.e. after a lost fragment,
+        /// a sequence gap or a size change. Cleared by the next complete keyframe.
+        [[nodiscard]] bool needs_keyframe() const { return !synced; }
+
+        [[nodiscard]] const DecoderStats &get_stats() const { return stats; }
+
+    private:
+        void begin_frame(uint32_t frame_sequence, uint8_t fragment_count, bool keyframe);
+        bool decode_tile(uint16_t index, Codec codec, const uint8_t *data, size_t size);
+
+        DecoderStats stats;
+
+        std::vector<uint8_t> pixels;
+        std::vector<uint8_t> tile_scratch;
+        int frame_width = 0;
+        int frame_height = 0;
+        int tile_size = 0;
+
+        bool has_frame = false;
+        bool synced = false;
+        uint32_t sequence = 0;
+        bool is_keyframe = false;
+        bool frame_damaged = false;
+        bool published = false;
+        uint8_t expected_fragments = 0;
+        uint8_t received_fragments = 0;
+        uint64_t received_mask[4] = {};
+    };
+}
+
+/// A full RGB24 frame. Packets deriving from this can be sent as a FrameStream
+/// instead of one large datagram, see WebsocketClient::threadLoop.
+struct SHARED_COMMON_API FramePacket : UdpPacket
+{
+    std::vector<uint8_t> rgb;
+    uint16_t width;
+    uint16_t height;
+
+    FramePacket(uint8_t plId, std::vector<uint8_t> rgbData, uint16_t frameWidth, uint16_t frameHeight);
+
+    [[nodiscard]] std::vector<uint8_t> toData() const override;
+    [[nodiscard]] std::span<const uint8_t> dataView() const override { return rgb; }
+    void writeData(std::vector<uint8_t> &out) const override;
+};
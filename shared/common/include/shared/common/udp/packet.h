@@ -1,9 +1,15 @@
 #pragma once
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <vector>
 #include "shared/common/macro.h"
 
 struct SHARED_COMMON_API UdpPacket {
+    /// Magic (2 bytes), plugin id and the big-endian u32 payload size.
+    static constexpr size_t header_size = 7;
+
     virtual ~UdpPacket() = default;
 
     uint8_t pluginId;
@@ -13,5 +19,28 @@ struct SHARED_COMMON_API UdpPacket {
 
     [[nodiscard]] virtual std::vector<uint8_t> toData() const = 0;
 
+    /// The payload without copying, for packets that already hold it in one buffer.
+    /// Empty if the packet has to be serialized with writeData() instead.
+    [[nodiscard]] virtual std::span<const uint8_t> dataView() const { return {}; }
+
+    /// Replaces the contents of 'out' with the payload, reusing its capacity.
+    /// The default goes through toData(); override it to skip that temporary vector.
+    virtual void writeData(std::vector<uint8_t> &out) const;
+
+    /// A serialized packet as two pieces (header and payload) for scatter-gather sends.
+    struct View {
+        std::array<uint8_t, header_size> header;
+        std::span<const uint8_t> payload;
+    };
+
+    /// Serializes without allocating once 'scratch' has grown to the payload size.
+    /// The payload points into the packet or into 'scratch', so both must outlive the view.
+    [[nodiscard]] View view(std::vector<uint8_t> &scratch) const;
+
+    /// Writes header and payload into 'out', reusing its capacity.
+    void serializeInto(std::vector<uint8_t> &out) const;
+
     [[nodiscard]] std::vector<uint8_t> toBytes() const;
+
+    static void writeHeader(uint8_t *out, uint8_t pluginId, uint32_t payloadSize);
 };
@@ -0,0 +1,110 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "shared/common/macro.h"
+
+/// Shared-memory transport between the desktop app and a matrix running on the same machine.
+///
+/// The matrix owns a memfd holding a single-producer single-consumer ring and an eventfd,
+/// and hands both to the desktop app over a UNIX socket (SCM_RIGHTS). The desktop app
+/// writes packets straight into the ring in the same wire format as UDP datagrams
+/// (0xAD 0x01, plugin id, u32 size, payload) and bumps the eventfd. The matrix copies
+/// every packet out of the ring before it validates and dispatches it to the plugins,
+/// exactly like datagrams, so no socket stack is involved and every packet is copied
+/// once on each side.
+///
+/// Ring records are a u32 length followed by the packet bytes, padded to 8 bytes. A
+/// length of UINT32_MAX marks the unused end of the buffer before the writer wrapped.
+/// Like UDP, a full ring drops packets instead of blocking the sender.
+namespace ShmTransport
+{
+    constexpr uint32_t ring_magic = 0x4C4D5352; // "LMSR"
+    constexpr uint32_t ring_version = 1;
+
+    /// Room for about 80 raw 128x128 frames.
+    constexpr size_t default_capacity = 4 * 1024 * 1024;
+
+    /// The ring data starts one page into the mapping, after the header.
+    constexpr size_t data_offset = 4096;
+
+    /// Name of the abstract UNIX socket the matrix listens on for the given HTTP/UDP port.
+    SHARED_COMMON_API std::string socket_name(uint16_t port);
+
+    /// Sent by the matrix together with the memfd and the eventfd.
+    struct Hello
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t mapping_size;
+    };
+
+    struct RingHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t capacity;
+
+        /// Positions grow monotonically, the buffer offset is position & (capacity - 1).
+        alignas(64) std::atomic<uint64_t> head;
+        alignas(64) std::atomic<uint64_t> tail;
+        alignas(64) std::atomic<uint64_t> dropped;
+    };
+
+    static_assert(sizeof(RingHeader) <= data_offset);
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "ring positions are shared between processes");
+
+    /// Formats a mapping of 'mapping_size' bytes as an empty ring. Returns false if the
+    /// size leaves no power-of-two data area.
+    SHARED_COMMON_API bool init_ring(void *mapping, size_t mapping_size);
+
+    /// Returns true if 'mapping' holds a ring created by init_ring() that fits 'mapping_size'.
+    SHARED_COMMON_API bool is_valid_ring(const void *mapping, size_t mapping_size);
+
+    /// Producer side, used by the desktop app.
+    class SHARED_COMMON_API RingWriter
+    {
+    public:
+        /// 'mapping' must have passed is_valid_ring().
+        explicit RingWriter(void *mapping);
+
+        /// Writes one packet. Returns false (and counts a drop) if the ring is full.
+        bool write(uint8_t pluginId, const uint8_t *payload, size_t size);
+
+    private:
+        RingHeader *header;
+        uint8_t *data;
+        uint64_t mask;
+    };
+
+    /// Consumer side, used by the matrix.
+    class SHARED_COMMON_API RingReader
+    {
+    public:
+        /// Called with one packet in wire format. The bytes are a copy the writer cannot
+        /// change, valid until the handler returns.
+        using PacketHandler = std::function<void(const uint8_t *packet, size_t size)>;
+
+        /// 'mapping' must have been set up with init_ring() by the caller. The ring geometry
+        /// is read once here, so a misbehaving writer cannot make the reader leave the mapping.
+        explicit RingReader(void *mapping);
+
+        /// Hands all packets written so far to 'handler'. Returns the number of packets.
+        /// Records that do not make sense (the ring is writable by the other process)
+        /// discard everything up to the current write position. Each packet is copied
+        /// out first, so the writer cannot change it while the handler checks and uses it.
+        size_t drain(const PacketHandler &handler);
+
+        [[nodiscard]] uint64_t dropped() const { return header->dropped.load(std::memory_order_relaxed); }
+
+    private:
+        RingHeader *header;
+        const uint8_t *data;
+        uint64_t mask;
+        /// The packet being handled, reused so draining does not allocate
+        std::vector<uint8_t> packet;
+    };
+}
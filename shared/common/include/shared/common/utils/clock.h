@@ -0,0 +1,137 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include "shared/common/macro.h"
+#include "shared/common/utils/utils.h"
+
+/// Time source of the scenes: frame pacing, FrameTimer, scene durations, transitions,
+/// post-processing effects and animations timed with Clock::wall_millis(). Normally the
+/// real clock; the matrix can run on a scaled or stepped one (see Settings) and tools
+/// like preview_gen swap in a virtual one so scenes can be rendered faster than real
+/// time. GetTimeInMillis() and SleepMillis() always use real time, so polling loops,
+/// token expiry and update checks are not affected.
+namespace Clock
+{
+    class Source
+    {
+    public:
+        virtual ~Source() = default;
+
+        /// Monotonic time since some fixed point.
+        virtual std::chrono::nanoseconds now() = 0;
+
+        /// Wall clock milliseconds since the epoch.
+        virtual tmillis_t wall_millis() = 0;
+
+        virtual void sleep_for(std::chrono::nanoseconds duration) = 0;
+
+        /// Called by the render loop after every frame it put on the panel.
+        virtual void frame_presented()
+        {
+        }
+    };
+
+    class SHARED_COMMON_API RealSource final : public Source
+    {
+    public:
+        std::chrono::nanoseconds now() override;
+        tmillis_t wall_millis() override;
+        void sleep_for(std::chrono::nanoseconds duration) override;
+    };
+
+    /// Real time sped up (or slowed down) by 'factor': a scene with a 30s duration
+    /// runs for 15 real seconds at factor 2, and its frames are paced accordingly.
+    class SHARED_COMMON_API ScaledSource final : public Source
+    {
+    public:
+        explicit ScaledSource(double factor);
+
+        std::chrono::nanoseconds now() override;
+        tmillis_t wall_millis() override;
+        void sleep_for(std::chrono::nanoseconds duration) override;
+
+    private:
+        std::chrono::nanoseconds elapsed() const;
+
+        double factor;
+        std::chrono::steady_clock::time_point real_start;
+        tmillis_t wall_start_ms;
+    };
+
+    /// Only moves when advanced or slept on, so sleeping costs nothing and the same
+    /// sequence of calls always sees the same times.
+    class SHARED_COMMON_API VirtualSource final : public Source
+    {
+    public:
+        /// 'wall_start_ms' is what wall_millis() returns before the clock was advanced.
+        /// With a 'frame_step', every presented frame takes at least that long, so
+        /// scenes that never sleep still see time pass.
+        explicit VirtualSource(tmillis_t wall_start_ms,
+                               std::chrono::nanoseconds frame_step = std::chrono::nanoseconds::zero());
+
+        std::chrono::nanoseconds now() override;
+        tmillis_t wall_millis() override;
+        void sleep_for(std::chrono::nanoseconds duration) override;
+        void frame_presented() override;
+
+        void advance(std::chrono::nanoseconds duration);
+
+    private:
+        tmillis_t wall_start_ms;
+        std::chrono::nanoseconds frame_step;
+        std::atomic<int64_t> elapsed_ns{0};
+        /// Only touched by frame_presented(), i.e. the render loop
+        int64_t last_frame_ns = 0;
+    };
+
+    /// Which source the matrix starts with. Read from the environment:
+    /// MATRIX_CLOCK is "real" (default), "scaled" or "stepped", MATRIX_CLOCK_SCALE
+    /// (0.01-100, default 1) is the factor of the scaled clock and MATRIX_CLOCK_STEP_MS
+    /// (1-1000, default 16) the virtual time every frame takes on the stepped clock.
+    struct SHARED_COMMON_API Settings
+    {
+        enum class Mode
+        {
+            Real,
+            Scaled,
+            Stepped
+        };
+
+        Mode mode = Mode::Real;
+        double scale = 1.0;
+        tmillis_t step_ms = 16;
+
+        static Settings from_env();
+
+        std::shared_ptr<Source> create_source() const;
+    };
+
+    /// Replaces the process-wide source. Meant to be called at startup or between
+    /// scenes; replaced sources are kept alive for threads still reading them.
+    SHARED_COMMON_API void set_source(std::shared_ptr<Source> source);
+
+    SHARED_COMMON_API Source &source();
+
+    inline std::chrono::nanoseconds now()
+    {
+        return source().now();
+    }
+
+    /// Wall clock milliseconds as the scenes see them, GetTimeInMillis() on scene time.
+    inline tmillis_t wall_millis()
+    {
+        return source().wall_millis();
+    }
+
+    inline void sleep_for(const std::chrono::nanoseconds duration)
+    {
+        source().sleep_for(duration);
+    }
+
+    inline void frame_presented()
+    {
+        source().frame_presented();
+    }
+}
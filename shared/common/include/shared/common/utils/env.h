@@ -0,0 +1,18 @@
+#pragma once
+#include <climits>
+#include <cstddef>
+#include <initializer_list>
+#include <string_view>
+#include "shared/common/macro.h"
+
+// Settings from environment variables. An unset or empty variable gives 'fallback', a
+// value that does not parse is logged and ignored, numbers are clamped to [min, max].
+
+SHARED_COMMON_API int env_int(const char *name, int fallback, int min = INT_MIN, int max = INT_MAX);
+
+/// Non-finite values count as invalid.
+SHARED_COMMON_API double env_number(const char *name, double fallback, double min, double max);
+
+/// Index of the value in 'choices', 'fallback' if it is none of them.
+SHARED_COMMON_API size_t env_choice(const char *name, std::initializer_list<std::string_view> choices,
+                                    size_t fallback = 0);
@@ -0,0 +1,496 @@
+#include "shared/common/udp/frame_stream.h"
+#include <algorithm>
+#include <cstring>
+#include <lz4.h>
+
+namespace
+{
+    constexpr uint8_t min_tile_size = 4;
+    constexpr uint8_t max_tile_size = 20;
+    constexpr size_t max_fragments = 255;
+    constexpr size_t max_tiles_per_fragment = 255;
+
+    void write_u16(uint8_t *out, uint16_t value)
+    {
+        out[0] = static_cast<uint8_t>(value >> 8);
+        out[1] = static_cast<uint8_t>(value);
+    }
+
+    void write_u32(uint8_t *out, uint32_t value)
+    {
+        out[0] = static_cast<uint8_t>(value >> 24);
+        out[1] = static_cast<uint8_t>(value >> 16);
+        out[2] = static_cast<uint8_t>(value >> 8);
+        out[3] = static_cast<uint8_t>(value);
+    }
+
+    uint16_t read_u16(const uint8_t *in)
+    {
+        return static_cast<uint16_t>(in[0] << 8 | in[1]);
+    }
+
+    uint32_t read_u32(const uint8_t *in)
+    {
+        return static_cast<uint32_t>(in[0]) << 24 | static_cast<uint32_t>(in[1]) << 16 |
+               static_cast<uint32_t>(in[2]) << 8 | static_cast<uint32_t>(in[3]);
+    }
+
+    struct TileRect
+    {
+        int x, y, width, height;
+    };
+
+    TileRect tile_rect(uint16_t index, int width, int height, int tile_size)
+    {
+        const int tiles_x = (width + tile_size - 1) / tile_size;
+        const int x = index % tiles_x * tile_size;
+        const int y = index / tiles_x * tile_size;
+        return {x, y, std::min(tile_size, width - x), std::min(tile_size, height - y)};
+    }
+
+    size_t tile_count(int width, int height, int tile_size)
+    {
+        return static_cast<size_t>((width + tile_size - 1) / tile_size) * ((height + tile_size - 1) / tile_size);
+    }
+
+    /// Run-length encodes RGB24 pixels as (count, r, g, b) quadruples. Returns false as soon
+    /// as the output would reach 'limit' bytes.
+    bool rle_encode(const uint8_t *pixels, size_t pixel_count, std::vector<uint8_t> &out, size_t limit)
+    {
+        out.clear();
+        size_t i = 0;
+        while (i < pixel_count)
+        {
+            const uint8_t *pixel = pixels + i * 3;
+            size_t run = 1;
+            while (i + run < pixel_count && run < 255 && std::memcmp(pixel, pixels + (i + run) * 3, 3) == 0)
+                run++;
+
+            if (out.size() + 4 >= limit)
+                return false;
+
+            out.push_back(static_cast<uint8_t>(run));
+            out.insert(out.end(), pixel, pixel + 3);
+            i += run;
+        }
+        return true;
+    }
+
+    bool rle_decode(const uint8_t *data, size_t size, uint8_t *out, size_t out_size)
+    {
+        if (size % 4 != 0)
+            return false;
+
+        size_t written = 0;
+        for (size_t i = 0; i < size; i += 4)
+        {
+            const size_t run = data[i];
+            if (run == 0 || written + run * 3 > out_size)
+                return false;
+
+            for (size_t p = 0; p < run; ++p, written += 3)
+                std::memcpy(out + written, data + i + 1, 3);
+        }
+        return written == out_size;
+    }
+}
+
+namespace FrameStream
+{
+    std::string to_string(Codec codec)
+    {
+        switch (codec)
+        {
+        case Codec::Raw:
+            return "raw";
+        case Codec::Rle:
+            return "rle";
+        case Codec::Lz4:
+            return "lz4";
+        }
+        return "raw";
+    }
+
+    Codec codec_from_string(const std::string &name, Codec fallback)
+    {
+        if (name == "raw")
+            return Codec::Raw;
+        if (name == "rle")
+            return Codec::Rle;
+        if (name == "lz4")
+            return Codec::Lz4;
+        return fallback;
+    }
+
+    bool is_fragment(const uint8_t *payload, size_t size)
+    {
+        if (size < header_size || payload[0] != magic[0] || payload[1] != magic[1] || payload[2] != version)
+            return false;
+
+        const uint16_t width = read_u16(payload + 8);
+        const uint16_t height = read_u16(payload + 10);
+        const uint8_t tile_size = payload[12];
+        const uint8_t fragment_index = payload[13];
+        const uint8_t fragment_count = payload[14];
+        if (width == 0 || height == 0 || tile_size < min_tile_size || tile_size > max_tile_size ||
+            fragment_count == 0 || fragment_index >= fragment_count)
+            return false;
+
+        // The tile records have to fill the fragment exactly
+        const size_t tiles = tile_count(width, height, tile_size);
+        const size_t max_tile_bytes = static_cast<size_t>(tile_size) * tile_size * 3;
+        size_t offset = header_size;
+        for (uint8_t i = 0; i < payload[15]; ++i)
+        {
+            if (offset + tile_header_size > size)
+                return false;
+
+            const uint16_t index = read_u16(payload + offset);
+            const uint8_t codec = payload[offset + 2];
+            const uint16_t length = read_u16(payload + offset + 3);
+            if (index >= tiles || codec > static_cast<uint8_t>(Codec::Lz4) || length == 0 || length > max_tile_bytes)
+                return false;
+
+            offset += tile_header_size + length;
+        }
+        return offset == size;
+    }
+
+    // ─── Encoder ─────────────────────────────────────────────────────────────
+
+    Encoder::Encoder(EncoderOptions options) : options(options)
+    {
+        this->options.tile_size = std::clamp(options.tile_size, min_tile_size, max_tile_size);
+        this->options.max_datagram_size = std::max(options.max_datagram_size,
+                                                   packet_header_size + header_size + tile_header_size +
+                                                       static_cast<size_t>(this->options.tile_size) * this->options.tile_size * 3);
+    }
+
+    std::span<const std::vector<uint8_t>> Encoder::encode(const uint8_t *rgb, int width, int height)
+    {
+        if (width <= 0 || height <= 0 || width > UINT16_MAX || height > UINT16_MAX)
+            return {};
+
+        const int ts = options.tile_size;
+        const size_t total_tiles = tile_count(width, height, ts);
+        if (total_tiles > UINT16_MAX)
+            return {};
+
+        const size_t frame_bytes = static_cast<size_t>(width) * height * 3;
+        bool keyframe = keyframe_requested || width != reference_width || height != reference_height ||
+                        (options.keyframe_interval > 0 && frames_since_keyframe >= options.keyframe_interval);
+
+        changed_tiles.clear();
+        if (!keyframe)
+        {
+            for (size_t index = 0; index < total_tiles; ++index)
+            {
+                const auto rect = tile_rect(static_cast<uint16_t>(index), width, height, ts);
+                for (int y = rect.y; y < rect.y + rect.height; ++y)
+                {
+                    const size_t offset = (static_cast<size_t>(y) * width + rect.x) * 3;
+                    if (std::memcmp(rgb + offset, reference.data() + offset, static_cast<size_t>(rect.width) * 3) != 0)
+                    {
+                        changed_tiles.push_back(static_cast<uint16_t>(index));
+                        break;
+                    }
+                }
+            }
+
+            keyframe = static_cast<float>(changed_tiles.size()) > options.keyframe_threshold * static_cast<float>(total_tiles);
+        }
+
+        if (keyframe)
+        {
+            changed_tiles.resize(total_tiles);
+            for (size_t index = 0; index < total_tiles; ++index)
+                changed_tiles[index] = static_cast<uint16_t>(index);
+        }
+
+        tiles.clear();
+        tile_data.clear();
+        for (const uint16_t index : changed_tiles)
+            encode_tile(rgb, width, height, index);
+
+        if (!pack_fragments(sequence, static_cast<uint16_t>(width), static_cast<uint16_t>(height), keyframe))
+        {
+            // Too large to stream, the caller sends the raw frame. The receiver cannot
+            // apply deltas on top of that, so start over with a keyframe.
+            keyframe_requested = true;
+            return {};
+        }
+
+        reference.assign(rgb, rgb + frame_bytes);
+        reference_width = width;
+        reference_height = height;
+        keyframe_requested = false;
+        frames_since_keyframe = keyframe ? 0 : frames_since_keyframe + 1;
+        sequence++;
+
+        stats.frames++;
+        stats.keyframes += keyframe;
+        stats.tiles_sent += tiles.size();
+        stats.fragments += fragment_count;
+        for (size_t i = 0; i < fragment_count; ++i)
+            stats.bytes += fragments[i].size() + packet_header_size;
+
+        return {fragments.data(), fragment_count};
+    }
+
+    void Encoder::encode_tile(const uint8_t *rgb, int width, int height, uint16_t index)
+    {
+        const auto rect = tile_rect(index, width, height, options.tile_size);
+        const size_t row_bytes = static_cast<size_t>(rect.width) * 3;
+        const size_t raw_size = row_bytes * rect.height;
+
+        tile_pixels.resize(raw_size);
+        for (int row = 0; row < rect.height; ++row)
+        {
+            const size_t offset = (static_cast<size_t>(rect.y + row) * width + rect.x) * 3;
+            std::memcpy(tile_pixels.data() + row * row_bytes, rgb + offset, row_bytes);
+        }
+
+        // Compressed tiles are only used if they are smaller than the raw pixels
+        Codec codec = Codec::Raw;
+        if (options.codec == Codec::Rle)
+        {
+            if (rle_encode(tile_pixels.data(), raw_size / 3, tile_scratch, raw_size))
+                codec = Codec::Rle;
+        }
+        else if (options.codec == Codec::Lz4)
+        {
+            tile_scratch.resize(raw_size);
+            const int compressed = LZ4_compress_default(reinterpret_cast<const char *>(tile_pixels.data()),
+                                                        reinterpret_cast<char *>(tile_scratch.data()),
+                                                        static_cast<int>(raw_size), static_cast<int>(raw_size - 1));
+            if (compressed > 0)
+            {
+                tile_scratch.resize(compressed);
+                codec = Codec::Lz4;
+            }
+        }
+
+        const auto &encoded = codec == Codec::Raw ? tile_pixels : tile_scratch;
+        tiles.push_back({index, codec, tile_data.size(), encoded.size()});
+        tile_data.insert(tile_data.end(), encoded.begin(), encoded.end());
+    }
+
+    bool Encoder::pack_fragments(uint32_t frame_sequence, uint16_t width, uint16_t height, bool keyframe)
+    {
+        const size_t max_payload = options.max_datagram_size - packet_header_size;
+
+        fragment_count = 0;
+        auto start_fragment = [&]() -> bool
+        {
+            if (fragment_count == max_fragments)
+                return false;
+
+            if (fragments.size() <= fragment_count)
+                fragments.emplace_back();
+
+            auto &fragment = fragments[fragment_count++];
+            fragment.resize(header_size);
+            fragment[0] = magic[0];
+            fragment[1] = magic[1];
+            fragment[2] = version;
+            fragment[3] = keyframe ? keyframe_flag : 0;
+            write_u32(fragment.data() + 4, frame_sequence);
+            write_u16(fragment.data() + 8, width);
+            write_u16(fragment.data() + 10, height);
+            fragment[12] = options.tile_size;
+            fragment[15] = 0;
+            return true;
+        };
+
+        // A frame without changes still sends an empty fragment, so the receiver sees
+        // the sequence number advance and knows the sender is alive.
+        start_fragment();
+        for (const auto &tile : tiles)
+        {
+            auto *fragment = &fragments[fragment_count - 1];
+            if (fragment->size() + tile_header_size + tile.size > max_payload || (*fragment)[15] == max_tiles_per_fragment)
+            {
+                if (!start_fragment())
+                    return false;
+                fragment = &fragments[fragment_count - 1];
+            }
+
+            uint8_t tile_header[tile_header_size];
+            write_u16(tile_header, tile.index);
+            tile_header[2] = static_cast<uint8_t>(tile.codec);
+            write_u16(tile_header + 3, static_cast<uint16_t>(tile.size));
+
+            fragment->insert(fragment->end(), tile_header, tile_header + tile_header_size);
+            fragment->insert(fragment->end(), tile_data.begin() + tile.offset, tile_data.begin() + tile.offset + tile.size);
+            (*fragment)[15]++;
+        }
+
+        for (size_t i = 0; i < fragment_count; ++i)
+        {
+            fragments[i][13] = static_cast<uint8_t>(i);
+            fragments[i][14] = static_cast<uint8_t>(fragment_count);
+        }
+        return true;
+    }
+
+    // ─── Decoder ─────────────────────────────────────────────────────────────
+
+    Decoder::Result Decoder::apply(const uint8_t *payload, size_t size)
+    {
+        if (!is_fragment(payload, size))
+            return Result::Invalid;
+
+        stats.fragments++;
+        const bool keyframe = payload[3] & keyframe_flag;
+        const uint32_t frame_sequence = read_u32(payload + 4);
+        const uint16_t width = read_u16(payload + 8);
+        const uint16_t height = read_u16(payload + 10);
+        const uint8_t fragment_index = payload[13];
+        const uint8_t fragment_count = payload[14];
+
+        if (has_frame)
+        {
+            const auto age = static_cast<int32_t>(frame_sequence - sequence);
+            if (age < 0)
+            {
+                stats.late_fragments++;
+                return Result::Partial;
+            }
+            if (age > 0)
+                begin_frame(frame_sequence, fragment_count, keyframe);
+        }
+        else
+        {
+            begin_frame(frame_sequence, fragment_count, keyframe);
+        }
+
+        if (width != frame_width || height != frame_height || payload[12] != tile_size)
+        {
+            frame_width = width;
+            frame_height = height;
+            tile_size = payload[12];
+            pixels.assign(static_cast<size_t>(width) * height * 3, 0);
+            synced = false;
+        }
+
+        uint64_t &mask = received_mask[fragment_index / 64];
+        const uint64_t bit = uint64_t{1} << (fragment_index % 64);
+        if (mask & bit || fragment_count != expected_fragments)
+        {
+            stats.late_fragments++;
+            return Result::Partial;
+        }
+        mask |= bit;
+
+        size_t offset = header_size;
+        for (uint8_t i = 0; i < payload[15]; ++i)
+        {
+            const uint16_t index = read_u16(payload + offset);
+            const auto codec = static_cast<Codec>(payload[offset + 2]);
+            const uint16_t length = read_u16(payload + offset + 3);
+            if (!decode_tile(index, codec, payload + offset + tile_header_size, length))
+            {
+                stats.corrupt_tiles++;
+                frame_damaged = true;
+                synced = false;
+            }
+            offset += tile_header_size + length;
+        }
+
+        // Fragments are sent in order, so the last one normally arrives last. If some in between
+        // were lost, the frame is published anyway, only their tiles show the previous frame.
+        ++received_fragments;
+        if (published || (received_fragments < expected_fragments && fragment_index + 1 < expected_fragments))
+            return Result::Partial;
+
+        published = true;
+        if (received_fragments < expected_fragments)
+        {
+            frame_damaged = true;
+            synced = false;
+        }
+
+        stats.frames++;
+        if (is_keyframe)
+        {
+            stats.keyframes++;
+            if (!frame_damaged)
+                synced = true;
+        }
+        return Result::FrameComplete;
+    }
+
+    void Decoder::begin_frame(uint32_t frame_sequence, uint8_t fragment_count, bool keyframe)
+    {
+        if (has_frame)
+        {
+            const uint32_t skipped = frame_sequence - sequence - 1;
+            const bool incomplete = received_fragments < expected_fragments;
+            if (skipped > 0 || incomplete)
+            {
+                stats.lost_frames += skipped + incomplete;
+                synced = false;
+            }
+        }
+
+        has_frame = true;
+        sequence = frame_sequence;
+        is_keyframe = keyframe;
+        frame_damaged = false;
+        published = false;
+        expected_fragments = fragment_count;
+        received_fragments = 0;
+        std::fill(std::begin(received_mask), std::end(received_mask), 0);
+    }
+
+    bool Decoder::decode_tile(uint16_t index, Codec codec, const uint8_t *data, size_t size)
+    {
+        const auto rect = tile_rect(index, frame_width, frame_height, tile_size);
+        const size_t row_bytes = static_cast<size_t>(rect.width) * 3;
+        const size_t raw_size = row_bytes * rect.height;
+
+        const uint8_t *tile_pixels = data;
+        switch (codec)
+        {
+        case Codec::Raw:
+            if (size != raw_size)
+                return false;
+            break;
+        case Codec::Rle:
+            tile_scratch.resize(raw_size);
+            if (!rle_decode(data, size, tile_scratch.data(), raw_size))
+                return false;
+            tile_pixels = tile_scratch.data();
+            break;
+        case Codec::Lz4:
+            tile_scratch.resize(raw_size);
+            if (LZ4_decompress_safe(reinterpret_cast<const char *>(data), reinterpret_cast<char *>(tile_scratch.data()),
+                                    static_cast<int>(size), static_cast<int>(raw_size)) != static_cast<int>(raw_size))
+                return false;
+            tile_pixels = tile_scratch.data();
+            break;
+        }
+
+        for (int row = 0; row < rect.height; ++row)
+        {
+            const size_t offset = (static_cast<size_t>(rect.y + row) * frame_width + rect.x) * 3;
+            std::memcpy(pixels.data() + offset, tile_pixels + row * row_bytes, row_bytes);
+        }
+        return true;
+    }
+}
+
+FramePacket::FramePacket(uint8_t plId, std::vector<uint8_t> rgbData, uint16_t frameWidth, uint16_t frameHeight)
+    : UdpPacket(plId), rgb(std::move(rgbData)), width(frameWidth), height(frameHeight)
+{
+}
+
+std::vector<uint8_t> FramePacket::toData() const
+{
+    return rgb;
+}
+
+void FramePacket::writeData(std::vector<uint8_t> &out) const
+{
+    out.assign(rgb.begin(), rgb.end());
+}
@@ -1,19 +1,50 @@
 #include "shared/common/udp/packet.h"
+#include <cstring>
 
-std::vector<uint8_t> UdpPacket::toBytes() const {
-     std::vector<uint8_t> data = toData();
+void UdpPacket::writeData(std::vector<uint8_t> &out) const {
+     const auto data = toData();
+     out.assign(data.begin(), data.end());
+}
+
+UdpPacket::View UdpPacket::view(std::vector<uint8_t> &scratch) const {
+     View result{};
+     result.payload = dataView();
+     if (result.payload.empty()) {
+          writeData(scratch);
+          result.payload = scratch;
+     }
+
+     writeHeader(result.header.data(), pluginId, static_cast<uint32_t>(result.payload.size()));
+     return result;
+}
+
+void UdpPacket::serializeInto(std::vector<uint8_t> &out) const {
+     if (const auto payload = dataView(); !payload.empty()) {
+          out.resize(header_size + payload.size());
+          std::memcpy(out.data() + header_size, payload.data(), payload.size());
+     } else {
+          // Let the packet write its payload first, then make room for the header in front
+          writeData(out);
+          out.insert(out.begin(), header_size, 0);
+     }
 
+     writeHeader(out.data(), pluginId, static_cast<uint32_t>(out.size() - header_size));
+}
+
+std::vector<uint8_t> UdpPacket::toBytes() const {
      std::vector<uint8_t> packet;
-     packet.push_back(0xAD); // Magic byte
-     packet.push_back(0x01); // Magic byte
-     packet.push_back(pluginId); // Version byte
-
-     uint32_t payload_size = static_cast<uint32_t>(data.size());
-     // Insert size as 4 bytes (big-endian / network order)
-     packet.push_back(static_cast<uint8_t>((payload_size >> 24) & 0xFF));
-     packet.push_back(static_cast<uint8_t>((payload_size >> 16) & 0xFF));
-     packet.push_back(static_cast<uint8_t>((payload_size >> 8) & 0xFF));
-     packet.push_back(static_cast<uint8_t>(payload_size & 0xFF));
-     packet.insert(packet.end(), data.begin(), data.end());
+     serializeInto(packet);
      return packet;
- }
\ No newline at end of file
+}
+
+void UdpPacket::writeHeader(uint8_t *out, const uint8_t pluginId, const uint32_t payloadSize) {
+     out[0] = 0xAD; // Magic byte
+     out[1] = 0x01; // Magic byte
+     out[2] = pluginId;
+
+     // Size as 4 bytes (big-endian / network order)
+     out[3] = static_cast<uint8_t>((payloadSize >> 24) & 0xFF);
+     out[4] = static_cast<uint8_t>((payloadSize >> 16) & 0xFF);
+     out[5] = static_cast<uint8_t>((payloadSize >> 8) & 0xFF);
+     out[6] = static_cast<uint8_t>(payloadSize & 0xFF);
+}
@@ -0,0 +1,150 @@
+#include "shared/common/udp/shm_ring.h"
+#include "shared/common/udp/packet.h"
+#include <bit>
+#include <cstring>
+#include <new>
+
+namespace
+{
+    constexpr uint32_t wrap_marker = UINT32_MAX;
+    constexpr size_t length_size = sizeof(uint32_t);
+    constexpr size_t packet_header_size = UdpPacket::header_size;
+
+    constexpr uint64_t record_size(size_t packet_size)
+    {
+        return (length_size + packet_size + 7) & ~uint64_t{7};
+    }
+}
+
+namespace ShmTransport
+{
+    std::string socket_name(uint16_t port)
+    {
+        return "led-matrix-shm-" + std::to_string(port);
+    }
+
+    bool init_ring(void *mapping, size_t mapping_size)
+    {
+        if (mapping_size <= data_offset)
+            return false;
+
+        const uint64_t capacity = std::bit_floor(static_cast<uint64_t>(mapping_size - data_offset));
+        if (capacity < 4096)
+            return false;
+
+        auto *header = new (mapping) RingHeader{};
+        header->magic = ring_magic;
+        header->version = ring_version;
+        header->capacity = capacity;
+        return true;
+    }
+
+    bool is_valid_ring(const void *mapping, size_t mapping_size)
+    {
+        if (mapping_size <= data_offset)
+            return false;
+
+        const auto *header = static_cast<const RingHeader *>(mapping);
+        return header->magic == ring_magic && header->version == ring_version &&
+               std::has_single_bit(header->capacity) && header->capacity <= mapping_size - data_offset;
+    }
+
+    // ─── Writer ──────────────────────────────────────────────────────────────
+
+    RingWriter::RingWriter(void *mapping)
+        : header(static_cast<RingHeader *>(mapping)),
+          data(static_cast<uint8_t *>(mapping) + data_offset),
+          mask(header->capacity - 1)
+    {
+    }
+
+    bool RingWriter::write(uint8_t pluginId, const uint8_t *payload, size_t size)
+    {
+        const uint64_t capacity = mask + 1;
+        const uint64_t record = record_size(packet_header_size + size);
+        if (record > capacity / 2)
+        {
+            header->dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        uint64_t head = header->head.load(std::memory_order_relaxed);
+        const uint64_t tail = header->tail.load(std::memory_order_acquire);
+
+        // Records never wrap around, the rest of the buffer is skipped instead
+        const uint64_t contiguous = capacity - (head & mask);
+        const uint64_t skip = contiguous < record ? contiguous : 0;
+        if (head + skip + record - tail > capacity)
+        {
+            header->dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        if (skip > 0)
+        {
+            std::memcpy(data + (head & mask), &wrap_marker, length_size);
+            head += skip;
+        }
+
+        uint8_t *out = data + (head & mask);
+        const auto packet_size = static_cast<uint32_t>(packet_header_size + size);
+        std::memcpy(out, &packet_size, length_size);
+        out += length_size;
+
+        UdpPacket::writeHeader(out, pluginId, static_cast<uint32_t>(size));
+        if (size > 0)
+            std::memcpy(out + packet_header_size, payload, size);
+
+        header->head.store(head + record, std::memory_order_release);
+        return true;
+    }
+
+    // ─── Reader ──────────────────────────────────────────────────────────────
+
+    RingReader::RingReader(void *mapping)
+        : header(static_cast<RingHeader *>(mapping)),
+          data(static_cast<const uint8_t *>(mapping) + data_offset),
+          mask(header->capacity - 1)
+    {
+    }
+
+    size_t RingReader::drain(const PacketHandler &handler)
+    {
+        const uint64_t capacity = mask + 1;
+        uint64_t tail = header->tail.load(std::memory_order_relaxed);
+        const uint64_t head = header->head.load(std::memory_order_acquire);
+
+        size_t packets = 0;
+        while (tail != head)
+        {
+            const uint64_t offset = tail & mask;
+            const uint64_t available = head - tail;
+
+            uint32_t length;
+            std::memcpy(&length, data + offset, length_size);
+            if (length == wrap_marker && capacity - offset <= available)
+            {
+                tail += capacity - offset;
+                continue;
+            }
+
+            const uint64_t record = record_size(length);
+            if (available > capacity || record > available || record > capacity - offset)
+            {
+                tail = head;
+                break;
+            }
+
+            // The writer can still change the record, so the handler gets a private copy
+            packet.assign(data + offset + length_size, data + offset + length_size + length);
+            tail += record;
+            header->tail.store(tail, std::memory_order_release);
+
+            handler(packet.data(), packet.size());
+            packets++;
+        }
+
+        header->tail.store(tail, std::memory_order_release);
+        return packets;
+    }
+}
@@ -0,0 +1,160 @@
+#include "shared/common/utils/clock.h"
+#include "shared/common/utils/env.h"
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    std::shared_ptr<Clock::Source> &owned_source()
+    {
+        static std::shared_ptr<Clock::Source> source = std::make_shared<Clock::RealSource>();
+        return source;
+    }
+
+    /// Replaced sources stay alive, other threads may still be reading them.
+    std::vector<std::shared_ptr<Clock::Source>> &retired_sources()
+    {
+        static std::vector<std::shared_ptr<Clock::Source>> retired;
+        return retired;
+    }
+
+    /// Read on every clock call, so it is a plain pointer instead of the shared_ptr.
+    std::atomic<Clock::Source *> current{nullptr};
+    std::mutex set_mutex;
+}
+
+std::chrono::nanoseconds Clock::RealSource::now()
+{
+    return std::chrono::steady_clock::now().time_since_epoch();
+}
+
+tmillis_t Clock::RealSource::wall_millis()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+void Clock::RealSource::sleep_for(const std::chrono::nanoseconds duration)
+{
+    std::this_thread::sleep_for(duration);
+}
+
+Clock::ScaledSource::ScaledSource(const double factor)
+    : factor(factor), real_start(std::chrono::steady_clock::now()), wall_start_ms(RealSource().wall_millis())
+{
+}
+
+std::chrono::nanoseconds Clock::ScaledSource::elapsed() const
+{
+    const auto real = std::chrono::steady_clock::now() - real_start;
+    return std::chrono::nanoseconds(static_cast<int64_t>(
+        static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(real).count()) * factor));
+}
+
+std::chrono::nanoseconds Clock::ScaledSource::now()
+{
+    return real_start.time_since_epoch() + elapsed();
+}
+
+tmillis_t Clock::ScaledSource::wall_millis()
+{
+    return wall_start_ms + std::chrono::duration_cast<std::chrono::milliseconds>(elapsed()).count();
+}
+
+void Clock::ScaledSource::sleep_for(const std::chrono::nanoseconds duration)
+{
+    std::this_thread::sleep_for(std::chrono::nanoseconds(
+        static_cast<int64_t>(static_cast<double>(duration.count()) / factor)));
+}
+
+Clock::VirtualSource::VirtualSource(const tmillis_t wall_start_ms, const std::chrono::nanoseconds frame_step)
+    : wall_start_ms(wall_start_ms), frame_step(frame_step)
+{
+}
+
+std::chrono::nanoseconds Clock::VirtualSource::now()
+{
+    return std::chrono::nanoseconds(elapsed_ns.load(std::memory_order_acquire));
+}
+
+tmillis_t Clock::VirtualSource::wall_millis()
+{
+    return wall_start_ms + elapsed_ns.load(std::memory_order_acquire) / 1000000;
+}
+
+void Clock::VirtualSource::sleep_for(const std::chrono::nanoseconds duration)
+{
+    advance(duration);
+}
+
+void Clock::VirtualSource::frame_presented()
+{
+    if (frame_step.count() <= 0)
+        return;
+
+    // Frames that already slept for longer keep their time, the rest are topped up to one step
+    const int64_t target = last_frame_ns + frame_step.count();
+    int64_t current = elapsed_ns.load(std::memory_order_acquire);
+    while (current < target && !elapsed_ns.compare_exchange_weak(current, target, std::memory_order_acq_rel))
+    {
+    }
+
+    last_frame_ns = std::max(current, target);
+}
+
+void Clock::VirtualSource::advance(const std::chrono::nanoseconds duration)
+{
+    if (duration.count() > 0)
+        elapsed_ns.fetch_add(duration.count(), std::memory_order_acq_rel);
+}
+
+void Clock::set_source(std::shared_ptr<Source> source)
+{
+    if (!source)
+        source = std::make_shared<RealSource>();
+
+    std::lock_guard lock(set_mutex);
+    current.store(source.get(), std::memory_order_release);
+    retired_sources().push_back(std::exchange(owned_source(), std::move(source)));
+}
+
+Clock::Source &Clock::source()
+{
+    if (Source *source = current.load(std::memory_order_acquire))
+        return *source;
+
+    std::lock_guard lock(set_mutex);
+    Source *source = owned_source().get();
+    current.store(source, std::memory_order_release);
+    return *source;
+}
+
+Clock::Settings Clock::Settings::from_env()
+{
+    Settings settings;
+    // In the order of Mode
+    settings.mode = static_cast<Mode>(env_choice("MATRIX_CLOCK", {"real", "scaled", "stepped"}));
+    settings.scale = env_number("MATRIX_CLOCK_SCALE", 1.0, 0.01, 100.0);
+    // Clamped as a double, so the cast is always in range
+    settings.step_ms = static_cast<tmillis_t>(env_number("MATRIX_CLOCK_STEP_MS", 16, 1, 1000));
+    return settings;
+}
+
+std::shared_ptr<Clock::Source> Clock::Settings::create_source() const
+{
+    switch (mode)
+    {
+    case Mode::Scaled:
+        return std::make_shared<ScaledSource>(scale);
+    case Mode::Stepped:
+        return std::make_shared<VirtualSource>(RealSource().wall_millis(), std::chrono::milliseconds(step_ms));
+    case Mode::Real:
+        break;
+    }
+
+    return std::make_shared<RealSource>();
+}
@@ -0,0 +1,64 @@
+#include "shared/common/utils/env.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+    const char *get_raw(const char *name) {
+        const char *raw = std::getenv(name);
+        if (raw == nullptr || *raw == '\0')
+            return nullptr;
+
+        return raw;
+    }
+
+    void warn_invalid(const char *name, const char *raw) {
+        spdlog::warn("Ignoring invalid value '{}' for {}", raw, name);
+    }
+}
+
+int env_int(const char *name, const int fallback, const int min, const int max) {
+    const char *raw = get_raw(name);
+    if (raw == nullptr)
+        return fallback;
+
+    // Out of range for long long saturates, which the clamp below handles like any other value
+    char *end = nullptr;
+    const long long value = std::strtoll(raw, &end, 10);
+    if (end == raw || *end != '\0') {
+        warn_invalid(name, raw);
+        return fallback;
+    }
+
+    return static_cast<int>(std::clamp<long long>(value, min, max));
+}
+
+double env_number(const char *name, const double fallback, const double min, const double max) {
+    const char *raw = get_raw(name);
+    if (raw == nullptr)
+        return fallback;
+
+    char *end = nullptr;
+    const double value = std::strtod(raw, &end);
+    if (end == raw || *end != '\0' || !std::isfinite(value)) {
+        warn_invalid(name, raw);
+        return fallback;
+    }
+
+    return std::clamp(value, min, max);
+}
+
+size_t env_choice(const char *name, const std::initializer_list<std::string_view> choices, const size_t fallback) {
+    const char *raw = get_raw(name);
+    if (raw == nullptr)
+        return fallback;
+
+    const auto match = std::ranges::find(choices, std::string_view(raw));
+    if (match == choices.end()) {
+        warn_invalid(name, raw);
+        return fallback;
+    }
+
+    return static_cast<size_t>(match - choices.begin());
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "shared/desktop/macro.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string>
+#include <vector>
+#include <shared/common/udp/packet.h>
+
+/// Desktop end of the shared-memory transport (see shared/common/udp/shm_ring.h).
+/// Only works when the matrix runs on the same Linux machine; everywhere else connect()
+/// fails and the caller keeps using UdpSender.
+class SHARED_DESKTOP_API ShmSender final
+{
+public:
+    ShmSender() = default;
+    ~ShmSender();
+
+    ShmSender(const ShmSender &) = delete;
+    ShmSender &operator=(const ShmSender &) = delete;
+
+    /// Connects to the matrix listening on 'port' and maps the ring it hands out.
+    [[nodiscard]] std::expected<void, std::string> connect(uint16_t port);
+    void disconnect();
+
+    [[nodiscard]] bool is_connected() const { return mapping != nullptr; }
+
+    /// Returns false once the matrix closed the connection (e.g. because it restarted).
+    [[nodiscard]] bool is_alive() const;
+
+    /// Writes one packet into the ring and wakes the matrix. Fails if the ring is full,
+    /// which means the matrix is not keeping up; the packet is dropped like a UDP datagram.
+    [[nodiscard]] std::expected<void, std::string> sendPacket(uint8_t pluginId, const uint8_t *payload,
+                                                              size_t size) const;
+
+    /// Same as above for a whole packet, see UdpSender::sendPacket for 'scratch'.
+    [[nodiscard]] std::expected<void, std::string> sendPacket(const UdpPacket &packet,
+                                                              std::vector<uint8_t> &scratch) const;
+
+private:
+    int socket = -1;
+    int event_fd = -1;
+    void *mapping = nullptr;
+    size_t mapping_size = 0;
+};
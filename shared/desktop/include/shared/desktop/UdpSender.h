@@ -6,6 +6,7 @@
 #include "shared/desktop/macro.h"
 #define NOMINMAX
 #include <vector>
+#include <span>
 #include <string>
 #include <expected>
 #include <cstdint>
@@ -35,6 +36,17 @@ public:
     UdpSender();
 
     ~UdpSender();
-    [[nodiscard]] std::expected<void, std::string> sendPacket(std::unique_ptr<UdpPacket, void(*)(UdpPacket *)> packet, const std::string &targetAddr,
-                                                              uint16_t port) const;
+    /// Sends 'packet' as one datagram. Header and payload go out as separate iovecs,
+    /// 'scratch' only holds the payload of packets without a dataView() and is reused
+    /// across calls, so steady-state sends don't allocate.
+    [[nodiscard]] std::expected<void, std::string> sendPacket(const UdpPacket &packet, std::vector<uint8_t> &scratch,
+                                                              const std::string &targetAddr, uint16_t port) const;
+
+    /// Sends an already serialized payload (e.g. a FrameStream fragment) for 'pluginId'.
+    [[nodiscard]] std::expected<void, std::string> sendPayload(uint8_t pluginId, std::span<const uint8_t> payload,
+                                                               const std::string &targetAddr, uint16_t port) const;
+
+private:
+    [[nodiscard]] std::expected<void, std::string> sendGather(const uint8_t *header, std::span<const uint8_t> payload,
+                                                              const std::string &targetAddr, uint16_t port) const;
 };
@@ -2,10 +2,12 @@
 #include "shared/desktop/macro.h"
 #include <ixwebsocket/IXWebSocket.h>
 #include "shared/desktop/UdpSender.h"
+#include "shared/desktop/ShmSender.h"
 #include <string>
 #include <thread>
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <spdlog/spdlog.h>
 
 class SHARED_DESKTOP_API WebsocketClient
@@ -88,6 +90,9 @@ public:
 
 private:
     UdpSender udpSender;
+    // Only used by the sender thread, connected while the shared memory transport is active
+    ShmSender shmSender;
+    uint16_t shmPort = 0;
 
     std::thread senderThread;
 
@@ -97,6 +102,10 @@ private:
     std::mutex lastErrorMutex;
     std::string lastError = "";
 
+    // Plugins whose matrix side lost sync and asked for a FrameStream keyframe
+    std::mutex keyframeRequestsMutex;
+    std::unordered_set<std::string> keyframeRequests;
+
     void threadLoop();
 
     bool senderRunning = false;
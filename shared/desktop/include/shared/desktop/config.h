@@ -24,6 +24,9 @@ namespace Config
         uint16_t port = 8080; // Default port
         int fpsLimit = 60; // Default FPS limit
         int udpFpsLimit = 30; // Default UDP send FPS limit
+        bool frameStreaming = false; // Send frames as tiled deltas (FrameStream), older matrix builds only take raw frames
+        std::string frameStreamCodec = "lz4"; // "raw", "rle" or "lz4"
+        bool sharedMemoryTransport = false; // Hand frames to a matrix on the same machine through shared memory
         bool turnMatrixOffOnExit;
         bool turnMatrixOnOnStart;
 
@@ -57,6 +60,15 @@ namespace Config
         int getUdpFpsLimit() const;
         void setUdpFpsLimit(int newUdpFpsLimit);
 
+        bool isFrameStreaming() const;
+        void setFrameStreaming(bool value);
+
+        std::string getFrameStreamCodec() const;
+        void setFrameStreamCodec(const std::string &codec);
+
+        bool isSharedMemoryTransport() const;
+        void setSharedMemoryTransport(bool value);
+
         bool isTurnMatrixOffOnExit() const;
         void setTurnMatrixOffOnExit(bool value);
 
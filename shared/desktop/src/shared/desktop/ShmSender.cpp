@@ -0,0 +1,168 @@
+#include "shared/desktop/ShmSender.h"
+#include <shared/common/udp/shm_ring.h>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+ShmSender::~ShmSender() {
+  disconnect();
+}
+
+std::expected<void, std::string>
+ShmSender::sendPacket(const UdpPacket &packet,
+                      std::vector<uint8_t> &scratch) const {
+  const auto view = packet.view(scratch);
+  return sendPacket(packet.pluginId, view.payload.data(), view.payload.size());
+}
+
+#ifdef __linux__
+
+std::expected<void, std::string> ShmSender::connect(const uint16_t port) {
+  disconnect();
+
+  socket = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  if (socket < 0) {
+    return std::unexpected("Failed to create socket: " +
+                           std::string(strerror(errno)));
+  }
+
+  const std::string name = ShmTransport::socket_name(port);
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  std::memcpy(addr.sun_path + 1, name.data(), name.size());
+  const auto addr_len = static_cast<socklen_t>(
+      offsetof(sockaddr_un, sun_path) + 1 + name.size());
+
+  if (::connect(socket, reinterpret_cast<sockaddr *>(&addr), addr_len) < 0) {
+    const std::string reason = strerror(errno);
+    disconnect();
+    return std::unexpected("No matrix listening on @" + name + ": " + reason);
+  }
+
+  // Don't hang forever if the matrix accepted but never answers
+  timeval timeout{2, 0};
+  setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  ShmTransport::Hello hello{};
+  iovec iov{&hello, sizeof(hello)};
+
+  union {
+    cmsghdr header;
+    uint8_t bytes[CMSG_SPACE(2 * sizeof(int))];
+  } control{};
+
+  msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control.bytes;
+  message.msg_controllen = sizeof(control.bytes);
+
+  const ssize_t received = recvmsg(socket, &message, MSG_CMSG_CLOEXEC);
+  const cmsghdr *cmsg = CMSG_FIRSTHDR(&message);
+  if (received != sizeof(hello) || cmsg == nullptr ||
+      cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS ||
+      cmsg->cmsg_len != CMSG_LEN(2 * sizeof(int))) {
+    disconnect();
+    return std::unexpected("Invalid handshake from matrix");
+  }
+
+  int fds[2];
+  std::memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+  const int memfd = fds[0];
+  event_fd = fds[1];
+
+  if (hello.magic != ShmTransport::ring_magic ||
+      hello.version != ShmTransport::ring_version) {
+    close(memfd);
+    disconnect();
+    return std::unexpected("Matrix uses an incompatible shared memory version");
+  }
+
+  mapping_size = hello.mapping_size;
+  void *mapped = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, memfd, 0);
+  close(memfd);
+  if (mapped == MAP_FAILED) {
+    const std::string reason = strerror(errno);
+    disconnect();
+    return std::unexpected("Failed to map shared memory ring: " + reason);
+  }
+
+  mapping = mapped;
+  if (!ShmTransport::is_valid_ring(mapping, mapping_size)) {
+    disconnect();
+    return std::unexpected("Matrix sent an invalid shared memory ring");
+  }
+
+  return {};
+}
+
+void ShmSender::disconnect() {
+  if (mapping != nullptr) {
+    munmap(mapping, mapping_size);
+    mapping = nullptr;
+    mapping_size = 0;
+  }
+
+  for (int *fd : {&socket, &event_fd}) {
+    if (*fd >= 0) {
+      close(*fd);
+      *fd = -1;
+    }
+  }
+}
+
+bool ShmSender::is_alive() const {
+  if (socket < 0)
+    return false;
+
+  // The matrix never sends anything after the handshake, so EOF is the only
+  // thing that can show up here
+  uint8_t byte;
+  const ssize_t result = recv(socket, &byte, 1, MSG_PEEK | MSG_DONTWAIT);
+  return result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+}
+
+std::expected<void, std::string>
+ShmSender::sendPacket(const uint8_t pluginId, const uint8_t *payload,
+                      const size_t size) const {
+  if (mapping == nullptr)
+    return std::unexpected("Not connected");
+
+  if (!ShmTransport::RingWriter(mapping).write(pluginId, payload, size))
+    return std::unexpected("Shared memory ring is full");
+
+  const uint64_t signal = 1;
+  if (write(event_fd, &signal, sizeof(signal)) < 0 && errno != EAGAIN) {
+    return std::unexpected("Failed to wake matrix: " +
+                           std::string(strerror(errno)));
+  }
+
+  return {};
+}
+
+#else
+
+std::expected<void, std::string> ShmSender::connect(uint16_t) {
+  return std::unexpected(
+      "Shared memory transport is only supported on Linux");
+}
+
+void ShmSender::disconnect() {}
+
+bool ShmSender::is_alive() const {
+  return false;
+}
+
+std::expected<void, std::string> ShmSender::sendPacket(uint8_t, const uint8_t *,
+                                                       size_t) const {
+  return std::unexpected("Not connected");
+}
+
+#endif
@@ -10,6 +10,8 @@
 #ifdef _WIN32
 #pragma comment(lib, "bcrypt.lib")
 #include <ws2tcpip.h>
+#else
+#include <sys/uio.h>
 #endif
 
 UdpSender::UdpSender() {
@@ -50,44 +52,67 @@ UdpSender::~UdpSender() {
 }
 
 std::expected<void, std::string>
-UdpSender::sendPacket(std::unique_ptr<UdpPacket, void (*)(UdpPacket *)> packet,
+UdpSender::sendPacket(const UdpPacket &packet, std::vector<uint8_t> &scratch,
                       const std::string &targetAddr,
                       const uint16_t port) const {
-  const std::vector<uint8_t> data = packet->toBytes();
+  const auto view = packet.view(scratch);
+  return sendGather(view.header.data(), view.payload, targetAddr, port);
+}
+
+std::expected<void, std::string>
+UdpSender::sendPayload(const uint8_t pluginId,
+                       const std::span<const uint8_t> payload,
+                       const std::string &targetAddr,
+                       const uint16_t port) const {
+  uint8_t header[UdpPacket::header_size];
+  UdpPacket::writeHeader(header, pluginId,
+                         static_cast<uint32_t>(payload.size()));
+  return sendGather(header, payload, targetAddr, port);
+}
 
+std::expected<void, std::string>
+UdpSender::sendGather(const uint8_t *header,
+                      const std::span<const uint8_t> payload,
+                      const std::string &targetAddr,
+                      const uint16_t port) const {
   sockaddr_in addr{};
   addr.sin_family = AF_INET;
   addr.sin_port = htons(port); // Use the provided port
 
-#if defined(_WIN32)
-  // Use InetPton or inet_pton if available
-  const std::wstring wTargetAddr(targetAddr.begin(), targetAddr.end());
-  const PCWSTR pcwStrTarget = wTargetAddr.c_str();
-
-  if (InetPtonW(AF_INET, pcwStrTarget, &addr.sin_addr) != 1) {
-    return std::unexpected("Invalid address: " + targetAddr);
-  }
-#else
   if (inet_pton(AF_INET, targetAddr.c_str(), &addr.sin_addr) != 1) {
     return std::unexpected("Invalid address: " + targetAddr);
   }
-#endif
-#ifdef _WIN32
-  auto toSend = reinterpret_cast<const char *>(data.data());
-#else
-  auto toSend = data.data();
-#endif
-
-  int result = sendto(socket, toSend, data.size(), 0,
-                      reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
 
 #if defined(_WIN32)
+  WSABUF buffers[2];
+  buffers[0].buf = reinterpret_cast<CHAR *>(const_cast<uint8_t *>(header));
+  buffers[0].len = UdpPacket::header_size;
+  buffers[1].buf =
+      reinterpret_cast<CHAR *>(const_cast<uint8_t *>(payload.data()));
+  buffers[1].len = static_cast<ULONG>(payload.size());
+
+  DWORD sent = 0;
+  const int result = WSASendTo(socket, buffers, payload.empty() ? 1 : 2, &sent,
+                               0, reinterpret_cast<sockaddr *>(&addr),
+                               sizeof(addr), nullptr, nullptr);
   if (result == SOCKET_ERROR) {
     return std::unexpected("Failed to send data with code: " +
                            std::to_string(WSAGetLastError()));
   }
 #else
-  if (result < 0) {
+  iovec iov[2];
+  iov[0].iov_base = const_cast<uint8_t *>(header);
+  iov[0].iov_len = UdpPacket::header_size;
+  iov[1].iov_base = const_cast<uint8_t *>(payload.data());
+  iov[1].iov_len = payload.size();
+
+  msghdr message{};
+  message.msg_name = &addr;
+  message.msg_namelen = sizeof(addr);
+  message.msg_iov = iov;
+  message.msg_iovlen = payload.empty() ? 1 : 2;
+
+  if (sendmsg(socket, &message, 0) < 0) {
     return std::unexpected("Failed to send data: " +
                            std::string(strerror(errno)));
   }
@@ -2,9 +2,19 @@
 #include <spdlog/spdlog.h>
 #include "shared/desktop/plugin_loader/loader.h"
 #include <ixwebsocket/IXNetSystem.h>
+#include <shared/common/udp/frame_stream.h>
 
 WebsocketClient *websocketClientInstance = nullptr;
 
+namespace
+{
+    // The shared memory transport only reaches a matrix on this machine
+    bool isLocalHost(const std::string &hostname)
+    {
+        return hostname == "localhost" || hostname == "::1" || hostname.starts_with("127.");
+    }
+}
+
 void WebsocketClient::setInstance(WebsocketClient *instance)
 {
     websocketClientInstance = instance;
@@ -35,6 +45,11 @@ WebsocketClient::WebsocketClient() : udpSender()
                 const std::string pluginName = m.substr(4, pluginNameEnd -4);
                 const std::string message = m.substr(m.find(':', pluginNameEnd) +1);
 
+                if (message == FrameStream::keyframe_request_message) {
+                    std::unique_lock<std::mutex> keyframeLock(keyframeRequestsMutex);
+                    keyframeRequests.insert(pluginName);
+                }
+
                 for (const auto & [_p, plugin] : Plugins::PluginManager::instance()->get_plugins()) {
                     if (plugin->get_plugin_name() != pluginName)
                         continue;
@@ -68,14 +83,22 @@ void WebsocketClient::threadLoop()
     std::string hostname = generalConfig.getHostname();
     uint16_t port = generalConfig.getPort();
     int udpFpsLimit = generalConfig.getUdpFpsLimit();
-    auto lastUpdated = clock::now();
+    bool frameStreaming = generalConfig.isFrameStreaming();
+    auto frameStreamCodec = FrameStream::codec_from_string(generalConfig.getFrameStreamCodec());
+    auto lastUpdated = clock::time_point{};
+    bool shmFallbackLogged = false;
 
     std::unordered_map<std::string, clock::time_point> lastLargePayloadSend;
+    // One encoder per plugin, each one holds the last frame its matrix side has seen
+    std::unordered_map<std::string, FrameStream::Encoder> frameEncoders;
+    // Serialization scratch per plugin, reused so sending doesn't allocate once warmed up
+    std::unordered_map<std::string, std::vector<uint8_t>> sendBuffers;
 
     for (const auto &plugin : plugins | std::views::values)
     {
         plugin->udp_init();
         lastLargePayloadSend[plugin->get_plugin_name()] = clock::time_point{};
+        sendBuffers[plugin->get_plugin_name()];
     }
 
     while (senderRunning)
@@ -91,6 +114,36 @@ void WebsocketClient::threadLoop()
             hostname = generalConfig.getHostname();
             port = generalConfig.getPort();
             udpFpsLimit = generalConfig.getUdpFpsLimit();
+            frameStreamCodec = FrameStream::codec_from_string(generalConfig.getFrameStreamCodec());
+
+            // Deltas sent after switching back would reference a frame the matrix never got
+            if (frameStreaming != generalConfig.isFrameStreaming())
+                frameEncoders.clear();
+            frameStreaming = generalConfig.isFrameStreaming();
+
+            const bool useSharedMemory = generalConfig.isSharedMemoryTransport() && isLocalHost(hostname);
+            if (shmSender.is_connected() && (!useSharedMemory || shmPort != port || !shmSender.is_alive()))
+            {
+                spdlog::info("Shared memory transport closed, sending over UDP");
+                shmSender.disconnect();
+                frameEncoders.clear();
+            }
+
+            if (useSharedMemory && !shmSender.is_connected())
+            {
+                if (auto res = shmSender.connect(port); res.has_value())
+                {
+                    spdlog::info("Sending frames to the matrix over shared memory");
+                    shmPort = port;
+                    shmFallbackLogged = false;
+                    frameEncoders.clear();
+                }
+                else if (!shmFallbackLogged)
+                {
+                    spdlog::warn("Shared memory transport unavailable, using UDP: {}", res.error());
+                    shmFallbackLogged = true;
+                }
+            }
         }
 
         auto largePayloadMinInterval = std::chrono::duration<double, std::milli>(1000.0 / udpFpsLimit);
@@ -113,7 +166,45 @@ void WebsocketClient::threadLoop()
 
             lastLargePayloadSend[name] = clock::now();
 
-            auto res = this->udpSender.sendPacket(std::move(packet.value()), hostname, port);
+            std::expected<void, std::string> res;
+            const UdpPacket &udpPacket = *packet.value();
+            auto &sendBuffer = sendBuffers[name];
+            const auto *frame = dynamic_cast<const FramePacket *>(&udpPacket);
+            if (shmSender.is_connected())
+            {
+                // No MTU and no loss, so whole frames go into the ring as they are
+                res = shmSender.sendPacket(udpPacket, sendBuffer);
+            }
+            else
+            {
+                std::span<const std::vector<uint8_t>> fragments;
+                if (frameStreaming && frame != nullptr &&
+                    frame->rgb.size() == static_cast<size_t>(frame->width) * frame->height * 3)
+                {
+                    auto &encoder = frameEncoders[name];
+                    encoder.set_codec(frameStreamCodec);
+                    {
+                        std::unique_lock<std::mutex> keyframeLock(keyframeRequestsMutex);
+                        if (keyframeRequests.erase(name) > 0)
+                            encoder.force_keyframe();
+                    }
+                    fragments = encoder.encode(frame->rgb.data(), frame->width, frame->height);
+                }
+
+                if (!fragments.empty())
+                {
+                    for (const auto &fragment : fragments)
+                    {
+                        res = this->udpSender.sendPayload(frame->pluginId, fragment, hostname, port);
+                        if (!res.has_value())
+                            break;
+                    }
+                }
+                else
+                {
+                    res = this->udpSender.sendPacket(udpPacket, sendBuffer, hostname, port);
+                }
+            }
             static int consecutiveError = 0;
             if (!res.has_value())
             {
@@ -16,6 +16,9 @@ Config::General::General(const General &other)
     port = other.port;
     fpsLimit = other.fpsLimit;
     udpFpsLimit = other.udpFpsLimit;
+    frameStreaming = other.frameStreaming;
+    frameStreamCodec = other.frameStreamCodec;
+    sharedMemoryTransport = other.sharedMemoryTransport;
     turnMatrixOffOnExit = other.turnMatrixOffOnExit;
     turnMatrixOnOnStart = other.turnMatrixOnOnStart;
 }
@@ -33,6 +36,9 @@ Config::General &Config::General::operator=(const General &other)
         port = other.port;
         fpsLimit = other.fpsLimit;
         udpFpsLimit = other.udpFpsLimit;
+        frameStreaming = other.frameStreaming;
+        frameStreamCodec = other.frameStreamCodec;
+        sharedMemoryTransport = other.sharedMemoryTransport;
         turnMatrixOffOnExit = other.turnMatrixOffOnExit;
         turnMatrixOnOnStart = other.turnMatrixOnOnStart;
     }
@@ -47,6 +53,9 @@ Config::General::General(General &&other) noexcept
     port = other.port;
     fpsLimit = other.fpsLimit;
     udpFpsLimit = other.udpFpsLimit;
+    frameStreaming = other.frameStreaming;
+    frameStreamCodec = other.frameStreamCodec;
+    sharedMemoryTransport = other.sharedMemoryTransport;
     turnMatrixOffOnExit = other.turnMatrixOffOnExit;
     turnMatrixOnOnStart = other.turnMatrixOnOnStart;
 }
@@ -64,6 +73,9 @@ Config::General &Config::General::operator=(General &&other) noexcept
         port = other.port;
         fpsLimit = other.fpsLimit;
         udpFpsLimit = other.udpFpsLimit;
+        frameStreaming = other.frameStreaming;
+        frameStreamCodec = other.frameStreamCodec;
+        sharedMemoryTransport = other.sharedMemoryTransport;
         turnMatrixOffOnExit = other.turnMatrixOffOnExit;
         turnMatrixOnOnStart = other.turnMatrixOnOnStart;
     }
@@ -147,6 +159,42 @@ void Config::General::setUdpFpsLimit(int newUdpFpsLimit)
     udpFpsLimit = newUdpFpsLimit;
 }
 
+bool Config::General::isFrameStreaming() const
+{
+    std::shared_lock lock(mutex_);
+    return frameStreaming;
+}
+
+void Config::General::setFrameStreaming(bool value)
+{
+    std::unique_lock lock(mutex_);
+    frameStreaming = value;
+}
+
+std::string Config::General::getFrameStreamCodec() const
+{
+    std::shared_lock lock(mutex_);
+    return frameStreamCodec;
+}
+
+void Config::General::setFrameStreamCodec(const std::string &codec)
+{
+    std::unique_lock lock(mutex_);
+    frameStreamCodec = codec;
+}
+
+bool Config::General::isSharedMemoryTransport() const
+{
+    std::shared_lock lock(mutex_);
+    return sharedMemoryTransport;
+}
+
+void Config::General::setSharedMemoryTransport(bool value)
+{
+    std::unique_lock lock(mutex_);
+    sharedMemoryTransport = value;
+}
+
 bool Config::General::isTurnMatrixOffOnExit() const
 {
     std::shared_lock lock(mutex_);
@@ -184,6 +232,13 @@ void Config::from_json(const json &j, General &p)
     if (j.contains("udpFpsLimit"))
         j.at("udpFpsLimit").get_to(p.udpFpsLimit);
 
+    if (j.contains("frameStreaming"))
+        j.at("frameStreaming").get_to(p.frameStreaming);
+    if (j.contains("frameStreamCodec"))
+        j.at("frameStreamCodec").get_to(p.frameStreamCodec);
+    if (j.contains("sharedMemoryTransport"))
+        j.at("sharedMemoryTransport").get_to(p.sharedMemoryTransport);
+
     if (j.contains("turnMatrixOffOnExit"))
         j.at("turnMatrixOffOnExit").get_to(p.turnMatrixOffOnExit);
     else
@@ -202,6 +257,9 @@ void Config::to_json(json &j, const General &p)
         {"port", p.port},
         {"fpsLimit", p.fpsLimit},
         {"udpFpsLimit", p.udpFpsLimit},
+        {"frameStreaming", p.frameStreaming},
+        {"frameStreamCodec", p.frameStreamCodec},
+        {"sharedMemoryTransport", p.sharedMemoryTransport},
         {"turnMatrixOffOnExit", p.turnMatrixOffOnExit},
         {"turnMatrixOnOnStart", p.turnMatrixOnOnStart} //
     };
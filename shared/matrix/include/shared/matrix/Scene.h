@@ -5,6 +5,9 @@
 #include "led-matrix.h"
 #include <spdlog/spdlog.h>
 #include <vector>
+#include <chrono>
+#include <functional>
+#include <utility>
 #include <shared/matrix/plugin/property.h>
 #include <shared/common/utils/utils.h>
 #include <shared/matrix/plugin/PropertyMacros.h>
@@ -20,6 +23,7 @@ using Property = Plugins::Property<T>;
 namespace Scenes {
     class Scene {
         std::vector<std::shared_ptr<Plugins::PropertyBase>> properties;
+        std::chrono::nanoseconds pacing_wait{0};
 
     protected:
         bool initialized = false;
@@ -50,6 +54,13 @@ namespace Scenes {
 
         virtual void wait_until_next_frame();
 
+        /// Runs fn(y_begin, y_end) over tiles of the rows [0, height) on the shared RenderPool,
+        /// on the render thread and the pool's workers at once, and returns when all rows are done.
+        /// fn must only write to its own rows, e.g. of a CanvasBuffer that is written to the canvas
+        /// afterwards. FrameCanvas::SetPixel is not safe to call from several threads, the matrix
+        /// framebuffer packs two rows into the same words.
+        void parallel_rows(int height, const std::function<void(int y_begin, int y_end)> &fn);
+
         void add_property(const std::shared_ptr<Plugins::PropertyBase> &property) {
             std::string name = property->getName();
             for (const auto &item: properties) {
@@ -110,6 +121,13 @@ namespace Scenes {
         /// Returns true if the scene should continue rendering, false if not
         virtual bool render(FrameCanvas *canvas) = 0;
 
+        /// Time slept in wait_until_next_frame() since the last call, so the profiler
+        /// can tell frame pacing apart from actual render work. Real (steady_clock)
+        /// time, whatever Clock the scene runs on.
+        std::chrono::nanoseconds take_pacing_wait() {
+            return std::exchange(pacing_wait, std::chrono::nanoseconds{0});
+        }
+
         static std::unique_ptr<Scene, void (*)(Scene *)> from_json(const nlohmann::json &j);
 
         virtual void register_properties() = 0;
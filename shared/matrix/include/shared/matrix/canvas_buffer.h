@@ -0,0 +1,48 @@
+#pragma once
+
+#include "led-matrix.h"
+#include <cstddef>
+#include <vector>
+
+using rgb_matrix::FrameCanvas;
+
+/// Contiguous, row-major RGB888 copy of a FrameCanvas.
+/// Effects that touch every pixel (transitions, post-processing) read the
+/// whole frame once, work on plain memory, and push the result back in a
+/// single bulk write instead of calling GetPixel/SetPixel per pixel.
+class CanvasBuffer {
+    int buffer_width = 0;
+    int buffer_height = 0;
+    std::vector<rgb_matrix::Color> pixels;
+
+public:
+    CanvasBuffer() = default;
+    CanvasBuffer(int width, int height);
+
+    /// Resizes the buffer. Existing contents are kept only if the size did not change.
+    void resize(int width, int height);
+
+    /// Reads every pixel of 'canvas' into this buffer, resizing it to match.
+    void read_from(FrameCanvas *canvas);
+
+    /// Writes the whole buffer into 'canvas' using the bulk SetPixels path,
+    /// which encodes straight into the library's bit-plane framebuffer.
+    void write_to(FrameCanvas *canvas) const;
+
+    void fill(const rgb_matrix::Color &color);
+    void clear();
+
+    [[nodiscard]] int width() const { return buffer_width; }
+    [[nodiscard]] int height() const { return buffer_height; }
+    [[nodiscard]] size_t size() const { return pixels.size(); }
+    [[nodiscard]] bool empty() const { return pixels.empty(); }
+
+    [[nodiscard]] rgb_matrix::Color *data() { return pixels.data(); }
+    [[nodiscard]] const rgb_matrix::Color *data() const { return pixels.data(); }
+
+    [[nodiscard]] rgb_matrix::Color *row(int y) { return pixels.data() + static_cast<size_t>(y) * buffer_width; }
+    [[nodiscard]] const rgb_matrix::Color *row(int y) const { return pixels.data() + static_cast<size_t>(y) * buffer_width; }
+
+    [[nodiscard]] rgb_matrix::Color &at(int x, int y) { return row(y)[x]; }
+    [[nodiscard]] const rgb_matrix::Color &at(int x, int y) const { return row(y)[x]; }
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "led-matrix.h"
+#include "shared/matrix/canvas_buffer.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// A cached layer of a frame, for the parts of a scene that stay the same for many
+/// frames (labels, icons, borders) on top of parts that animate.
+///
+/// The layer is a rgb_matrix::Canvas, so the usual drawing code (SetPixel, DrawText,
+/// TextCache) draws into it, blend() and SetImageTransparent() draw translucent
+/// pixels. Every pixel keeps a color and a coverage, and end() indexes the runs of
+/// pixels that are covered at all. composite() then puts the layer over a frame in
+/// a CanvasBuffer, copying fully covered runs with memcpy and blending only the
+/// translucent pixels, and never touches the uncovered rest.
+///
+/// Redraw the layer only when stale(key) says so, with a key that changes together
+/// with whatever the layer shows:
+///
+///     if (labels.stale(key)) {
+///         labels.begin(key);
+///         text.draw(&labels, font, 2, 10, color, label);
+///         labels.end();
+///     }
+///     labels.composite(frame);
+class CanvasLayer : public rgb_matrix::Canvas
+{
+public:
+    CanvasLayer() = default;
+    CanvasLayer(int width, int height);
+
+    /// Resizes the layer. A layer that changed size is empty and stale.
+    void resize(int width, int height);
+
+    /// Whether the layer has to be drawn again: it never was drawn since it was
+    /// resized or invalidated, or it was drawn for a different key.
+    [[nodiscard]] bool stale(uint64_t key) const { return !drawn || key != drawn_key; }
+
+    /// Makes the next stale() true whatever the key.
+    void invalidate() { drawn = false; }
+
+    /// Clears the layer to start drawing it for 'key'.
+    void begin(uint64_t key);
+
+    /// Done drawing, indexes the covered runs for composite().
+    void end();
+
+    /// Puts the layer over 'frame', which has to be the layer's size.
+    void composite(CanvasBuffer &frame) const;
+
+    /// Draws (r, g, b) with 'alpha' (0 to 1) over what the layer has at (x, y).
+    void blend(int x, int y, uint8_t r, uint8_t g, uint8_t b, float alpha);
+
+    // rgb_matrix::Canvas, SetPixel() covers the pixel completely
+    int width() const override { return layer_width; }
+    int height() const override { return layer_height; }
+    void SetPixel(int x, int y, uint8_t r, uint8_t g, uint8_t b) override;
+    void SetPixels(int x, int y, int width, int height, rgb_matrix::Color *pixels) override;
+    void Clear() override;
+    void Fill(uint8_t r, uint8_t g, uint8_t b) override;
+
+    /// Pixels that composite() writes, after end().
+    [[nodiscard]] size_t covered_pixels() const { return covered; }
+
+private:
+    /// 'length' pixels from 'offset', all fully covered or all translucent.
+    struct Run
+    {
+        uint32_t offset;
+        uint32_t length;
+        bool opaque;
+    };
+
+    int layer_width = 0;
+    int layer_height = 0;
+
+    /// Premultiplied by the coverage, so blending over a frame is one multiply-add.
+    std::vector<rgb_matrix::Color> colors;
+    std::vector<uint8_t> coverage;
+
+    std::vector<Run> runs;
+    size_t covered = 0;
+
+    bool drawn = false;
+    uint64_t drawn_key = 0;
+};
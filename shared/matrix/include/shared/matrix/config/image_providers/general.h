@@ -3,6 +3,7 @@
 #include "nlohmann/json.hpp"
 #include <variant>
 #include <expected>
+#include <functional>
 #include "fmt/format.h"
 
 #include "shared/matrix/plugin/property.h"
@@ -11,6 +12,12 @@
 using json = nlohmann::json;
 
 namespace ImageProviders {
+    using PostVariant = std::variant<std::unique_ptr<Post, void(*)(Post *)>, std::shared_ptr<Post> >;
+
+    /// Finishes a post handed out by get_next_pending(), e.g. by fetching its page.
+    /// Runs on the prefetch pool, so it must not touch the provider.
+    using PendingPost = std::function<std::expected<PostVariant, string>()>;
+
     class General {
         std::vector<std::shared_ptr<Plugins::PropertyBase> > properties;
         std::string uuid;
@@ -43,6 +50,11 @@ namespace ImageProviders {
             Post> > >, string>
         get_next_image() = 0;
 
+        /// Like get_next_image(), but leaves the slow per-image work to the returned
+        /// PendingPost so the prefetcher can run it for several images at once.
+        /// The default resolves the post right away.
+        virtual std::expected<std::optional<PendingPost>, string> get_next_pending();
+
         virtual void flush() = 0;
 
         [[nodiscard]] virtual string get_name() const = 0;
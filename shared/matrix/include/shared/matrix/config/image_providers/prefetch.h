@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "shared/matrix/config/image_providers/general.h"
+#include "shared/matrix/utils/FrameCache.h"
+
+namespace ImageProviders {
+    /// An image that went through the whole pipeline and is ready to be shown.
+    struct PreparedImage {
+        PostVariant post;
+        /// Decoded frames. Empty when the image came from (or went into) the frame cache.
+        vector<Magick::Image> frames;
+        std::shared_ptr<const CachedAnimation> cached;
+        /// Memory the image holds while it waits to be shown, used for backpressure.
+        size_t bytes = 0;
+    };
+
+    /// MATRIX_IMAGE_PREFETCH images are prepared ahead per provider (default 3, 1-16),
+    /// on a pool of MATRIX_IMAGE_PREFETCH_THREADS threads (default 3, 1-16) shared by
+    /// all image scenes. At most MATRIX_IMAGE_PREFETCH_MB (default 64) of prepared
+    /// images wait in memory per provider.
+    struct PrefetchSettings {
+        size_t lookahead = 3;
+        size_t threads = 3;
+        size_t decode_threads = 1;
+        size_t memory_budget_bytes = 64 * 1024 * 1024;
+
+        static PrefetchSettings from_env();
+    };
+
+    /// Keeps the next few images of a provider ready. Every image goes through
+    /// separate stages on the shared pool:
+    ///
+    ///   list     General::get_next_pending(), one at a time (providers aren't thread safe)
+    ///   resolve  the returned PendingPost, e.g. scraping the post page
+    ///   download Post::fetch(), skipped on a frame cache hit
+    ///   decode   Post::process_images() and storing the frames in the frame cache,
+    ///            limited to 'decode_threads' and held back while the memory budget is used up
+    ///
+    /// so a slow page only stalls its own image while the others keep flowing.
+    class Prefetcher {
+    public:
+        /// Stages stop early once 'cancel' is set (the scene's is_exiting flag).
+        Prefetcher(std::shared_ptr<General> provider, int width, int height, const PrefetchSettings &settings,
+                   const std::atomic<bool> &cancel);
+
+        /// Drops queued work and waits for stages that are still running.
+        ~Prefetcher();
+
+        Prefetcher(const Prefetcher &) = delete;
+        Prefetcher &operator=(const Prefetcher &) = delete;
+
+        /// Blocks until the next image is ready. Returns nullopt once the provider has
+        /// no images left and nothing is in flight anymore, or when cancelled.
+        /// Images that failed in some stage come back as errors.
+        std::expected<std::optional<PreparedImage>, string> next();
+
+        /// Starts the provider over after next() returned nullopt (General::flush()).
+        void flush();
+
+    private:
+        struct State;
+        std::shared_ptr<State> state;
+    };
+}
@@ -123,7 +123,8 @@ namespace Plugins
             return std::move(router);
         }
 
-        /// Return true if the request has been handled by this plugin
+        /// Return true if the request has been handled by this plugin.
+        /// Called on the UDP or the shared-memory thread, never on both at once for the same pluginId.
         virtual bool on_udp_packet(const uint8_t pluginId, const uint8_t *data, const size_t size)
         {
             return false;
@@ -2,6 +2,8 @@
 
 #include <string>
 #include <optional>
+#include <expected>
+#include <filesystem>
 #include "Magick++.h"
 
 using std::string;
@@ -19,5 +21,9 @@ public:
 
     string get_image_url();
 
+    /// Makes sure the image is on disk (downloading it if needed) and returns its path.
+    /// process_images() calls this itself; calling it earlier lets downloads run ahead of decoding.
+    std::expected<std::filesystem::path, string> fetch();
+
     optional<vector<Magick::Image>> process_images(int width, int height, bool store_processed_file = false);
 };
\ No newline at end of file
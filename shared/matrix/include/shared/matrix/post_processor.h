@@ -2,6 +2,7 @@
 
 #include "led-matrix.h"
 #include "post_processing_effect.h"
+#include "canvas_buffer.h"
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -16,6 +17,11 @@ private:
     mutable std::mutex effectsMutex;
     std::vector<PostProcessEffect> active_effects;
     std::unordered_map<std::string, std::unique_ptr<PostProcessingEffect, void (*)(PostProcessingEffect *)>> registered_effects;
+    // Scratch frame reused by apply_effects(FrameCanvas*) so steady-state frames don't allocate
+    CanvasBuffer scratch_frame;
+
+    // Drops expired effects and runs the remaining ones on 'frame'. Caller must hold effectsMutex.
+    void apply_active_effects(CanvasBuffer& frame);
 
 public:
     PostProcessor() = default;
@@ -29,6 +35,9 @@ public:
     
     // Apply all active post-processing effects to the canvas
     void apply_effects(FrameCanvas* canvas);
+
+    // Apply all active post-processing effects to an already captured frame
+    void apply_effects(CanvasBuffer& frame);
     
     // Clear all effects
     void clear_effects();
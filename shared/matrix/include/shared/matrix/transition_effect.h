@@ -1,13 +1,16 @@
 #pragma once
 
 #include "led-matrix.h"
+#include "canvas_buffer.h"
 #include <string>
 
 using rgb_matrix::FrameCanvas;
 
 /// Base class for a scene-to-scene transition effect.
-/// Implementations blend 'from' and 'to' canvases into 'dst' based on the
+/// Implementations blend 'from' and 'to' frames into 'dst' based on the
 /// normalized progress value alpha (0.0 = fully from, 1.0 = fully to).
+/// The caller reads both scene canvases into buffers once per frame and
+/// writes 'dst' back to the display canvas afterwards.
 class TransitionEffect {
 public:
     virtual ~TransitionEffect() = default;
@@ -15,12 +18,10 @@ public:
     virtual std::string get_name() const = 0;
 
     /// Apply the transition.
-    /// @param dst    Target canvas to write the blended frame into.
-    /// @param from   The outgoing scene canvas (fully rendered).
-    /// @param to     The incoming scene canvas (fully rendered).
+    /// @param dst    Target buffer to write the blended frame into (same size as 'from').
+    /// @param from   The outgoing scene frame (fully rendered).
+    /// @param to     The incoming scene frame (fully rendered).
     /// @param alpha  Progress in [0.0, 1.0].
-    /// @param width  Canvas width in pixels.
-    /// @param height Canvas height in pixels.
-    virtual void apply(FrameCanvas *dst, FrameCanvas *from, FrameCanvas *to,
-                       float alpha, int width, int height) = 0;
+    virtual void apply(CanvasBuffer &dst, const CanvasBuffer &from, const CanvasBuffer &to,
+                       float alpha) = 0;
 };
@@ -0,0 +1,351 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define FAST_MATH_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define FAST_MATH_NEON 1
+#include <arm_neon.h>
+#endif
+
+/// Four-lane float math for per-pixel effects (see PixelShader.h).
+///
+/// f32x4 is an SSE2 or NEON register where available and four plain floats elsewhere.
+/// sin/cos/exp/atan2 are polynomial approximations. Against double precision <cmath>,
+/// sin and cos are off by at most 2.5e-7 for |x| up to 3000, exp by 1e-7 relative and
+/// atan2 by 2.5e-6 rad; tests/fast_math_test.cpp checks these bounds. sqrt and division
+/// are exact on SSE2 and AArch64 and two Newton steps off the hardware estimate on
+/// 32-bit ARM. Nothing checks for NaN or infinity, and floor/round/trunc only work for
+/// |x| < 2^31. That is plenty for colors, but not a replacement for <cmath>.
+namespace FastMath
+{
+    // ─── Lane types ──────────────────────────────────────────────────────────
+
+    struct f32x4;
+
+    /// Result of a lane-wise comparison, all bits set in the lanes where it holds.
+    struct mask4
+    {
+#if defined(FAST_MATH_SSE2)
+        __m128 v;
+#elif defined(FAST_MATH_NEON)
+        uint32x4_t v;
+#else
+        uint32_t v[4];
+#endif
+    };
+
+    struct f32x4
+    {
+#if defined(FAST_MATH_SSE2)
+        __m128 v;
+
+        f32x4() : v(_mm_setzero_ps()) {}
+        f32x4(__m128 value) : v(value) {}
+        f32x4(float value) : v(_mm_set1_ps(value)) {}
+        f32x4(float a, float b, float c, float d) : v(_mm_setr_ps(a, b, c, d)) {}
+
+        static f32x4 load(const float *in) { return _mm_loadu_ps(in); }
+        void store(float *out) const { _mm_storeu_ps(out, v); }
+#elif defined(FAST_MATH_NEON)
+        float32x4_t v;
+
+        f32x4() : v(vdupq_n_f32(0.0f)) {}
+        f32x4(float32x4_t value) : v(value) {}
+        f32x4(float value) : v(vdupq_n_f32(value)) {}
+        f32x4(float a, float b, float c, float d)
+        {
+            const float lanes[4] = {a, b, c, d};
+            v = vld1q_f32(lanes);
+        }
+
+        static f32x4 load(const float *in) { return vld1q_f32(in); }
+        void store(float *out) const { vst1q_f32(out, v); }
+#else
+        float v[4];
+
+        f32x4() : v{0.0f, 0.0f, 0.0f, 0.0f} {}
+        f32x4(float value) : v{value, value, value, value} {}
+        f32x4(float a, float b, float c, float d) : v{a, b, c, d} {}
+
+        static f32x4 load(const float *in) { return {in[0], in[1], in[2], in[3]}; }
+        void store(float *out) const { std::memcpy(out, v, sizeof(v)); }
+#endif
+
+        /// {start, start + step, start + 2 step, start + 3 step}
+        static f32x4 ramp(float start, float step = 1.0f)
+        {
+            return {start, start + step, start + 2.0f * step, start + 3.0f * step};
+        }
+    };
+
+    // ─── Arithmetic ──────────────────────────────────────────────────────────
+
+#if defined(FAST_MATH_SSE2)
+    inline f32x4 operator+(f32x4 a, f32x4 b) { return _mm_add_ps(a.v, b.v); }
+    inline f32x4 operator-(f32x4 a, f32x4 b) { return _mm_sub_ps(a.v, b.v); }
+    inline f32x4 operator*(f32x4 a, f32x4 b) { return _mm_mul_ps(a.v, b.v); }
+    inline f32x4 operator/(f32x4 a, f32x4 b) { return _mm_div_ps(a.v, b.v); }
+    inline f32x4 operator-(f32x4 a) { return _mm_xor_ps(a.v, _mm_set1_ps(-0.0f)); }
+
+    inline f32x4 min(f32x4 a, f32x4 b) { return _mm_min_ps(a.v, b.v); }
+    inline f32x4 max(f32x4 a, f32x4 b) { return _mm_max_ps(a.v, b.v); }
+    inline f32x4 abs(f32x4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v); }
+    inline f32x4 sqrt(f32x4 a) { return _mm_sqrt_ps(a.v); }
+
+    inline mask4 operator<(f32x4 a, f32x4 b) { return {_mm_cmplt_ps(a.v, b.v)}; }
+    inline mask4 operator>(f32x4 a, f32x4 b) { return {_mm_cmpgt_ps(a.v, b.v)}; }
+    inline mask4 operator==(f32x4 a, f32x4 b) { return {_mm_cmpeq_ps(a.v, b.v)}; }
+    inline mask4 operator!=(f32x4 a, f32x4 b) { return {_mm_cmpneq_ps(a.v, b.v)}; }
+    inline mask4 operator&(mask4 a, mask4 b) { return {_mm_and_ps(a.v, b.v)}; }
+    inline mask4 operator|(mask4 a, mask4 b) { return {_mm_or_ps(a.v, b.v)}; }
+    inline mask4 operator^(mask4 a, mask4 b) { return {_mm_xor_ps(a.v, b.v)}; }
+
+    /// 'if_true' in the lanes where 'mask' is set, 'if_false' in the others.
+    inline f32x4 select(mask4 mask, f32x4 if_true, f32x4 if_false)
+    {
+        return _mm_or_ps(_mm_and_ps(mask.v, if_true.v), _mm_andnot_ps(mask.v, if_false.v));
+    }
+
+    inline f32x4 trunc(f32x4 a) { return _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v)); }
+#elif defined(FAST_MATH_NEON)
+    inline f32x4 operator+(f32x4 a, f32x4 b) { return vaddq_f32(a.v, b.v); }
+    inline f32x4 operator-(f32x4 a, f32x4 b) { return vsubq_f32(a.v, b.v); }
+    inline f32x4 operator*(f32x4 a, f32x4 b) { return vmulq_f32(a.v, b.v); }
+    inline f32x4 operator-(f32x4 a) { return vnegq_f32(a.v); }
+
+    inline f32x4 min(f32x4 a, f32x4 b) { return vminq_f32(a.v, b.v); }
+    inline f32x4 max(f32x4 a, f32x4 b) { return vmaxq_f32(a.v, b.v); }
+    inline f32x4 abs(f32x4 a) { return vabsq_f32(a.v); }
+
+#if defined(__aarch64__)
+    inline f32x4 operator/(f32x4 a, f32x4 b) { return vdivq_f32(a.v, b.v); }
+    inline f32x4 sqrt(f32x4 a) { return vsqrtq_f32(a.v); }
+#else
+    // 32-bit NEON has neither, both refine the hardware estimate with two Newton steps
+    inline f32x4 operator/(f32x4 a, f32x4 b)
+    {
+        float32x4_t inv = vrecpeq_f32(b.v);
+        inv = vmulq_f32(inv, vrecpsq_f32(b.v, inv));
+        inv = vmulq_f32(inv, vrecpsq_f32(b.v, inv));
+        return vmulq_f32(a.v, inv);
+    }
+
+    inline f32x4 sqrt(f32x4 a)
+    {
+        float32x4_t inv = vrsqrteq_f32(a.v);
+        inv = vmulq_f32(inv, vrsqrtsq_f32(vmulq_f32(a.v, inv), inv));
+        inv = vmulq_f32(inv, vrsqrtsq_f32(vmulq_f32(a.v, inv), inv));
+        // The estimate of 1/sqrt(0) is infinity, keep those lanes at 0
+        const uint32x4_t zero = vceqq_f32(a.v, vdupq_n_f32(0.0f));
+        return vbslq_f32(zero, a.v, vmulq_f32(a.v, inv));
+    }
+#endif
+
+    inline mask4 operator<(f32x4 a, f32x4 b) { return {vcltq_f32(a.v, b.v)}; }
+    inline mask4 operator>(f32x4 a, f32x4 b) { return {vcgtq_f32(a.v, b.v)}; }
+    inline mask4 operator==(f32x4 a, f32x4 b) { return {vceqq_f32(a.v, b.v)}; }
+    inline mask4 operator!=(f32x4 a, f32x4 b) { return {vmvnq_u32(vceqq_f32(a.v, b.v))}; }
+    inline mask4 operator&(mask4 a, mask4 b) { return {vandq_u32(a.v, b.v)}; }
+    inline mask4 operator|(mask4 a, mask4 b) { return {vorrq_u32(a.v, b.v)}; }
+    inline mask4 operator^(mask4 a, mask4 b) { return {veorq_u32(a.v, b.v)}; }
+
+    inline f32x4 select(mask4 mask, f32x4 if_true, f32x4 if_false) { return vbslq_f32(mask.v, if_true.v, if_false.v); }
+
+    inline f32x4 trunc(f32x4 a) { return vcvtq_f32_s32(vcvtq_s32_f32(a.v)); }
+#else
+    namespace detail
+    {
+        template<typename Fn>
+        f32x4 map(f32x4 a, f32x4 b, Fn fn)
+        {
+            return {fn(a.v[0], b.v[0]), fn(a.v[1], b.v[1]), fn(a.v[2], b.v[2]), fn(a.v[3], b.v[3])};
+        }
+
+        template<typename Fn>
+        mask4 compare(f32x4 a, f32x4 b, Fn fn)
+        {
+            mask4 m;
+            for (int i = 0; i < 4; ++i)
+                m.v[i] = fn(a.v[i], b.v[i]) ? ~0u : 0u;
+            return m;
+        }
+    }
+
+    inline f32x4 operator+(f32x4 a, f32x4 b) { return detail::map(a, b, [](float x, float y) { return x + y; }); }
+    inline f32x4 operator-(f32x4 a, f32x4 b) { return detail::map(a, b, [](float x, float y) { return x - y; }); }
+    inline f32x4 operator*(f32x4 a, f32x4 b) { return detail::map(a, b, [](float x, float y) { return x * y; }); }
+    inline f32x4 operator/(f32x4 a, f32x4 b) { return detail::map(a, b, [](float x, float y) { return x / y; }); }
+    inline f32x4 operator-(f32x4 a) { return {-a.v[0], -a.v[1], -a.v[2], -a.v[3]}; }
+
+    inline f32x4 min(f32x4 a, f32x4 b) { return detail::map(a, b, [](float x, float y) { return x < y ? x : y; }); }
+    inline f32x4 max(f32x4 a, f32x4 b) { return detail::map(a, b, [](float x, float y) { return x > y ? x : y; }); }
+    inline f32x4 abs(f32x4 a) { return detail::map(a, a, [](float x, float) { return std::fabs(x); }); }
+    inline f32x4 sqrt(f32x4 a) { return detail::map(a, a, [](float x, float) { return std::sqrt(x); }); }
+
+    inline mask4 operator<(f32x4 a, f32x4 b) { return detail::compare(a, b, [](float x, float y) { return x < y; }); }
+    inline mask4 operator>(f32x4 a, f32x4 b) { return detail::compare(a, b, [](float x, float y) { return x > y; }); }
+    inline mask4 operator==(f32x4 a, f32x4 b) { return detail::compare(a, b, [](float x, float y) { return x == y; }); }
+    inline mask4 operator!=(f32x4 a, f32x4 b) { return detail::compare(a, b, [](float x, float y) { return x != y; }); }
+
+    inline mask4 operator&(mask4 a, mask4 b) { return {{a.v[0] & b.v[0], a.v[1] & b.v[1], a.v[2] & b.v[2], a.v[3] & b.v[3]}}; }
+    inline mask4 operator|(mask4 a, mask4 b) { return {{a.v[0] | b.v[0], a.v[1] | b.v[1], a.v[2] | b.v[2], a.v[3] | b.v[3]}}; }
+    inline mask4 operator^(mask4 a, mask4 b) { return {{a.v[0] ^ b.v[0], a.v[1] ^ b.v[1], a.v[2] ^ b.v[2], a.v[3] ^ b.v[3]}}; }
+
+    inline f32x4 select(mask4 mask, f32x4 if_true, f32x4 if_false)
+    {
+        f32x4 out;
+        for (int i = 0; i < 4; ++i)
+            out.v[i] = mask.v[i] ? if_true.v[i] : if_false.v[i];
+        return out;
+    }
+
+    inline f32x4 trunc(f32x4 a) { return detail::map(a, a, [](float x, float) { return static_cast<float>(static_cast<int32_t>(x)); }); }
+#endif
+
+    inline f32x4 &operator+=(f32x4 &a, f32x4 b) { return a = a + b; }
+    inline f32x4 &operator-=(f32x4 &a, f32x4 b) { return a = a - b; }
+    inline f32x4 &operator*=(f32x4 &a, f32x4 b) { return a = a * b; }
+
+    inline f32x4 floor(f32x4 a)
+    {
+        const f32x4 t = trunc(a);
+        return select(t > a, t - 1.0f, t);
+    }
+
+    /// Rounds halves away from zero, like std::round.
+    inline f32x4 round(f32x4 a)
+    {
+        const f32x4 up = trunc(abs(a) + 0.5f);
+        return select(a < 0.0f, -up, up);
+    }
+
+    /// a - floor(a), in [0, 1)
+    inline f32x4 fract(f32x4 a) { return a - floor(a); }
+
+    /// Same sign as 'a' like std::fmod.
+    inline f32x4 fmod(f32x4 a, f32x4 b) { return a - trunc(a / b) * b; }
+
+    inline f32x4 clamp(f32x4 a, f32x4 lo, f32x4 hi) { return min(max(a, lo), hi); }
+
+    inline f32x4 mix(f32x4 a, f32x4 b, f32x4 t) { return a + (b - a) * t; }
+
+    // ─── Transcendentals ─────────────────────────────────────────────────────
+
+    namespace detail
+    {
+        /// x = q pi + r with r in [-pi/2, pi/2]. pi is split in two so r stays accurate for large x.
+        inline f32x4 reduce_pi(f32x4 x, f32x4 &q)
+        {
+            q = round(x * 0.318309886f);
+            return (x - q * 3.140625f) - q * 9.67653590e-4f;
+        }
+
+        /// (-1)^q v
+        inline f32x4 flip_odd(f32x4 q, f32x4 v)
+        {
+            const f32x4 half = q * 0.5f;
+            return select(floor(half) != half, -v, v);
+        }
+    }
+
+    inline f32x4 sin(f32x4 x)
+    {
+        f32x4 q;
+        const f32x4 r = detail::reduce_pi(x, q);
+
+        // Taylor series up to r^11, the first term left out is below 1e-7 on [-pi/2, pi/2]
+        const f32x4 r2 = r * r;
+        f32x4 p = -2.5052108e-8f;
+        p = p * r2 + 2.7557319e-6f;
+        p = p * r2 - 1.9841270e-4f;
+        p = p * r2 + 8.3333333e-3f;
+        p = p * r2 - 1.6666667e-1f;
+        return detail::flip_odd(q, r + r * r2 * p);
+    }
+
+    inline f32x4 cos(f32x4 x)
+    {
+        f32x4 q;
+        const f32x4 r = detail::reduce_pi(x, q);
+
+        const f32x4 r2 = r * r;
+        f32x4 p = 2.0876757e-9f;
+        p = p * r2 - 2.7557319e-7f;
+        p = p * r2 + 2.4801587e-5f;
+        p = p * r2 - 1.3888889e-3f;
+        p = p * r2 + 4.1666667e-2f;
+        p = p * r2 - 0.5f;
+        return detail::flip_odd(q, p * r2 + 1.0f);
+    }
+
+    /// Overflows to infinity above about 88 and returns 0 below about -87.
+    inline f32x4 exp(f32x4 x)
+    {
+        x = clamp(x, -87.3f, 88.7f);
+
+        // e^x = 2^n e^r with |r| <= ln(2) / 2
+        const f32x4 n = round(x * 1.44269504f);
+        const f32x4 r = (x - n * 0.693359375f) + n * 2.12194440e-4f;
+
+        f32x4 p = 1.9875691e-4f;
+        p = p * r + 1.3981999e-3f;
+        p = p * r + 8.3334519e-3f;
+        p = p * r + 4.1665795e-2f;
+        p = p * r + 1.6666665e-1f;
+        p = p * r + 5.0000001e-1f;
+        const f32x4 e = (p * r * r + r) + 1.0f;
+
+        // 2^n straight into the exponent bits. n goes down to -126 in two halves so
+        // that 2^-127 and below (e^x < ~1e-38) stay representable as n/2 + n/2.
+#if defined(FAST_MATH_SSE2)
+        const __m128i n1 = _mm_cvttps_epi32(_mm_mul_ps(n.v, _mm_set1_ps(0.5f)));
+        const __m128i n2 = _mm_sub_epi32(_mm_cvttps_epi32(n.v), n1);
+        const __m128 s1 = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n1, _mm_set1_epi32(127)), 23));
+        const __m128 s2 = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n2, _mm_set1_epi32(127)), 23));
+        return _mm_mul_ps(_mm_mul_ps(e.v, s1), s2);
+#elif defined(FAST_MATH_NEON)
+        const int32x4_t n1 = vcvtq_s32_f32(vmulq_f32(n.v, vdupq_n_f32(0.5f)));
+        const int32x4_t n2 = vsubq_s32(vcvtq_s32_f32(n.v), n1);
+        const float32x4_t s1 = vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(n1, vdupq_n_s32(127)), 23));
+        const float32x4_t s2 = vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(n2, vdupq_n_s32(127)), 23));
+        return vmulq_f32(vmulq_f32(e.v, s1), s2);
+#else
+        f32x4 out;
+        for (int i = 0; i < 4; ++i)
+            out.v[i] = std::ldexp(e.v[i], static_cast<int>(n.v[i]));
+        return out;
+#endif
+    }
+
+    /// Angle of (x, y) in [-pi, pi] like std::atan2, off by at most 2.5e-6 rad.
+    /// atan2(0, 0) is 0.
+    inline f32x4 atan2(f32x4 y, f32x4 x)
+    {
+        const f32x4 ax = abs(x);
+        const f32x4 ay = abs(y);
+
+        // atan of the smaller over the larger, in [0, 1]
+        const f32x4 hi = max(ax, ay);
+        const f32x4 lo = min(ax, ay);
+        const f32x4 t = select(hi == 0.0f, 0.0f, lo / select(hi == 0.0f, 1.0f, hi));
+
+        const f32x4 t2 = t * t;
+        f32x4 p = -1.17212e-2f;
+        p = p * t2 + 5.265332e-2f;
+        p = p * t2 - 1.1643287e-1f;
+        p = p * t2 + 1.9354346e-1f;
+        p = p * t2 - 3.3262347e-1f;
+        p = p * t2 + 9.9997726e-1f;
+        f32x4 angle = p * t;
+
+        // Back to the octant, quadrant and sign of the input
+        angle = select(ay > ax, 1.57079633f - angle, angle);
+        angle = select(x < 0.0f, 3.14159265f - angle, angle);
+        return select(y < 0.0f, -angle, angle);
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "graphics.h"
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/// Process-wide store of parsed BDF fonts.
+///
+/// Every plugin installs its own copy of the fonts it needs from shared/fonts, and the
+/// main binary one more for the fallback screen. Fonts are kept by file name, so the
+/// first copy of e.g. 7x13.bdf is parsed and every later load(), from whatever
+/// directory, gets that same font. Fonts are never unloaded, the pointers stay valid
+/// for the lifetime of the process.
+class FontRegistry
+{
+public:
+    static FontRegistry &instance();
+
+    FontRegistry() = default;
+    FontRegistry(const FontRegistry &) = delete;
+    FontRegistry &operator=(const FontRegistry &) = delete;
+
+    /// The font in 'path', parsed on first use. nullptr if the file could not be loaded,
+    /// failed loads are tried again on the next call.
+    const rgb_matrix::Font *load(const std::filesystem::path &path);
+
+private:
+    std::mutex mutex;
+    std::unordered_map<std::string, std::unique_ptr<rgb_matrix::Font>> fonts;
+};
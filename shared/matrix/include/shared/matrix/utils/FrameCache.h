@@ -0,0 +1,101 @@
+#pragma once
+
+#include "led-matrix.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+
+/// A decoded, canvas-sized animation from the FrameCache, mapped read-only.
+/// Frames are RGB888 rows of width x height pixels, played straight from the mapping.
+class CachedAnimation {
+public:
+    /// Maps 'path'. Returns nullptr if the file is not a valid cache entry of the given size.
+    static std::shared_ptr<const CachedAnimation> open(const std::filesystem::path &path, int width, int height);
+
+    ~CachedAnimation();
+
+    CachedAnimation(const CachedAnimation &) = delete;
+    CachedAnimation &operator=(const CachedAnimation &) = delete;
+
+    [[nodiscard]] int width() const { return frame_width; }
+    [[nodiscard]] int height() const { return frame_height; }
+    [[nodiscard]] size_t frame_count() const { return frames; }
+    [[nodiscard]] size_t size_bytes() const { return mapping_size; }
+
+    [[nodiscard]] const uint8_t *frame(size_t index) const;
+
+    /// How long frame 'index' is shown. 0 for single images, their duration is up to the scene.
+    [[nodiscard]] uint32_t delay_us(size_t index) const;
+
+    /// Writes frame 'index' into 'canvas' with one SetPixels call.
+    void write_to(rgb_matrix::FrameCanvas *canvas, size_t index) const;
+
+private:
+    CachedAnimation(void *mapping, size_t mapping_size, int width, int height, size_t frames);
+
+    void *mapping;
+    size_t mapping_size;
+    int frame_width;
+    int frame_height;
+    size_t frames;
+    const uint32_t *delays;
+    const uint8_t *pixels;
+};
+
+/// The frame cache is on by default. MATRIX_FRAME_CACHE_MB sets its byte budget
+/// (default 256), 0 turns it off.
+struct FrameCacheSettings {
+    std::filesystem::path directory;
+    uint64_t budget_bytes = 0;
+
+    static std::optional<FrameCacheSettings> from_env();
+};
+
+/// Persistent on-disk cache of decoded animations, keyed by an image id (e.g. the post
+/// hash) and the matrix size. Entries are evicted least recently used first once the
+/// byte budget is exceeded; the access order survives restarts through the file mtime.
+class FrameCache {
+public:
+    explicit FrameCache(FrameCacheSettings settings);
+
+    /// The process-wide cache configured from the environment, nullptr if it is disabled.
+    static FrameCache *instance();
+
+    /// Returns the cached animation or nullptr on a miss.
+    std::shared_ptr<const CachedAnimation> get(const std::string &id, int width, int height);
+
+    /// Stores 'frame_count' frames of width x height RGB888 pixels, back to back in 'rgb',
+    /// and returns the mapped entry. Returns nullptr if it could not be written.
+    std::shared_ptr<const CachedAnimation> put(const std::string &id, int width, int height,
+                                               std::span<const uint8_t> rgb, std::span<const uint32_t> delays_us);
+
+    [[nodiscard]] uint64_t total_bytes() const;
+
+private:
+    struct Entry {
+        std::string name;
+        uint64_t size;
+    };
+
+    [[nodiscard]] std::filesystem::path path_for(const std::string &name) const;
+    void touch_locked(std::unordered_map<std::string, std::list<Entry>::iterator>::iterator it);
+    void remove_locked(const std::string &name);
+    void evict_locked();
+
+    std::filesystem::path directory;
+    uint64_t budget_bytes;
+
+    mutable std::mutex mutex;
+    /// Most recently used first.
+    std::list<Entry> lru;
+    std::unordered_map<std::string, std::list<Entry>::iterator> entries;
+    uint64_t used_bytes = 0;
+    uint64_t temp_counter = 0;
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <map>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// Latency histogram with log-linear buckets (8 sub-buckets per power of two,
+/// so every bucket is at most 12.5% wide) covering 1 µs to ~18 minutes.
+/// record() only does relaxed atomic increments, so the render loop never
+/// blocks on a reader and percentiles can be read from any thread.
+class LatencyHistogram
+{
+public:
+    static constexpr int sub_bucket_bits = 3;
+    static constexpr int sub_bucket_count = 1 << sub_bucket_bits;
+    static constexpr int bucket_count = 28 * sub_bucket_count;
+
+    struct Snapshot
+    {
+        uint64_t count = 0;
+        double sum_seconds = 0;
+        double p50_seconds = 0;
+        double p95_seconds = 0;
+        double p99_seconds = 0;
+        double max_seconds = 0;
+    };
+
+    void record(std::chrono::nanoseconds duration);
+
+    [[nodiscard]] Snapshot snapshot() const;
+
+    void reset();
+
+private:
+    static size_t bucket_index(uint64_t micros);
+    static uint64_t bucket_upper_bound(size_t index);
+
+    std::array<std::atomic<uint64_t>, bucket_count> buckets{};
+    std::atomic<uint64_t> sum_ns{0};
+    std::atomic<uint64_t> max_ns{0};
+};
+
+/// Per-scene frame timings of the render loop.
+struct SceneProfile
+{
+    /// Time spent in Scene::render(), without the frame pacing sleep.
+    LatencyHistogram render;
+    LatencyHistogram post_processing;
+    /// Transition blend, recorded on the outgoing scene.
+    LatencyHistogram transition;
+    /// Time blocked in SwapOnVSync().
+    LatencyHistogram swap_wait;
+};
+
+/// Process-wide registry of scene profiles, read by the /metrics routes.
+class FrameProfiler
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    static FrameProfiler &instance();
+
+    /// Returns the profile for a scene, creating it on first use. The reference
+    /// stays valid for the lifetime of the process, so look it up once per scene
+    /// activation and not once per frame.
+    SceneProfile &get(const std::string &scene_name);
+
+    /// Snapshot of all profiles, sorted by scene name.
+    [[nodiscard]] std::vector<std::pair<std::string, const SceneProfile *>> profiles() const;
+
+    /// Process-wide histogram that is not tied to a scene (e.g. UDP receive latency),
+    /// exported as 'metric_name'. Created on first use, the reference stays valid.
+    LatencyHistogram &histogram(const std::string &metric_name, const std::string &help);
+
+    struct NamedHistogram
+    {
+        std::string name;
+        std::string help;
+        const LatencyHistogram *histogram;
+    };
+
+    /// Snapshot of all process-wide histograms, sorted by metric name.
+    [[nodiscard]] std::vector<NamedHistogram> histograms() const;
+
+    void reset();
+
+    [[nodiscard]] std::string to_prometheus() const;
+
+    static std::chrono::nanoseconds since(clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+    }
+
+private:
+    FrameProfiler() = default;
+
+    mutable std::shared_mutex profiles_mutex;
+    std::unordered_map<std::string, std::unique_ptr<SceneProfile>> scene_profiles;
+
+    std::map<std::string, std::pair<std::string, std::unique_ptr<LatencyHistogram>>> named_histograms;
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include "shared/common/udp/frame_stream.h"
+#include "shared/matrix/utils/FrameTripleBuffer.h"
+
+/// Matrix side of a frame stream from the desktop app. Accepts both legacy payloads
+/// (one raw RGB24 frame per packet) and FrameStream fragments, decodes the fragments
+/// in place and publishes every complete frame to a FrameTripleBuffer for the scene.
+class FrameStreamReceiver
+{
+public:
+    /// Minimum time between repeated keyframe requests while the decoder stays out of sync,
+    /// so a lossy link is not flooded with keyframes. The first request is sent right away.
+    static constexpr auto keyframe_request_interval = std::chrono::milliseconds(250);
+
+    /// Writer side, called from the plugin's on_udp_packet() with the packet payload.
+    /// That runs on the UDP or the shared-memory thread, PacketDispatcher makes sure
+    /// never on both at once, so the receiver has a single writer at any time.
+    void receive(const uint8_t *payload, size_t size);
+
+    /// Returns true if the decoder lost sync and a keyframe should be requested now.
+    /// The caller then sends FrameStream::keyframe_request_message to the desktop.
+    /// Only call this from on_udp_packet(), right after receive().
+    [[nodiscard]] bool take_keyframe_request();
+
+    /// Reader side: the newest complete frame, see FrameTripleBuffer::read().
+    [[nodiscard]] FrameTripleBuffer::FrameView read() { return frames.read(); }
+
+    [[nodiscard]] uint64_t frames_written() const { return frames.frames_written(); }
+    [[nodiscard]] std::chrono::steady_clock::time_point last_write() const { return frames.last_write(); }
+
+private:
+    FrameTripleBuffer frames;
+    FrameStream::Decoder decoder;
+    std::chrono::steady_clock::time_point last_keyframe_request;
+    bool keyframe_requested = false;
+};
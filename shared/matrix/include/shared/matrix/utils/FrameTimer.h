@@ -3,7 +3,8 @@
 #include <chrono>
 
 struct FrameTime {
-    std::chrono::high_resolution_clock::time_point now;
+    /// Clock::now() at the tick
+    std::chrono::nanoseconds now;
 
     std::chrono::duration<double> deltaStart;
     std::chrono::duration<double> deltaFrame;
@@ -19,6 +20,6 @@ public:
     const FrameTime tick();
 
 private:
-    std::chrono::high_resolution_clock::time_point startTick;
-    std::chrono::high_resolution_clock::time_point lastTick;
+    std::chrono::nanoseconds startTick;
+    std::chrono::nanoseconds lastTick;
 };
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/// Triple buffer for frames streamed from the desktop app.
+/// The packet dispatch (UDP or shared-memory thread, serialized per plugin by
+/// PacketDispatcher) is the only writer and never blocks: it copies the payload
+/// into its back buffer and swaps it with the shared middle buffer. Readers
+/// swap the middle buffer into the front buffer if a newer frame is available
+/// and read it in place, so a frame is copied exactly once after it was received.
+class FrameTripleBuffer
+{
+    struct Buffer
+    {
+        std::vector<uint8_t> bytes;
+        size_t size = 0;
+        std::chrono::steady_clock::time_point received;
+    };
+
+public:
+    /// Read access to the newest frame. Holds the reader lock while alive, so
+    /// keep it only for as long as the frame is being drawn.
+    class FrameView
+    {
+    public:
+        [[nodiscard]] const uint8_t *data() const { return buffer->bytes.data(); }
+        [[nodiscard]] size_t size() const { return buffer->size; }
+        [[nodiscard]] bool empty() const { return buffer->size == 0; }
+        [[nodiscard]] std::chrono::steady_clock::time_point received() const { return buffer->received; }
+
+    private:
+        friend class FrameTripleBuffer;
+
+        FrameView(std::unique_lock<std::mutex> lock, const Buffer *buffer)
+            : lock(std::move(lock)), buffer(buffer)
+        {
+        }
+
+        std::unique_lock<std::mutex> lock;
+        const Buffer *buffer;
+    };
+
+    /// Writer side: copies 'size' bytes into the back buffer and publishes them.
+    /// Only allocates if the frame is larger than any frame before.
+    void write(const uint8_t *payload, size_t size);
+
+    /// Reader side: returns the newest published frame (empty if none arrived yet).
+    [[nodiscard]] FrameView read();
+
+    /// Number of frames written so far.
+    [[nodiscard]] uint64_t frames_written() const
+    {
+        return written.load(std::memory_order_relaxed);
+    }
+
+    /// Time of the last write, or a default constructed time point if nothing was written.
+    [[nodiscard]] std::chrono::steady_clock::time_point last_write() const
+    {
+        return std::chrono::steady_clock::time_point(
+            std::chrono::steady_clock::duration(last_write_ticks.load(std::memory_order_relaxed)));
+    }
+
+private:
+    static constexpr uint8_t index_mask = 0x3;
+    static constexpr uint8_t fresh_bit = 0x4;
+
+    std::array<Buffer, 3> buffers;
+
+    /// Index of the middle buffer, plus fresh_bit if it holds a frame the readers have not seen yet.
+    std::atomic<uint8_t> middle{1};
+    uint8_t back = 0;
+    uint8_t front = 2;
+
+    /// Serializes readers only (two scenes may read the same plugin during a cross-fade).
+    std::mutex reader_mutex;
+
+    std::atomic<uint64_t> written{0};
+    std::atomic<std::chrono::steady_clock::rep> last_write_ticks{0};
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "shared/matrix/canvas_buffer.h"
+#include "shared/matrix/utils/FastMath.h"
+#include "shared/matrix/utils/RenderPool.h"
+#include <algorithm>
+#include <cstdint>
+
+/// Runs a per-pixel function over a whole frame, four pixels at a time.
+///
+/// A shader is any callable taking the pixel coordinates of four neighbouring pixels
+/// of one row (x, x + 1, x + 2, x + 3 and y, as FastMath::f32x4) and returning their
+/// colors. Per-frame values (time, properties, anything that is the same for every
+/// pixel) belong in the shader object, computed once before render() is called:
+///
+///     struct Gradient {
+///         float t;
+///         PixelShader::Color4 operator()(FastMath::f32x4 x, FastMath::f32x4 y) const {
+///             return {FastMath::sin(x * 0.1f + t) * 0.5f + 0.5f, y * (1.0f / 64), 0.0f};
+///         }
+///     };
+///
+///     PixelShader::render(frame, Gradient{t});
+///     frame.write_to(canvas);
+///
+/// Rows are spread over the shared RenderPool, so the shader is called from several
+/// threads at once and must not modify anything. At the right edge of the frame it
+/// may be called with x past the last column, those lanes are thrown away.
+namespace PixelShader
+{
+    /// Colors of four pixels, channels in [0, 1]. Anything outside is clamped.
+    struct Color4
+    {
+        FastMath::f32x4 r, g, b;
+    };
+
+    /// Writes the first 'count' (1 to 4) pixels of 'color' to 'out'. Channels are
+    /// scaled to 0-255 and truncated.
+    inline void store(const Color4 &color, rgb_matrix::Color *out, int count)
+    {
+        alignas(16) float r[4], g[4], b[4];
+        FastMath::clamp(color.r * 255.0f, 0.0f, 255.0f).store(r);
+        FastMath::clamp(color.g * 255.0f, 0.0f, 255.0f).store(g);
+        FastMath::clamp(color.b * 255.0f, 0.0f, 255.0f).store(b);
+
+        for (int i = 0; i < count; ++i)
+            out[i] = rgb_matrix::Color(static_cast<uint8_t>(r[i]), static_cast<uint8_t>(g[i]),
+                                       static_cast<uint8_t>(b[i]));
+    }
+
+    /// Renders every pixel of 'frame' with 'shader'. Returns once the frame is complete.
+    template<typename Shader>
+    void render(CanvasBuffer &frame, const Shader &shader, RenderPool &pool = RenderPool::instance())
+    {
+        const int width = frame.width();
+
+        pool.parallel_rows(frame.height(), [&](int y_begin, int y_end)
+        {
+            for (int y = y_begin; y < y_end; ++y)
+            {
+                rgb_matrix::Color *row = frame.row(y);
+                const FastMath::f32x4 fy(static_cast<float>(y));
+
+                for (int x = 0; x < width; x += 4)
+                {
+                    const Color4 color = shader(FastMath::f32x4::ramp(static_cast<float>(x)), fy);
+                    store(color, row + x, std::min(4, width - x));
+                }
+            }
+        });
+    }
+}
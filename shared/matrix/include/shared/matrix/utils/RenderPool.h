@@ -0,0 +1,79 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Settings of the shared render pool, read from the environment:
+///   MATRIX_RENDER_THREADS=n   worker threads besides the thread that renders (default:
+///                             one per core that is left, at most 8, see RenderPool)
+///   MATRIX_RENDER_PIN=0       do not pin the workers to their cores
+///   MATRIX_REFRESH_CORE=3     core of the matrix library's refresh thread, kept free of
+///                             workers (-1: don't reserve one)
+struct RenderPoolSettings
+{
+    int workers = 0;
+    bool pin = true;
+    /// The library pins its refresh thread with a fixed affinity mask of core 3 (it has
+    /// no option for it), so this only needs changing for a patched library or an
+    /// isolcpus setup.
+    int refresh_core = 3;
+
+    static RenderPoolSettings from_env();
+};
+
+/// Process-wide worker threads for per-pixel scenes.
+///
+/// parallel_rows() splits the rows of a frame into tiles. Every thread taking part
+/// (the calling render thread and the workers) starts on its own contiguous share
+/// of the tiles and, once that is done, steals tiles from the back of the others'
+/// shares, so an expensive region of the frame does not hold everyone up.
+///
+/// The matrix library pins its refresh thread to core 3 on multi-core Pis. That core
+/// (RenderPoolSettings::refresh_core) is never given to a worker, and every worker
+/// gets a core of its own with one left for the render thread, so the pool cannot
+/// oversubscribe the refresh thread and the panel does not flicker. On a single core
+/// there are no workers and jobs just run inline.
+///
+/// Several threads may run jobs at once (e.g. both scenes of a transition), workers
+/// help with whichever job still has tiles left.
+class RenderPool
+{
+public:
+    /// Called with a half-open range of rows [y_begin, y_end).
+    using RowJob = std::function<void(int y_begin, int y_end)>;
+
+    /// The pool shared by all scenes, started on first use with RenderPoolSettings::from_env().
+    static RenderPool &instance();
+
+    explicit RenderPool(const RenderPoolSettings &settings);
+    ~RenderPool();
+
+    RenderPool(const RenderPool &) = delete;
+    RenderPool &operator=(const RenderPool &) = delete;
+
+    /// Runs 'job' over all rows [0, rows) and returns once every row is done. Tiles are
+    /// 'tile_rows' rows high, 0 picks a size that gives every thread a few tiles. Rows
+    /// run on different threads, so 'job' must only write to the rows it was given.
+    void parallel_rows(int rows, const RowJob &job, int tile_rows = 0);
+
+    [[nodiscard]] int worker_count() const { return static_cast<int>(workers.size()); }
+
+private:
+    struct Job;
+
+    void worker_loop();
+    /// Works on tiles of 'job' until none are left, starting with the share 'home'
+    /// (-1: steal only).
+    static void run_tiles(Job &job, int home);
+
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable work_done;
+    std::vector<Job *> jobs;
+    bool stopping = false;
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "graphics.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/// Strings drawn with BDF fonts, rasterized once and drawn from then on as runs of lit
+/// pixels.
+///
+/// rgb_matrix::DrawText() decodes the UTF-8, looks every glyph up in the font and
+/// tests its bitmap bit by bit with one SetPixel() per lit pixel, every frame, even
+/// for labels that do not change for minutes. The cache does that once per font,
+/// string and color and from then on only writes the lit pixels, every horizontal
+/// run of more than one pixel with a single SetPixels() call.
+///
+/// Entries are kept for the fonts' addresses, fonts have to outlive the cache (fonts
+/// from the FontRegistry always do). The least recently drawn string is dropped once
+/// 'capacity' strings are cached. Not thread-safe, every scene keeps its own cache.
+class TextCache
+{
+public:
+    explicit TextCache(size_t capacity = 64);
+
+    /// Same as rgb_matrix::DrawText(canvas, font, x, y, color, text): draws 'text'
+    /// with its baseline at 'y' and returns how far it advanced in x. With a null
+    /// 'canvas' it only measures the text (and caches it for the draw that follows).
+    int draw(rgb_matrix::Canvas *canvas, const rgb_matrix::Font &font, int x, int y, const rgb_matrix::Color &color,
+             std::string_view text);
+
+    void clear();
+
+    [[nodiscard]] size_t size() const { return entries.size(); }
+
+private:
+    /// 'length' lit pixels from (x, y), relative to the origin DrawText() was given.
+    struct Run
+    {
+        int16_t x;
+        int16_t y;
+        int16_t length;
+    };
+
+    struct Entry
+    {
+        std::vector<Run> runs;
+        /// The text's color, as long as its longest run, handed to SetPixels().
+        std::vector<rgb_matrix::Color> colors;
+        int advance = 0;
+        uint64_t last_used = 0;
+    };
+
+    struct Key
+    {
+        const rgb_matrix::Font *font;
+        uint32_t color;
+        std::string text;
+    };
+
+    struct KeyView
+    {
+        const rgb_matrix::Font *font;
+        uint32_t color;
+        std::string_view text;
+    };
+
+    struct KeyHash
+    {
+        using is_transparent = void;
+        size_t operator()(const KeyView &key) const;
+        size_t operator()(const Key &key) const { return (*this)(KeyView{key.font, key.color, key.text}); }
+    };
+
+    struct KeyEqual
+    {
+        using is_transparent = void;
+        template <typename A, typename B>
+        bool operator()(const A &a, const B &b) const
+        {
+            return a.font == b.font && a.color == b.color && std::string_view(a.text) == std::string_view(b.text);
+        }
+    };
+
+    /// The cached entry for the text, rasterizing it on first use.
+    const Entry &lookup(const rgb_matrix::Font &font, const rgb_matrix::Color &color, std::string_view text);
+
+    static Entry rasterize(const rgb_matrix::Font &font, const rgb_matrix::Color &color, std::string_view text);
+
+    size_t capacity;
+    uint64_t clock = 0;
+    std::unordered_map<Key, Entry, KeyHash, KeyEqual> entries;
+};
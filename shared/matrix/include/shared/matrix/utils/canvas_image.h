@@ -8,12 +8,17 @@
 #include <filesystem>
 #include <optional>
 #include "magick/image.h"
+#include "shared/matrix/canvas_layer.h"
 
 using namespace std;
 
 bool SetImageTransparent(rgb_matrix::FrameCanvas *c, int x_offset, int y_offset,
                          const Magick::Image& img);
 
+/// Same, blended into a cached layer instead of the canvas.
+bool SetImageTransparent(CanvasLayer *layer, int x_offset, int y_offset,
+                         const Magick::Image& img);
+
 std::expected<vector<Magick::Image>, string>
 LoadImageAndScale(const filesystem::path &path, int canvas_width, int canvas_height, bool fill_width, bool fill_height,
                   bool contain_img, bool store_resized_img = false, std::optional<std::function<void(Magick::Image*)>> pre_process = std::nullopt);
@@ -23,4 +28,8 @@ void StoreInStream(const Magick::Image &img, int64_t delay_time_us,
                    rgb_matrix::FrameCanvas *scratch,
                    rgb_matrix::StreamWriter *output);
 
+/// Renders 'img' like StoreInStream does (black background, transparent pixels skipped)
+/// into 'out', which holds canvas_width * canvas_height RGB888 pixels.
+void RenderToRgb(const Magick::Image &img, bool do_center, int canvas_width, int canvas_height, uint8_t *out);
+
 filesystem::path to_processed_path(const filesystem::path &path);
\ No newline at end of file
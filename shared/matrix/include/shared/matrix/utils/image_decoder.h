@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+/// Decodes GIF, PNG and JPEG straight into 8-bit RGBA at the size they are shown at,
+/// without GraphicsMagick's full-size 16-bit frames. Anything else is left to Magick.
+namespace ImageDecoder {
+    enum class Format {
+        Gif,
+        Png,
+        Jpeg,
+        Unknown
+    };
+
+    /// Detects the format from the file signature.
+    Format detect_format(std::span<const uint8_t> data);
+
+    /// Where the source ends up: it is scaled to scaled_width x scaled_height and
+    /// then cropped to width x height at crop_x, crop_y.
+    struct Geometry {
+        int scaled_width = 0;
+        int scaled_height = 0;
+        int crop_x = 0;
+        int crop_y = 0;
+        int width = 0;
+        int height = 0;
+        /// Nearest neighbour instead of box filtering, used when upscaling.
+        bool nearest = false;
+    };
+
+    /// Called with the source size once the header is read.
+    using GeometryFn = std::function<Geometry(int source_width, int source_height)>;
+
+    struct Frame {
+        /// width * height RGBA pixels, not premultiplied
+        std::vector<uint8_t> rgba;
+        /// in 1/100s, like Magick::Image::animationDelay()
+        uint32_t delay_cs = 0;
+    };
+
+    struct Image {
+        int width = 0;
+        int height = 0;
+        /// Fully composed frames, GIF disposal already applied.
+        std::vector<Frame> frames;
+    };
+
+    /// Decodes 'data' and scales every frame as 'geometry' says. Returns an error for
+    /// other formats and for files this decoder can't handle, callers fall back to Magick then.
+    std::expected<Image, std::string> decode(std::span<const uint8_t> data, const GeometryFn &geometry);
+
+    std::expected<Image, std::string> decode_file(const std::filesystem::path &path, const GeometryFn &geometry);
+}
@@ -1,8 +1,10 @@
 #include "shared/matrix/Scene.h"
 
 #include <shared/common/utils/utils.h>
+#include <shared/common/utils/clock.h>
 #include <shared/matrix/utils/utils.h>
 #include <shared/matrix/utils/uuid.h>
+#include <shared/matrix/utils/RenderPool.h>
 #include "spdlog/spdlog.h"
 #include "shared/matrix/plugin_loader/loader.h"
 #include "shared/matrix/plugin/property.h"
@@ -106,7 +108,7 @@ int Scenes::Scene::get_weight() const
 void Scenes::Scene::wait_until_next_frame()
 {
     tmillis_t step = 1000 / target_fps;
-    tmillis_t current_time = GetTimeInMillis();
+    tmillis_t current_time = Clock::wall_millis();
 
     if (last_render_time + step < current_time)
     {
@@ -114,10 +116,18 @@ void Scenes::Scene::wait_until_next_frame()
         return;
     }
 
-    SleepMillis(last_render_time + step - current_time);
+    // Measured on steady_clock like the profiler that subtracts it, Clock may be scaled or stepped
+    const auto sleep_start = std::chrono::steady_clock::now();
+    Clock::sleep_for(std::chrono::milliseconds(last_render_time + step - current_time));
+    pacing_wait += std::chrono::steady_clock::now() - sleep_start;
     last_render_time = current_time;
 }
 
+void Scenes::Scene::parallel_rows(int height, const std::function<void(int y_begin, int y_end)> &fn)
+{
+    RenderPool::instance().parallel_rows(height, fn);
+}
+
 Scenes::Scene::Scene()
 {
     add_property(weight);
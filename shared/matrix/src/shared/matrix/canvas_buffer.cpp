@@ -0,0 +1,66 @@
+#include "shared/matrix/canvas_buffer.h"
+#include <algorithm>
+
+CanvasBuffer::CanvasBuffer(int width, int height)
+{
+    resize(width, height);
+}
+
+void CanvasBuffer::resize(int width, int height)
+{
+    width = std::max(0, width);
+    height = std::max(0, height);
+    if (width == buffer_width && height == buffer_height)
+        return;
+
+    buffer_width = width;
+    buffer_height = height;
+    pixels.assign(static_cast<size_t>(width) * height, rgb_matrix::Color());
+}
+
+void CanvasBuffer::read_from(FrameCanvas *canvas)
+{
+    if (canvas == nullptr)
+        return;
+
+    resize(canvas->width(), canvas->height());
+
+    rgb_matrix::Color *out = pixels.data();
+    for (int y = 0; y < buffer_height; ++y)
+    {
+        for (int x = 0; x < buffer_width; ++x, ++out)
+        {
+            canvas->GetPixel(x, y, &out->r, &out->g, &out->b);
+        }
+    }
+}
+
+void CanvasBuffer::write_to(FrameCanvas *canvas) const
+{
+    if (canvas == nullptr || pixels.empty())
+        return;
+
+    const int w = std::min(buffer_width, canvas->width());
+    const int h = std::min(buffer_height, canvas->height());
+    if (w == buffer_width)
+    {
+        // SetPixels() takes a non-const pointer but never writes through it.
+        canvas->SetPixels(0, 0, w, h, const_cast<rgb_matrix::Color *>(pixels.data()));
+        return;
+    }
+
+    for (int y = 0; y < h; ++y)
+    {
+        canvas->SetPixels(0, y, w, 1, const_cast<rgb_matrix::Color *>(row(y)));
+    }
+}
+
+void CanvasBuffer::fill(const rgb_matrix::Color &color)
+{
+    std::fill(pixels.begin(), pixels.end(), color);
+}
+
+void CanvasBuffer::clear()
+{
+    fill(rgb_matrix::Color());
+}
@@ -0,0 +1,157 @@
+#include "shared/matrix/canvas_layer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    /// value * scale / 255, rounded
+    uint8_t scale(int value, int scale)
+    {
+        const int product = value * scale + 128;
+        return static_cast<uint8_t>((product + (product >> 8)) >> 8);
+    }
+}
+
+CanvasLayer::CanvasLayer(int width, int height)
+{
+    resize(width, height);
+}
+
+void CanvasLayer::resize(int width, int height)
+{
+    width = std::max(0, width);
+    height = std::max(0, height);
+    if (width == layer_width && height == layer_height)
+        return;
+
+    layer_width = width;
+    layer_height = height;
+    colors.assign(static_cast<size_t>(width) * height, rgb_matrix::Color());
+    coverage.assign(colors.size(), 0);
+    runs.clear();
+    covered = 0;
+    drawn = false;
+}
+
+void CanvasLayer::begin(uint64_t key)
+{
+    Clear();
+    drawn = false;
+    drawn_key = key;
+}
+
+void CanvasLayer::end()
+{
+    runs.clear();
+    covered = 0;
+
+    for (int y = 0; y < layer_height; ++y)
+    {
+        const size_t row = static_cast<size_t>(y) * layer_width;
+        int x = 0;
+        while (x < layer_width)
+        {
+            const uint8_t first = coverage[row + x];
+            if (first == 0)
+            {
+                x++;
+                continue;
+            }
+
+            // Runs end at the row so composite() never has to care about the stride
+            const bool opaque = first == 255;
+            int end = x + 1;
+            while (end < layer_width && coverage[row + end] != 0 && (coverage[row + end] == 255) == opaque)
+                end++;
+
+            runs.push_back({static_cast<uint32_t>(row + x), static_cast<uint32_t>(end - x), opaque});
+            covered += end - x;
+            x = end;
+        }
+    }
+
+    drawn = true;
+}
+
+void CanvasLayer::composite(CanvasBuffer &frame) const
+{
+    if (frame.width() != layer_width || frame.height() != layer_height)
+        return;
+
+    rgb_matrix::Color *out = frame.data();
+    for (const Run &run : runs)
+    {
+        if (run.opaque)
+        {
+            std::memcpy(out + run.offset, colors.data() + run.offset, run.length * sizeof(rgb_matrix::Color));
+            continue;
+        }
+
+        for (uint32_t i = run.offset; i < run.offset + run.length; ++i)
+        {
+            const int rest = 255 - coverage[i];
+            out[i].r = colors[i].r + scale(out[i].r, rest);
+            out[i].g = colors[i].g + scale(out[i].g, rest);
+            out[i].b = colors[i].b + scale(out[i].b, rest);
+        }
+    }
+}
+
+void CanvasLayer::blend(int x, int y, uint8_t r, uint8_t g, uint8_t b, float alpha)
+{
+    if (x < 0 || x >= layer_width || y < 0 || y >= layer_height)
+        return;
+
+    const int a = static_cast<int>(std::lround(std::clamp(alpha, 0.0f, 1.0f) * 255.0f));
+    if (a == 0)
+        return;
+
+    const size_t i = static_cast<size_t>(y) * layer_width + x;
+    const int rest = 255 - a;
+
+    // Porter-Duff "over" on premultiplied colors
+    rgb_matrix::Color &color = colors[i];
+    color.r = scale(r, a) + scale(color.r, rest);
+    color.g = scale(g, a) + scale(color.g, rest);
+    color.b = scale(b, a) + scale(color.b, rest);
+    coverage[i] = static_cast<uint8_t>(a + scale(coverage[i], rest));
+}
+
+void CanvasLayer::SetPixel(int x, int y, uint8_t r, uint8_t g, uint8_t b)
+{
+    if (x < 0 || x >= layer_width || y < 0 || y >= layer_height)
+        return;
+
+    const size_t i = static_cast<size_t>(y) * layer_width + x;
+    colors[i] = rgb_matrix::Color(r, g, b);
+    coverage[i] = 255;
+}
+
+void CanvasLayer::SetPixels(int x, int y, int width, int height, rgb_matrix::Color *pixels)
+{
+    const int x_begin = std::max(0, x);
+    const int x_end = std::min(layer_width, x + width);
+    if (x_begin >= x_end)
+        return;
+
+    for (int row = std::max(0, y); row < std::min(layer_height, y + height); ++row)
+    {
+        const size_t i = static_cast<size_t>(row) * layer_width + x_begin;
+        const rgb_matrix::Color *in = pixels + static_cast<size_t>(row - y) * width + (x_begin - x);
+        std::copy_n(in, x_end - x_begin, colors.begin() + i);
+        std::fill_n(coverage.begin() + i, x_end - x_begin, 255);
+    }
+}
+
+void CanvasLayer::Clear()
+{
+    std::fill(colors.begin(), colors.end(), rgb_matrix::Color());
+    std::fill(coverage.begin(), coverage.end(), 0);
+}
+
+void CanvasLayer::Fill(uint8_t r, uint8_t g, uint8_t b)
+{
+    std::fill(colors.begin(), colors.end(), rgb_matrix::Color(r, g, b));
+    std::fill(coverage.begin(), coverage.end(), 255);
+}
@@ -15,6 +15,21 @@ void ImageProviders::General::load_properties(const nlohmann::json &j) {
     }
 }
 
+std::expected<std::optional<ImageProviders::PendingPost>, string> ImageProviders::General::get_next_pending() {
+    auto res = get_next_image();
+    if (!res.has_value())
+        return std::unexpected(res.error());
+
+    if (!res->has_value())
+        return std::nullopt;
+
+    // std::function has to be copyable, the post itself may not be
+    auto post = std::make_shared<PostVariant>(std::move(res->value()));
+    return PendingPost([post]() -> std::expected<PostVariant, string> {
+        return std::move(*post);
+    });
+}
+
 nlohmann::json ImageProviders::General::to_json() const {
     nlohmann::json j;
     for (const auto& item: properties) {
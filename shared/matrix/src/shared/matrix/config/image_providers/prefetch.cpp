@@ -0,0 +1,450 @@
+#include "shared/matrix/config/image_providers/prefetch.h"
+#include "shared/matrix/utils/canvas_image.h"
+#include "shared/common/utils/env.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include "spdlog/spdlog.h"
+
+using namespace std;
+
+namespace {
+    Post *get_post(ImageProviders::PostVariant &post) {
+        if (holds_alternative<std::unique_ptr<Post, void (*)(Post *)> >(post))
+            return get<0>(post).get();
+
+        return get<1>(post).get();
+    }
+
+    /// Fixed set of threads shared by every prefetcher in the process. Image work is
+    /// mostly waiting on the network, so this is kept apart from the render workers.
+    class PrefetchPool {
+    public:
+        explicit PrefetchPool(const size_t threads) {
+            for (size_t i = 0; i < threads; ++i)
+                workers.emplace_back([this] { run(); });
+        }
+
+        ~PrefetchPool() {
+            {
+                std::lock_guard lock(mutex);
+                stopping = true;
+            }
+            cv.notify_all();
+            for (auto &worker: workers)
+                worker.join();
+        }
+
+        static PrefetchPool &instance(const size_t threads) {
+            static PrefetchPool pool(threads);
+            return pool;
+        }
+
+        void submit(std::function<void()> job) {
+            {
+                std::lock_guard lock(mutex);
+                jobs.push_back(std::move(job));
+            }
+            cv.notify_one();
+        }
+
+    private:
+        void run() {
+            while (true) {
+                std::function<void()> job;
+                {
+                    std::unique_lock lock(mutex);
+                    cv.wait(lock, [this] { return stopping || !jobs.empty(); });
+                    if (jobs.empty())
+                        return;
+
+                    job = std::move(jobs.front());
+                    jobs.pop_front();
+                }
+
+                try {
+                    job();
+                } catch (const std::exception &e) {
+                    spdlog::error("Image prefetch job failed: {}", e.what());
+                }
+            }
+        }
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<std::function<void()> > jobs;
+        std::vector<std::thread> workers;
+        bool stopping = false;
+    };
+
+    /// Post files that a download or decode stage is working on, across all prefetchers.
+    /// Identical posts share one file name, so only one stage at a time may touch it:
+    /// another one would download over it or remove it while it is being decoded.
+    class FileClaims {
+    public:
+        static FileClaims &instance() {
+            static FileClaims claims;
+            return claims;
+        }
+
+        /// Returns true if 'name' was free and is now claimed. Otherwise 'on_release'
+        /// runs once the current claim is released.
+        bool claim(const std::string &name, std::function<void()> on_release) {
+            std::lock_guard lock(mutex);
+            const auto [it, inserted] = claims.try_emplace(name);
+            if (!inserted)
+                it->second.push_back(std::move(on_release));
+            return inserted;
+        }
+
+        void release(const std::string &name) {
+            std::vector<std::function<void()> > waiters;
+            {
+                std::lock_guard lock(mutex);
+                const auto it = claims.find(name);
+                if (it == claims.end())
+                    return;
+
+                waiters = std::move(it->second);
+                claims.erase(it);
+            }
+
+            // Outside the lock, waiters claim again right away
+            for (auto &waiter: waiters)
+                waiter();
+        }
+
+    private:
+        std::mutex mutex;
+        std::unordered_map<std::string, std::vector<std::function<void()> > > claims;
+    };
+
+    size_t frames_bytes(const vector<Magick::Image> &frames) {
+        size_t bytes = 0;
+        for (const auto &frame: frames)
+            bytes += frame.columns() * frame.rows() * sizeof(Magick::PixelPacket);
+        return bytes;
+    }
+
+    std::shared_ptr<const CachedAnimation> store_in_cache(FrameCache &cache, const std::string &id,
+                                                          const vector<Magick::Image> &frames, const int width,
+                                                          const int height) {
+        if (frames.empty())
+            return nullptr;
+
+        const size_t frame_size = static_cast<size_t>(width) * height * 3;
+        std::vector<uint8_t> rgb(frames.size() * frame_size);
+        std::vector<uint32_t> delays_us(frames.size(), 0);
+
+        // Same timing rules as ImageScene::GetFileInfo. Single images get no delay,
+        // how long they are shown is up to the scene.
+        const bool is_multi_frame = frames.size() > 1;
+        for (size_t i = 0; i < frames.size(); ++i) {
+            RenderToRgb(frames[i], true, width, height, rgb.data() + i * frame_size);
+
+            if (is_multi_frame) {
+                const int64_t delay_us = static_cast<int64_t>(frames[i].animationDelay()) * 10000; // unit in 1/100s
+                delays_us[i] = delay_us > 0 ? static_cast<uint32_t>(delay_us) : 100 * 1000; // 1/10sec
+            }
+        }
+
+        return cache.put(id, width, height, rgb, delays_us);
+    }
+}
+
+ImageProviders::PrefetchSettings ImageProviders::PrefetchSettings::from_env() {
+    PrefetchSettings settings;
+    settings.lookahead = env_int("MATRIX_IMAGE_PREFETCH", static_cast<int>(settings.lookahead), 1, 16);
+    settings.threads = env_int("MATRIX_IMAGE_PREFETCH_THREADS", static_cast<int>(settings.threads), 1, 16);
+    settings.memory_budget_bytes = static_cast<size_t>(env_int("MATRIX_IMAGE_PREFETCH_MB", 64, 1, 4096)) * 1024 * 1024;
+    return settings;
+}
+
+// ─── State ───────────────────────────────────────────────────────────────────
+
+struct ImageProviders::Prefetcher::State : std::enable_shared_from_this<State> {
+    using Result = std::expected<PreparedImage, string>;
+
+    State(std::shared_ptr<General> provider, const int width, const int height, const PrefetchSettings &settings,
+          const std::atomic<bool> &cancel)
+        : provider(std::move(provider)), width(width), height(height), settings(settings), cancel(cancel),
+          pool(PrefetchPool::instance(settings.threads)) {
+    }
+
+    std::shared_ptr<General> provider;
+    const int width;
+    const int height;
+    const PrefetchSettings settings;
+    const std::atomic<bool> &cancel;
+    PrefetchPool &pool;
+
+    /// Held while calling into the provider, which is not thread safe.
+    std::mutex provider_mutex;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool started = false;
+    /// Read by stages without holding the mutex
+    std::atomic<bool> stopped{false};
+    bool listing = false;
+    bool exhausted = false;
+    /// Images between the list and the ready stage, every stage that drops its image
+    /// (failed, cancelled or skipped) has to count it down
+    size_t in_flight = 0;
+    /// Stages currently executing on the pool, the destructor waits for them
+    size_t running = 0;
+    size_t decoding = 0;
+    std::deque<PostVariant> waiting_for_decode;
+    std::deque<Result> ready;
+    size_t ready_bytes = 0;
+
+    [[nodiscard]] bool cancelled() const {
+        return stopped || cancel.load();
+    }
+
+    /// Runs 'stage' on the pool. If the prefetcher is cancelled by then, runs 'skipped'
+    /// instead, which releases whatever the stage would have released.
+    void submit_locked(std::function<void(State &)> stage, std::function<void(State &)> skipped) {
+        running++;
+        pool.submit([self = shared_from_this(), stage = std::move(stage), skipped = std::move(skipped)] {
+            if (!self->cancelled())
+                stage(*self);
+            else
+                skipped(*self);
+
+            std::lock_guard lock(self->mutex);
+            self->running--;
+            self->cv.notify_all();
+        });
+    }
+
+    /// Drops an image that will never reach the ready queue.
+    void abandon() {
+        std::lock_guard lock(mutex);
+        in_flight--;
+        cv.notify_all();
+    }
+
+    void submit_download_locked(std::shared_ptr<PostVariant> post) {
+        submit_locked([post](State &s) { s.download(std::move(*post)); }, [](State &s) { s.abandon(); });
+    }
+
+    void pump_locked() {
+        if (!started || cancelled())
+            return;
+
+        while (decoding < settings.decode_threads && !waiting_for_decode.empty() &&
+               (ready_bytes < settings.memory_budget_bytes || ready.empty())) {
+            auto post = std::make_shared<PostVariant>(std::move(waiting_for_decode.front()));
+            waiting_for_decode.pop_front();
+            decoding++;
+            submit_locked([post](State &s) { s.decode(std::move(*post)); },
+                          [post](State &s) {
+                              FileClaims::instance().release(get_post(*post)->get_filename());
+
+                              std::lock_guard lock(s.mutex);
+                              s.decoding--;
+                              s.in_flight--;
+                              s.cv.notify_all();
+                          });
+        }
+
+        if (!listing && !exhausted && ready.size() + in_flight < settings.lookahead) {
+            listing = true;
+            submit_locked([](State &s) { s.list(); }, [](State &s) {
+                std::lock_guard lock(s.mutex);
+                s.listing = false;
+                s.cv.notify_all();
+            });
+        }
+    }
+
+    void deliver(Result result) {
+        std::lock_guard lock(mutex);
+        in_flight--;
+        if (!result.has_value() || !cancelled()) {
+            ready_bytes += result.has_value() ? result->bytes : 0;
+            ready.push_back(std::move(result));
+        }
+        cv.notify_all();
+        pump_locked();
+    }
+
+    // ─── Stages ──────────────────────────────────────────────────────────────
+
+    void list() {
+        std::expected<std::optional<PendingPost>, string> pending;
+        {
+            std::lock_guard provider_lock(provider_mutex);
+            pending = provider->get_next_pending();
+        }
+
+        std::lock_guard lock(mutex);
+        listing = false;
+        if (!pending.has_value()) {
+            ready.emplace_back(std::unexpected(pending.error()));
+        } else if (!pending->has_value()) {
+            exhausted = true;
+        } else {
+            in_flight++;
+            auto job = std::make_shared<PendingPost>(std::move(pending->value()));
+            submit_locked([job](State &s) { s.resolve(*job); }, [](State &s) { s.abandon(); });
+        }
+
+        cv.notify_all();
+        pump_locked();
+    }
+
+    void resolve(const PendingPost &pending) {
+        auto post = pending();
+        if (!post.has_value()) {
+            deliver(std::unexpected(post.error()));
+            return;
+        }
+
+        std::lock_guard lock(mutex);
+        submit_download_locked(std::make_shared<PostVariant>(std::move(post.value())));
+    }
+
+    void download(PostVariant post) {
+        Post *raw_post = get_post(post);
+
+        // Decoded before, nothing to download
+        if (auto *cache = FrameCache::instance()) {
+            if (auto cached = cache->get(cache_id(raw_post), width, height)) {
+                const size_t bytes = cached->size_bytes();
+                deliver(PreparedImage{.post = std::move(post), .frames = {}, .cached = std::move(cached), .bytes = bytes});
+                return;
+            }
+        }
+
+        // Held until the decode is done. A second stage for the same post comes back
+        // afterwards and then usually finds it in the frame cache.
+        const std::string file_name = raw_post->get_filename();
+        auto deferred = std::make_shared<PostVariant>(std::move(post));
+        const bool claimed = FileClaims::instance().claim(file_name, [self = shared_from_this(), deferred] {
+            std::lock_guard lock(self->mutex);
+            self->submit_download_locked(deferred);
+        });
+        if (!claimed)
+            return;
+
+        post = std::move(*deferred);
+        if (const auto fetched = raw_post->fetch(); !fetched.has_value()) {
+            FileClaims::instance().release(file_name);
+            deliver(std::unexpected("Could not download image " + raw_post->get_image_url() + ": " + fetched.error()));
+            return;
+        }
+
+        std::lock_guard lock(mutex);
+        waiting_for_decode.push_back(std::move(post));
+        pump_locked();
+    }
+
+    void decode(PostVariant post) {
+        Post *raw_post = get_post(post);
+        auto frames = raw_post->process_images(width, height);
+
+        {
+            std::lock_guard lock(mutex);
+            decoding--;
+        }
+
+        if (!frames.has_value()) {
+            FileClaims::instance().release(raw_post->get_filename());
+            deliver(std::unexpected("Could not load image " + raw_post->get_image_url()));
+            return;
+        }
+
+        std::shared_ptr<const CachedAnimation> cached;
+        if (auto *cache = FrameCache::instance())
+            cached = store_in_cache(*cache, cache_id(raw_post), frames.value(), width, height);
+
+        // After storing, so stages waiting for this post find it in the frame cache
+        FileClaims::instance().release(raw_post->get_filename());
+
+        if (cached) {
+            const size_t bytes = cached->size_bytes();
+            deliver(PreparedImage{.post = std::move(post), .frames = {}, .cached = std::move(cached), .bytes = bytes});
+            return;
+        }
+
+        const size_t bytes = frames_bytes(frames.value());
+        deliver(PreparedImage{.post = std::move(post), .frames = std::move(frames.value()), .cached = nullptr, .bytes = bytes});
+    }
+
+    /// The post file name is the hash of the image url.
+    static std::string cache_id(Post *post) {
+        return filesystem::path(post->get_filename()).stem().string();
+    }
+};
+
+// ─── Prefetcher ──────────────────────────────────────────────────────────────
+
+ImageProviders::Prefetcher::Prefetcher(std::shared_ptr<General> provider, const int width, const int height,
+                                       const PrefetchSettings &settings, const std::atomic<bool> &cancel)
+    : state(std::make_shared<State>(std::move(provider), width, height, settings, cancel)) {
+}
+
+ImageProviders::Prefetcher::~Prefetcher() {
+    std::deque<PostVariant> downloaded;
+    {
+        std::lock_guard lock(state->mutex);
+        state->stopped = true;
+        downloaded = std::move(state->waiting_for_decode);
+        state->waiting_for_decode.clear();
+        state->in_flight -= downloaded.size();
+        state->ready.clear();
+        state->cv.notify_all();
+    }
+
+    // Not under the mutex, releasing may hand the files to stages of this prefetcher
+    for (auto &post: downloaded)
+        FileClaims::instance().release(get_post(post)->get_filename());
+
+    // Queued stages see 'stopped' and only release what they hold, running ones hold the provider
+    std::unique_lock lock(state->mutex);
+    state->cv.wait(lock, [this] { return state->running == 0; });
+}
+
+std::expected<std::optional<ImageProviders::PreparedImage>, string> ImageProviders::Prefetcher::next() {
+    std::unique_lock lock(state->mutex);
+    state->started = true;
+    state->pump_locked();
+
+    // 'cancel' is set by the scene without notifying, so look at it now and then
+    const auto done = [this] {
+        return state->cancelled() || !state->ready.empty() ||
+               (state->exhausted && !state->listing && state->in_flight == 0);
+    };
+    while (!state->cv.wait_for(lock, std::chrono::milliseconds(50), done)) {
+    }
+
+    if (state->ready.empty())
+        return std::nullopt;
+
+    auto result = std::move(state->ready.front());
+    state->ready.pop_front();
+    if (result.has_value())
+        state->ready_bytes -= result->bytes;
+
+    state->pump_locked();
+
+    if (!result.has_value())
+        return std::unexpected(result.error());
+
+    return std::move(result.value());
+}
+
+void ImageProviders::Prefetcher::flush() {
+    {
+        std::lock_guard provider_lock(state->provider_mutex);
+        state->provider->flush();
+    }
+
+    std::lock_guard lock(state->mutex);
+    state->exhausted = false;
+}
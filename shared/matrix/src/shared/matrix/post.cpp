@@ -1,5 +1,6 @@
 #include "shared/matrix/post.h"
 #include "shared/matrix/utils/image_fetch.h"
+#include <atomic>
 #include <vector>
 #include <optional>
 #include <shared/matrix/server/MimeTypes.h>
@@ -40,8 +41,7 @@ optional<vector<Magick::Image>> Post::process_images(const int width, const int
 
         // Download image if needed
         if (!exists(processed_img)) {
-            try_remove(file_path);
-            const auto res = utils::download_image(get_image_url(), file_path);
+            const auto res = fetch();
             if (!res) {
                 spdlog::error("Could not download image: {}", res.error());
                 return nullopt;
@@ -73,6 +73,44 @@ optional<vector<Magick::Image>> Post::process_images(const int width, const int
     }
 }
 
+std::expected<filesystem::path, string> Post::fetch() {
+    try {
+        if (!filesystem::exists(Constants::post_dir)) {
+            filesystem::create_directories(Constants::post_dir);
+        }
+
+        const filesystem::path file_path = Constants::post_dir / get_filename();
+        const filesystem::path processed_img = to_processed_path(file_path);
+        if (exists(processed_img))
+            return processed_img;
+
+        // Downloaded ahead by the prefetcher. Downloads only get this name once they are
+        // complete, so an existing file is never one that was cut off by a crash or cancel.
+        if (exists(file_path))
+            return file_path;
+
+        static std::atomic<uint64_t> temp_counter{0};
+        const filesystem::path temp_path = file_path.string() + ".part" + to_string(temp_counter++);
+
+        const auto res = utils::download_image(get_image_url(), temp_path);
+        if (!res) {
+            try_remove(temp_path);
+            return std::unexpected(res.error());
+        }
+
+        error_code ec;
+        filesystem::rename(temp_path, file_path, ec);
+        if (ec) {
+            try_remove(temp_path);
+            return std::unexpected("Could not move download into place: " + ec.message());
+        }
+
+        return file_path;
+    } catch (std::exception &e) {
+        return std::unexpected(string("Exception in fetch: ") + e.what());
+    }
+}
+
 Post::Post(const string &img_url, const bool maybe_fetch_type) {
     this->img_url = img_url;
 
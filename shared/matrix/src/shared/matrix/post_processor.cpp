@@ -29,7 +29,22 @@ void PostProcessor::apply_effects(FrameCanvas* canvas) {
     if (active_effects.empty() || !canvas) {
         return;
     }
-    
+
+    scratch_frame.read_from(canvas);
+    apply_active_effects(scratch_frame);
+    scratch_frame.write_to(canvas);
+}
+
+void PostProcessor::apply_effects(CanvasBuffer& frame) {
+    std::lock_guard<std::mutex> lock(effectsMutex);
+    if (active_effects.empty() || frame.empty()) {
+        return;
+    }
+
+    apply_active_effects(frame);
+}
+
+void PostProcessor::apply_active_effects(CanvasBuffer& frame) {
     // Remove expired effects
     active_effects.erase(
         std::remove_if(active_effects.begin(), active_effects.end(),
@@ -43,7 +58,7 @@ void PostProcessor::apply_effects(FrameCanvas* canvas) {
     for (const auto& effect : active_effects) {
         auto it = registered_effects.find(effect.effect_name);
         if (it != registered_effects.end()) {
-            it->second->apply(canvas, effect);
+            it->second->apply(frame, effect);
         }
     }
 }
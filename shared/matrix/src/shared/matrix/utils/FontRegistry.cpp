@@ -0,0 +1,24 @@
+#include "shared/matrix/utils/FontRegistry.h"
+#include <spdlog/spdlog.h>
+
+FontRegistry &FontRegistry::instance()
+{
+    static FontRegistry registry;
+    return registry;
+}
+
+const rgb_matrix::Font *FontRegistry::load(const std::filesystem::path &path)
+{
+    const std::string file_name = path.filename().string();
+
+    std::lock_guard lock(mutex);
+    if (const auto it = fonts.find(file_name); it != fonts.end())
+        return it->second.get();
+
+    auto font = std::make_unique<rgb_matrix::Font>();
+    if (!font->LoadFont(path.c_str()))
+        return nullptr;
+
+    spdlog::debug("Loaded font {}", path.string());
+    return fonts.emplace(file_name, std::move(font)).first->second.get();
+}
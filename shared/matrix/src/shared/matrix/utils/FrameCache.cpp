@@ -0,0 +1,366 @@
+#include "shared/matrix/utils/FrameCache.h"
+#include "shared/matrix/utils/consts.h"
+#include "shared/common/utils/env.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <spdlog/spdlog.h>
+
+namespace
+{
+    constexpr char file_magic[4] = {'L', 'M', 'F', 'C'};
+    constexpr uint32_t file_version = 1;
+    constexpr const char *file_extension = ".lmfc";
+
+    /// File layout: this header, one u32 delay per frame, then the frames starting
+    /// at pixels_offset (64 byte aligned), each width * height * 3 bytes.
+    struct FileHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint16_t width;
+        uint16_t height;
+        uint32_t frame_count;
+        uint64_t pixels_offset;
+        uint8_t reserved[40];
+    };
+
+    static_assert(sizeof(FileHeader) == 64);
+    static_assert(sizeof(rgb_matrix::Color) == 3, "frames are handed to SetPixels as they are");
+
+    uint64_t pixels_offset_for(size_t frame_count)
+    {
+        return (sizeof(FileHeader) + frame_count * sizeof(uint32_t) + 63) & ~uint64_t{63};
+    }
+
+    size_t frame_bytes(int width, int height)
+    {
+        return static_cast<size_t>(width) * height * 3;
+    }
+
+    std::string entry_name(const std::string &id, int width, int height)
+    {
+        std::string name;
+        name.reserve(id.size() + 16);
+        for (const char c : id)
+        {
+            const bool safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                              c == '-' || c == '_';
+            name += safe ? c : '_';
+        }
+        return name + "_" + std::to_string(width) + "x" + std::to_string(height) + file_extension;
+    }
+}
+
+// ─── CachedAnimation ─────────────────────────────────────────────────────────
+
+std::shared_ptr<const CachedAnimation> CachedAnimation::open(const std::filesystem::path &path, int width,
+                                                             int height)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return nullptr;
+
+    struct stat st{};
+    if (fstat(fd, &st) < 0 || static_cast<size_t>(st.st_size) < sizeof(FileHeader))
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    const auto size = static_cast<size_t>(st.st_size);
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+        return nullptr;
+
+    FileHeader header{};
+    std::memcpy(&header, mapping, sizeof(header));
+
+    const bool valid = std::memcmp(header.magic, file_magic, sizeof(file_magic)) == 0 &&
+                       header.version == file_version && header.width == width && header.height == height &&
+                       header.frame_count > 0 && header.pixels_offset == pixels_offset_for(header.frame_count) &&
+                       size == header.pixels_offset + uint64_t{header.frame_count} * frame_bytes(width, height);
+    if (!valid)
+    {
+        munmap(mapping, size);
+        return nullptr;
+    }
+
+    return std::shared_ptr<const CachedAnimation>(
+        new CachedAnimation(mapping, size, width, height, header.frame_count));
+}
+
+CachedAnimation::CachedAnimation(void *mapping, size_t mapping_size, int width, int height, size_t frames)
+    : mapping(mapping), mapping_size(mapping_size), frame_width(width), frame_height(height), frames(frames),
+      delays(reinterpret_cast<const uint32_t *>(static_cast<const uint8_t *>(mapping) + sizeof(FileHeader))),
+      pixels(static_cast<const uint8_t *>(mapping) + pixels_offset_for(frames))
+{
+}
+
+CachedAnimation::~CachedAnimation()
+{
+    munmap(mapping, mapping_size);
+}
+
+const uint8_t *CachedAnimation::frame(size_t index) const
+{
+    return pixels + (index % frames) * frame_bytes(frame_width, frame_height);
+}
+
+uint32_t CachedAnimation::delay_us(size_t index) const
+{
+    return delays[index % frames];
+}
+
+void CachedAnimation::write_to(rgb_matrix::FrameCanvas *canvas, size_t index) const
+{
+    if (canvas == nullptr)
+        return;
+
+    // SetPixels() takes a non-const pointer but never writes through it.
+    auto *colors = reinterpret_cast<rgb_matrix::Color *>(const_cast<uint8_t *>(frame(index)));
+    const int w = std::min(frame_width, canvas->width());
+    const int h = std::min(frame_height, canvas->height());
+    if (w == frame_width)
+    {
+        canvas->SetPixels(0, 0, w, h, colors);
+        return;
+    }
+
+    for (int y = 0; y < h; ++y)
+    {
+        canvas->SetPixels(0, y, w, 1, colors + static_cast<size_t>(y) * frame_width);
+    }
+}
+
+// ─── FrameCache ──────────────────────────────────────────────────────────────
+
+std::optional<FrameCacheSettings> FrameCacheSettings::from_env()
+{
+    FrameCacheSettings settings;
+    settings.directory = Constants::root_dir / "frame_cache";
+
+    const int megabytes = env_int("MATRIX_FRAME_CACHE_MB", 256, 0, 65536);
+    if (megabytes == 0)
+        return std::nullopt;
+
+    settings.budget_bytes = static_cast<uint64_t>(megabytes) * 1024 * 1024;
+    return settings;
+}
+
+FrameCache *FrameCache::instance()
+{
+    static const std::unique_ptr<FrameCache> cache = []() -> std::unique_ptr<FrameCache>
+    {
+        auto settings = FrameCacheSettings::from_env();
+        if (!settings.has_value())
+        {
+            spdlog::info("Frame cache disabled");
+            return nullptr;
+        }
+
+        return std::make_unique<FrameCache>(std::move(settings.value()));
+    }();
+
+    return cache.get();
+}
+
+FrameCache::FrameCache(FrameCacheSettings settings)
+    : directory(std::move(settings.directory)), budget_bytes(settings.budget_bytes)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec)
+    {
+        spdlog::error("Could not create frame cache directory {}: {}", directory.string(), ec.message());
+        return;
+    }
+
+    struct Found
+    {
+        std::filesystem::file_time_type last_used;
+        Entry entry;
+    };
+    std::vector<Found> found;
+
+    for (const auto &file : std::filesystem::directory_iterator(directory, ec))
+    {
+        const auto &path = file.path();
+        if (!file.is_regular_file(ec))
+            continue;
+
+        // Left behind by a write that never finished
+        if (path.filename().string().find(".tmp") != std::string::npos)
+        {
+            std::filesystem::remove(path, ec);
+            continue;
+        }
+
+        if (path.extension() != file_extension)
+            continue;
+
+        found.push_back({file.last_write_time(ec), {path.filename().string(), file.file_size(ec)}});
+    }
+
+    std::ranges::sort(found, [](const Found &a, const Found &b) { return a.last_used > b.last_used; });
+
+    std::lock_guard lock(mutex);
+    for (auto &[_, entry] : found)
+    {
+        used_bytes += entry.size;
+        lru.push_back(std::move(entry));
+        entries.emplace(lru.back().name, std::prev(lru.end()));
+    }
+    evict_locked();
+
+    spdlog::info("Frame cache at {}: {} entries, {:.1f} of {} MB", directory.string(), lru.size(),
+                 used_bytes / (1024.0 * 1024.0), budget_bytes / (1024 * 1024));
+}
+
+std::filesystem::path FrameCache::path_for(const std::string &name) const
+{
+    return directory / name;
+}
+
+std::shared_ptr<const CachedAnimation> FrameCache::get(const std::string &id, int width, int height)
+{
+    const std::string name = entry_name(id, width, height);
+
+    std::lock_guard lock(mutex);
+    const auto it = entries.find(name);
+    if (it == entries.end())
+        return nullptr;
+
+    auto animation = CachedAnimation::open(path_for(name), width, height);
+    if (animation == nullptr)
+    {
+        spdlog::warn("Dropping unreadable frame cache entry {}", name);
+        remove_locked(name);
+        return nullptr;
+    }
+
+    touch_locked(it);
+    return animation;
+}
+
+std::shared_ptr<const CachedAnimation> FrameCache::put(const std::string &id, int width, int height,
+                                                       std::span<const uint8_t> rgb,
+                                                       std::span<const uint32_t> delays_us)
+{
+    const size_t frame_count = delays_us.size();
+    if (width <= 0 || height <= 0 || width > UINT16_MAX || height > UINT16_MAX || frame_count == 0 ||
+        rgb.size() != frame_count * frame_bytes(width, height))
+        return nullptr;
+
+    FileHeader header{};
+    std::memcpy(header.magic, file_magic, sizeof(file_magic));
+    header.version = file_version;
+    header.width = static_cast<uint16_t>(width);
+    header.height = static_cast<uint16_t>(height);
+    header.frame_count = static_cast<uint32_t>(frame_count);
+    header.pixels_offset = pixels_offset_for(frame_count);
+
+    const uint64_t size = header.pixels_offset + rgb.size();
+    if (size > budget_bytes)
+        return nullptr;
+
+    const std::string name = entry_name(id, width, height);
+    std::filesystem::path temp_path;
+    {
+        std::lock_guard lock(mutex);
+        temp_path = path_for(name + ".tmp" + std::to_string(temp_counter++));
+    }
+
+    // Written next to the entry and renamed, so readers never see half a file
+    {
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        const std::vector<char> padding(header.pixels_offset - sizeof(header) - frame_count * sizeof(uint32_t), 0);
+
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(delays_us.data()),
+                  static_cast<std::streamsize>(frame_count * sizeof(uint32_t)));
+        out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+        out.write(reinterpret_cast<const char *>(rgb.data()), static_cast<std::streamsize>(rgb.size()));
+        out.close();
+
+        if (!out)
+        {
+            spdlog::warn("Could not write frame cache entry {}", name);
+            std::error_code ec;
+            std::filesystem::remove(temp_path, ec);
+            return nullptr;
+        }
+    }
+
+    std::lock_guard lock(mutex);
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path_for(name), ec);
+    if (ec)
+    {
+        spdlog::warn("Could not store frame cache entry {}: {}", name, ec.message());
+        std::filesystem::remove(temp_path, ec);
+        return nullptr;
+    }
+
+    if (const auto it = entries.find(name); it != entries.end())
+    {
+        used_bytes -= it->second->size;
+        lru.erase(it->second);
+        entries.erase(it);
+    }
+
+    lru.push_front({name, size});
+    entries.emplace(name, lru.begin());
+    used_bytes += size;
+    evict_locked();
+
+    return CachedAnimation::open(path_for(name), width, height);
+}
+
+uint64_t FrameCache::total_bytes() const
+{
+    std::lock_guard lock(mutex);
+    return used_bytes;
+}
+
+void FrameCache::touch_locked(std::unordered_map<std::string, std::list<Entry>::iterator>::iterator it)
+{
+    lru.splice(lru.begin(), lru, it->second);
+
+    // The mtime keeps the access order across restarts
+    std::error_code ec;
+    std::filesystem::last_write_time(path_for(it->first), std::filesystem::file_time_type::clock::now(), ec);
+}
+
+void FrameCache::remove_locked(const std::string &name)
+{
+    const auto it = entries.find(name);
+    if (it == entries.end())
+        return;
+
+    used_bytes -= it->second->size;
+    lru.erase(it->second);
+    entries.erase(it);
+
+    // Animations that are still playing keep their mapping
+    std::error_code ec;
+    std::filesystem::remove(path_for(name), ec);
+}
+
+void FrameCache::evict_locked()
+{
+    // Never evict the most recent entry, it was just stored or played
+    while (used_bytes > budget_bytes && lru.size() > 1)
+    {
+        const std::string name = lru.back().name;
+        spdlog::debug("Evicting frame cache entry {}", name);
+        remove_locked(name);
+    }
+}
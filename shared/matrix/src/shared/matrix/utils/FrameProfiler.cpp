@@ -0,0 +1,241 @@
+#include "shared/matrix/utils/FrameProfiler.h"
+#include <algorithm>
+#include <bit>
+#include <mutex>
+#include <ranges>
+#include <sstream>
+
+size_t LatencyHistogram::bucket_index(uint64_t micros)
+{
+    if (micros < sub_bucket_count)
+        return micros;
+
+    // Top sub_bucket_bits bits below the most significant one select the sub bucket
+    const int shift = std::bit_width(micros) - 1 - sub_bucket_bits;
+    const auto index = static_cast<size_t>(shift + 1) * sub_bucket_count + ((micros >> shift) & (sub_bucket_count - 1));
+    return std::min<size_t>(index, bucket_count - 1);
+}
+
+uint64_t LatencyHistogram::bucket_upper_bound(size_t index)
+{
+    if (index < sub_bucket_count)
+        return index + 1;
+
+    const auto shift = index / sub_bucket_count - 1;
+    const auto sub_bucket = index % sub_bucket_count;
+    return (static_cast<uint64_t>(sub_bucket_count + sub_bucket + 1)) << shift;
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration)
+{
+    const auto ns = static_cast<uint64_t>(std::max<int64_t>(0, duration.count()));
+
+    buckets[bucket_index(ns / 1000)].fetch_add(1, std::memory_order_relaxed);
+    sum_ns.fetch_add(ns, std::memory_order_relaxed);
+
+    uint64_t current_max = max_ns.load(std::memory_order_relaxed);
+    while (ns > current_max && !max_ns.compare_exchange_weak(current_max, ns, std::memory_order_relaxed))
+    {
+    }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const
+{
+    std::array<uint64_t, bucket_count> counts{};
+    uint64_t total = 0;
+    for (size_t i = 0; i < bucket_count; ++i)
+    {
+        counts[i] = buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+
+    Snapshot snapshot;
+    snapshot.count = total;
+    snapshot.sum_seconds = static_cast<double>(sum_ns.load(std::memory_order_relaxed)) / 1e9;
+    snapshot.max_seconds = static_cast<double>(max_ns.load(std::memory_order_relaxed)) / 1e9;
+    if (total == 0)
+        return snapshot;
+
+    // Reports the upper bound of the bucket containing the percentile, capped at the real maximum.
+    const auto percentile = [&](double fraction)
+    {
+        const auto target = std::max<uint64_t>(1, static_cast<uint64_t>(fraction * static_cast<double>(total) + 0.5));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < bucket_count; ++i)
+        {
+            seen += counts[i];
+            if (seen >= target)
+                return std::min(static_cast<double>(bucket_upper_bound(i)) / 1e6, snapshot.max_seconds);
+        }
+        return snapshot.max_seconds;
+    };
+
+    snapshot.p50_seconds = percentile(0.50);
+    snapshot.p95_seconds = percentile(0.95);
+    snapshot.p99_seconds = percentile(0.99);
+    return snapshot;
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto &bucket : buckets)
+        bucket.store(0, std::memory_order_relaxed);
+    sum_ns.store(0, std::memory_order_relaxed);
+    max_ns.store(0, std::memory_order_relaxed);
+}
+
+FrameProfiler &FrameProfiler::instance()
+{
+    static FrameProfiler profiler;
+    return profiler;
+}
+
+SceneProfile &FrameProfiler::get(const std::string &scene_name)
+{
+    {
+        std::shared_lock lock(profiles_mutex);
+        if (const auto it = scene_profiles.find(scene_name); it != scene_profiles.end())
+            return *it->second;
+    }
+
+    std::unique_lock lock(profiles_mutex);
+    auto &profile = scene_profiles[scene_name];
+    if (!profile)
+        profile = std::make_unique<SceneProfile>();
+    return *profile;
+}
+
+std::vector<std::pair<std::string, const SceneProfile *>> FrameProfiler::profiles() const
+{
+    std::vector<std::pair<std::string, const SceneProfile *>> result;
+    {
+        std::shared_lock lock(profiles_mutex);
+        result.reserve(scene_profiles.size());
+        for (const auto &[name, profile] : scene_profiles)
+            result.emplace_back(name, profile.get());
+    }
+
+    std::ranges::sort(result, {}, &std::pair<std::string, const SceneProfile *>::first);
+    return result;
+}
+
+LatencyHistogram &FrameProfiler::histogram(const std::string &metric_name, const std::string &help)
+{
+    std::unique_lock lock(profiles_mutex);
+    auto &[metric_help, histogram] = named_histograms[metric_name];
+    if (!histogram)
+    {
+        metric_help = help;
+        histogram = std::make_unique<LatencyHistogram>();
+    }
+    return *histogram;
+}
+
+std::vector<FrameProfiler::NamedHistogram> FrameProfiler::histograms() const
+{
+    std::vector<NamedHistogram> result;
+    std::shared_lock lock(profiles_mutex);
+    result.reserve(named_histograms.size());
+    for (const auto &[name, entry] : named_histograms)
+        result.push_back({name, entry.first, entry.second.get()});
+    return result;
+}
+
+void FrameProfiler::reset()
+{
+    std::shared_lock lock(profiles_mutex);
+    for (const auto &profile : scene_profiles | std::views::values)
+    {
+        profile->render.reset();
+        profile->post_processing.reset();
+        profile->transition.reset();
+        profile->swap_wait.reset();
+    }
+
+    for (const auto &entry : named_histograms | std::views::values)
+        entry.second->reset();
+}
+
+namespace
+{
+    std::string escape_label(const std::string &value)
+    {
+        std::string escaped;
+        escaped.reserve(value.size());
+        for (const char c : value)
+        {
+            if (c == '\\' || c == '"')
+                escaped += '\\';
+            if (c == '\n')
+            {
+                escaped += "\\n";
+                continue;
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+}
+
+std::string FrameProfiler::to_prometheus() const
+{
+    struct Metric
+    {
+        const char *name;
+        const char *help;
+        const LatencyHistogram SceneProfile::*histogram;
+    };
+
+    static constexpr Metric metrics[] = {
+        {"led_matrix_scene_render_seconds", "Time spent rendering a scene frame", &SceneProfile::render},
+        {"led_matrix_scene_post_processing_seconds", "Time spent applying post-processing effects", &SceneProfile::post_processing},
+        {"led_matrix_scene_transition_seconds", "Time spent blending a transition frame", &SceneProfile::transition},
+        {"led_matrix_scene_swap_wait_seconds", "Time blocked waiting for the vsync swap", &SceneProfile::swap_wait},
+    };
+
+    const auto all_profiles = profiles();
+
+    std::ostringstream out;
+    for (const auto &metric : metrics)
+    {
+        out << "# HELP " << metric.name << ' ' << metric.help << '\n';
+        out << "# TYPE " << metric.name << " summary\n";
+        for (const auto &[name, profile] : all_profiles)
+        {
+            const auto snapshot = (profile->*metric.histogram).snapshot();
+            const auto label = escape_label(name);
+
+            out << metric.name << "{scene=\"" << label << "\",quantile=\"0.5\"} " << snapshot.p50_seconds << '\n';
+            out << metric.name << "{scene=\"" << label << "\",quantile=\"0.95\"} " << snapshot.p95_seconds << '\n';
+            out << metric.name << "{scene=\"" << label << "\",quantile=\"0.99\"} " << snapshot.p99_seconds << '\n';
+            out << metric.name << "_sum{scene=\"" << label << "\"} " << snapshot.sum_seconds << '\n';
+            out << metric.name << "_count{scene=\"" << label << "\"} " << snapshot.count << '\n';
+        }
+
+        out << "# HELP " << metric.name << "_max Slowest recorded sample\n";
+        out << "# TYPE " << metric.name << "_max gauge\n";
+        for (const auto &[name, profile] : all_profiles)
+        {
+            const auto snapshot = (profile->*metric.histogram).snapshot();
+            out << metric.name << "_max{scene=\"" << escape_label(name) << "\"} " << snapshot.max_seconds << '\n';
+        }
+    }
+
+    for (const auto &[name, help, histogram] : histograms())
+    {
+        const auto snapshot = histogram->snapshot();
+
+        out << "# HELP " << name << ' ' << help << '\n';
+        out << "# TYPE " << name << " summary\n";
+        out << name << "{quantile=\"0.5\"} " << snapshot.p50_seconds << '\n';
+        out << name << "{quantile=\"0.95\"} " << snapshot.p95_seconds << '\n';
+        out << name << "{quantile=\"0.99\"} " << snapshot.p99_seconds << '\n';
+        out << name << "_sum " << snapshot.sum_seconds << '\n';
+        out << name << "_count " << snapshot.count << '\n';
+        out << "# HELP " << name << "_max Slowest recorded sample\n";
+        out << "# TYPE " << name << "_max gauge\n";
+        out << name << "_max " << snapshot.max_seconds << '\n';
+    }
+
+    return out.str();
+}
@@ -0,0 +1,33 @@
+#include "shared/matrix/utils/FrameStreamReceiver.h"
+
+void FrameStreamReceiver::receive(const uint8_t *payload, size_t size)
+{
+    switch (decoder.apply(payload, size))
+    {
+    case FrameStream::Decoder::Result::Invalid:
+        frames.write(payload, size);
+        break;
+    case FrameStream::Decoder::Result::FrameComplete:
+        frames.write(decoder.frame().data(), decoder.frame().size());
+        break;
+    case FrameStream::Decoder::Result::Partial:
+        break;
+    }
+}
+
+bool FrameStreamReceiver::take_keyframe_request()
+{
+    if (!decoder.needs_keyframe() || decoder.get_stats().fragments == 0)
+    {
+        keyframe_requested = false;
+        return false;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (keyframe_requested && now - last_keyframe_request < keyframe_request_interval)
+        return false;
+
+    keyframe_requested = true;
+    last_keyframe_request = now;
+    return true;
+}
@@ -4,15 +4,16 @@
 
 #include "shared/matrix/utils/FrameTimer.h"
 #include <chrono>
+#include "shared/common/utils/clock.h"
 
 
 FrameTimer::FrameTimer() {
-    startTick = std::chrono::high_resolution_clock::now();
+    startTick = Clock::now();
     lastTick = startTick;
 }
 
 const FrameTime FrameTimer::tick() {
-    auto now = std::chrono::high_resolution_clock::now();
+    auto now = Clock::now();
 
     struct FrameTime frameTime;
     frameTime.now = now;
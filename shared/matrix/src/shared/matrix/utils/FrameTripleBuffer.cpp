@@ -0,0 +1,34 @@
+#include "shared/matrix/utils/FrameTripleBuffer.h"
+#include <cstring>
+
+void FrameTripleBuffer::write(const uint8_t *payload, size_t size)
+{
+    auto &buffer = buffers[back];
+    if (buffer.bytes.size() < size)
+        buffer.bytes.resize(size);
+
+    if (size > 0)
+        std::memcpy(buffer.bytes.data(), payload, size);
+    const auto now = std::chrono::steady_clock::now();
+    buffer.size = size;
+    buffer.received = now;
+
+    // Publish: the filled back buffer becomes the middle one, the old middle becomes the back buffer.
+    const auto previous = middle.exchange(static_cast<uint8_t>(back | fresh_bit), std::memory_order_acq_rel);
+    back = previous & index_mask;
+
+    written.fetch_add(1, std::memory_order_relaxed);
+    last_write_ticks.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+FrameTripleBuffer::FrameView FrameTripleBuffer::read()
+{
+    std::unique_lock lock(reader_mutex);
+    if (middle.load(std::memory_order_acquire) & fresh_bit)
+    {
+        const auto previous = middle.exchange(front, std::memory_order_acq_rel);
+        front = previous & index_mask;
+    }
+
+    return {std::move(lock), &buffers[front]};
+}
@@ -0,0 +1,255 @@
+#include "shared/matrix/utils/RenderPool.h"
+#include "shared/common/utils/env.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace
+{
+    constexpr int max_default_workers = 8;
+
+    /// Cores this process may run on, without the refresh thread's core (-1: none reserved).
+    std::vector<int> render_cores(int refresh_core)
+    {
+        const int cpus = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+        std::vector<int> cores;
+#ifdef __linux__
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        const bool have_mask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+        for (int cpu = 0; cpu < std::min(cpus, CPU_SETSIZE); ++cpu)
+        {
+            if (have_mask && !CPU_ISSET(cpu, &allowed))
+                continue;
+            if (cpu == refresh_core && cpus > refresh_core)
+                continue;
+            cores.push_back(cpu);
+        }
+#else
+        for (int cpu = 0; cpu < cpus; ++cpu)
+        {
+            if (cpu != refresh_core || cpus <= refresh_core)
+                cores.push_back(cpu);
+        }
+#endif
+
+        if (cores.empty())
+            cores.push_back(0);
+        return cores;
+    }
+
+    void pin_to_core([[maybe_unused]] std::thread &thread, [[maybe_unused]] int cpu)
+    {
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        if (const int error = pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set); error != 0)
+            spdlog::warn("Could not pin render worker to core {}: error {}", cpu, error);
+#endif
+    }
+
+    // Tiles of a share are packed as begin << 32 | end, so taking one from the front
+    // (owner) and stealing one from the back (others) is a single compare-exchange.
+    constexpr uint64_t pack(uint32_t begin, uint32_t end)
+    {
+        return static_cast<uint64_t>(begin) << 32 | end;
+    }
+
+    bool take_tile(std::atomic<uint64_t> &share, bool from_front, uint32_t &tile)
+    {
+        uint64_t current = share.load(std::memory_order_relaxed);
+        while (true)
+        {
+            const auto begin = static_cast<uint32_t>(current >> 32);
+            const auto end = static_cast<uint32_t>(current);
+            if (begin >= end)
+                return false;
+
+            const uint64_t next = from_front ? pack(begin + 1, end) : pack(begin, end - 1);
+            if (share.compare_exchange_weak(current, next, std::memory_order_acq_rel, std::memory_order_relaxed))
+            {
+                tile = from_front ? begin : end - 1;
+                return true;
+            }
+        }
+    }
+}
+
+struct RenderPool::Job
+{
+    const RowJob *fn = nullptr;
+    int rows = 0;
+    int tile_rows = 1;
+
+    int share_count = 0;
+    std::unique_ptr<std::atomic<uint64_t>[]> shares;
+    /// Next share handed to a joining worker, share 0 belongs to the caller
+    std::atomic<int> next_share{1};
+
+    /// False once a thread found no tile left to take
+    std::atomic<bool> open{true};
+    /// Workers inside run_tiles(), guarded by the pool mutex
+    int participants = 0;
+};
+
+RenderPoolSettings RenderPoolSettings::from_env()
+{
+    RenderPoolSettings settings;
+    settings.refresh_core = env_int("MATRIX_REFRESH_CORE", settings.refresh_core, -1);
+
+    const int available = static_cast<int>(render_cores(settings.refresh_core).size()) - 1;
+    settings.workers = env_int("MATRIX_RENDER_THREADS", std::min(available, max_default_workers), 0, available);
+    settings.pin = env_int("MATRIX_RENDER_PIN", 1) != 0;
+    return settings;
+}
+
+RenderPool &RenderPool::instance()
+{
+    static RenderPool pool(RenderPoolSettings::from_env());
+    return pool;
+}
+
+RenderPool::RenderPool(const RenderPoolSettings &settings)
+{
+    // Core 0 (the first one left) stays with the render thread and the rest of the system
+    const std::vector<int> cores = render_cores(settings.refresh_core);
+    for (int i = 0; i < settings.workers; ++i)
+    {
+        const int cpu = cores[(i + 1) % cores.size()];
+        workers.emplace_back([this] { worker_loop(); });
+        if (settings.pin)
+            pin_to_core(workers.back(), cpu);
+    }
+
+    spdlog::debug("Render pool started with {} worker(s){}", workers.size(), settings.pin ? ", pinned" : "");
+}
+
+RenderPool::~RenderPool()
+{
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    work_ready.notify_all();
+
+    for (auto &worker : workers)
+        worker.join();
+}
+
+void RenderPool::parallel_rows(int rows, const RowJob &job, int tile_rows)
+{
+    if (rows <= 0)
+        return;
+
+    const int threads = static_cast<int>(workers.size()) + 1;
+    if (tile_rows <= 0)
+        tile_rows = std::max(1, rows / (threads * 4));
+
+    const int tiles = (rows + tile_rows - 1) / tile_rows;
+    if (threads == 1 || tiles == 1)
+    {
+        job(0, rows);
+        return;
+    }
+
+    Job state;
+    state.fn = &job;
+    state.rows = rows;
+    state.tile_rows = tile_rows;
+    state.share_count = threads;
+    state.shares = std::make_unique<std::atomic<uint64_t>[]>(threads);
+    for (int share = 0; share < threads; ++share)
+    {
+        const auto begin = static_cast<uint32_t>(static_cast<int64_t>(tiles) * share / threads);
+        const auto end = static_cast<uint32_t>(static_cast<int64_t>(tiles) * (share + 1) / threads);
+        state.shares[share].store(pack(begin, end), std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard lock(mutex);
+        jobs.push_back(&state);
+    }
+    work_ready.notify_all();
+
+    run_tiles(state, 0);
+
+    // Every tile is taken now, wait for the workers still busy with one
+    std::unique_lock lock(mutex);
+    std::erase(jobs, &state);
+    work_done.wait(lock, [&state] { return state.participants == 0; });
+}
+
+void RenderPool::run_tiles(Job &job, int home)
+{
+    const auto run = [&job](uint32_t tile)
+    {
+        const int y_begin = static_cast<int>(tile) * job.tile_rows;
+        (*job.fn)(y_begin, std::min(job.rows, y_begin + job.tile_rows));
+    };
+
+    uint32_t tile;
+    while (true)
+    {
+        if (home >= 0 && take_tile(job.shares[home], true, tile))
+        {
+            run(tile);
+            continue;
+        }
+
+        // Own share is done, steal from the back of the others
+        bool stolen = false;
+        for (int offset = 1; offset <= job.share_count && !stolen; ++offset)
+        {
+            const int victim = ((home < 0 ? 0 : home) + offset) % job.share_count;
+            stolen = take_tile(job.shares[victim], false, tile);
+        }
+
+        if (!stolen)
+            break;
+        run(tile);
+    }
+
+    job.open.store(false, std::memory_order_relaxed);
+}
+
+void RenderPool::worker_loop()
+{
+    while (true)
+    {
+        Job *job = nullptr;
+        {
+            std::unique_lock lock(mutex);
+            work_ready.wait(lock, [this, &job]
+            {
+                if (stopping)
+                    return true;
+
+                const auto open = std::ranges::find_if(jobs, [](const Job *j) { return j->open.load(std::memory_order_relaxed); });
+                job = open != jobs.end() ? *open : nullptr;
+                return job != nullptr;
+            });
+
+            if (stopping)
+                return;
+            job->participants++;
+        }
+
+        const int share = job->next_share.fetch_add(1, std::memory_order_relaxed);
+        run_tiles(*job, share < job->share_count ? share : -1);
+
+        {
+            std::lock_guard lock(mutex);
+            job->participants--;
+        }
+        work_done.notify_all();
+    }
+}
@@ -0,0 +1,131 @@
+#include "shared/matrix/utils/TextCache.h"
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <utility>
+
+namespace
+{
+    /// Canvas without bounds that only notes down where DrawText() puts pixels.
+    class RecordingCanvas final : public rgb_matrix::Canvas
+    {
+    public:
+        std::vector<std::pair<int, int>> pixels;
+
+        int width() const override { return INT_MAX; }
+        int height() const override { return INT_MAX; }
+
+        void SetPixel(int x, int y, uint8_t, uint8_t, uint8_t) override { pixels.emplace_back(y, x); }
+
+        void Clear() override {}
+        void Fill(uint8_t, uint8_t, uint8_t) override {}
+    };
+
+    uint32_t pack(const rgb_matrix::Color &color)
+    {
+        return static_cast<uint32_t>(color.r) << 16 | static_cast<uint32_t>(color.g) << 8 | color.b;
+    }
+}
+
+size_t TextCache::KeyHash::operator()(const KeyView &key) const
+{
+    size_t hash = std::hash<std::string_view>{}(key.text);
+    hash ^= std::hash<const void *>{}(key.font) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<uint32_t>{}(key.color) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+TextCache::TextCache(size_t capacity) : capacity(std::max<size_t>(1, capacity))
+{
+}
+
+int TextCache::draw(rgb_matrix::Canvas *canvas, const rgb_matrix::Font &font, int x, int y,
+                    const rgb_matrix::Color &color, std::string_view text)
+{
+    const Entry &entry = lookup(font, color, text);
+    if (canvas == nullptr)
+        return entry.advance;
+
+    const int canvas_width = canvas->width();
+    const int canvas_height = canvas->height();
+    // SetPixels() takes a non-const pointer but never writes through it.
+    auto *colors = const_cast<rgb_matrix::Color *>(entry.colors.data());
+
+    for (const Run &run : entry.runs)
+    {
+        const int row = y + run.y;
+        if (row < 0 || row >= canvas_height)
+            continue;
+
+        const int begin = std::max(0, x + run.x);
+        const int end = std::min(canvas_width, x + run.x + run.length);
+        // Most runs of small fonts are a single pixel, those are not worth a bulk write
+        if (end - begin == 1)
+            canvas->SetPixel(begin, row, color.r, color.g, color.b);
+        else if (begin < end)
+            canvas->SetPixels(begin, row, end - begin, 1, colors);
+    }
+
+    return entry.advance;
+}
+
+void TextCache::clear()
+{
+    entries.clear();
+}
+
+const TextCache::Entry &TextCache::lookup(const rgb_matrix::Font &font, const rgb_matrix::Color &color,
+                                          std::string_view text)
+{
+    const KeyView key{&font, pack(color), text};
+    auto it = entries.find(key);
+    if (it == entries.end())
+    {
+        if (entries.size() >= capacity)
+        {
+            const auto oldest = std::min_element(entries.begin(), entries.end(), [](const auto &a, const auto &b)
+            {
+                return a.second.last_used < b.second.last_used;
+            });
+            entries.erase(oldest);
+        }
+
+        it = entries.emplace(Key{&font, key.color, std::string(text)}, rasterize(font, color, text)).first;
+    }
+
+    it->second.last_used = ++clock;
+    return it->second;
+}
+
+TextCache::Entry TextCache::rasterize(const rgb_matrix::Font &font, const rgb_matrix::Color &color,
+                                      std::string_view text)
+{
+    // DrawText() wants a terminated string
+    const std::string terminated(text);
+
+    RecordingCanvas recorder;
+    Entry entry;
+    entry.advance = rgb_matrix::DrawText(&recorder, font, 0, 0, color, terminated.c_str());
+
+    // Glyphs may overlap (negative bearings), so sort and drop duplicates before joining runs
+    auto &pixels = recorder.pixels;
+    std::sort(pixels.begin(), pixels.end());
+    pixels.erase(std::unique(pixels.begin(), pixels.end()), pixels.end());
+
+    int longest = 0;
+    for (size_t i = 0; i < pixels.size();)
+    {
+        const auto [y, x] = pixels[i];
+        size_t end = i + 1;
+        while (end < pixels.size() && pixels[end].first == y && pixels[end].second == x + static_cast<int>(end - i))
+            end++;
+
+        const int length = static_cast<int>(end - i);
+        entry.runs.push_back({static_cast<int16_t>(x), static_cast<int16_t>(y), static_cast<int16_t>(length)});
+        longest = std::max(longest, length);
+        i = end;
+    }
+
+    entry.colors.assign(longest, color);
+    return entry;
+}
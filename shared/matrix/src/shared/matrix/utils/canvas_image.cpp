@@ -1,4 +1,6 @@
 #include "shared/matrix/utils/canvas_image.h"
+#include "shared/matrix/utils/image_decoder.h"
+#include "shared/common/utils/env.h"
 #include "led-matrix.h"
 #include "content-streamer.h"
 #include "Magick++.h"
@@ -7,10 +9,80 @@
 #include "spdlog/spdlog.h"
 #include <functional>
 #include <optional>
+#include <algorithm>
 
 using namespace spdlog;
 using namespace std;
 
+namespace {
+    /// MATRIX_IMAGE_DECODER=magick sends every image through GraphicsMagick again.
+    bool native_decoder_enabled() {
+        static const bool enabled = env_choice("MATRIX_IMAGE_DECODER", {"native", "magick"}) == 0;
+        return enabled;
+    }
+
+    // Scale, so that it fits in "width" and "height".
+    ImageDecoder::Geometry scale_geometry(const int img_width, const int img_height, const int canvas_width,
+                                          const int canvas_height, const bool fill_width, const bool fill_height,
+                                          const bool contain_img) {
+        int target_width = canvas_width;
+        int target_height = canvas_height;
+
+        const float width_fraction = (float) target_width / img_width;
+        const float height_fraction = (float) target_height / img_height;
+        if (fill_width && fill_height) {
+            // Scrolling diagonally. Fill as much as we can get in available space.
+            // Largest scale fraction determines that.
+
+            // Covers if contain_img is false (chooses largest fraction) and if contain_img is true (chooses smallest fraction)
+            const bool which_factor = contain_img ? width_fraction < height_fraction : width_fraction > height_fraction;
+
+            const float factor = which_factor
+                                     ? width_fraction
+                                     : height_fraction;
+            target_width = (int) roundf(factor * img_width);
+            target_height = (int) roundf(factor * img_height);
+        } else if (fill_height) {
+            // Horizontal scrolling: Make things fit in vertical space.
+            // While the height constraint stays the same, we can expand to full
+            // width as we scroll along that axis.
+            target_width = (int) roundf(height_fraction * img_width);
+        } else if (fill_width) {
+            // dito, vertical. Make things fit in horizontal space.
+            target_height = (int) roundf(width_fraction * img_height);
+        }
+
+        ImageDecoder::Geometry geometry;
+        geometry.scaled_width = std::max(target_width, 1);
+        geometry.scaled_height = std::max(target_height, 1);
+
+        if (canvas_height < geometry.scaled_height) {
+            geometry.crop_y = (geometry.scaled_height - canvas_height) / 2;
+        } else if (canvas_width < geometry.scaled_width) {
+            geometry.crop_x = (geometry.scaled_width - canvas_width) / 2;
+        }
+
+        // Same as Magick's crop, which clips to the image
+        geometry.width = std::min(canvas_width, geometry.scaled_width - geometry.crop_x);
+        geometry.height = std::min(canvas_height, geometry.scaled_height - geometry.crop_y);
+
+        // Determine the appropriate scaling filter based on image size
+        geometry.nearest = img_width < canvas_width || img_height < canvas_height;
+        return geometry;
+    }
+
+    vector<Magick::Image> to_magick(const ImageDecoder::Image &decoded) {
+        vector<Magick::Image> result;
+        result.reserve(decoded.frames.size());
+        for (const auto &frame: decoded.frames) {
+            Magick::Image img(decoded.width, decoded.height, "RGBA", Magick::CharPixel, frame.rgba.data());
+            img.animationDelay(frame.delay_cs);
+            result.push_back(std::move(img));
+        }
+        return result;
+    }
+}
+
 filesystem::path to_processed_path(const filesystem::path &path) {
     filesystem::path processed = path;
     processed.replace_extension("p" + processed.extension().string());
@@ -20,6 +92,7 @@ filesystem::path to_processed_path(const filesystem::path &path) {
 
 // Load still image or animation.
 // Scale, so that it fits in "width" and "height" and store in "result".
+// Falls back to GraphicsMagick for formats the native decoder doesn't know.
 std::expected<vector<Magick::Image>, string>
 LoadImageAndScale(const filesystem::path &path, int canvas_width, int canvas_height, const bool fill_width,
                   const bool fill_height,
@@ -31,12 +104,44 @@ LoadImageAndScale(const filesystem::path &path, int canvas_width, int canvas_hei
     try {
         // Check for processed image first
         if (filesystem::exists(img_processed)) {
+            if (native_decoder_enabled()) {
+                // Already scaled, decoded as it is
+                auto decoded = ImageDecoder::decode_file(img_processed, [](const int w, const int h) {
+                    return ImageDecoder::Geometry{w, h, 0, 0, w, h, true};
+                });
+                if (decoded.has_value())
+                    return to_magick(decoded.value());
+            }
+
             readImages(&result, img_processed);
             if (!result.empty()) {
                 return result;
             }
         }
 
+        // GIF, PNG and JPEG are decoded and scaled without Magick. Images that need
+        // pre-processing at their original size still go through Magick.
+        if (native_decoder_enabled() && !pre_process.has_value()) {
+            auto decoded = ImageDecoder::decode_file(path, [&](const int w, const int h) {
+                return scale_geometry(w, h, canvas_width, canvas_height, fill_width, fill_height, contain_img);
+            });
+
+            if (decoded.has_value()) {
+                result = to_magick(decoded.value());
+                if (store_resized_img) {
+                    try {
+                        writeImages(result.begin(), result.end(), img_processed);
+                    } catch (std::exception &e) {
+                        spdlog::warn("Failed to write processed image: {}", e.what());
+                    }
+                }
+
+                return result;
+            }
+
+            spdlog::debug("Native decoder can't handle {} ({}), using GraphicsMagick", path.string(), decoded.error());
+        }
+
         vector<Magick::Image> frames;
         spdlog::trace("Reading images from {}", path.c_str());
         readImages(&frames, path);
@@ -52,46 +157,15 @@ LoadImageAndScale(const filesystem::path &path, int canvas_width, int canvas_hei
             result.push_back(std::move(frames[0]));
         }
 
-        int target_width = canvas_width;
-        int target_height = canvas_height;
-
         const int img_width = result[0].columns();
         const int img_height = result[0].rows();
-        const float width_fraction = (float) target_width / img_width;
-        const float height_fraction = (float) target_height / img_height;
-        if (fill_width && fill_height) {
-            // Scrolling diagonally. Fill as much as we can get in available space.
-            // Largest scale fraction determines that.
-
-            // Covers if contain_img is false (chooses largest fraction) and if contain_img is true (chooses smallest fraction)
-            const bool which_factor = contain_img ? width_fraction < height_fraction : width_fraction > height_fraction;
-
-            const float factor = which_factor
-                                     ? width_fraction
-                                     : height_fraction;
-            target_width = (int) roundf(factor * img_width);
-            target_height = (int) roundf(factor * img_height);
-        } else if (fill_height) {
-            // Horizontal scrolling: Make things fit in vertical space.
-            // While the height constraint stays the same, we can expand to full
-            // width as we scroll along that axis.
-            target_width = (int) roundf(height_fraction * img_width);
-        } else if (fill_width) {
-            // dito, vertical. Make things fit in horizontal space.
-            target_height = (int) roundf(width_fraction * img_height);
-        }
-
-        int offset_x = 0;
-        int offset_y = 0;
-
-        if (canvas_height < target_height) {
-            offset_y = (target_height - canvas_height) / 2;
-        } else if (canvas_width < target_width) {
-            offset_x = (target_width - canvas_width) / 2;
-        }
-
-        // Determine the appropriate scaling filter based on image size
-        bool use_nearest_neighbor = img_width < canvas_width || img_height < canvas_height;
+        const auto geometry = scale_geometry(img_width, img_height, canvas_width, canvas_height, fill_width,
+                                             fill_height, contain_img);
+        const int target_width = geometry.scaled_width;
+        const int target_height = geometry.scaled_height;
+        const int offset_x = geometry.crop_x;
+        const int offset_y = geometry.crop_y;
+        const bool use_nearest_neighbor = geometry.nearest;
 
         trace("Scaling to {}x{} using {} and cropping to {}x{} with {},{} offset",
               target_width, target_height,
@@ -154,6 +228,34 @@ void StoreInStream(const Magick::Image &img, const int64_t delay_time_us,
     output->Stream(*scratch, delay_time_us);
 }
 
+void RenderToRgb(const Magick::Image &img, const bool do_center, const int canvas_width, const int canvas_height,
+                 uint8_t *out) {
+    std::fill_n(out, static_cast<size_t>(canvas_width) * canvas_height * 3, 0);
+    const int x_offset = do_center ? (canvas_width - static_cast<int>(img.columns())) / 2 : 0;
+    const int y_offset = do_center ? (canvas_height - static_cast<int>(img.rows())) / 2 : 0;
+
+    const Magick::PixelPacket *pixels = img.getConstPixels(0, 0, img.columns(), img.rows());
+
+    for (size_t y = 0; y < img.rows(); ++y) {
+        const int out_y = static_cast<int>(y) + y_offset;
+        if (out_y < 0 || out_y >= canvas_height)
+            continue;
+
+        const Magick::PixelPacket *row = pixels + (y * img.columns());
+        for (size_t x = 0; x < img.columns(); ++x) {
+            const int out_x = static_cast<int>(x) + x_offset;
+            const auto &q = row[x];
+            if (out_x < 0 || out_x >= canvas_width || q.opacity == MaxRGB)
+                continue;
+
+            uint8_t *pixel = out + (static_cast<size_t>(out_y) * canvas_width + out_x) * 3;
+            pixel[0] = ScaleQuantumToChar(q.red);
+            pixel[1] = ScaleQuantumToChar(q.green);
+            pixel[2] = ScaleQuantumToChar(q.blue);
+        }
+    }
+}
+
 bool SetImageTransparent(rgb_matrix::FrameCanvas *c, const int x_offset, const int y_offset,
                          const Magick::Image &img) {
     // Get direct access to pixel data
@@ -184,3 +286,23 @@ bool SetImageTransparent(rgb_matrix::FrameCanvas *c, const int x_offset, const i
     }
     return true;
 }
+
+bool SetImageTransparent(CanvasLayer *layer, const int x_offset, const int y_offset,
+                         const Magick::Image &img) {
+    const Magick::PixelPacket *pixels = img.getConstPixels(0, 0, img.columns(), img.rows());
+
+    for (int y = 0; y < img.rows(); y++) {
+        const Magick::PixelPacket *row = pixels + (y * img.columns());
+        for (int x = 0; x < img.columns(); x++) {
+            const auto &q = row[x];
+
+            // Opacity is inverted in ImageMagick, see above
+            const float alpha = 1.0f - (ScaleQuantumToChar(q.opacity) / 255.0f);
+            if (alpha > 0.0f) {
+                layer->blend(x + x_offset, y + y_offset, ScaleQuantumToChar(q.red), ScaleQuantumToChar(q.green),
+                             ScaleQuantumToChar(q.blue), alpha);
+            }
+        }
+    }
+    return true;
+}
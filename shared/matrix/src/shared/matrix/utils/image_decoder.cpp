@@ -0,0 +1,579 @@
+#include "shared/matrix/utils/image_decoder.h"
+#include <algorithm>
+#include <array>
+#include <csetjmp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <png.h>
+#include <jpeglib.h>
+
+using namespace std;
+
+namespace {
+    /// Larger sources go to Magick, which can at least report a sensible error.
+    constexpr int64_t max_source_pixels = 8192LL * 8192LL;
+
+    bool valid_geometry(const ImageDecoder::Geometry &g) {
+        return g.scaled_width > 0 && g.scaled_height > 0 && g.width > 0 && g.height > 0 &&
+               g.crop_x >= 0 && g.crop_y >= 0 && g.crop_x + g.width <= g.scaled_width &&
+               g.crop_y + g.height <= g.scaled_height;
+    }
+
+    // ─── Scaling ─────────────────────────────────────────────────────────────
+
+    /// Maps every output pixel to the block of source pixels it covers, computed
+    /// once per image and reused for all of its frames.
+    class Scaler {
+    public:
+        Scaler(const int source_width, const int source_height, const ImageDecoder::Geometry &g)
+            : source_width(source_width), width(g.width), height(g.height) {
+            columns = spans(source_width, g.scaled_width, g.crop_x, g.width, g.nearest);
+            rows = spans(source_height, g.scaled_height, g.crop_y, g.height, g.nearest);
+            one_to_one = ranges::all_of(columns, [](const Span &s) { return s.end - s.begin == 1; }) &&
+                         ranges::all_of(rows, [](const Span &s) { return s.end - s.begin == 1; });
+        }
+
+        /// 'source' is source_width x source_height RGBA, 'out' width x height RGBA.
+        void scale(const uint8_t *source, uint8_t *out) const {
+            if (one_to_one) {
+                for (const auto &row: rows) {
+                    const uint8_t *in = source + static_cast<size_t>(row.begin) * source_width * 4;
+                    for (const auto &column: columns) {
+                        memcpy(out, in + static_cast<size_t>(column.begin) * 4, 4);
+                        out += 4;
+                    }
+                }
+                return;
+            }
+
+            for (const auto &row: rows) {
+                for (const auto &column: columns) {
+                    // Colors are weighted by alpha so transparent pixels don't darken the edges
+                    uint32_t r = 0, g = 0, b = 0, alpha = 0, count = 0;
+                    for (int y = row.begin; y < row.end; ++y) {
+                        const uint8_t *in = source + (static_cast<size_t>(y) * source_width + column.begin) * 4;
+                        for (int x = column.begin; x < column.end; ++x, in += 4) {
+                            r += in[0] * in[3];
+                            g += in[1] * in[3];
+                            b += in[2] * in[3];
+                            alpha += in[3];
+                            count++;
+                        }
+                    }
+
+                    if (alpha == 0) {
+                        memset(out, 0, 4);
+                    } else {
+                        out[0] = static_cast<uint8_t>((r + alpha / 2) / alpha);
+                        out[1] = static_cast<uint8_t>((g + alpha / 2) / alpha);
+                        out[2] = static_cast<uint8_t>((b + alpha / 2) / alpha);
+                        out[3] = static_cast<uint8_t>((alpha + count / 2) / count);
+                    }
+                    out += 4;
+                }
+            }
+        }
+
+        [[nodiscard]] size_t frame_bytes() const {
+            return static_cast<size_t>(width) * height * 4;
+        }
+
+    private:
+        struct Span {
+            int begin;
+            int end;
+        };
+
+        static vector<Span> spans(const int source, const int scaled, const int crop, const int count,
+                                  const bool nearest) {
+            vector<Span> result(count);
+            for (int i = 0; i < count; ++i) {
+                const int64_t s = i + crop;
+                int begin, end;
+                if (nearest) {
+                    begin = static_cast<int>(((2 * s + 1) * source) / (2LL * scaled));
+                    end = begin + 1;
+                } else {
+                    begin = static_cast<int>(s * source / scaled);
+                    end = max(begin + 1, static_cast<int>((s + 1) * source / scaled));
+                }
+
+                begin = clamp(begin, 0, source - 1);
+                end = clamp(end, begin + 1, source);
+                result[i] = {begin, end};
+            }
+            return result;
+        }
+
+        int source_width;
+        int width;
+        int height;
+        vector<Span> columns;
+        vector<Span> rows;
+        bool one_to_one = false;
+    };
+
+    ImageDecoder::Frame scaled_frame(const Scaler &scaler, const uint8_t *source, const uint32_t delay_cs) {
+        ImageDecoder::Frame frame;
+        frame.rgba.resize(scaler.frame_bytes());
+        frame.delay_cs = delay_cs;
+        scaler.scale(source, frame.rgba.data());
+        return frame;
+    }
+
+    // ─── GIF ─────────────────────────────────────────────────────────────────
+
+    class ByteReader {
+    public:
+        explicit ByteReader(const span<const uint8_t> data) : data(data) {
+        }
+
+        [[nodiscard]] bool has(const size_t count) const {
+            return pos + count <= data.size();
+        }
+
+        uint8_t u8() {
+            return has(1) ? data[pos++] : 0;
+        }
+
+        uint16_t u16() {
+            const uint16_t low = u8();
+            return low | static_cast<uint16_t>(u8() << 8);
+        }
+
+        span<const uint8_t> bytes(const size_t count) {
+            if (!has(count)) {
+                pos = data.size();
+                return {};
+            }
+            auto result = data.subspan(pos, count);
+            pos += count;
+            return result;
+        }
+
+        /// Appends the data sub-blocks that follow to 'out' (or skips them if it is null).
+        bool sub_blocks(vector<uint8_t> *out) {
+            while (has(1)) {
+                const uint8_t size = u8();
+                if (size == 0)
+                    return true;
+
+                const auto block = bytes(size);
+                if (block.size() != size)
+                    return false;
+                if (out)
+                    out->insert(out->end(), block.begin(), block.end());
+            }
+            return false;
+        }
+
+    private:
+        span<const uint8_t> data;
+        size_t pos = 0;
+    };
+
+    /// Decodes GIF LZW 'data' into 'out', stopping once 'out' is full. Returns false
+    /// on a corrupt stream, pixels after the error keep their previous value.
+    bool decode_lzw(const span<const uint8_t> data, const int min_code_size, span<uint8_t> out) {
+        if (min_code_size < 2 || min_code_size > 8)
+            return false;
+
+        constexpr int max_codes = 4096;
+        array<uint16_t, max_codes> prefix{};
+        array<uint8_t, max_codes> suffix{};
+        array<uint8_t, max_codes> first{};
+        array<uint8_t, max_codes + 1> stack{};
+
+        const int clear_code = 1 << min_code_size;
+        const int end_code = clear_code + 1;
+        for (int i = 0; i < clear_code; ++i) {
+            suffix[i] = first[i] = static_cast<uint8_t>(i);
+        }
+
+        int code_size = min_code_size + 1;
+        int next_code = clear_code + 2;
+        int previous = -1;
+
+        uint32_t bits = 0;
+        int bit_count = 0;
+        size_t in = 0;
+        size_t written = 0;
+
+        while (written < out.size()) {
+            while (bit_count < code_size) {
+                if (in >= data.size())
+                    return written == out.size();
+                bits |= static_cast<uint32_t>(data[in++]) << bit_count;
+                bit_count += 8;
+            }
+
+            int code = static_cast<int>(bits & ((1u << code_size) - 1));
+            bits >>= code_size;
+            bit_count -= code_size;
+
+            if (code == clear_code) {
+                code_size = min_code_size + 1;
+                next_code = clear_code + 2;
+                previous = -1;
+                continue;
+            }
+            if (code == end_code)
+                break;
+
+            if (previous == -1) {
+                if (code >= clear_code)
+                    return false;
+                out[written++] = static_cast<uint8_t>(code);
+                previous = code;
+                continue;
+            }
+
+            if (code > next_code || (code == next_code && next_code >= max_codes))
+                return false;
+
+            const int current = code;
+            size_t depth = 0;
+            if (code == next_code) {
+                // The KwKwK case: the code being defined right now
+                stack[depth++] = first[previous];
+                code = previous;
+            }
+            while (code > end_code) {
+                stack[depth++] = suffix[code];
+                code = prefix[code];
+            }
+            stack[depth++] = static_cast<uint8_t>(code);
+
+            while (depth > 0 && written < out.size())
+                out[written++] = stack[--depth];
+
+            if (next_code < max_codes) {
+                prefix[next_code] = static_cast<uint16_t>(previous);
+                suffix[next_code] = static_cast<uint8_t>(code);
+                first[next_code] = first[previous];
+                next_code++;
+                if (next_code == (1 << code_size) && code_size < 12)
+                    code_size++;
+            }
+
+            previous = current;
+        }
+
+        return true;
+    }
+
+    /// Row of the n-th stored row of an interlaced image.
+    int interlaced_row(int n, const int height) {
+        constexpr int starts[] = {0, 4, 2, 1};
+        constexpr int steps[] = {8, 8, 4, 2};
+        for (int pass = 0; pass < 4; ++pass) {
+            const int rows = (height - starts[pass] + steps[pass] - 1) / steps[pass];
+            if (n < rows)
+                return starts[pass] + n * steps[pass];
+            n -= max(rows, 0);
+        }
+        return height - 1;
+    }
+
+    std::expected<ImageDecoder::Image, string> decode_gif(const span<const uint8_t> data,
+                                                          const ImageDecoder::GeometryFn &geometry_fn) {
+        ByteReader reader(data);
+        reader.bytes(6); // GIF87a / GIF89a
+
+        const int screen_width = reader.u16();
+        const int screen_height = reader.u16();
+        const uint8_t screen_flags = reader.u8();
+        reader.u8(); // background color, disposal clears to transparent like Magick's coalesce
+        reader.u8(); // aspect ratio
+
+        if (screen_width == 0 || screen_height == 0 ||
+            static_cast<int64_t>(screen_width) * screen_height > max_source_pixels)
+            return unexpected("Unsupported GIF screen size");
+
+        span<const uint8_t> global_palette;
+        if (screen_flags & 0x80)
+            global_palette = reader.bytes(3 * (2 << (screen_flags & 0x07)));
+
+        const auto geometry = geometry_fn(screen_width, screen_height);
+        if (!valid_geometry(geometry))
+            return unexpected("Invalid target geometry");
+
+        const Scaler scaler(screen_width, screen_height, geometry);
+        ImageDecoder::Image image{geometry.width, geometry.height, {}};
+
+        // Composed at the source size, only the scaled result of each frame is kept
+        vector<uint8_t> canvas(static_cast<size_t>(screen_width) * screen_height * 4, 0);
+        vector<uint8_t> previous_canvas;
+        vector<uint8_t> lzw_data;
+        vector<uint8_t> indices;
+
+        int disposal = 0;
+        int transparent_index = -1;
+        uint32_t delay_cs = 0;
+
+        while (reader.has(1)) {
+            const uint8_t block = reader.u8();
+
+            if (block == 0x3B)
+                break;
+
+            if (block == 0x21) {
+                const uint8_t label = reader.u8();
+                if (label == 0xF9) {
+                    const auto gce = reader.bytes(reader.u8());
+                    if (gce.size() >= 4) {
+                        disposal = (gce[0] >> 2) & 0x07;
+                        delay_cs = gce[1] | (gce[2] << 8);
+                        transparent_index = (gce[0] & 0x01) ? gce[3] : -1;
+                    }
+                }
+                if (!reader.sub_blocks(nullptr))
+                    break;
+                continue;
+            }
+
+            if (block != 0x2C)
+                break;
+
+            const int left = reader.u16();
+            const int top = reader.u16();
+            const int width = reader.u16();
+            const int height = reader.u16();
+            const uint8_t flags = reader.u8();
+
+            // The descriptor is untrusted and the frame is decoded at its own size, so a frame
+            // reaching past the screen could ask for gigabytes. Inside it, the frame is never
+            // larger than the screen, which was checked against max_source_pixels.
+            if (left + width > screen_width || top + height > screen_height) {
+                if (image.frames.empty())
+                    return unexpected("GIF frame outside of the logical screen");
+                break;
+            }
+
+            span<const uint8_t> palette = global_palette;
+            if (flags & 0x80)
+                palette = reader.bytes(3 * (2 << (flags & 0x07)));
+
+            const int min_code_size = reader.u8();
+            lzw_data.clear();
+            if (!reader.sub_blocks(&lzw_data) && lzw_data.empty())
+                break;
+
+            if (disposal == 3)
+                previous_canvas = canvas;
+
+            // A broken stream still shows what was decoded, like browsers do
+            indices.assign(static_cast<size_t>(width) * height, transparent_index >= 0 ? transparent_index : 0);
+            decode_lzw(lzw_data, min_code_size, indices);
+
+            const bool interlaced = flags & 0x40;
+            const size_t palette_colors = palette.size() / 3;
+            for (int row = 0; row < height; ++row) {
+                const int y = top + (interlaced ? interlaced_row(row, height) : row);
+                if (y >= screen_height)
+                    continue;
+
+                const uint8_t *in = indices.data() + static_cast<size_t>(row) * width;
+                uint8_t *out = canvas.data() + static_cast<size_t>(y) * screen_width * 4;
+                const int end_x = min(width, screen_width - left);
+                for (int x = 0; x < end_x; ++x) {
+                    const uint8_t index = in[x];
+                    if (index == transparent_index || index >= palette_colors)
+                        continue;
+
+                    uint8_t *pixel = out + static_cast<size_t>(left + x) * 4;
+                    pixel[0] = palette[index * 3];
+                    pixel[1] = palette[index * 3 + 1];
+                    pixel[2] = palette[index * 3 + 2];
+                    pixel[3] = 255;
+                }
+            }
+
+            image.frames.push_back(scaled_frame(scaler, canvas.data(), delay_cs));
+
+            if (disposal == 2) {
+                for (int y = top; y < min(top + height, screen_height); ++y) {
+                    if (left >= screen_width)
+                        break;
+                    uint8_t *out = canvas.data() + (static_cast<size_t>(y) * screen_width + left) * 4;
+                    memset(out, 0, static_cast<size_t>(min(width, screen_width - left)) * 4);
+                }
+            } else if (disposal == 3 && !previous_canvas.empty()) {
+                canvas.swap(previous_canvas);
+            }
+
+            // The graphic control extension only applies to the next image
+            disposal = 0;
+            transparent_index = -1;
+            delay_cs = 0;
+        }
+
+        if (image.frames.empty())
+            return unexpected("GIF has no frames");
+
+        return image;
+    }
+
+    // ─── PNG ─────────────────────────────────────────────────────────────────
+
+    std::expected<ImageDecoder::Image, string> decode_png(const span<const uint8_t> data,
+                                                          const ImageDecoder::GeometryFn &geometry_fn) {
+        png_image png{};
+        png.version = PNG_IMAGE_VERSION;
+        if (!png_image_begin_read_from_memory(&png, data.data(), data.size()))
+            return unexpected(string("PNG: ") + png.message);
+
+        if (static_cast<int64_t>(png.width) * png.height > max_source_pixels) {
+            png_image_free(&png);
+            return unexpected("Unsupported PNG size");
+        }
+
+        const auto geometry = geometry_fn(static_cast<int>(png.width), static_cast<int>(png.height));
+        if (!valid_geometry(geometry)) {
+            png_image_free(&png);
+            return unexpected("Invalid target geometry");
+        }
+
+        png.format = PNG_FORMAT_RGBA;
+        vector<uint8_t> pixels(PNG_IMAGE_SIZE(png));
+        if (!png_image_finish_read(&png, nullptr, pixels.data(), 0, nullptr))
+            return unexpected(string("PNG: ") + png.message);
+
+        const Scaler scaler(static_cast<int>(png.width), static_cast<int>(png.height), geometry);
+        ImageDecoder::Image image{geometry.width, geometry.height, {}};
+        image.frames.push_back(scaled_frame(scaler, pixels.data(), 0));
+        return image;
+    }
+
+    // ─── JPEG ────────────────────────────────────────────────────────────────
+
+    struct JpegError {
+        jpeg_error_mgr manager;
+        jmp_buf jump;
+        char message[JMSG_LENGTH_MAX];
+    };
+
+    void jpeg_error_exit(const j_common_ptr info) {
+        auto *error = reinterpret_cast<JpegError *>(info->err);
+        info->err->format_message(info, error->message);
+        longjmp(error->jump, 1);
+    }
+
+    void jpeg_silence(j_common_ptr, int) {
+    }
+
+    std::expected<ImageDecoder::Image, string> decode_jpeg(const span<const uint8_t> data,
+                                                           const ImageDecoder::GeometryFn &geometry_fn) {
+        // Everything with a destructor lives outside the setjmp scope
+        jpeg_decompress_struct info{};
+        JpegError error{};
+        ImageDecoder::Geometry geometry;
+        vector<uint8_t> pixels;
+        vector<uint8_t> row;
+
+        info.err = jpeg_std_error(&error.manager);
+        error.manager.error_exit = jpeg_error_exit;
+        error.manager.emit_message = jpeg_silence;
+
+        if (setjmp(error.jump)) {
+            jpeg_destroy_decompress(&info);
+            return unexpected(string("JPEG: ") + error.message);
+        }
+
+        jpeg_create_decompress(&info);
+        jpeg_mem_src(&info, data.data(), data.size());
+        jpeg_read_header(&info, TRUE);
+
+        if (static_cast<int64_t>(info.image_width) * info.image_height > max_source_pixels) {
+            jpeg_destroy_decompress(&info);
+            return unexpected("Unsupported JPEG size");
+        }
+
+        geometry = geometry_fn(static_cast<int>(info.image_width), static_cast<int>(info.image_height));
+        if (!valid_geometry(geometry)) {
+            jpeg_destroy_decompress(&info);
+            return unexpected("Invalid target geometry");
+        }
+
+        // Let the IDCT do most of the downscaling, as long as the result still covers the target
+        info.scale_num = 1;
+        info.scale_denom = 1;
+        for (const unsigned denom: {8u, 4u, 2u}) {
+            if ((info.image_width + denom - 1) / denom >= static_cast<unsigned>(geometry.scaled_width) &&
+                (info.image_height + denom - 1) / denom >= static_cast<unsigned>(geometry.scaled_height)) {
+                info.scale_denom = denom;
+                break;
+            }
+        }
+        info.out_color_space = JCS_RGB;
+        jpeg_start_decompress(&info);
+
+        const int width = static_cast<int>(info.output_width);
+        const int height = static_cast<int>(info.output_height);
+        pixels.resize(static_cast<size_t>(width) * height * 4);
+        row.resize(static_cast<size_t>(width) * info.output_components);
+
+        while (info.output_scanline < info.output_height) {
+            const size_t y = info.output_scanline;
+            JSAMPROW rows[] = {row.data()};
+            jpeg_read_scanlines(&info, rows, 1);
+
+            uint8_t *out = pixels.data() + y * width * 4;
+            for (int x = 0; x < width; ++x, out += 4) {
+                memcpy(out, row.data() + x * 3, 3);
+                out[3] = 255;
+            }
+        }
+
+        jpeg_finish_decompress(&info);
+        jpeg_destroy_decompress(&info);
+
+        const Scaler scaler(width, height, geometry);
+        ImageDecoder::Image image{geometry.width, geometry.height, {}};
+        image.frames.push_back(scaled_frame(scaler, pixels.data(), 0));
+        return image;
+    }
+}
+
+ImageDecoder::Format ImageDecoder::detect_format(const span<const uint8_t> data) {
+    constexpr uint8_t png_signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+    if (data.size() >= 6 && (memcmp(data.data(), "GIF87a", 6) == 0 || memcmp(data.data(), "GIF89a", 6) == 0))
+        return Format::Gif;
+    if (data.size() >= sizeof(png_signature) && memcmp(data.data(), png_signature, sizeof(png_signature)) == 0)
+        return Format::Png;
+    if (data.size() >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF)
+        return Format::Jpeg;
+
+    return Format::Unknown;
+}
+
+std::expected<ImageDecoder::Image, string> ImageDecoder::decode(const span<const uint8_t> data,
+                                                                const GeometryFn &geometry) {
+    switch (detect_format(data)) {
+        case Format::Gif:
+            return decode_gif(data, geometry);
+        case Format::Png:
+            return decode_png(data, geometry);
+        case Format::Jpeg:
+            return decode_jpeg(data, geometry);
+        default:
+            return unexpected("Unsupported format");
+    }
+}
+
+std::expected<ImageDecoder::Image, string> ImageDecoder::decode_file(const filesystem::path &path,
+                                                                     const GeometryFn &geometry) {
+    ifstream file(path, ios::binary | ios::ate);
+    if (!file)
+        return unexpected("Could not open " + path.string());
+
+    const auto size = static_cast<size_t>(file.tellg());
+    vector<uint8_t> data(size);
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char *>(data.data()), static_cast<streamsize>(size)))
+        return unexpected("Could not read " + path.string());
+
+    return decode(data, geometry);
+}
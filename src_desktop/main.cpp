@@ -319,6 +319,36 @@ int run_app(int argc, char *argv[]) {
         ImGui::SetItemTooltip("Limits the rate at which frames are sent to the Pi. "
                               "Lower this if the Pi can't keep up (e.g. 15-25 FPS).");
 
+        static bool frameStreaming = generalCfg.isFrameStreaming();
+        if (ImGui::Checkbox("Delta frame streaming", &frameStreaming)) {
+            generalCfg.setFrameStreaming(frameStreaming);
+        }
+        ImGui::SetItemTooltip("Only send the parts of video and shader frames that changed, split into "
+                              "MTU-sized packets. Needs a matrix build that supports it, older ones only accept raw frames.");
+
+        if (frameStreaming) {
+            static const char *codecs[] = {"raw", "rle", "lz4"};
+            static int codecIndex = [&generalCfg]() {
+                const auto codec = generalCfg.getFrameStreamCodec();
+                for (int i = 0; i < IM_ARRAYSIZE(codecs); i++)
+                    if (codec == codecs[i])
+                        return i;
+                return 2;
+            }();
+            if (ImGui::Combo("Compression", &codecIndex, codecs, IM_ARRAYSIZE(codecs))) {
+                generalCfg.setFrameStreamCodec(codecs[codecIndex]);
+            }
+        }
+
+#ifdef __linux__
+        static bool sharedMemoryTransport = generalCfg.isSharedMemoryTransport();
+        if (ImGui::Checkbox("Shared memory transport", &sharedMemoryTransport)) {
+            generalCfg.setSharedMemoryTransport(sharedMemoryTransport);
+        }
+        ImGui::SetItemTooltip("Only for a matrix running on this machine (e.g. the emulator). Frames are handed "
+                              "over through shared memory instead of UDP. Falls back to UDP if the matrix isn't local.");
+#endif
+
         if (somethingInvalid) {
             ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "Please fix the highlighted fields.");
         } else if (initialConnect) {
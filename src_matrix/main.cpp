@@ -18,6 +18,8 @@
 #include "shared/matrix/server/server_utils.h"
 #include "shared/matrix/update/UpdateManager.h"
 #include "udp.h"
+#include "shm_server.h"
+#include "shared/common/utils/clock.h"
 #include "shared/matrix/server/common.h"
 
 #include <restinio/core.hpp>
@@ -83,6 +85,15 @@ int main(int argc, char *argv[])
     SetMagickResourceLimit(Magick::MapResource, 512 * 1024 * 1024);    // Limit to 512MB
     cfg::load_env_levels();
 
+    const auto clock_settings = Clock::Settings::from_env();
+    if (clock_settings.mode != Clock::Settings::Mode::Real)
+    {
+        Clock::set_source(clock_settings.create_source());
+        spdlog::info("Running on a {} clock", clock_settings.mode == Clock::Settings::Mode::Scaled
+                                                  ? fmt::format("scaled (x{})", clock_settings.scale)
+                                                  : fmt::format("stepped ({} ms per frame)", clock_settings.step_ms));
+    }
+
     // -----------------------------------------------------------------------
     // Emulator-only: parse --scene / --prop before the rgb-matrix flags so
     // that CLI11 consumes its arguments first and the remainder is handed to
@@ -285,6 +296,13 @@ int main(int argc, char *argv[])
     debug("Starting UDP server on port {}", port);
     UdpServer *udpServer = new UdpServer(port);
 
+    ShmServer *shmServer = nullptr;
+    if (const auto shm_settings = ShmServerSettings::from_env())
+    {
+        debug("Starting shared memory transport");
+        shmServer = new ShmServer(port, *shm_settings);
+    }
+
     debug("Initializing hardware...");
 #ifdef ENABLE_EMULATOR
     auto hardware_code = start_hardware_mainloop(matrix, pinned_scene);
@@ -308,6 +326,7 @@ int main(int argc, char *argv[])
     initiate_shutdown(server);
 
     delete udpServer;
+    delete shmServer;
 
     for (const auto plugin : pl->get_plugins())
     {
@@ -1,4 +1,5 @@
 #include "canvas.h"
+#include "compositor.h"
 #include <restinio/core.hpp>
 #include <restinio/websocket/websocket.hpp>
 
@@ -7,11 +8,22 @@
 #include "shared/matrix/server/server_utils.h"
 #include "shared/matrix/utils/utils.h"
 #include "shared/matrix/canvas_consts.h"
+#include "shared/matrix/canvas_buffer.h"
+#include "shared/matrix/utils/FrameProfiler.h"
+#include "shared/matrix/utils/FontRegistry.h"
+#include "shared/matrix/utils/TextCache.h"
 #include "shared/matrix/utils/shared.h"
 #include "shared/matrix/interrupt.h"
 #include "shared/matrix/plugin_loader/loader.h"
+#include "shared/common/utils/clock.h"
 #include <spdlog/spdlog.h>
 #include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
 
 #ifdef ENABLE_EMULATOR
 #include "emulator.h"
@@ -23,12 +35,104 @@ using namespace spdlog;
 using rgb_matrix::RGBMatrixBase;
 
 rgb_matrix::Color ERROR_COLOR = rgb_matrix::Color(255, 0, 0);
-rgb_matrix::Font ERROR_FONT = rgb_matrix::Font();
+const rgb_matrix::Font *ERROR_FONT = nullptr;
 bool load_font_error = false;
-bool loaded_font_success = false;
+TextCache ERROR_TEXT(1);
 
 namespace
 {
+    /// Runs one render job at a time on a dedicated thread. Used to render the
+    /// outgoing scene of a cross-fade while the caller renders the incoming one.
+    class SceneRenderWorker
+    {
+    public:
+        SceneRenderWorker() : worker([this]()
+                                     { loop(); })
+        {
+        }
+
+        ~SceneRenderWorker()
+        {
+            {
+                std::lock_guard lock(mutex);
+                quit = true;
+            }
+            job_changed.notify_all();
+            worker.join();
+        }
+
+        SceneRenderWorker(const SceneRenderWorker &) = delete;
+        SceneRenderWorker &operator=(const SceneRenderWorker &) = delete;
+
+        void start(std::function<bool()> next_job)
+        {
+            {
+                std::lock_guard lock(mutex);
+                job = std::move(next_job);
+                has_job = true;
+                done = false;
+            }
+            job_changed.notify_all();
+        }
+
+        /// Blocks until the job passed to start() finished and returns its result.
+        bool wait()
+        {
+            std::unique_lock lock(mutex);
+            job_changed.wait(lock, [this]()
+                             { return done; });
+
+            if (failure)
+                std::rethrow_exception(std::exchange(failure, nullptr));
+
+            return result;
+        }
+
+    private:
+        void loop()
+        {
+            std::unique_lock lock(mutex);
+            while (true)
+            {
+                job_changed.wait(lock, [this]()
+                                 { return has_job || quit; });
+                if (quit)
+                    return;
+
+                auto current_job = std::move(job);
+                has_job = false;
+                lock.unlock();
+
+                bool current_result = false;
+                std::exception_ptr current_failure;
+                try
+                {
+                    current_result = current_job();
+                }
+                catch (...)
+                {
+                    current_failure = std::current_exception();
+                }
+
+                lock.lock();
+                result = current_result;
+                failure = current_failure;
+                done = true;
+                job_changed.notify_all();
+            }
+        }
+
+        std::mutex mutex;
+        std::condition_variable job_changed;
+        std::function<bool()> job;
+        bool has_job = false;
+        bool done = false;
+        bool quit = false;
+        bool result = false;
+        std::exception_ptr failure;
+        std::thread worker;
+    };
+
     std::vector<std::pair<int, std::shared_ptr<Scenes::Scene>>> build_weighted_scenes(
         const std::vector<std::shared_ptr<Scenes::Scene>> &scenes,
         bool is_desktop_connected,
@@ -109,48 +213,22 @@ namespace
         return transition_duration > 0 && transition_duration < scene_duration;
     }
 
-    void copy_canvas(FrameCanvas *dst, FrameCanvas *src, int width, int height)
+    /// Renders one frame and records the render time without the scene's frame pacing sleep.
+    bool render_profiled(Scenes::Scene &scene, FrameCanvas *canvas, SceneProfile &profile)
     {
-        for (int y = 0; y < height; ++y)
-        {
-            for (int x = 0; x < width; ++x)
-            {
-                uint8_t r = 0;
-                uint8_t g = 0;
-                uint8_t b = 0;
-                src->GetPixel(x, y, &r, &g, &b);
-                dst->SetPixel(x, y, r, g, b);
-            }
-        }
+        scene.take_pacing_wait();
+        const auto start = FrameProfiler::clock::now();
+        const bool keep_going = scene.render(canvas);
+        profile.render.record(FrameProfiler::since(start) - scene.take_pacing_wait());
+        return keep_going;
     }
 
-    void apply_transition_frame(
-        FrameCanvas *dst,
-        FrameCanvas *from,
-        FrameCanvas *to,
-        float alpha_progress,
-        int width,
-        int height,
-        const std::string &transition_name)
+    FrameCanvas *swap_profiled(RGBMatrixBase *matrix, FrameCanvas *canvas, SceneProfile &profile)
     {
-        TransitionEffect *transition_effect = nullptr;
-        if (Constants::global_transition_manager != nullptr)
-        {
-            transition_effect = Constants::global_transition_manager->get_transition(transition_name);
-            if (transition_effect == nullptr)
-            {
-                transition_effect = Constants::global_transition_manager->get_transition("blend");
-            }
-        }
-
-        if (transition_effect != nullptr)
-        {
-            transition_effect->apply(dst, from, to, alpha_progress, width, height);
-            return;
-        }
-
-        // If no transition effect is available, render a hard cut to the next scene.
-        copy_canvas(dst, to, width, height);
+        const auto start = FrameProfiler::clock::now();
+        auto *next_canvas = matrix->SwapOnVSync(canvas, 1);
+        profile.swap_wait.record(FrameProfiler::since(start));
+        return next_canvas;
     }
 
     void notify_scene_active(const std::shared_ptr<Scenes::Scene> &scene)
@@ -173,34 +251,48 @@ namespace
             }
         }
     }
+}
 
-    tmillis_t render_interval_ms_from_visibility(float visibility)
-    {
-        const auto clamped_visibility = std::clamp(visibility, 0.0f, 1.0f);
-
-        // Keep visible scenes responsive while aggressively throttling nearly-hidden scenes.
-        constexpr tmillis_t min_interval_ms = 33;   // ~30 FPS
-        constexpr tmillis_t max_interval_ms = 140;  // ~7 FPS
+void apply_transition_frame(
+    CanvasBuffer &dst,
+    const CanvasBuffer &from,
+    const CanvasBuffer &to,
+    float alpha_progress,
+    const std::string &transition_name)
+{
+    dst.resize(from.width(), from.height());
 
-        const auto interval_range = max_interval_ms - min_interval_ms;
-        const auto interval = max_interval_ms - static_cast<tmillis_t>(clamped_visibility * static_cast<float>(interval_range));
+    TransitionEffect *transition_effect = nullptr;
+    if (Constants::global_transition_manager != nullptr)
+    {
+        transition_effect = Constants::global_transition_manager->get_transition(transition_name);
+        if (transition_effect == nullptr)
+        {
+            transition_effect = Constants::global_transition_manager->get_transition("blend");
+        }
+    }
 
-        return std::clamp(interval, min_interval_ms, max_interval_ms);
+    if (transition_effect != nullptr)
+    {
+        transition_effect->apply(dst, from, to, alpha_progress);
+        return;
     }
+
+    // If no transition effect is available, render a hard cut to the next scene.
+    std::copy_n(to.data(), std::min(dst.size(), to.size()), dst.data());
 }
 
-void render_fallback(RGBMatrixBase *canvas)
+void render_fallback(rgb_matrix::Canvas *canvas)
 {
-    if (!loaded_font_success && !load_font_error)
+    if (ERROR_FONT == nullptr && !load_font_error)
     {
-        if (!ERROR_FONT.LoadFont((get_exec_dir() / "7x13.bdf").c_str()))
+        ERROR_FONT = FontRegistry::instance().load(get_exec_dir() / "7x13.bdf");
+        if (ERROR_FONT == nullptr)
         {
             spdlog::error("Could not load error font");
             load_font_error = true;
             return;
         }
-
-        loaded_font_success = true;
     }
 
     if (load_font_error)
@@ -210,10 +302,10 @@ void render_fallback(RGBMatrixBase *canvas)
     }
 
     canvas->Fill(0, 0, 0); // Fill with black
-    rgb_matrix::DrawText(canvas, ERROR_FONT, 0, 11, ERROR_COLOR, "No scene available");
+    ERROR_TEXT.draw(canvas, *ERROR_FONT, 0, 11, ERROR_COLOR, "No scene available");
 }
 
-void update_canvas(RGBMatrixBase *matrix, FrameCanvas *&first_offscreen_canvas, FrameCanvas *&second_offscreen_canvas, FrameCanvas *&composite_offscreen_canvas, std::shared_ptr<Scenes::Scene> &forced_scene, std::shared_ptr<Scenes::Scene> pinned_scene)
+void update_canvas(RGBMatrixBase *matrix, FrameCanvas *&first_offscreen_canvas, FrameCanvas *&second_offscreen_canvas, FrameCanvas *&composite_offscreen_canvas, std::shared_ptr<Scenes::Scene> &forced_scene, std::shared_ptr<Scenes::Scene> pinned_scene, Compositor *compositor)
 {
     const auto preset = config->get_curr();
     const auto &scenes = preset->scenes;
@@ -226,6 +318,12 @@ void update_canvas(RGBMatrixBase *matrix, FrameCanvas *&first_offscreen_canvas,
             item->initialize(matrix_width, matrix_height);
     }
 
+    // Row-major copies of both scene canvases and the blended result used during cross-fades
+    CanvasBuffer from_frame(matrix_width, matrix_height);
+    CanvasBuffer to_frame(matrix_width, matrix_height);
+    CanvasBuffer blended_frame(matrix_width, matrix_height);
+    SceneRenderWorker outgoing_renderer;
+
     int no_scene_count = 0;
     while (!exit_canvas_update)
     {
@@ -246,21 +344,33 @@ void update_canvas(RGBMatrixBase *matrix, FrameCanvas *&first_offscreen_canvas,
             no_scene_count++;
 
             Server::currScene = nullptr;
-            render_fallback(matrix);
+            if (compositor != nullptr)
+            {
+                if (auto *slot = compositor->acquire())
+                {
+                    render_fallback(slot->canvas);
+                    compositor->submit(slot);
+                }
+            }
+            else
+            {
+                render_fallback(matrix);
 
 #ifdef ENABLE_EMULATOR
-            ((rgb_matrix::EmulatorMatrix *)matrix)->Render();
+                ((rgb_matrix::EmulatorMatrix *)matrix)->Render();
 #endif
+            }
 
             SleepMillis(300);
             continue;
         }
 
         no_scene_count = 0;
-        const tmillis_t start_ms = GetTimeInMillis();
+        const tmillis_t start_ms = Clock::wall_millis();
         const tmillis_t end_ms = start_ms + scene->get_duration();
 
         notify_scene_active(scene);
+        auto &scene_profile = FrameProfiler::instance().get(scene->get_name());
 
         std::shared_ptr<Scenes::Scene> next_scene;
         const auto transition_duration = resolve_transition_duration(preset, scene);
@@ -277,9 +387,31 @@ void update_canvas(RGBMatrixBase *matrix, FrameCanvas *&first_offscreen_canvas,
 
         // Phase 1: render current scene until transition window or scene end
         bool early_exit = false;
-        while (GetTimeInMillis() < end_ms)
+        while (Clock::wall_millis() < end_ms)
         {
-            const auto should_continue = scene->render(composite_offscreen_canvas);
+            if (compositor != nullptr)
+            {
+                // Pipelined mode: render into the ring, the compositor thread post-processes and swaps.
+                auto *slot = compositor->acquire();
+                const auto should_continue = slot != nullptr && render_profiled(*scene, slot->canvas, scene_profile);
+
+                if (!should_continue || interrupt_received || exit_canvas_update)
+                {
+                    if (slot != nullptr)
+                        compositor->discard(slot);
+
+                    trace("Exiting scene early.");
+                    early_exit = true;
+                    break;
+                }
+
+                slot->profile = &scene_profile;
+                compositor->submit(slot);
+                Clock::frame_presented();
+                continue;
+            }
+
+            const auto should_continue = render_profiled(*scene, composite_offscreen_canvas, scene_profile);
 
             if (!should_continue || interrupt_received || exit_canvas_update)
             {
@@ -290,14 +422,17 @@ void update_canvas(RGBMatrixBase *matrix, FrameCanvas *&first_offscreen_canvas,
 
             if (Constants::global_post_processor)
             {
+                const auto post_start = FrameProfiler::clock::now();
                 Constants::global_post_processor->apply_effects(composite_offscreen_canvas);
+                scene_profile.post_processing.record(FrameProfiler::since(post_start));
             }
 
-            composite_offscreen_canvas = matrix->SwapOnVSync(composite_offscreen_canvas, 1);
+            composite_offscreen_canvas = swap_profiled(matrix, composite_offscreen_canvas, scene_profile);
 
 #ifdef ENABLE_EMULATOR
             ((rgb_matrix::EmulatorMatrix *)matrix)->Render();
 #endif
+            Clock::frame_presented();
         }
 
         // Phase 2: cross-fade to next scene
@@ -305,63 +440,85 @@ void update_canvas(RGBMatrixBase *matrix, FrameCanvas *&first_offscreen_canvas,
         {
             scene->before_transition_stop();
 
-            tmillis_t transition_start_ms = GetTimeInMillis();
-            tmillis_t last_current_render_ms = transition_start_ms;
-            tmillis_t last_next_render_ms = transition_start_ms;
-
-            auto current_continue = scene->render(first_offscreen_canvas);
-            auto next_continue = next_scene->render(second_offscreen_canvas);
+            auto &next_scene_profile = FrameProfiler::instance().get(next_scene->get_name());
+            const tmillis_t transition_start_ms = Clock::wall_millis();
+            bool current_continue = true;
+            bool next_continue = true;
 
             while (true)
             {
-                const auto now_ms = GetTimeInMillis();
+                const auto now_ms = Clock::wall_millis();
                 const auto elapsed_transition = now_ms - transition_start_ms;
                 const auto alpha_progress = std::clamp(
                     static_cast<float>(elapsed_transition) / static_cast<float>(std::max<tmillis_t>(1, transition_duration)),
                     0.0f,
                     1.0f);
 
-                const auto current_visibility = 1.0f - alpha_progress;
-                const auto next_visibility = alpha_progress;
+                // Both scenes render concurrently: the outgoing one on the worker, the incoming one here.
+                outgoing_renderer.start([&]()
+                                        {
+                    const bool keep_going = render_profiled(*scene, first_offscreen_canvas, scene_profile);
+                    from_frame.read_from(first_offscreen_canvas);
+                    return keep_going; });
 
-                const auto current_render_interval_ms = render_interval_ms_from_visibility(current_visibility);
-                const auto next_render_interval_ms = render_interval_ms_from_visibility(next_visibility);
+                next_continue = render_profiled(*next_scene, second_offscreen_canvas, next_scene_profile);
+                to_frame.read_from(second_offscreen_canvas);
 
-                if ((now_ms - last_current_render_ms) >= current_render_interval_ms)
-                {
-                    current_continue = scene->render(first_offscreen_canvas);
-                    last_current_render_ms = now_ms;
-                }
-
-                if ((now_ms - last_next_render_ms) >= next_render_interval_ms)
-                {
-                    next_continue = next_scene->render(second_offscreen_canvas);
-                    last_next_render_ms = now_ms;
-                }
+                // Barrier: both frames have to be complete before they are blended.
+                current_continue = outgoing_renderer.wait();
 
                 if (!current_continue || !next_continue || interrupt_received || exit_canvas_update)
                 {
                     trace("Exiting scene early.");
                     break;
                 }
-                apply_transition_frame(composite_offscreen_canvas,
-                                       first_offscreen_canvas,
-                                       second_offscreen_canvas,
+
+                if (compositor != nullptr)
+                {
+                    // Hand both frames to the compositor, it does the blend at its own rate.
+                    auto *slot = compositor->acquire();
+                    if (slot == nullptr)
+                        break;
+
+                    slot->is_transition = true;
+                    slot->from = from_frame;
+                    slot->to = to_frame;
+                    slot->alpha = alpha_progress;
+                    slot->transition_name = transition_name;
+                    slot->profile = &scene_profile;
+                    compositor->submit(slot);
+                    Clock::frame_presented();
+
+                    if (alpha_progress >= 1.0f)
+                    {
+                        forced_scene = next_scene;
+                        break;
+                    }
+                    continue;
+                }
+
+                const auto transition_start = FrameProfiler::clock::now();
+                apply_transition_frame(blended_frame,
+                                       from_frame,
+                                       to_frame,
                                        alpha_progress,
-                                       matrix_width,
-                                       matrix_height,
                                        transition_name);
+                scene_profile.transition.record(FrameProfiler::since(transition_start));
 
                 if (Constants::global_post_processor)
                 {
-                    Constants::global_post_processor->apply_effects(composite_offscreen_canvas);
+                    const auto post_start = FrameProfiler::clock::now();
+                    Constants::global_post_processor->apply_effects(blended_frame);
+                    scene_profile.post_processing.record(FrameProfiler::since(post_start));
                 }
 
-                composite_offscreen_canvas = matrix->SwapOnVSync(composite_offscreen_canvas, 1);
+                blended_frame.write_to(composite_offscreen_canvas);
+                composite_offscreen_canvas = swap_profiled(matrix, composite_offscreen_canvas, scene_profile);
 
 #ifdef ENABLE_EMULATOR
                 ((rgb_matrix::EmulatorMatrix *)matrix)->Render();
 #endif
+                Clock::frame_presented();
 
                 if (alpha_progress >= 1.0f)
                 {
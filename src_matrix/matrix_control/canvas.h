@@ -7,6 +7,7 @@
 #include "shared/matrix/utils/utils.h"
 #include "shared/matrix/Scene.h"
 #include "shared/matrix/utils/canvas_image.h"
+#include "shared/matrix/canvas_buffer.h"
 #include <vector>
 
 using rgb_matrix::Canvas;
@@ -14,6 +15,11 @@ using rgb_matrix::FrameCanvas;
 using rgb_matrix::RGBMatrixBase;
 using rgb_matrix::StreamReader;
 
-// Global post-processor instance
+class Compositor;
 
-void update_canvas(RGBMatrixBase * matrix, FrameCanvas *&first_offscreen_canvas, FrameCanvas *&second_offscreen_canvas,  FrameCanvas *&composite_offscreen_canvas, std::shared_ptr<Scenes::Scene> &forced_scene, std::shared_ptr<Scenes::Scene> pinned_scene = nullptr);
+// Blends 'from' and 'to' with the named transition (falls back to "blend", then to a hard cut)
+void apply_transition_frame(CanvasBuffer &dst, const CanvasBuffer &from, const CanvasBuffer &to, float alpha_progress, const std::string &transition_name);
+
+// Renders scenes until exit_canvas_update is set. If 'compositor' is given, frames are submitted
+// to it instead of being swapped to the panel directly (pipelined mode).
+void update_canvas(RGBMatrixBase * matrix, FrameCanvas *&first_offscreen_canvas, FrameCanvas *&second_offscreen_canvas,  FrameCanvas *&composite_offscreen_canvas, std::shared_ptr<Scenes::Scene> &forced_scene, std::shared_ptr<Scenes::Scene> pinned_scene = nullptr, Compositor *compositor = nullptr);
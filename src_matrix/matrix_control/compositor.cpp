@@ -0,0 +1,310 @@
+#include "compositor.h"
+#include "canvas.h"
+#include "shared/matrix/canvas_consts.h"
+#include "shared/matrix/interrupt.h"
+#include "shared/matrix/utils/shared.h"
+#include "shared/common/utils/env.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <utility>
+
+#ifdef ENABLE_EMULATOR
+#include "emulator.h"
+#endif
+
+std::mutex Compositor::active_mutex;
+Compositor *Compositor::active = nullptr;
+
+std::optional<CompositorSettings> CompositorSettings::from_env()
+{
+    const char *enabled = std::getenv("MATRIX_PIPELINE");
+    if (enabled == nullptr)
+        return std::nullopt;
+
+    const std::string value = enabled;
+    if (value != "1" && value != "true")
+        return std::nullopt;
+
+    CompositorSettings settings;
+    settings.depth = static_cast<size_t>(env_int("MATRIX_PIPELINE_DEPTH", 3, 2, 8));
+    settings.target_fps = env_int("MATRIX_COMPOSITOR_FPS", 60, 1, 240);
+    return settings;
+}
+
+Compositor::Compositor(RGBMatrixBase *matrix, const CompositorSettings &settings)
+    : matrix(matrix), target_fps(settings.target_fps), slots(settings.depth)
+{
+    for (auto &slot : slots)
+    {
+        slot.canvas = matrix->CreateFrameCanvas();
+    }
+
+    frame_canvas = matrix->CreateFrameCanvas();
+    display_canvas = matrix->CreateFrameCanvas();
+}
+
+Compositor::~Compositor()
+{
+    {
+        // Waits for an active_stats() call that is still reading this compositor
+        std::lock_guard lock(active_mutex);
+        if (active == this)
+            active = nullptr;
+    }
+
+    stop();
+}
+
+Compositor::Slot *Compositor::acquire()
+{
+    std::unique_lock lock(slots_mutex);
+    while (true)
+    {
+        if (stopping || interrupt_received || exit_canvas_update)
+            return nullptr;
+
+        for (auto &slot : slots)
+        {
+            if (slot.state == Slot::State::Free)
+            {
+                slot.state = Slot::State::Writing;
+                slot.is_transition = false;
+                slot.profile = nullptr;
+                return &slot;
+            }
+        }
+
+        // Ring is full, wait for the compositor to consume a frame
+        slot_freed.wait_for(lock, std::chrono::milliseconds(50));
+    }
+}
+
+void Compositor::submit(Slot *slot)
+{
+    std::lock_guard lock(slots_mutex);
+    slot->state = Slot::State::Ready;
+    slot->sequence = next_sequence++;
+    frames_submitted.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Compositor::discard(Slot *slot)
+{
+    release(slot);
+}
+
+void Compositor::clear_display()
+{
+    clear_requested.store(true);
+}
+
+void Compositor::stop()
+{
+    {
+        std::lock_guard lock(slots_mutex);
+        stopping.store(true);
+    }
+    slot_freed.notify_all();
+}
+
+Compositor::Slot *Compositor::take_newest_ready()
+{
+    Slot *newest = nullptr;
+    bool freed = false;
+    {
+        std::lock_guard lock(slots_mutex);
+        for (auto &slot : slots)
+        {
+            if (slot.state != Slot::State::Ready)
+                continue;
+
+            if (newest == nullptr || slot.sequence > newest->sequence)
+            {
+                if (newest != nullptr)
+                {
+                    newest->state = Slot::State::Free;
+                    frames_dropped.fetch_add(1, std::memory_order_relaxed);
+                    freed = true;
+                }
+                newest = &slot;
+            }
+            else
+            {
+                slot.state = Slot::State::Free;
+                frames_dropped.fetch_add(1, std::memory_order_relaxed);
+                freed = true;
+            }
+        }
+
+        if (newest != nullptr)
+            newest->state = Slot::State::Presenting;
+    }
+
+    if (freed)
+        slot_freed.notify_all();
+
+    return newest;
+}
+
+void Compositor::release(Slot *slot)
+{
+    {
+        std::lock_guard lock(slots_mutex);
+        slot->state = Slot::State::Free;
+    }
+    slot_freed.notify_all();
+}
+
+void Compositor::compose(Slot &slot)
+{
+    current_profile = slot.profile;
+
+    if (slot.is_transition)
+    {
+        const auto transition_start = FrameProfiler::clock::now();
+        apply_transition_frame(composed, slot.from, slot.to, slot.alpha, slot.transition_name);
+        if (current_profile != nullptr)
+            current_profile->transition.record(FrameProfiler::since(transition_start));
+
+        composed.write_to(frame_canvas);
+        composed_valid = true;
+    }
+    else
+    {
+        // Take over the rendered canvas and hand the previous frame back to the ring,
+        // the same way SwapOnVSync() hands back the old front buffer.
+        std::swap(frame_canvas, slot.canvas);
+        composed_valid = false;
+    }
+
+    has_frame = true;
+}
+
+void Compositor::present(bool has_new_frame)
+{
+    if (clear_requested.exchange(false))
+    {
+        display_canvas->Clear();
+        display_canvas = matrix->SwapOnVSync(display_canvas, 1);
+        has_frame = false;
+        composed_valid = false;
+#ifdef ENABLE_EMULATOR
+        ((rgb_matrix::EmulatorMatrix *)matrix)->Render();
+#endif
+        return;
+    }
+
+    if (!has_frame)
+        return;
+
+    auto *post_processor = Constants::global_post_processor;
+    const bool has_effects = post_processor != nullptr && post_processor->has_active_effects();
+
+    if (!has_new_frame && !has_effects)
+    {
+        // Nothing changed, the panel keeps showing the previous frame.
+        frames_repeated.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if (has_effects)
+    {
+        if (!composed_valid)
+        {
+            composed.read_from(frame_canvas);
+            composed_valid = true;
+        }
+
+        // Effects run on a copy so a repeated frame can be re-processed with the next effect progress.
+        output = composed;
+        const auto post_start = FrameProfiler::clock::now();
+        post_processor->apply_effects(output);
+        if (current_profile != nullptr)
+            current_profile->post_processing.record(FrameProfiler::since(post_start));
+        output.write_to(display_canvas);
+    }
+    else
+    {
+        display_canvas->CopyFrom(*frame_canvas);
+    }
+
+    const auto swap_start = FrameProfiler::clock::now();
+    display_canvas = matrix->SwapOnVSync(display_canvas, 1);
+    if (current_profile != nullptr)
+        current_profile->swap_wait.record(FrameProfiler::since(swap_start));
+
+    frames_presented.fetch_add(1, std::memory_order_relaxed);
+    if (!has_new_frame)
+        frames_repeated.fetch_add(1, std::memory_order_relaxed);
+
+#ifdef ENABLE_EMULATOR
+    ((rgb_matrix::EmulatorMatrix *)matrix)->Render();
+#endif
+}
+
+void Compositor::run()
+{
+    using clock = std::chrono::steady_clock;
+
+    {
+        std::lock_guard lock(active_mutex);
+        active = this;
+    }
+    spdlog::info("Compositor running at {} fps with {} frames in flight", target_fps, slots.size());
+
+    const auto period = std::chrono::duration_cast<clock::duration>(std::chrono::nanoseconds(1'000'000'000 / target_fps));
+    auto next_tick = clock::now();
+
+    while (!stopping && !interrupt_received)
+    {
+        Slot *slot = take_newest_ready();
+        if (slot != nullptr)
+        {
+            compose(*slot);
+            release(slot);
+        }
+
+        present(slot != nullptr);
+
+        next_tick += period;
+        const auto now = clock::now();
+        if (next_tick < now)
+        {
+            // Fell behind (slow swap or blend), don't try to catch up with a burst of frames.
+            next_tick = now;
+            continue;
+        }
+
+        std::this_thread::sleep_until(next_tick);
+    }
+
+    stop();
+}
+
+CompositorStats Compositor::get_stats() const
+{
+    CompositorStats stats;
+    stats.depth = slots.size();
+    stats.target_fps = target_fps;
+    stats.frames_submitted = frames_submitted.load(std::memory_order_relaxed);
+    stats.frames_presented = frames_presented.load(std::memory_order_relaxed);
+    stats.frames_dropped = frames_dropped.load(std::memory_order_relaxed);
+    stats.frames_repeated = frames_repeated.load(std::memory_order_relaxed);
+
+    std::lock_guard lock(slots_mutex);
+    stats.queued = std::count_if(slots.begin(), slots.end(), [](const Slot &slot)
+                                 { return slot.state == Slot::State::Ready; });
+    return stats;
+}
+
+std::optional<CompositorStats> Compositor::active_stats()
+{
+    // Held while reading so the compositor can't be destroyed underneath
+    std::lock_guard lock(active_mutex);
+    if (active == nullptr)
+        return std::nullopt;
+
+    return active->get_stats();
+}
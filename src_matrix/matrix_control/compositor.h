@@ -0,0 +1,149 @@
+#pragma once
+
+#include "led-matrix.h"
+#include "shared/matrix/canvas_buffer.h"
+#include "shared/matrix/utils/FrameProfiler.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+using rgb_matrix::FrameCanvas;
+using rgb_matrix::RGBMatrixBase;
+
+/// Settings for the pipelined render mode, read from the environment:
+///   MATRIX_PIPELINE=1          enables the compositor thread
+///   MATRIX_PIPELINE_DEPTH=3    number of offscreen frames in the ring (2-8)
+///   MATRIX_COMPOSITOR_FPS=60   fixed rate at which frames are swapped to the panel
+struct CompositorSettings
+{
+    size_t depth = 3;
+    int target_fps = 60;
+
+    /// Returns std::nullopt if the pipelined mode is disabled.
+    static std::optional<CompositorSettings> from_env();
+};
+
+struct CompositorStats
+{
+    size_t depth = 0;
+    size_t queued = 0;
+    int target_fps = 0;
+    uint64_t frames_submitted = 0;
+    uint64_t frames_presented = 0;
+    uint64_t frames_dropped = 0;
+    uint64_t frames_repeated = 0;
+};
+
+/// Decouples scene rendering from the display swap.
+/// The producer (the scene loop in update_canvas) renders into a ring of
+/// offscreen FrameCanvas buffers and submits them. The compositor thread runs at
+/// a fixed rate, picks the newest submitted frame, does the transition blend and
+/// post-processing and swaps it to the panel. Stale frames are dropped, and if
+/// nothing new arrived in time the previous frame is kept (repeated).
+class Compositor
+{
+public:
+    struct Slot
+    {
+        /// Scene frames are rendered straight into this canvas.
+        FrameCanvas *canvas = nullptr;
+
+        /// Transition frames only carry both scene frames, the compositor blends them.
+        bool is_transition = false;
+        CanvasBuffer from;
+        CanvasBuffer to;
+        float alpha = 0.0f;
+        std::string transition_name;
+
+        /// Profile of the scene that produced the frame, compositor timings are recorded there.
+        SceneProfile *profile = nullptr;
+
+    private:
+        friend class Compositor;
+        enum class State
+        {
+            Free,
+            Writing,
+            Ready,
+            Presenting
+        };
+
+        State state = State::Free;
+        uint64_t sequence = 0;
+    };
+
+    Compositor(RGBMatrixBase *matrix, const CompositorSettings &settings);
+    ~Compositor();
+
+    Compositor(const Compositor &) = delete;
+    Compositor &operator=(const Compositor &) = delete;
+
+    // ─── Producer side ───
+
+    /// Returns a free slot to render into. Blocks while the ring is full and
+    /// returns nullptr if the compositor stops or the current scene should exit.
+    Slot *acquire();
+
+    /// Hands a rendered slot over to the compositor.
+    void submit(Slot *slot);
+
+    /// Returns an acquired slot without presenting it.
+    void discard(Slot *slot);
+
+    /// Blanks the panel on the next tick (used while the matrix is turned off).
+    void clear_display();
+
+    // ─── Compositor side ───
+
+    /// Runs the compositor loop on the calling thread until stop() is called or
+    /// an interrupt is received.
+    void run();
+
+    void stop();
+
+    [[nodiscard]] CompositorStats get_stats() const;
+
+    /// Snapshot of the stats of the compositor that is currently running, if the
+    /// pipelined mode is enabled. Safe to call while the compositor is destroyed.
+    static std::optional<CompositorStats> active_stats();
+
+private:
+    Slot *take_newest_ready();
+    void release(Slot *slot);
+    void compose(Slot &slot);
+    void present(bool has_new_frame);
+
+    RGBMatrixBase *matrix;
+    const int target_fps;
+
+    std::vector<Slot> slots;
+    mutable std::mutex slots_mutex;
+    std::condition_variable slot_freed;
+    uint64_t next_sequence = 0;
+
+    /// Last composed frame (before post-processing). Repeated frames are re-presented from here.
+    FrameCanvas *frame_canvas;
+    FrameCanvas *display_canvas;
+    CanvasBuffer composed;
+    CanvasBuffer output;
+    bool composed_valid = false;
+    bool has_frame = false;
+    SceneProfile *current_profile = nullptr;
+
+    std::atomic<bool> stopping{false};
+    std::atomic<bool> clear_requested{false};
+
+    std::atomic<uint64_t> frames_submitted{0};
+    std::atomic<uint64_t> frames_presented{0};
+    std::atomic<uint64_t> frames_dropped{0};
+    std::atomic<uint64_t> frames_repeated{0};
+
+    /// Guards 'active'. The destructor unregisters under it, so active_stats()
+    /// never reads a compositor that is being destroyed.
+    static std::mutex active_mutex;
+    static Compositor *active;
+};
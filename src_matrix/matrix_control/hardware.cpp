@@ -2,12 +2,14 @@
 
 #include "led-matrix.h"
 #include "canvas.h"
+#include "compositor.h"
 #include "shared/matrix/interrupt.h"
 #include "shared/matrix/utils/shared.h"
 #include "shared/matrix/canvas_consts.h"
 
 #include <csignal>
 #include <chrono>
+#include <thread>
 #include "spdlog/spdlog.h"
 
 using namespace rgb_matrix;
@@ -23,38 +25,69 @@ void hardware_mainloop(rgb_matrix::RGBMatrixBase *matrix, std::shared_ptr<Scenes
     string last_scheduled_preset = "";
     std::shared_ptr<Scenes::Scene> forced_scene = nullptr;
 
-    while (!interrupt_received)
+    const auto compositor_settings = CompositorSettings::from_env();
+    std::unique_ptr<Compositor> compositor;
+    if (compositor_settings.has_value())
     {
-        // Check for active scheduled preset
-        if (config->is_scheduling_enabled())
+        compositor = std::make_unique<Compositor>(matrix, compositor_settings.value());
+    }
+
+    auto scene_loop = [&]()
+    {
+        while (!interrupt_received)
         {
-            auto active_preset = config->get_active_scheduled_preset();
-            if (active_preset.has_value() && active_preset.value() != last_scheduled_preset)
+            // Check for active scheduled preset
+            if (config->is_scheduling_enabled())
             {
-                debug("Switching to scheduled preset: {}", active_preset.value());
-                config->set_curr(active_preset.value());
-                last_scheduled_preset = active_preset.value();
-                config->set_turned_off(false);
+                auto active_preset = config->get_active_scheduled_preset();
+                if (active_preset.has_value() && active_preset.value() != last_scheduled_preset)
+                {
+                    debug("Switching to scheduled preset: {}", active_preset.value());
+                    config->set_curr(active_preset.value());
+                    last_scheduled_preset = active_preset.value();
+                    config->set_turned_off(false);
+                }
+                else if (!active_preset.has_value() && !last_scheduled_preset.empty())
+                {
+
+                    debug("No active schedule, clearing scheduled preset and turning off canvas");
+                    last_scheduled_preset = "";
+                    config->set_turned_off(true);
+                }
             }
-            else if (!active_preset.has_value() && !last_scheduled_preset.empty())
-            {
 
-                debug("No active schedule, clearing scheduled preset and turning off canvas");
-                last_scheduled_preset = "";
-                config->set_turned_off(true);
+            if (!config->is_turned_off())
+            {
+                update_canvas(matrix, first_offscreen_canvas, second_offscreen_canvas, composite_offscreen_Canvas, forced_scene, pinned_scene, compositor.get());
+                exit_canvas_update = false;
+                debug("Outer loop iteration, checking again...");
+                continue;
             }
-        }
 
-        if (!config->is_turned_off())
-        {
-            update_canvas(matrix, first_offscreen_canvas, second_offscreen_canvas, composite_offscreen_Canvas, forced_scene, pinned_scene);
-            exit_canvas_update = false;
-            debug("Outer loop iteration, checking again...");
-            continue;
+            if (compositor)
+                compositor->clear_display();
+            else
+                matrix->Clear();
+            SleepMillis(1000);
         }
+    };
+
+    if (compositor)
+    {
+        // Pipelined mode: scenes render on a producer thread, this thread presents the frames
+        // (so the emulator window is still drawn from the thread that created it).
+        std::thread producer([&]()
+                             {
+            scene_loop();
+            compositor->stop(); });
 
-        matrix->Clear();
-        SleepMillis(1000);
+        compositor->run();
+        producer.join();
+        compositor.reset();
+    }
+    else
+    {
+        scene_loop();
     }
 
     // Cleanup post-processor
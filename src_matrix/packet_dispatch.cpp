@@ -0,0 +1,61 @@
+#include "packet_dispatch.h"
+#include <array>
+#include <mutex>
+#include <spdlog/spdlog.h>
+#include <shared/matrix/plugin_loader/loader.h>
+
+namespace
+{
+    constexpr size_t header_size = 7;
+
+    /// One per plugin id, shared by the UDP and the shared-memory dispatcher
+    std::array<std::mutex, 256> plugin_mutexes;
+}
+
+void PacketDispatcher::dispatch(const uint8_t *buffer, size_t size, const std::vector<Plugins::BasicPlugin *> &plugins)
+{
+    size_t offset = 0;
+    while (size - offset >= header_size)
+    {
+        const uint8_t *data = buffer + offset;
+
+        // Check magic number (2 bytes: 0xAD, 0x01)
+        if (data[0] != 0xAD || data[1] != 0x01)
+        {
+            // Invalid packet, skip one byte and try again
+            offset += 1;
+            continue;
+        }
+
+        const uint8_t pluginId = data[2];
+
+        // Parse payload size (4 bytes, network byte order)
+        const uint32_t payload_size = (static_cast<uint32_t>(data[3]) << 24) |
+                                      (static_cast<uint32_t>(data[4]) << 16) |
+                                      (static_cast<uint32_t>(data[5]) << 8) |
+                                      (static_cast<uint32_t>(data[6]));
+
+        if (size - offset - header_size < payload_size)
+        {
+            if (truncated_packets++ < 10)
+                spdlog::warn("Dropping truncated {} packet for plugin {} ({} of {} bytes)", transport, pluginId,
+                             size - offset - header_size, payload_size);
+            return;
+        }
+
+        const uint8_t *payload = data + header_size;
+
+        // Pass to plugins (note: using data[1] as magicPacket for backward compatibility)
+        std::lock_guard lock(plugin_mutexes[pluginId]);
+        for (const auto &plugin : plugins)
+        {
+            if (plugin->on_udp_packet(pluginId, payload, payload_size))
+            {
+                // Packet was handled by the plugin
+                break;
+            }
+        }
+
+        offset += header_size + payload_size;
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Plugins {
+    class BasicPlugin;
+}
+
+/// Parses buffers holding one or more complete packets (0xAD 0x01, plugin id,
+/// u32 size, payload) and hands each payload to the first plugin that accepts
+/// it. Shared by the UDP and the shared-memory transport.
+///
+/// Each transport dispatches on its own thread, but plugins treat their receive
+/// state (FrameStreamReceiver, FrameTripleBuffer) as single-writer. Dispatch is
+/// therefore serialized per plugin id across all dispatchers: on_udp_packet() for
+/// one id never runs on two transport threads at once.
+class PacketDispatcher {
+    public:
+        /// 'transport' is only used in log messages.
+        explicit PacketDispatcher(const char *transport) : transport(transport) {}
+
+        /// Dispatches all packets in 'buffer'. The payloads are passed in place.
+        void dispatch(const uint8_t *buffer, size_t size, const std::vector<Plugins::BasicPlugin *> &plugins);
+
+    private:
+        const char *transport;
+        size_t truncated_packets = 0;
+};
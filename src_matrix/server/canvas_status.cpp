@@ -1,6 +1,8 @@
 #include "canvas_status.h"
 #include "shared/matrix/utils/shared.h"
 #include "shared/matrix/server/server_utils.h"
+#include "matrix_control/compositor.h"
+#include "shared/matrix/utils/FrameProfiler.h"
 #include <spdlog/spdlog.h>
 
 
@@ -39,5 +41,69 @@ std::unique_ptr<Server::router_t> Server::add_canvas_status_routes(std::unique_p
         );
     });
 
+    router->http_get("/profiler", [](auto req, auto) {
+        const auto to_json = [](const LatencyHistogram &histogram) {
+            const auto snapshot = histogram.snapshot();
+            return json{
+                {"count", snapshot.count},
+                {"p50_ms", snapshot.p50_seconds * 1000.0},
+                {"p95_ms", snapshot.p95_seconds * 1000.0},
+                {"p99_ms", snapshot.p99_seconds * 1000.0},
+                {"max_ms", snapshot.max_seconds * 1000.0},
+                {"total_ms", snapshot.sum_seconds * 1000.0}
+            };
+        };
+
+        json scenes = json::object();
+        for (const auto &[name, profile] : FrameProfiler::instance().profiles()) {
+            scenes[name] = {
+                {"render", to_json(profile->render)},
+                {"post_processing", to_json(profile->post_processing)},
+                {"transition", to_json(profile->transition)},
+                {"swap_wait", to_json(profile->swap_wait)}
+            };
+        }
+
+        json metrics = json::object();
+        for (const auto &[name, help, histogram] : FrameProfiler::instance().histograms()) {
+            metrics[name] = to_json(*histogram);
+        }
+
+        return reply_with_json(req, {{"scenes", scenes}, {"metrics", metrics}});
+    });
+
+    router->http_post("/profiler/reset", [](auto req, auto) {
+        FrameProfiler::instance().reset();
+        return reply_success(req);
+    });
+
+    router->http_get("/metrics", [](auto req, auto) {
+        auto response = req->create_response()
+                .append_header_date_field()
+                .append_header(restinio::http_field::content_type, "text/plain; version=0.0.4; charset=utf-8");
+        Server::add_cors_headers(response);
+
+        return response.set_body(FrameProfiler::instance().to_prometheus()).done();
+    });
+
+    router->http_get("/compositor", [](auto req, auto) {
+        const auto stats = Compositor::active_stats();
+        if (!stats.has_value()) {
+            return reply_with_json(req, {{"enabled", false}});
+        }
+
+        return reply_with_json(req, {
+                                   {"enabled", true},
+                                   {"depth", stats->depth},
+                                   {"queued", stats->queued},
+                                   {"target_fps", stats->target_fps},
+                                   {"submitted", stats->frames_submitted},
+                                   {"presented", stats->frames_presented},
+                                   {"dropped", stats->frames_dropped},
+                                   {"repeated", stats->frames_repeated}
+                               }
+        );
+    });
+
     return std::move(router);
 }
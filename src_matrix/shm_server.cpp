@@ -0,0 +1,261 @@
+#include "shm_server.h"
+#include <array>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <spdlog/spdlog.h>
+#include <shared/common/udp/shm_ring.h>
+#include <shared/common/utils/env.h>
+#include <shared/matrix/plugin_loader/loader.h>
+
+std::optional<ShmServerSettings> ShmServerSettings::from_env()
+{
+    if (const char *enabled = std::getenv("MATRIX_SHM_TRANSPORT"))
+    {
+        const std::string value = enabled;
+        if (value == "0" || value == "false")
+            return std::nullopt;
+    }
+
+    ShmServerSettings settings;
+    const int default_megabytes = static_cast<int>(ShmTransport::default_capacity / (1024 * 1024));
+    settings.capacity = static_cast<size_t>(env_int("MATRIX_SHM_RING_MB", default_megabytes, 1, 64)) * 1024 * 1024;
+    return settings;
+}
+
+ShmServer::ShmServer(uint16_t port, const ShmServerSettings &settings) : capacity(settings.capacity)
+{
+    listen_fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0)
+    {
+        spdlog::error("Failed to create shared memory transport socket: {}", strerror(errno));
+        return;
+    }
+
+    // Abstract socket: no file to clean up, gone when the matrix exits
+    const std::string name = ShmTransport::socket_name(port);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path + 1, name.data(), name.size());
+    const auto addr_len = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + 1 + name.size());
+
+    if (bind(listen_fd, reinterpret_cast<sockaddr *>(&addr), addr_len) < 0 || listen(listen_fd, 1) < 0)
+    {
+        spdlog::error("Failed to listen on shared memory transport socket: {}", strerror(errno));
+        close_all();
+        return;
+    }
+
+    stop_event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (stop_event_fd < 0 || epoll_fd < 0)
+    {
+        spdlog::error("Failed to create epoll instance: {}", strerror(errno));
+        close_all();
+        return;
+    }
+
+    for (const int fd : {listen_fd, stop_event_fd})
+    {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+    }
+
+    server_thread = std::thread(&ShmServer::server_loop, this);
+    spdlog::info("Shared memory transport listening on @{}", name);
+}
+
+ShmServer::~ShmServer()
+{
+    if (stop_event_fd >= 0)
+    {
+        const uint64_t value = 1;
+        if (write(stop_event_fd, &value, sizeof(value)) < 0)
+            spdlog::error("Failed to signal shared memory transport shutdown: {}", strerror(errno));
+    }
+
+    if (server_thread.joinable())
+        server_thread.join();
+
+    close_client();
+    close_all();
+}
+
+void ShmServer::close_all()
+{
+    for (int *fd : {&listen_fd, &epoll_fd, &stop_event_fd})
+    {
+        if (*fd >= 0)
+        {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+void ShmServer::close_client()
+{
+    for (const int fd : {client_fd, data_event_fd})
+    {
+        if (fd >= 0 && epoll_fd >= 0)
+            epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    }
+
+    for (int *fd : {&client_fd, &memfd, &data_event_fd})
+    {
+        if (*fd >= 0)
+        {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+
+    reader.reset();
+    if (mapping != nullptr)
+    {
+        munmap(mapping, mapping_size);
+        mapping = nullptr;
+        mapping_size = 0;
+    }
+}
+
+void ShmServer::accept_client()
+{
+    const int fd = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd < 0)
+    {
+        spdlog::warn("Failed to accept shared memory transport client: {}", strerror(errno));
+        return;
+    }
+
+    // The abstract socket is open to every local user, only take clients running as the
+    // matrix's user (or root) before they can replace the current one
+    ucred peer{};
+    socklen_t peer_len = sizeof(peer);
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &peer, &peer_len) < 0 || (peer.uid != geteuid() && peer.uid != 0))
+    {
+        spdlog::warn("Rejected shared memory transport client (uid {}, pid {})", peer.uid, peer.pid);
+        close(fd);
+        return;
+    }
+
+    // Only one desktop app streams at a time, the newest one wins
+    close_client();
+    client_fd = fd;
+
+    mapping_size = ShmTransport::data_offset + capacity;
+    memfd = memfd_create("led-matrix-frames", MFD_CLOEXEC);
+    data_event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (memfd < 0 || data_event_fd < 0 || ftruncate(memfd, static_cast<off_t>(mapping_size)) < 0)
+    {
+        spdlog::error("Failed to create shared memory ring: {}", strerror(errno));
+        close_client();
+        return;
+    }
+
+    mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        mapping = nullptr;
+        spdlog::error("Failed to map shared memory ring: {}", strerror(errno));
+        close_client();
+        return;
+    }
+    ShmTransport::init_ring(mapping, mapping_size);
+    // The reader keeps its own copy of the ring geometry, the mapping is writable by the client
+    reader.emplace(mapping);
+
+    // Hand the ring and the eventfd to the client
+    ShmTransport::Hello hello{ShmTransport::ring_magic, ShmTransport::ring_version, mapping_size};
+    iovec iov{&hello, sizeof(hello)};
+
+    union
+    {
+        cmsghdr header;
+        uint8_t bytes[CMSG_SPACE(2 * sizeof(int))];
+    } control{};
+
+    msghdr message{};
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control.bytes;
+    message.msg_controllen = sizeof(control.bytes);
+
+    cmsghdr *cmsg = CMSG_FIRSTHDR(&message);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(2 * sizeof(int));
+    const int fds[2] = {memfd, data_event_fd};
+    std::memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    if (sendmsg(client_fd, &message, MSG_NOSIGNAL) < 0)
+    {
+        spdlog::warn("Failed to send shared memory ring to client: {}", strerror(errno));
+        close_client();
+        return;
+    }
+
+    for (const int watched : {client_fd, data_event_fd})
+    {
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = watched;
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, watched, &event);
+    }
+
+    spdlog::info("Desktop app connected over shared memory ({} MB ring)", capacity / (1024 * 1024));
+}
+
+void ShmServer::server_loop()
+{
+    auto plugins = Plugins::PluginManager::instance()->get_plugins();
+
+    std::array<epoll_event, 4> events{};
+    while (true)
+    {
+        const int ready = epoll_wait(epoll_fd, events.data(), events.size(), -1);
+        if (ready < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            spdlog::error("Shared memory transport epoll_wait error: {}", strerror(errno));
+            return;
+        }
+
+        for (int i = 0; i < ready; ++i)
+        {
+            const int fd = events[i].data.fd;
+            if (fd == stop_event_fd)
+                return;
+
+            if (fd == listen_fd)
+            {
+                accept_client();
+            }
+            else if (fd == client_fd)
+            {
+                // The client never sends anything, so readable means it went away
+                spdlog::info("Desktop app disconnected from shared memory transport");
+                close_client();
+            }
+            else if (fd == data_event_fd && reader.has_value())
+            {
+                uint64_t signals;
+                [[maybe_unused]] const auto result = read(data_event_fd, &signals, sizeof(signals));
+
+                reader->drain([&](const uint8_t *packet, size_t size)
+                              { dispatcher.dispatch(packet, size, plugins); });
+            }
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <shared/common/udp/shm_ring.h>
+#include "packet_dispatch.h"
+
+/// Shared-memory transport is on unless MATRIX_SHM_TRANSPORT is "0" or "false".
+/// MATRIX_SHM_RING_MB (1-64, default 4) sets the ring size per client.
+struct ShmServerSettings
+{
+    size_t capacity = 0;
+
+    static std::optional<ShmServerSettings> from_env();
+};
+
+/// Matrix end of the shared-memory transport (see shared/common/udp/shm_ring.h).
+/// Listens on an abstract UNIX socket; every desktop app that connects gets a fresh
+/// memfd ring and eventfd, the previous client is dropped. Only processes of the
+/// matrix's own user (or root) are accepted, checked with SO_PEERCRED. Packets from the ring are
+/// dispatched to the plugins on the server thread. PacketDispatcher serializes this
+/// with the UDP thread per plugin id, so plugins still see a single writer.
+class ShmServer {
+    public:
+        /// Check is_open() afterwards, the server thread only runs if listening worked.
+        ShmServer(uint16_t port, const ShmServerSettings &settings);
+        ~ShmServer();
+
+        ShmServer(const ShmServer &) = delete;
+        ShmServer &operator=(const ShmServer &) = delete;
+
+        [[nodiscard]] bool is_open() const { return listen_fd >= 0; }
+
+    private:
+        void server_loop();
+        void accept_client();
+        void close_client();
+        void close_all();
+
+        size_t capacity;
+        PacketDispatcher dispatcher{"shared memory"};
+
+        int listen_fd = -1;
+        int epoll_fd = -1;
+        int stop_event_fd = -1;
+
+        // Current client
+        int client_fd = -1;
+        int memfd = -1;
+        int data_event_fd = -1;
+        void *mapping = nullptr;
+        size_t mapping_size = 0;
+        std::optional<ShmTransport::RingReader> reader;
+
+        std::thread server_thread;
+};
@@ -1,18 +1,24 @@
 #pragma once
 #include <thread>
-#include <arpa/inet.h>
+#include <vector>
+#include <cstdint>
+#include "packet_dispatch.h"
+#include "udp_receiver.h"
+
+class LatencyHistogram;
 
 class UdpServer {
     private:
         void server_loop();
 
+        UdpReceiver receiver;
+        PacketDispatcher dispatcher{"UDP"};
 
-        int udp_socket;
-        struct sockaddr_in server_addr;
-        bool server_running;
+        /// Time between the kernel receiving a datagram and the plugins being called
+        LatencyHistogram &queue_latency;
 
         std::thread udp_server_thread;
     public:
         UdpServer(int port);
         ~UdpServer();
-};
\ No newline at end of file
+};
@@ -0,0 +1,211 @@
+#include "udp_receiver.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <spdlog/spdlog.h>
+
+UdpReceiver::UdpReceiver(uint16_t port) : slabs(batch_size * slab_size)
+{
+    // Create UDP socket
+    udp_socket = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (udp_socket < 0)
+    {
+        spdlog::error("Failed to create UDP socket: {}", strerror(errno));
+        return;
+    }
+
+    // Set socket options for reuse
+    int reuse = 1;
+    if (setsockopt(udp_socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0)
+    {
+        spdlog::error("Failed to set socket options: {}", strerror(errno));
+        close_all();
+        return;
+    }
+
+    // Enlarge receive buffer to handle large video frames (128x128x3 + header = ~49KB)
+    int rcvbuf = 256 * 1024;
+    if (setsockopt(udp_socket, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf)) < 0)
+    {
+        spdlog::warn("Failed to set SO_RCVBUF: {}", strerror(errno));
+    }
+
+    // Kernel receive timestamps, used to measure how long datagrams wait before they are dispatched
+    int timestamps = 1;
+    if (setsockopt(udp_socket, SOL_SOCKET, SO_TIMESTAMPNS, &timestamps, sizeof(timestamps)) < 0)
+    {
+        spdlog::warn("Failed to enable SO_TIMESTAMPNS: {}", strerror(errno));
+    }
+
+    // Bind socket
+    sockaddr_in server_addr{};
+    server_addr.sin_family = AF_INET;
+    server_addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    server_addr.sin_port = htons(port);
+    if (bind(udp_socket, reinterpret_cast<sockaddr *>(&server_addr), sizeof(server_addr)) < 0)
+    {
+        spdlog::error("Failed to bind UDP socket: {}", strerror(errno));
+        close_all();
+        return;
+    }
+
+    socklen_t addr_len = sizeof(server_addr);
+    getsockname(udp_socket, reinterpret_cast<sockaddr *>(&server_addr), &addr_len);
+    bound_port = ntohs(server_addr.sin_port);
+
+    stop_event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (stop_event_fd < 0 || epoll_fd < 0)
+    {
+        spdlog::error("Failed to create epoll instance: {}", strerror(errno));
+        close_all();
+        return;
+    }
+
+    epoll_event socket_event{};
+    socket_event.events = EPOLLIN;
+    socket_event.data.fd = udp_socket;
+
+    epoll_event stop_event{};
+    stop_event.events = EPOLLIN;
+    stop_event.data.fd = stop_event_fd;
+
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, udp_socket, &socket_event) < 0 ||
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, stop_event_fd, &stop_event) < 0)
+    {
+        spdlog::error("Failed to register UDP socket with epoll: {}", strerror(errno));
+        close_all();
+        return;
+    }
+
+    // recvmmsg() bookkeeping is set up once and reused for every batch
+    for (size_t i = 0; i < batch_size; ++i)
+    {
+        iovecs[i].iov_base = slabs.data() + i * slab_size;
+        iovecs[i].iov_len = slab_size;
+    }
+}
+
+UdpReceiver::~UdpReceiver()
+{
+    close_all();
+}
+
+void UdpReceiver::close_all()
+{
+    for (int *fd : {&udp_socket, &epoll_fd, &stop_event_fd})
+    {
+        if (*fd >= 0)
+        {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+void UdpReceiver::stop()
+{
+    if (stop_event_fd < 0)
+        return;
+
+    const uint64_t value = 1;
+    if (write(stop_event_fd, &value, sizeof(value)) < 0)
+    {
+        spdlog::error("Failed to signal UDP receiver shutdown: {}", strerror(errno));
+    }
+}
+
+bool UdpReceiver::drain(const DatagramHandler &handler)
+{
+    while (true)
+    {
+        // msg_controllen and msg_flags are overwritten by the kernel, so reset them for every call
+        for (size_t i = 0; i < batch_size; ++i)
+        {
+            auto &header = messages[i].msg_hdr;
+            header = {};
+            header.msg_iov = &iovecs[i];
+            header.msg_iovlen = 1;
+            header.msg_control = control_buffers[i].bytes;
+            header.msg_controllen = sizeof(control_buffers[i].bytes);
+        }
+
+        const int received = recvmmsg(udp_socket, messages.data(), batch_size, MSG_DONTWAIT, nullptr);
+        if (received < 0)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                return true;
+            if (errno == EINTR)
+                continue;
+
+            spdlog::error("UDP recvmmsg error: {}", strerror(errno));
+            return false;
+        }
+
+        for (int i = 0; i < received; ++i)
+        {
+            auto &header = messages[i].msg_hdr;
+            if (header.msg_flags & MSG_TRUNC)
+            {
+                spdlog::warn("Dropping oversized UDP datagram");
+                continue;
+            }
+
+            timespec kernel_timestamp{};
+            for (cmsghdr *cmsg = CMSG_FIRSTHDR(&header); cmsg != nullptr; cmsg = CMSG_NXTHDR(&header, cmsg))
+            {
+                if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS)
+                {
+                    std::memcpy(&kernel_timestamp, CMSG_DATA(cmsg), sizeof(kernel_timestamp));
+                    break;
+                }
+            }
+
+            handler(static_cast<const uint8_t *>(iovecs[i].iov_base), messages[i].msg_len, kernel_timestamp);
+        }
+
+        // A partial batch means the socket queue is empty now
+        if (static_cast<size_t>(received) < batch_size)
+            return true;
+    }
+}
+
+void UdpReceiver::run(const DatagramHandler &handler)
+{
+    if (!is_open())
+        return;
+
+    std::array<epoll_event, 2> events{};
+    while (true)
+    {
+        const int ready = epoll_wait(epoll_fd, events.data(), events.size(), -1);
+        if (ready < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            spdlog::error("UDP epoll_wait error: {}", strerror(errno));
+            return;
+        }
+
+        bool readable = false;
+        for (int i = 0; i < ready; ++i)
+        {
+            if (events[i].data.fd == stop_event_fd)
+            {
+                // Consume the event so the receiver can be run again
+                uint64_t value;
+                [[maybe_unused]] const auto result = read(stop_event_fd, &value, sizeof(value));
+                return;
+            }
+
+            readable = true;
+        }
+
+        if (readable && !drain(handler))
+            return;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <ctime>
+#include <sys/socket.h>
+
+/// UDP socket that blocks in epoll until datagrams arrive and drains them in
+/// batches with recvmmsg(). Shutdown is signalled through an eventfd, so there
+/// is no polling interval and no wakeup while idle. Every datagram comes with
+/// the kernel receive timestamp (SO_TIMESTAMPNS, CLOCK_REALTIME).
+class UdpReceiver {
+    public:
+        /// Called for each datagram. 'data' points into a receive slab and is only valid during the call.
+        using DatagramHandler = std::function<void(const uint8_t *data, size_t size, const timespec &kernel_timestamp)>;
+
+        /// Number of datagrams drained per recvmmsg() call and the size of each receive slab.
+        /// A slab holds the largest possible UDP payload, so a datagram is never truncated.
+        static constexpr size_t batch_size = 16;
+        static constexpr size_t slab_size = 64 * 1024;
+
+        /// Binds to 'port' on all interfaces (0 picks a free port). Check is_open() afterwards.
+        explicit UdpReceiver(uint16_t port);
+        ~UdpReceiver();
+
+        UdpReceiver(const UdpReceiver &) = delete;
+        UdpReceiver &operator=(const UdpReceiver &) = delete;
+
+        [[nodiscard]] bool is_open() const { return udp_socket >= 0; }
+
+        /// The port the socket is bound to.
+        [[nodiscard]] uint16_t port() const { return bound_port; }
+
+        /// Receives datagrams on the calling thread until stop() is called.
+        void run(const DatagramHandler &handler);
+
+        /// Wakes up run() and makes it return. Safe to call from any thread.
+        void stop();
+
+    private:
+        void close_all();
+        bool drain(const DatagramHandler &handler);
+
+        int udp_socket = -1;
+        int epoll_fd = -1;
+        int stop_event_fd = -1;
+        uint16_t bound_port = 0;
+
+        std::vector<uint8_t> slabs;
+        struct alignas(cmsghdr) ControlBuffer {
+            uint8_t bytes[CMSG_SPACE(sizeof(timespec))];
+        };
+
+        std::array<ControlBuffer, batch_size> control_buffers{};
+        std::array<iovec, batch_size> iovecs{};
+        std::array<mmsghdr, batch_size> messages{};
+};
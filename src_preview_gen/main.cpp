@@ -4,14 +4,26 @@
  * Usage:
  *   preview_gen [--output <dir>] [--scene <name>] [--scenes <n1,n2,...>]
  *               [--frames <n>] [--fps <n>] [--width <n>] [--height <n>]
+ *               [--jobs <n>] [--seed <n>] [--start-time <unix ms>] [--realtime]
  *               [--dump-manifest] [--manifest-out <file>]
  *
  * Defaults:
- *   --output    ./previews
- *   --frames    90   (6 seconds at 15 fps)
- *   --fps       15
- *   --width     128
- *   --height    128
+ *   --output      ./previews
+ *   --frames      90   (6 seconds at 15 fps)
+ *   --fps         15
+ *   --width       128
+ *   --height      128
+ *   --jobs        number of cores
+ *   --seed        1
+ *   --start-time  1704110400000 (2024-01-01 12:00 UTC)
+ *
+ * Scenes run on a virtual clock: Clock::wall_millis(), FrameTimer and frame pacing
+ * see time advance by exactly one frame delay per frame, without sleeping. --realtime sleeps between frames on the real clock instead.
+ *
+ * With --jobs > 1 the scenes are rendered by that many worker processes, each with
+ * its own plugins and headless emulator canvas. Every scene starts from the same
+ * virtual time and rand() seed, so the GIFs are byte-identical to a --jobs 1 run
+ * (scenes that seed from std::random_device are random either way).
  *
  * Manifest mode (--dump-manifest):
  *   Writes a JSON array of {name, plugin_name, plugin_path} objects and exits
@@ -26,6 +38,13 @@
 #include <vector>
 #include <thread>
 #include <chrono>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 #include <spdlog/spdlog.h>
 #include <spdlog/cfg/env.h>
@@ -42,6 +61,7 @@
 #include "shared/matrix/utils/shared.h"
 #include "shared/matrix/canvas_consts.h"
 #include "shared/matrix/utils/consts.h"
+#include "shared/common/utils/clock.h"
 
 namespace fs = std::filesystem;
 
@@ -70,6 +90,10 @@ struct Args
     int total_frames = 90; // 6 seconds @ 15 fps
     int matrix_width = 128;
     int matrix_height = 128;
+    int jobs = 0; // 0 = one per core
+    unsigned int seed = 1;
+    tmillis_t start_time_ms = 1704110400000; // 2024-01-01 12:00 UTC
+    bool realtime = false;
     bool dump_manifest = false;
     std::string manifest_out; // path for --manifest-out; empty = stdout
 };
@@ -103,6 +127,14 @@ static Args parse_args(int argc, char* argv[])
             parse_int(argv[++i], a.matrix_width);
         else if (std::string(argv[i]) == "--height" && i + 1 < argc)
             parse_int(argv[++i], a.matrix_height);
+        else if (std::string(argv[i]) == "--jobs" && i + 1 < argc)
+            parse_int(argv[++i], a.jobs);
+        else if (std::string(argv[i]) == "--seed" && i + 1 < argc)
+            a.seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+        else if (std::string(argv[i]) == "--start-time" && i + 1 < argc)
+            a.start_time_ms = std::strtoll(argv[++i], nullptr, 10);
+        else if (std::string(argv[i]) == "--realtime")
+            a.realtime = true;
         else if (std::string(argv[i]) == "--dump-manifest")
             a.dump_manifest = true;
         else if (std::string(argv[i]) == "--manifest-out" && i + 1 < argc)
@@ -118,6 +150,8 @@ static Args parse_args(int argc, char* argv[])
         a.fps = 60;
     if (a.total_frames < 1)
         a.total_frames = 1;
+    if (a.jobs < 1)
+        a.jobs = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
     return a;
 }
 
@@ -179,33 +213,19 @@ static Magick::Image make_frame(const std::vector<uint8_t>& rgb,
     return img;
 }
 
+#ifdef ENABLE_EMULATOR
 // ---------------------------------------------------------------------------
-// main
+// Headless matrix, config and plugins, set up once per process
 // ---------------------------------------------------------------------------
-int main(int argc, char* argv[])
+struct Environment
 {
-    spdlog::cfg::load_env_levels();
-
-    const Args args = parse_args(argc, argv);
-
-    // ---- initialise GraphicsMagick ----------------------------------------
-    Magick::InitializeMagick(*argv);
-
-    // ---- create output directory ------------------------------------------
-    std::error_code ec;
-    fs::create_directories(args.output_dir, ec);
-    if (ec)
-    {
-        spdlog::error("Cannot create output directory '{}': {}",
-                      args.output_dir, ec.message());
-        return 1;
-    }
+    rgb_matrix::EmulatorMatrix* matrix = nullptr;
+    Plugins::PluginManager* plugins = nullptr;
+    fs::path config_path;
+};
 
-    // ---- create headless emulator matrix ----------------------------------
-#ifndef ENABLE_EMULATOR
-    spdlog::error("preview_gen requires ENABLE_EMULATOR to be set at compile time.");
-    return 1;
-#else
+static bool setup_environment(const Args& args, Environment& env)
+{
     rgb_matrix::RGBMatrix::Options led_opts;
     led_opts.rows = args.matrix_height;
     led_opts.cols = args.matrix_width;
@@ -216,18 +236,18 @@ int main(int argc, char* argv[])
     emu_opts.headless = true;
     emu_opts.refresh_rate_hz = args.fps;
 
-    rgb_matrix::EmulatorMatrix* matrix =
-        rgb_matrix::EmulatorMatrix::Create(led_opts, emu_opts);
-    if (!matrix)
+    env.matrix = rgb_matrix::EmulatorMatrix::Create(led_opts, emu_opts);
+    if (!env.matrix)
     {
         spdlog::error("Failed to create headless emulator matrix.");
-        return 1;
+        return false;
     }
 
 
     if (!filesystem::exists(Constants::root_dir))
     {
-        filesystem::create_directory(Constants::root_dir);
+        std::error_code ec;
+        filesystem::create_directory(Constants::root_dir, ec);
     }
 
     // ---- initialise shared globals expected by SharedToolsMatrix ----------
@@ -238,30 +258,286 @@ int main(int argc, char* argv[])
     Constants::global_update_manager = nullptr;
 
     // provide a minimal config so nothing derefs a null pointer
-    const fs::path cfg_path = fs::temp_directory_path() / "preview_gen_config.json";
-    config = new Config::MainConfig(cfg_path.string());
+    // (one per process, workers load their plugins at the same time)
+    env.config_path = fs::temp_directory_path() /
+        ("preview_gen_config_" + std::to_string(getpid()) + ".json");
+    config = new Config::MainConfig(env.config_path.string());
 
     // ---- load plugins ------------------------------------------------------
     spdlog::trace("Loading plugins…");
-    const auto pl = Plugins::PluginManager::instance();
-    pl->initialize();
+    env.plugins = Plugins::PluginManager::instance();
+    env.plugins->initialize();
 
-    for (auto plugin : pl->get_plugins())
+    for (auto plugin : env.plugins->get_plugins())
     {
         plugin->before_server_init();
         plugin->after_server_init();
     }
 
-    const auto& wrappers = pl->get_scenes();
-    if (wrappers.empty())
+    return true;
+}
+
+static void teardown_environment(Environment& env)
+{
+    if (env.plugins)
+    {
+        env.plugins->delete_references();
+        env.plugins->destroy_plugins();
+    }
+
+    delete config;
+    config = nullptr;
+    if (!env.config_path.empty())
+    {
+        std::error_code ec;
+        fs::remove(env.config_path, ec);
+    }
+
+    delete env.matrix;
+    env.matrix = nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// Scenes that get a preview, in the same order in every process
+// ---------------------------------------------------------------------------
+static std::vector<std::shared_ptr<Plugins::SceneWrapper>> scenes_to_render(
+    const Args& args, const std::vector<std::shared_ptr<Plugins::SceneWrapper>>& wrappers,
+    bool log_skipped)
+{
+    if (wrappers.empty() && log_skipped)
     {
         spdlog::warn("No scenes found. Make sure PLUGIN_DIR points to the "
             "built plugins directory.");
     }
 
+    std::vector<std::shared_ptr<Plugins::SceneWrapper>> result;
+    for (const auto& wrapper : wrappers)
+    {
+        const std::string scene_name = wrapper->get_name();
+
+        // Skip scenes that require the desktop app - they cannot be rendered
+        // headlessly and need a running desktop connection.  Use
+        // scripts/capture_desktop_preview.sh to capture them manually.
+        if (wrapper->get_default()->needs_desktop_app())
+        {
+            if (log_skipped)
+                spdlog::info("Skipping '{}': requires desktop app (use capture_desktop_preview.sh).",
+                             scene_name);
+            continue;
+        }
+
+        // Apply scene filter (--scene or --scenes)
+        if (!args.filter_scenes.empty())
+        {
+            bool found = false;
+            for (const auto& f : args.filter_scenes)
+                if (f == scene_name)
+                {
+                    found = true;
+                    break;
+                }
+            if (!found)
+                continue;
+        }
+
+        result.push_back(wrapper);
+    }
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Render one scene into a GIF. Returns true if the preview was written.
+// ---------------------------------------------------------------------------
+static bool render_scene(const Args& args, Plugins::SceneWrapper& wrapper,
+                         rgb_matrix::FrameCanvas* canvas)
+{
+    const std::string scene_name = wrapper.get_name();
+
+    // Timing constants
+    const int frame_delay_ms = 1000 / args.fps;
+    const size_t frame_delay_cs =
+        static_cast<size_t>(std::max(1, 100 / args.fps)); // centiseconds
+
+    spdlog::info("Rendering preview for '{}' ({} frames @ {} fps)…",
+                 scene_name, args.total_frames, args.fps);
+
+    // Every scene starts from the same time and random state, no matter which
+    // process renders it or what ran before
+    std::shared_ptr<Clock::VirtualSource> clock;
+    if (!args.realtime)
+    {
+        clock = std::make_shared<Clock::VirtualSource>(args.start_time_ms);
+        Clock::set_source(clock);
+    }
+    std::srand(args.seed);
+
+    // Per-scene crash isolation: wrap the entire render in try/catch so a
+    // single broken scene does not abort the rest of the batch.
+    try
+    {
+        // Create a fresh instance so each scene starts from t=0.
+        // After register_properties(), dump default values back to a JSON object
+        // so that load_properties() can set registered=true even for required
+        // properties that have no user-supplied value.
+        auto scene = wrapper.create();
+        scene->update_default_properties();
+        scene->register_properties();
+
+        nlohmann::json default_props = nlohmann::json::object();
+        for (const auto& prop : scene->get_properties())
+            prop->dump_to_json(default_props);
+
+        scene->load_properties(default_props);
+        scene->initialize(args.matrix_width, args.matrix_height);
+
+        std::vector<Magick::Image> frames;
+        frames.reserve(static_cast<size_t>(args.total_frames));
+
+        for (int f = 0; f < args.total_frames; ++f)
+        {
+            // Advance time so that time-based animations (FrameTimer) move at the
+            // intended rate.  Most scenes read the clock, so without this the
+            // entire animation would appear as a single instant.
+            if (clock)
+                clock->advance(std::chrono::milliseconds(frame_delay_ms));
+            else
+                std::this_thread::sleep_for(std::chrono::milliseconds(frame_delay_ms));
+
+            canvas->Clear();
+            const bool keep_going = scene->render(canvas);
+
+            const auto rgb = capture_canvas(canvas, args.matrix_width,
+                                            args.matrix_height);
+            frames.push_back(make_frame(rgb, args.matrix_width,
+                                        args.matrix_height, frame_delay_cs));
+
+            if (!keep_going)
+            {
+                spdlog::debug("Scene '{}' stopped at frame {}/{}", scene_name,
+                              f + 1, args.total_frames);
+                break;
+            }
+        }
+
+        if (frames.empty())
+        {
+            spdlog::warn("No frames captured for '{}', skipping.", scene_name);
+            return false;
+        }
+
+        // Quantise colours (required for GIF palette, 256 colours max)
+        Magick::quantizeImages(frames.begin(), frames.end());
+
+        const fs::path gif_path =
+            fs::path(args.output_dir) / (scene_name + ".gif");
+
+        Magick::writeImages(frames.begin(), frames.end(), gif_path.string());
+        spdlog::info("Saved preview → {}", gif_path.string());
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::warn("Scene '{}' failed ({}); skipping — existing preview (if any) preserved.",
+                     scene_name, e.what());
+    }
+    catch (...)
+    {
+        spdlog::warn("Scene '{}' threw an unknown exception; skipping.", scene_name);
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// Work shared by all workers. Lives in a shared mapping when workers are
+// forked, so the atomics work across processes.
+// ---------------------------------------------------------------------------
+struct Progress
+{
+    std::atomic<int> next_scene{0};
+    std::atomic<int> total{0};
+    std::atomic<int> generated{0};
+    std::atomic<int> skipped{0};
+    std::atomic<bool> listed{false}; // the scene list was logged by one worker
+};
+
+static_assert(std::atomic<int>::is_always_lock_free, "Progress is shared between processes");
+
+// Takes scenes off the shared queue until it is empty, with its own plugins
+// and canvas.
+static void run_worker(const Args& args, Progress& progress)
+{
+    Environment env;
+    if (!setup_environment(args, env))
+    {
+        teardown_environment(env);
+        return;
+    }
+
+    const auto scenes = scenes_to_render(args, env.plugins->get_scenes(),
+                                         !progress.listed.exchange(true));
+    progress.total.store(static_cast<int>(scenes.size()));
+
+    // ---- allocate a single render canvas ----------------------------------
+    rgb_matrix::FrameCanvas* canvas = env.matrix->CreateFrameCanvas();
+    canvas->Clear();
+
+    for (int i = progress.next_scene.fetch_add(1); i < static_cast<int>(scenes.size());
+         i = progress.next_scene.fetch_add(1))
+    {
+        if (render_scene(args, *scenes[i], canvas))
+            ++progress.generated;
+        else
+            ++progress.skipped;
+    }
+
+    teardown_environment(env);
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// main
+// ---------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    spdlog::cfg::load_env_levels();
+
+    const Args args = parse_args(argc, argv);
+
+    // ---- initialise GraphicsMagick ----------------------------------------
+    Magick::InitializeMagick(*argv);
+
+    // ---- create output directory ------------------------------------------
+    std::error_code ec;
+    fs::create_directories(args.output_dir, ec);
+    if (ec)
+    {
+        spdlog::error("Cannot create output directory '{}': {}",
+                      args.output_dir, ec.message());
+        return 1;
+    }
+
+#ifndef ENABLE_EMULATOR
+    spdlog::error("preview_gen requires ENABLE_EMULATOR to be set at compile time.");
+    return 1;
+#else
     // ---- dump-manifest mode: output scene→plugin mapping then exit --------
     if (args.dump_manifest)
     {
+        Environment env;
+        if (!setup_environment(args, env))
+        {
+            teardown_environment(env);
+            return 1;
+        }
+
+        const auto pl = env.plugins;
+        const auto& wrappers = pl->get_scenes();
+        if (wrappers.empty())
+        {
+            spdlog::warn("No scenes found. Make sure PLUGIN_DIR points to the "
+                "built plugins directory.");
+        }
+
         nlohmann::json manifest = nlohmann::json::array();
 
         for (const auto& wrapper : wrappers)
@@ -297,6 +573,7 @@ int main(int argc, char* argv[])
 
         const std::string manifest_str = manifest.dump(2);
 
+        int exit_code = 0;
         if (args.manifest_out.empty())
         {
             std::cout << manifest_str << "\n";
@@ -307,150 +584,81 @@ int main(int argc, char* argv[])
             if (!out)
             {
                 spdlog::error("Cannot write manifest to '{}'", args.manifest_out);
-                return 1;
+                exit_code = 1;
+            }
+            else
+            {
+                out << manifest_str << "\n";
+                spdlog::info("Scene manifest written to {}", args.manifest_out);
             }
-            out << manifest_str << "\n";
-            spdlog::info("Scene manifest written to {}", args.manifest_out);
         }
 
         // Cleanup and exit without rendering
-        pl->delete_references();
-        pl->destroy_plugins();
-        delete config;
-        config = nullptr;
-        delete matrix;
-        return 0;
+        teardown_environment(env);
+        return exit_code;
     }
 
-    // ---- allocate a single render canvas ----------------------------------
-    rgb_matrix::FrameCanvas* canvas = matrix->CreateFrameCanvas();
-    canvas->Clear();
-
-    // Timing constants
-    const int frame_delay_ms = 1000 / args.fps;
-    const size_t frame_delay_cs =
-        static_cast<size_t>(std::max(1, 100 / args.fps)); // centiseconds
-
+    const auto started = std::chrono::steady_clock::now();
     int generated = 0;
     int skipped = 0;
 
-    // ---- iterate scenes ---------------------------------------------------
-    for (const auto& wrapper : wrappers)
+    if (args.jobs == 1)
     {
-        const std::string scene_name = wrapper->get_name();
-
-        // Skip scenes that require the desktop app - they cannot be rendered
-        // headlessly and need a running desktop connection.  Use
-        // scripts/capture_desktop_preview.sh to capture them manually.
-        if (wrapper->get_default()->needs_desktop_app())
+        Progress progress;
+        run_worker(args, progress);
+        generated = progress.generated.load();
+        skipped = progress.skipped.load();
+    }
+    else
+    {
+        // Workers are forked before any plugin is loaded, so none of them
+        // inherits plugin threads or half-held locks.
+        void* mapping = mmap(nullptr, sizeof(Progress), PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED)
         {
-            spdlog::info("Skipping '{}': requires desktop app (use capture_desktop_preview.sh).",
-                         scene_name);
-            continue;
+            spdlog::error("Cannot map shared progress: {}", std::strerror(errno));
+            return 1;
         }
+        auto* progress = new(mapping) Progress();
 
-        // Apply scene filter (--scene or --scenes)
-        if (!args.filter_scenes.empty())
+        spdlog::info("Rendering with {} worker processes", args.jobs);
+        std::vector<pid_t> workers;
+        for (int i = 0; i < args.jobs; ++i)
         {
-            bool found = false;
-            for (const auto& f : args.filter_scenes)
-                if (f == scene_name)
-                {
-                    found = true;
-                    break;
-                }
-            if (!found)
-                continue;
-        }
-
-        spdlog::info("Rendering preview for '{}' ({} frames @ {} fps)…",
-                     scene_name, args.total_frames, args.fps);
-
-        // Per-scene crash isolation: wrap the entire render in try/catch so a
-        // single broken scene does not abort the rest of the batch.
-        try
-        {
-            // Create a fresh instance so each scene starts from t=0.
-            // After register_properties(), dump default values back to a JSON object
-            // so that load_properties() can set registered=true even for required
-            // properties that have no user-supplied value.
-            auto scene = wrapper->create();
-            scene->update_default_properties();
-            scene->register_properties();
-
-            nlohmann::json default_props = nlohmann::json::object();
-            for (const auto& prop : scene->get_properties())
-                prop->dump_to_json(default_props);
-
-            scene->load_properties(default_props);
-            scene->initialize(args.matrix_width, args.matrix_height);
-
-            std::vector<Magick::Image> frames;
-            frames.reserve(static_cast<size_t>(args.total_frames));
-
-            for (int f = 0; f < args.total_frames; ++f)
+            const pid_t pid = fork();
+            if (pid == 0)
             {
-                // Sleep so that time-based animations (FrameTimer) advance at the
-                // intended rate.  Most scenes use real wall-clock time, so without
-                // this sleep the entire animation would appear as a single instant.
-                std::this_thread::sleep_for(std::chrono::milliseconds(frame_delay_ms));
-
-                canvas->Clear();
-                const bool keep_going = scene->render(canvas);
-
-                const auto rgb = capture_canvas(canvas, args.matrix_width,
-                                                args.matrix_height);
-                frames.push_back(make_frame(rgb, args.matrix_width,
-                                            args.matrix_height, frame_delay_cs));
-
-                if (!keep_going)
-                {
-                    spdlog::debug("Scene '{}' stopped at frame {}/{}", scene_name,
-                                  f + 1, args.total_frames);
-                    break;
-                }
+                run_worker(args, *progress);
+                std::fflush(nullptr);
+                _exit(0);
             }
-
-            if (frames.empty())
+            if (pid < 0)
             {
-                spdlog::warn("No frames captured for '{}', skipping.", scene_name);
-                ++skipped;
-                continue;
+                spdlog::warn("Could not start worker {}: {}", i, std::strerror(errno));
+                break;
             }
-
-            // Quantise colours (required for GIF palette, 256 colours max)
-            Magick::quantizeImages(frames.begin(), frames.end());
-
-            const fs::path gif_path =
-                fs::path(args.output_dir) / (scene_name + ".gif");
-
-            Magick::writeImages(frames.begin(), frames.end(), gif_path.string());
-            spdlog::info("Saved preview → {}", gif_path.string());
-            ++generated;
-        }
-        catch (const std::exception& e)
-        {
-            spdlog::warn("Scene '{}' failed ({}); skipping — existing preview (if any) preserved.",
-                         scene_name, e.what());
-            ++skipped;
+            workers.push_back(pid);
         }
-        catch (...)
+
+        for (const pid_t pid : workers)
         {
-            spdlog::warn("Scene '{}' threw an unknown exception; skipping.", scene_name);
-            ++skipped;
+            int status = 0;
+            waitpid(pid, &status, 0);
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+                spdlog::warn("Worker {} crashed, the scene it was rendering is skipped.", pid);
         }
-    }
-
-    spdlog::info("Done. Generated: {}  Skipped: {}", generated, skipped);
-
-    // ---- cleanup ----------------------------------------------------------
-    pl->delete_references();
-    pl->destroy_plugins();
 
-    delete config;
-    config = nullptr;
+        generated = progress->generated.load();
+        // Scenes of crashed workers never report back
+        skipped = std::max(progress->skipped.load(), progress->total.load() - generated);
+        progress->~Progress();
+        munmap(mapping, sizeof(Progress));
+    }
 
-    delete matrix;
+    spdlog::info("Done in {:.1f}s. Generated: {}  Skipped: {}",
+                 std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count(),
+                 generated, skipped);
 
     return (skipped > 0 && generated == 0) ? 1 : 0;
 #endif
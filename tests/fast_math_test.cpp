@@ -0,0 +1,113 @@
+/**
+ * fast_math_test: the error bounds FastMath.h documents, checked against double
+ * precision <cmath> over dense sweeps of the inputs.
+ *
+ * Usage:
+ *   fast_math_test
+ *
+ * Exits with status 1 if a bound is exceeded.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <numbers>
+
+#include "shared/matrix/utils/FastMath.h"
+
+namespace
+{
+    using FastMath::f32x4;
+
+    // The bounds documented in FastMath.h
+    constexpr double sin_bound = 2.5e-7;
+    constexpr double cos_bound = 2.5e-7;
+    constexpr double exp_relative_bound = 1.0e-7;
+    constexpr double atan2_bound = 2.5e-6;
+
+    /// Largest 'error' of 'fast' for 'count' evenly spaced x in [from, to].
+    double max_error(const double from, const double to, const long count, const std::function<f32x4(f32x4)> &fast,
+                     const std::function<double(double, double)> &error)
+    {
+        double worst = 0.0;
+        float in[4];
+        float out[4];
+        for (long i = 0; i < count; i += 4)
+        {
+            for (int lane = 0; lane < 4; ++lane)
+                in[lane] = static_cast<float>(from + (to - from) * static_cast<double>(std::min(i + lane, count - 1)) /
+                                                         static_cast<double>(count - 1));
+
+            fast(f32x4::load(in)).store(out);
+            for (int lane = 0; lane < 4; ++lane)
+                worst = std::max(worst, error(in[lane], out[lane]));
+        }
+        return worst;
+    }
+
+    /// Largest angle between FastMath::atan2 and std::atan2 on a circle of 'radius'.
+    double atan2_error(const double radius, const long count)
+    {
+        double worst = 0.0;
+        float ys[4];
+        float xs[4];
+        float out[4];
+        for (long i = 0; i < count; i += 4)
+        {
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                const double angle = -std::numbers::pi + 2.0 * std::numbers::pi * static_cast<double>(i + lane) / count;
+                ys[lane] = static_cast<float>(radius * std::sin(angle));
+                xs[lane] = static_cast<float>(radius * std::cos(angle));
+            }
+
+            FastMath::atan2(f32x4::load(ys), f32x4::load(xs)).store(out);
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                // -pi and pi are the same angle
+                const double difference = out[lane] - std::atan2(static_cast<double>(ys[lane]), xs[lane]);
+                worst = std::max(worst, std::abs(std::remainder(difference, 2.0 * std::numbers::pi)));
+            }
+        }
+        return worst;
+    }
+
+    int failures = 0;
+
+    void check(const char *name, const double measured, const double bound)
+    {
+        const bool ok = measured <= bound;
+        std::printf("%-40s %10.3g <= %-10.3g %s\n", name, measured, bound, ok ? "ok" : "FAILED");
+        failures += ok ? 0 : 1;
+    }
+}
+
+int main()
+{
+    const auto fast_sin = [](const f32x4 x) { return FastMath::sin(x); };
+    const auto fast_cos = [](const f32x4 x) { return FastMath::cos(x); };
+    const auto sin_error = [](const double x, const double y) { return std::abs(y - std::sin(x)); };
+    const auto cos_error = [](const double x, const double y) { return std::abs(y - std::cos(x)); };
+
+    check("sin, |x| <= 4", max_error(-4.0, 4.0, 4'000'000, fast_sin, sin_error), sin_bound);
+    check("sin, |x| <= 3000", max_error(-3000.0, 3000.0, 16'000'000, fast_sin, sin_error), sin_bound);
+    check("cos, |x| <= 4", max_error(-4.0, 4.0, 4'000'000, fast_cos, cos_error), cos_bound);
+    check("cos, |x| <= 3000", max_error(-3000.0, 3000.0, 16'000'000, fast_cos, cos_error), cos_bound);
+
+    const auto exp_error = [](const double x, const double y)
+    {
+        const double expected = std::exp(x);
+        return std::abs(y - expected) / expected;
+    };
+    check("exp relative, -87 <= x <= 88",
+          max_error(-87.0, 88.0, 16'000'000, [](const f32x4 x) { return FastMath::exp(x); }, exp_error),
+          exp_relative_bound);
+
+    double atan2_worst = 0.0;
+    for (const double radius : {1e-3, 0.5, 1.0, 7.0, 1e3})
+        atan2_worst = std::max(atan2_worst, atan2_error(radius, 4'000'000));
+    check("atan2, radius 1e-3 to 1e3", atan2_worst, atan2_bound);
+
+    return failures == 0 ? 0 : 1;
+}
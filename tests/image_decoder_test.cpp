@@ -0,0 +1,136 @@
+/**
+ * image_decoder_test: GIF streams with malformed image descriptors have to be
+ * rejected before the decoder allocates anything for them.
+ *
+ * Usage:
+ *   image_decoder_test
+ *
+ * Exits with status 1 if a check fails.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <vector>
+
+#include "shared/matrix/utils/image_decoder.h"
+
+namespace
+{
+    struct Descriptor
+    {
+        uint16_t left;
+        uint16_t top;
+        uint16_t width;
+        uint16_t height;
+    };
+
+    void put_u16(std::vector<uint8_t> &out, const uint16_t value)
+    {
+        out.push_back(value & 0xFF);
+        out.push_back(value >> 8);
+    }
+
+    /// LZW data for 'pixels' pixels of color 0. Every pixel is preceded by a clear
+    /// code, so the codes stay 3 bits wide.
+    std::vector<uint8_t> lzw_zeros(const size_t pixels)
+    {
+        std::vector<uint8_t> packed;
+        uint32_t bits = 0;
+        int bit_count = 0;
+        const auto put = [&](const uint32_t code)
+        {
+            bits |= code << bit_count;
+            bit_count += 3;
+            while (bit_count >= 8)
+            {
+                packed.push_back(bits & 0xFF);
+                bits >>= 8;
+                bit_count -= 8;
+            }
+        };
+
+        for (size_t i = 0; i < pixels; ++i)
+        {
+            put(4); // clear
+            put(0);
+        }
+        put(5); // end
+        if (bit_count > 0)
+            packed.push_back(bits & 0xFF);
+        return packed;
+    }
+
+    /// A GIF89a with a four color global palette and one image per descriptor.
+    std::vector<uint8_t> make_gif(const uint16_t screen_width, const uint16_t screen_height,
+                                  const std::initializer_list<Descriptor> frames)
+    {
+        std::vector<uint8_t> gif = {'G', 'I', 'F', '8', '9', 'a'};
+        put_u16(gif, screen_width);
+        put_u16(gif, screen_height);
+        gif.insert(gif.end(), {0x81, 0, 0});
+        gif.insert(gif.end(), {0, 0, 0, 255, 255, 255, 255, 0, 0, 0, 255, 0});
+
+        for (const auto &frame : frames)
+        {
+            gif.push_back(0x2C);
+            put_u16(gif, frame.left);
+            put_u16(gif, frame.top);
+            put_u16(gif, frame.width);
+            put_u16(gif, frame.height);
+            gif.push_back(0);
+
+            // Only enough data for a small frame, the big ones must never get this far
+            const auto lzw = lzw_zeros(std::min<size_t>(static_cast<size_t>(frame.width) * frame.height, 64));
+            gif.push_back(2);
+            for (size_t i = 0; i < lzw.size(); i += 255)
+            {
+                const size_t size = std::min<size_t>(255, lzw.size() - i);
+                gif.push_back(static_cast<uint8_t>(size));
+                gif.insert(gif.end(), lzw.begin() + i, lzw.begin() + i + size);
+            }
+            gif.push_back(0);
+        }
+
+        gif.push_back(0x3B);
+        return gif;
+    }
+
+    ImageDecoder::Geometry source_size(const int width, const int height)
+    {
+        return {.scaled_width = width, .scaled_height = height, .crop_x = 0, .crop_y = 0,
+                .width = width, .height = height, .nearest = true};
+    }
+
+    int failures = 0;
+
+    void check(const bool ok, const char *name)
+    {
+        std::printf("%-50s %s\n", name, ok ? "ok" : "FAILED");
+        failures += ok ? 0 : 1;
+    }
+}
+
+int main()
+{
+    const auto valid = ImageDecoder::decode(make_gif(4, 4, {{0, 0, 4, 4}}), source_size);
+    check(valid.has_value() && valid->frames.size() == 1 && valid->width == 4, "valid frame decodes");
+
+    const auto oversized = ImageDecoder::decode(make_gif(4, 4, {{0, 0, 65535, 65535}}), source_size);
+    check(!oversized.has_value(), "65535x65535 frame on a 4x4 screen is rejected");
+
+    const auto wide = ImageDecoder::decode(make_gif(4, 4, {{0, 0, 65535, 1}}), source_size);
+    check(!wide.has_value(), "frame wider than the screen is rejected");
+
+    const auto offset = ImageDecoder::decode(make_gif(4, 4, {{2, 0, 4, 4}}), source_size);
+    check(!offset.has_value(), "frame reaching past the right edge is rejected");
+
+    const auto below = ImageDecoder::decode(make_gif(4, 4, {{0, 65535, 4, 4}}), source_size);
+    check(!below.has_value(), "frame below the screen is rejected");
+
+    const auto partial = ImageDecoder::decode(make_gif(4, 4, {{0, 0, 4, 4}, {0, 0, 65535, 65535}}), source_size);
+    check(partial.has_value() && partial->frames.size() == 1, "frames before an oversized one are kept");
+
+    return failures == 0 ? 0 : 1;
+}